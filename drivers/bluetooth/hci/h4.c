@@ -60,6 +60,8 @@ struct h4_data {
 	struct {
 		uint8_t         type;
 		struct net_buf *buf;
+		/* Fragment of buf being written */
+		struct net_buf *frag;
 		struct k_fifo   fifo;
 	} tx;
 
@@ -425,16 +427,23 @@ static inline void process_tx(const struct device *dev)
 			uart_irq_tx_disable(cfg->uart);
 			return;
 		}
+
+		h4->tx.frag = h4->tx.buf;
 	}
 
-	bytes = uart_fifo_fill(cfg->uart, h4->tx.buf->data, h4->tx.buf->len);
+	bytes = uart_fifo_fill(cfg->uart, h4->tx.frag->data, h4->tx.frag->len);
 	if (unlikely(bytes < 0)) {
 		LOG_ERR("Unable to write to UART (err %d)", bytes);
 	} else {
-		net_buf_pull(h4->tx.buf, bytes);
+		net_buf_pull(h4->tx.frag, bytes);
+	}
+
+	/* ACL packets may come as a fragment chain (tx-frags quirk) */
+	while (!h4->tx.frag->len && h4->tx.frag->frags) {
+		h4->tx.frag = h4->tx.frag->frags;
 	}
 
-	if (h4->tx.buf->len) {
+	if (h4->tx.frag->len) {
 		return;
 	}
 
@@ -443,6 +452,8 @@ static inline void process_tx(const struct device *dev)
 	h4->tx.buf = k_fifo_get(&h4->tx.fifo, K_NO_WAIT);
 	if (!h4->tx.buf) {
 		uart_irq_tx_disable(cfg->uart);
+	} else {
+		h4->tx.frag = h4->tx.buf;
 	}
 }
 
@@ -411,8 +411,27 @@ void nvme_controller_data_swapbytes(struct nvme_controller_data *s)
 
 #define NVME_ADMINQ_ALLOCATE(n, n_entries)		\
 	NVME_QUEUE_ALLOCATE(admin_##n, n_entries)
-#define NVME_IOQ_ALLOCATE(n, n_entries)			\
-	NVME_QUEUE_ALLOCATE(io_##n, n_entries)
+
+#define NVME_IOQ_INIT(idx, n, n_entries)			\
+	{							\
+		.num_entries = n_entries,			\
+		.cmd = cmd_io_##n[idx].entries,			\
+		.cpl = cpl_io_##n[idx].entries,			\
+	}
+
+/* One queue pair per CPU, each with page aligned queues */
+#define NVME_IOQ_ALLOCATE(n, n_entries)					\
+	static struct __aligned(0x1000) {				\
+		struct nvme_command entries[n_entries];			\
+	} cmd_io_##n[CONFIG_NVME_IO_QUEUES];				\
+	static struct __aligned(0x1000) {				\
+		struct nvme_completion entries[n_entries];		\
+	} cpl_io_##n[CONFIG_NVME_IO_QUEUES];				\
+									\
+	static struct nvme_cmd_qpair io_##n[CONFIG_NVME_IO_QUEUES] = {	\
+		LISTIFY(CONFIG_NVME_IO_QUEUES, NVME_IOQ_INIT, (,),	\
+			n, n_entries)					\
+	}
 
 struct nvme_controller_config {
 	struct pcie_dev *pcie;
@@ -433,6 +452,7 @@ struct nvme_controller {
 
 	uint32_t num_io_queues;
 	struct nvme_cmd_qpair *adminq;
+	/** num_io_queues I/O queue pairs */
 	struct nvme_cmd_qpair *ioq;
 
 	uint32_t ready_timeout_in_ms;
@@ -462,6 +482,17 @@ bool nvme_controller_has_dataset_mgmt(struct nvme_controller *ctrlr)
 		NVME_CTRLR_DATA_ONCS_DSM_MASK);
 }
 
+/*
+ * I/O queue pair to submit to from the current CPU. The caller may migrate
+ * right after, which is harmless: any queue pair can be used from any CPU,
+ * picking the local one only spares lock contention and cache traffic.
+ */
+static inline
+struct nvme_cmd_qpair *nvme_controller_get_ioq(struct nvme_controller *ctrlr)
+{
+	return &ctrlr->ioq[arch_curr_cpu()->id % ctrlr->num_io_queues];
+}
+
 static inline void nvme_lock(const struct device *dev)
 {
 	struct nvme_controller *nvme_ctrlr = dev->data;
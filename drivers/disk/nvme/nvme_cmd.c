@@ -25,6 +25,11 @@ static struct nvme_request request_pool[NVME_REQUEST_AMOUNT];
 static sys_dlist_t free_request;
 static sys_dlist_t pending_request;
 
+/* Protects the pools and the pending list, shared by all the queue pairs */
+static struct k_spinlock request_lock;
+
+#define NVME_REQUEST_TIMEOUT_MS (CONFIG_NVME_REQUEST_TIMEOUT * MSEC_PER_SEC)
+
 static void request_timeout(struct k_work *work);
 
 static K_WORK_DELAYABLE_DEFINE(request_timer, request_timeout);
@@ -214,6 +219,7 @@ void nvme_cmd_init(void)
 	}
 }
 
+/* Must be called with request_lock held */
 static struct nvme_prp_list *nvme_prp_list_alloc(void)
 {
 	sys_dnode_t *node;
@@ -229,6 +235,7 @@ static struct nvme_prp_list *nvme_prp_list_alloc(void)
 	return CONTAINER_OF(node, struct nvme_prp_list, node);
 }
 
+/* Must be called with request_lock held */
 static void nvme_prp_list_free(struct nvme_prp_list *prp_list)
 {
 	memset(prp_list, 0, sizeof(struct nvme_prp_list));
@@ -237,6 +244,8 @@ static void nvme_prp_list_free(struct nvme_prp_list *prp_list)
 
 void nvme_cmd_request_free(struct nvme_request *request)
 {
+	k_spinlock_key_t key = k_spin_lock(&request_lock);
+
 	if (sys_dnode_is_linked(&request->node)) {
 		sys_dlist_remove(&request->node);
 	}
@@ -247,49 +256,113 @@ void nvme_cmd_request_free(struct nvme_request *request)
 
 	memset(request, 0, sizeof(struct nvme_request));
 	sys_dlist_append(&free_request, &request->node);
+
+	k_spin_unlock(&request_lock, key);
 }
 
 struct nvme_request *nvme_cmd_request_alloc(void)
 {
+	k_spinlock_key_t key = k_spin_lock(&request_lock);
 	sys_dnode_t *node;
 
 	node = sys_dlist_peek_head(&free_request);
+	if (node != NULL) {
+		sys_dlist_remove(node);
+	}
+
+	k_spin_unlock(&request_lock, key);
+
 	if (!node) {
 		LOG_ERR("Could not allocate request");
 		return NULL;
 	}
 
-	sys_dlist_remove(node);
-
 	return CONTAINER_OF(node, struct nvme_request, node);
 }
 
 static void nvme_cmd_register_request(struct nvme_request *request)
 {
-	sys_dlist_append(&pending_request, &request->node);
+	k_spinlock_key_t key = k_spin_lock(&request_lock);
 
 	request->req_start = k_uptime_get_32();
+	sys_dlist_append(&pending_request, &request->node);
+
+	k_spin_unlock(&request_lock, key);
 
 	if (!k_work_delayable_remaining_get(&request_timer)) {
 		k_work_reschedule(&request_timer,
-				  K_SECONDS(CONFIG_NVME_REQUEST_TIMEOUT));
+				  K_MSEC(NVME_REQUEST_TIMEOUT_MS));
 	}
 }
 
+/*
+ * Look up the pending request a completion refers to, and take it out of
+ * the pending list so it cannot time out anymore. A request that is not
+ * pending on that queue pair has already timed out, or the controller
+ * is returning garbage.
+ */
+static struct nvme_request *nvme_cmd_request_get_pending(struct nvme_cmd_qpair *qpair,
+							  uint16_t cid)
+{
+	struct nvme_request *request = NULL;
+	k_spinlock_key_t key;
+
+	if (cid >= NVME_REQUEST_AMOUNT) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&request_lock);
+
+	/* Free requests are linked too, but they don't belong to a qpair */
+	if (request_pool[cid].qpair == qpair &&
+	    sys_dnode_is_linked(&request_pool[cid].node)) {
+		request = &request_pool[cid];
+		sys_dlist_remove(&request->node);
+	}
+
+	k_spin_unlock(&request_lock, key);
+
+	return request;
+}
+
 static void request_timeout(struct k_work *work)
 {
 	uint32_t current = k_uptime_get_32();
 	struct nvme_request *request, *next;
+	int32_t remaining = 0;
+	k_spinlock_key_t key;
+	sys_dlist_t expired;
 
 	ARG_UNUSED(work);
 
+	sys_dlist_init(&expired);
+
+	key = k_spin_lock(&request_lock);
+
 	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&pending_request,
 					  request, next, node) {
-		if ((int32_t)(request->req_start +
-			      CONFIG_NVME_REQUEST_TIMEOUT - current) > 0) {
+		remaining = (int32_t)(request->req_start +
+				      NVME_REQUEST_TIMEOUT_MS - current);
+		if (remaining > 0) {
 			break;
 		}
 
+		/* A late completion will not match it anymore */
+		request->qpair = NULL;
+		sys_dlist_remove(&request->node);
+		sys_dlist_append(&expired, &request->node);
+	}
+
+	k_spin_unlock(&request_lock, key);
+
+	/* Callbacks are called without holding the lock, as they may
+	 * submit new requests.
+	 */
+	if (request != NULL) {
+		k_work_reschedule(&request_timer, K_MSEC(remaining));
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&expired, request, next, node) {
 		LOG_WRN("Request %p CID %u timed-out",
 			request, request->cmd.cdw0.cid);
 
@@ -305,13 +378,6 @@ static void request_timeout(struct k_work *work)
 
 		nvme_cmd_request_free(request);
 	}
-
-	if (request) {
-		k_work_reschedule(&request_timer,
-				  K_SECONDS(request->req_start +
-					    CONFIG_NVME_REQUEST_TIMEOUT -
-					    current));
-	}
 }
 
 static bool nvme_completion_is_retry(const struct nvme_completion *cpl)
@@ -401,12 +467,20 @@ static void nvme_cmd_request_complete(struct nvme_request *request,
 	}
 
 	if (retry) {
+		nvme_cb_fn_t cb_fn = request->cb_fn;
+		void *cb_arg = request->cb_arg;
+
 		LOG_DBG("Retrying CMD");
-		/* Let's remove it from pending... */
-		sys_dlist_remove(&request->node);
-		/* ...and re-submit, thus re-adding to pending */
-		nvme_cmd_qpair_submit_request(request->qpair, request);
+		/* It was removed from pending already, re-submitting
+		 * re-adds it there.
+		 */
 		request->retries++;
+		if (nvme_cmd_qpair_submit_request(request->qpair, request) != 0) {
+			/* The request got freed on the way */
+			if (cb_fn) {
+				cb_fn(cb_arg, cpl);
+			}
+		}
 	} else {
 		LOG_DBG("Request %p CMD complete on %p/%p",
 			request, request->cb_fn, request->cb_arg);
@@ -423,8 +497,11 @@ static void nvme_cmd_qpair_process_completion(struct nvme_cmd_qpair *qpair)
 {
 	struct nvme_request *request;
 	struct nvme_completion cpl;
+	k_spinlock_key_t key;
 	int done = 0;
 
+	key = k_spin_lock(&qpair->lock);
+
 	if (qpair->num_intr_handler_calls == 0 && qpair->phase == 0) {
 		LOG_WRN("Phase wrong for first interrupt call.");
 	}
@@ -446,24 +523,29 @@ static void nvme_cmd_qpair_process_completion(struct nvme_cmd_qpair *qpair)
 			LOG_WRN("Phase unexpectedly inconsistent");
 		}
 
-		if (cpl.cid < NVME_REQUEST_AMOUNT) {
-			request = &request_pool[cpl.cid];
-		} else {
-			request = NULL;
+		done++;
+		qpair->sq_head = cpl.sqhd;
+
+		qpair->cq_head++;
+		if (qpair->cq_head == qpair->num_entries) {
+			qpair->cq_head = 0;
+			qpair->phase = !qpair->phase;
 		}
 
-		done++;
+		/* Completing may re-submit the request on this qpair */
+		k_spin_unlock(&qpair->lock, key);
+
+		request = nvme_cmd_request_get_pending(qpair, cpl.cid);
 		if (request != NULL) {
 			nvme_cmd_request_complete(request, &cpl);
-			qpair->sq_head = cpl.sqhd;
 		} else {
 			LOG_ERR("cpl (cid = %u) does not map to cmd", cpl.cid);
 		}
 
-		qpair->cq_head++;
-		if (qpair->cq_head == qpair->num_entries) {
-			qpair->cq_head = 0;
-			qpair->phase = !qpair->phase;
+		key = k_spin_lock(&qpair->lock);
+
+		if (request == NULL) {
+			qpair->num_ignored++;
 		}
 	}
 
@@ -472,6 +554,8 @@ static void nvme_cmd_qpair_process_completion(struct nvme_cmd_qpair *qpair)
 
 		sys_write32(qpair->cq_head, regs + qpair->cq_hdbl_off);
 	}
+
+	k_spin_unlock(&qpair->lock, key);
 }
 
 static void nvme_cmd_qpair_msi_handler(const void *arg)
@@ -545,10 +629,14 @@ static int nvme_cmd_qpair_fill_prp_list(struct nvme_cmd_qpair *qpair,
 					int n_prp)
 {
 	struct nvme_prp_list *prp_list;
+	k_spinlock_key_t key;
 	uintptr_t p_addr;
 	int idx;
 
+	key = k_spin_lock(&request_lock);
 	prp_list = nvme_prp_list_alloc();
+	k_spin_unlock(&request_lock, key);
+
 	if (prp_list == NULL) {
 		return -ENOMEM;
 	}
@@ -639,35 +727,55 @@ int nvme_cmd_qpair_submit_request(struct nvme_cmd_qpair *qpair,
 				  struct nvme_request *request)
 {
 	mm_reg_t regs = DEVICE_MMIO_GET(qpair->ctrlr->dev);
+	k_spinlock_key_t key;
+	uint32_t sq_next;
 	int ret;
 
-	request->qpair = qpair;
-
 	request->cmd.cdw0.cid = sys_cpu_to_le16((uint16_t)(request -
 							   request_pool));
 
-	ret = nvme_cmd_qpair_fill_dptr(qpair, request);
-	if (ret != 0) {
+	if (request->prp_list == NULL) {
+		ret = nvme_cmd_qpair_fill_dptr(qpair, request);
+		if (ret != 0) {
+			nvme_cmd_request_free(request);
+			return ret;
+		}
+	}
+
+	key = k_spin_lock(&qpair->lock);
+
+	sq_next = qpair->sq_tail + 1;
+	if (sq_next == qpair->num_entries) {
+		sq_next = 0;
+	}
+
+	if (sq_next == qpair->sq_head) {
+		k_spin_unlock(&qpair->lock, key);
+		LOG_WRN("Submission queue %u is full", qpair->id);
 		nvme_cmd_request_free(request);
-		return ret;
+		return -EBUSY;
 	}
 
+	/* Registered before the controller sees it, as it may complete
+	 * right away on another CPU.
+	 */
+	request->qpair = qpair;
 	nvme_cmd_register_request(request);
 
 	memcpy(&qpair->cmd[qpair->sq_tail],
 	       &request->cmd, sizeof(request->cmd));
 
-	qpair->sq_tail++;
-	if (qpair->sq_tail == qpair->num_entries) {
-		qpair->sq_tail = 0;
-	}
+	qpair->sq_tail = sq_next;
 
 	sys_write32(qpair->sq_tail, regs + qpair->sq_tdbl_off);
 	qpair->num_cmds++;
 
 	LOG_DBG("Request %p %llu submitted: CID %u - sq_tail %u",
 		request, qpair->num_cmds, request->cmd.cdw0.cid,
-		qpair->sq_tail - 1);
+		qpair->sq_tail);
+
+	k_spin_unlock(&qpair->lock, key);
+
 	return 0;
 }
 
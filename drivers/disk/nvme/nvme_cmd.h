@@ -9,6 +9,7 @@
 #ifndef ZEPHYR_DRIVERS_DISK_NVME_NVME_COMMAND_H_
 #define ZEPHYR_DRIVERS_DISK_NVME_NVME_COMMAND_H_
 
+#include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/sys/byteorder.h>
 
@@ -324,6 +325,9 @@ struct nvme_cmd_qpair {
 	struct nvme_controller	*ctrlr;
 	uint32_t		id;
 
+	/* Protects the queues state, submission may happen from any CPU */
+	struct k_spinlock	lock;
+
 	uint32_t		num_entries;
 
 	uint32_t		sq_tdbl_off;
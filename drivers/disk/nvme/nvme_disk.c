@@ -9,6 +9,10 @@ LOG_MODULE_DECLARE(nvme, CONFIG_NVME_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <zephyr/sys/byteorder.h>
 
+#ifdef CONFIG_DISK_ACCESS_RTIO
+#include <zephyr/storage/disk_access_rtio.h>
+#endif
+
 #include "nvme.h"
 
 static int nvme_disk_status(struct disk_info *disk)
@@ -16,53 +20,77 @@ static int nvme_disk_status(struct disk_info *disk)
 	return 0;
 }
 
-static int nvme_disk_read(struct disk_info *disk,
-			  uint8_t *data_buf,
-			  uint32_t start_sector,
-			  uint32_t num_sector)
+int nvme_namespace_rw_async(struct nvme_namespace *ns, bool write,
+			    uint8_t *data_buf, uint32_t start_sector,
+			    uint32_t num_sector, nvme_cb_fn_t cb_fn,
+			    void *cb_arg)
 {
-	struct nvme_namespace *ns = CONTAINER_OF(disk->name,
-						 struct nvme_namespace, name[0]);
-	struct nvme_completion_poll_status status =
-		NVME_CPL_STATUS_POLL_INIT(status);
 	struct nvme_request *request;
 	uint32_t payload_size;
-	int ret = 0;
 
 	if (!NVME_IS_BUFFER_DWORD_ALIGNED(data_buf)) {
 		LOG_WRN("Data buffer pointer needs to be 4-bytes aligned");
 		return -EINVAL;
 	}
 
-	nvme_lock(disk->dev);
-
 	payload_size = num_sector * nvme_namespace_get_sector_size(ns);
 
 	request = nvme_allocate_request_vaddr((void *)data_buf, payload_size,
-					      nvme_completion_poll_cb, &status);
+					      cb_fn, cb_arg);
 	if (request == NULL) {
-		ret = -ENOMEM;
-		goto out;
+		return -ENOMEM;
 	}
 
-	nvme_namespace_read_cmd(&request->cmd, ns->id,
-				start_sector, num_sector);
+	if (write) {
+		nvme_namespace_write_cmd(&request->cmd, ns->id,
+					 start_sector, num_sector);
+	} else {
+		nvme_namespace_read_cmd(&request->cmd, ns->id,
+					start_sector, num_sector);
+	}
+
+	return nvme_cmd_qpair_submit_request(
+		nvme_controller_get_ioq(ns->ctrlr), request);
+}
+
+static int nvme_disk_rw(struct disk_info *disk, bool write,
+			uint8_t *data_buf, uint32_t start_sector,
+			uint32_t num_sector)
+{
+	struct nvme_namespace *ns = CONTAINER_OF(disk->name,
+						 struct nvme_namespace, name[0]);
+	struct nvme_completion_poll_status status =
+		NVME_CPL_STATUS_POLL_INIT(status);
+	int ret;
 
-	/* We use only the first ioq atm
-	 * ToDo: use smp cpu id and use it to select ioq
+	/* No controller wide lock: each CPU submits to its own queue pair
+	 * and only sleeps on the completion of its own request.
 	 */
-	nvme_cmd_qpair_submit_request(ns->ctrlr->ioq, request);
+	ret = nvme_namespace_rw_async(ns, write, data_buf, start_sector,
+				      num_sector, nvme_completion_poll_cb,
+				      &status);
+	if (ret != 0) {
+		return ret;
+	}
 
 	nvme_completion_poll(&status);
 	if (nvme_cpl_status_is_error(&status)) {
-		LOG_WRN("Reading at sector %u (count %d) on disk %s failed",
+		LOG_WRN("%s at sector %u (count %d) on disk %s failed",
+			write ? "Writing" : "Reading",
 			start_sector, num_sector, ns->name);
 		nvme_completion_print(&status.cpl);
-		ret = -EIO;
+		return -EIO;
 	}
-out:
-	nvme_unlock(disk->dev);
-	return ret;
+
+	return 0;
+}
+
+static int nvme_disk_read(struct disk_info *disk,
+			  uint8_t *data_buf,
+			  uint32_t start_sector,
+			  uint32_t num_sector)
+{
+	return nvme_disk_rw(disk, false, data_buf, start_sector, num_sector);
 }
 
 static int nvme_disk_write(struct disk_info *disk,
@@ -70,55 +98,74 @@ static int nvme_disk_write(struct disk_info *disk,
 			   uint32_t start_sector,
 			   uint32_t num_sector)
 {
-	struct nvme_namespace *ns = CONTAINER_OF(disk->name,
-						 struct nvme_namespace, name[0]);
-	struct nvme_completion_poll_status status =
-		NVME_CPL_STATUS_POLL_INIT(status);
-	struct nvme_request *request;
-	uint32_t payload_size;
-	int ret = 0;
+	return nvme_disk_rw(disk, true, (uint8_t *)data_buf, start_sector,
+			    num_sector);
+}
 
-	if (!NVME_IS_BUFFER_DWORD_ALIGNED(data_buf)) {
-		LOG_WRN("Data buffer pointer needs to be 4-bytes aligned");
-		return -EINVAL;
+#ifdef CONFIG_DISK_ACCESS_RTIO
+static void nvme_disk_rtio_cb(void *arg, const struct nvme_completion *cpl)
+{
+	struct rtio_iodev_sqe *iodev_sqe = arg;
+
+	if (cpl == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ETIMEDOUT);
+	} else if (nvme_completion_is_error(cpl)) {
+		nvme_completion_print(cpl);
+		rtio_iodev_sqe_err(iodev_sqe, -EIO);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, 0);
 	}
+}
 
-	nvme_lock(disk->dev);
-
-	payload_size = num_sector * nvme_namespace_get_sector_size(ns);
-
-	request = nvme_allocate_request_vaddr((void *)data_buf, payload_size,
-					      nvme_completion_poll_cb, &status);
-	if (request == NULL) {
-		ret = -ENOMEM;
-		goto out;
+static void nvme_disk_submit(struct disk_info *disk,
+			     struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct nvme_namespace *ns = CONTAINER_OF(disk->name,
+						 struct nvme_namespace, name[0]);
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint32_t sector_size = nvme_namespace_get_sector_size(ns);
+	uint8_t *buf;
+	uint32_t len;
+	bool write;
+	int ret;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		write = false;
+		buf = sqe->rx.buf;
+		len = sqe->rx.buf_len;
+		break;
+	case RTIO_OP_TX:
+		write = true;
+		buf = (uint8_t *)sqe->tx.buf;
+		len = sqe->tx.buf_len;
+		break;
+	default:
+		disk_access_iodev_submit_fallback(disk, iodev_sqe);
+		return;
 	}
 
-	nvme_namespace_write_cmd(&request->cmd, ns->id,
-				 start_sector, num_sector);
-
-	/* We use only the first ioq atm
-	 * ToDo: use smp cpu id and use it to select ioq
-	 */
-	nvme_cmd_qpair_submit_request(ns->ctrlr->ioq, request);
+	if (len == 0 || (len % sector_size) != 0) {
+		rtio_iodev_sqe_err(iodev_sqe, -EINVAL);
+		return;
+	}
 
-	nvme_completion_poll(&status);
-	if (nvme_cpl_status_is_error(&status)) {
-		LOG_WRN("Writing at sector %u (count %d) on disk %s failed",
-			start_sector, num_sector, ns->name);
-		nvme_completion_print(&status.cpl);
-		ret = -EIO;
+	ret = nvme_namespace_rw_async(ns, write, buf,
+				      disk_access_sqe_start_sector(iodev_sqe),
+				      len / sector_size, nvme_disk_rtio_cb,
+				      iodev_sqe);
+	if (ret != 0) {
+		rtio_iodev_sqe_err(iodev_sqe, ret);
 	}
-out:
-	nvme_unlock(disk->dev);
-	return ret;
 }
+#endif /* CONFIG_DISK_ACCESS_RTIO */
 
 static int nvme_disk_flush(struct nvme_namespace *ns)
 {
 	struct nvme_completion_poll_status status =
 		NVME_CPL_STATUS_POLL_INIT(status);
 	struct nvme_request *request;
+	int ret;
 
 	request = nvme_allocate_request_null(nvme_completion_poll_cb, &status);
 	if (request == NULL) {
@@ -127,10 +174,11 @@ static int nvme_disk_flush(struct nvme_namespace *ns)
 
 	nvme_namespace_flush_cmd(&request->cmd, ns->id);
 
-	/* We use only the first ioq
-	 * ToDo: use smp cpu id and use it to select ioq
-	 */
-	nvme_cmd_qpair_submit_request(ns->ctrlr->ioq, request);
+	ret = nvme_cmd_qpair_submit_request(
+		nvme_controller_get_ioq(ns->ctrlr), request);
+	if (ret != 0) {
+		return ret;
+	}
 
 	nvme_completion_poll(&status);
 	if (nvme_cpl_status_is_error(&status)) {
@@ -204,6 +252,9 @@ static const struct disk_operations nvme_disk_ops = {
 	.read = nvme_disk_read,
 	.write = nvme_disk_write,
 	.ioctl = nvme_disk_ioctl,
+#ifdef CONFIG_DISK_ACCESS_RTIO
+	.submit = nvme_disk_submit,
+#endif
 };
 
 int nvme_namespace_disk_setup(struct nvme_namespace *ns,
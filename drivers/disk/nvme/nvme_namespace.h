@@ -196,4 +196,15 @@ int nvme_namespace_construct(struct nvme_namespace *ns,
 int nvme_namespace_disk_setup(struct nvme_namespace *ns,
 			      struct disk_info *disk);
 
+/*
+ * Submit a read or a write without waiting for it: cb_fn is called from
+ * the completion interrupt, with a NULL completion on time-out. Requests
+ * go to the I/O queue pair of the calling CPU, so several of them can be
+ * in flight at once.
+ */
+int nvme_namespace_rw_async(struct nvme_namespace *ns, bool write,
+			    uint8_t *data_buf, uint32_t start_sector,
+			    uint32_t num_sector, nvme_cb_fn_t cb_fn,
+			    void *cb_arg);
+
 #endif /* ZEPHYR_DRIVERS_DISK_NVME_NVME_NAMESPACE_H_ */
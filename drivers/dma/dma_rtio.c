@@ -0,0 +1,170 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/rtio.h>
+#include <zephyr/rtio/rtio.h>
+
+/* Memory end of a submission in one direction, buf is 0 if it moves no data that way */
+static int dma_rtio_sqe_buf(const struct rtio_sqe *sqe, enum dma_rtio_dir dir, uintptr_t *buf,
+			    uint32_t *len)
+{
+	const bool tx = dir == DMA_RTIO_TX;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		if (sqe->rx.buf == NULL) {
+			return -EINVAL;
+		}
+		*buf = tx ? 0 : (uintptr_t)sqe->rx.buf;
+		*len = sqe->rx.buf_len;
+		return 0;
+	case RTIO_OP_TX:
+		*buf = tx ? (uintptr_t)sqe->tx.buf : 0;
+		*len = sqe->tx.buf_len;
+		return 0;
+	case RTIO_OP_TINY_TX:
+		*buf = tx ? (uintptr_t)sqe->tiny_tx.buf : 0;
+		*len = sqe->tiny_tx.buf_len;
+		return 0;
+	case RTIO_OP_TXRX:
+		*buf = tx ? (uintptr_t)sqe->txrx.tx_buf : (uintptr_t)sqe->txrx.rx_buf;
+		*len = sqe->txrx.buf_len;
+		return 0;
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static uintptr_t dma_rtio_next_addr(uintptr_t addr, uint16_t adj, uint32_t len)
+{
+	return adj == DMA_ADDR_ADJ_INCREMENT ? addr + len : addr;
+}
+
+static int dma_rtio_chain_add(struct dma_rtio_chain *chain, uintptr_t src, uint16_t src_adj,
+			      uintptr_t dst, uint16_t dst_adj, uint32_t len)
+{
+	struct dma_block_config *block;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (!IS_ENABLED(CONFIG_DMA_64BIT) &&
+	    ((uint64_t)src > UINT32_MAX || (uint64_t)dst > UINT32_MAX)) {
+		return -EINVAL;
+	}
+
+	/* Extend the last block when both ends carry on where it stopped */
+	if (chain->count > 0) {
+		block = &chain->blocks[chain->count - 1];
+
+		if (block->source_addr_adj == src_adj && block->dest_addr_adj == dst_adj &&
+		    src == dma_rtio_next_addr(block->source_address, src_adj, block->block_size) &&
+		    dst == dma_rtio_next_addr(block->dest_address, dst_adj, block->block_size) &&
+		    block->block_size <= UINT32_MAX - len) {
+			block->block_size += len;
+			return 0;
+		}
+	}
+
+	if (chain->count == chain->size) {
+		return -ENOMEM;
+	}
+
+	block = &chain->blocks[chain->count++];
+	memset(block, 0, sizeof(*block));
+	block->source_address = src;
+	block->dest_address = dst;
+	block->source_addr_adj = src_adj;
+	block->dest_addr_adj = dst_adj;
+	block->block_size = len;
+
+	return 0;
+}
+
+int dma_rtio_chain_build(struct dma_rtio_chain *chain, enum dma_rtio_dir dir,
+			 const struct dma_rtio_port *port, struct rtio_iodev_sqe *first,
+			 struct rtio_iodev_sqe *end)
+{
+	uint32_t offset = 0;
+
+	chain->count = 0;
+	chain->len = 0;
+
+	for (struct rtio_iodev_sqe *curr = first; curr != end; curr = rtio_txn_next(curr)) {
+		uint16_t mem_adj = DMA_ADDR_ADJ_INCREMENT;
+		uint16_t periph_adj;
+		uintptr_t periph;
+		uintptr_t buf;
+		uint32_t len;
+		int rc;
+
+		rc = dma_rtio_sqe_buf(&curr->sqe, dir, &buf, &len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		if (port->window_size > 0) {
+			/* Each submission has its place in the window, used or not */
+			if (len > port->window_size - offset) {
+				return -ENOMEM;
+			}
+			periph = port->addr + offset;
+			periph_adj = DMA_ADDR_ADJ_INCREMENT;
+			offset += len;
+
+			if (buf == 0) {
+				continue;
+			}
+		} else {
+			periph = port->addr;
+			periph_adj = DMA_ADDR_ADJ_NO_CHANGE;
+
+			if (buf == 0) {
+				buf = port->dummy;
+				mem_adj = DMA_ADDR_ADJ_NO_CHANGE;
+			}
+		}
+
+		if (dir == DMA_RTIO_TX) {
+			rc = dma_rtio_chain_add(chain, buf, mem_adj, periph, periph_adj, len);
+		} else {
+			rc = dma_rtio_chain_add(chain, periph, periph_adj, buf, mem_adj, len);
+		}
+		if (rc != 0) {
+			return rc;
+		}
+
+		chain->len += len;
+	}
+
+	return 0;
+}
+
+int dma_rtio_chain_start(const struct device *dev, uint32_t channel, struct dma_config *cfg,
+			 struct dma_rtio_chain *chain)
+{
+	int rc;
+
+	__ASSERT_NO_MSG(chain->count > 0);
+
+	for (uint16_t i = 0; i < chain->count; i++) {
+		chain->blocks[i].next_block = i + 1 < chain->count ? &chain->blocks[i + 1] : NULL;
+	}
+
+	cfg->head_block = &chain->blocks[0];
+	cfg->block_count = chain->count;
+
+	rc = dma_config(dev, channel, cfg);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return dma_start(dev, channel);
+}
@@ -16,12 +16,38 @@
 LOG_MODULE_REGISTER(i2c_emul_ctlr);
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/rtio.h>
 #include <zephyr/drivers/emul.h>
 #include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c/rtio.h>
 #include <zephyr/drivers/i2c_emul.h>
 
 #include "i2c-priv.h"
 
+#ifdef CONFIG_I2C_EMUL_DMA
+/**
+ * Transfers of RTIO transactions through the emulated DMA controller
+ *
+ * The data written by a transaction is gathered into the TX window by the TX
+ * channel, transferred with the emulator, then the data read is scattered
+ * from the RX window by the RX channel.
+ */
+struct i2c_emul_dma {
+	const struct device *dev;
+	uint32_t tx_channel;
+	uint32_t rx_channel;
+	struct i2c_rtio *rtio_ctx;
+	struct dma_rtio_chain *tx_chain;
+	struct dma_rtio_chain *rx_chain;
+	struct i2c_msg msgs[CONFIG_I2C_RTIO_FALLBACK_MSGS];
+	uint8_t num_msgs;
+	struct rtio_iodev_sqe *txn_last;
+	uint8_t *tx_window;
+	uint8_t *rx_window;
+};
+#endif /* CONFIG_I2C_EMUL_DMA */
+
 /** Working data for the device */
 struct i2c_emul_data {
 	/* List of struct i2c_emul associated with the device */
@@ -32,6 +58,10 @@ struct i2c_emul_data {
 #ifdef CONFIG_I2C_TARGET
 	struct i2c_target_config *target_cfg;
 #endif
+#ifdef CONFIG_I2C_EMUL_DMA
+	/* DMA transfers, NULL if the bus has no DMA channels */
+	struct i2c_emul_dma *dma;
+#endif
 };
 
 struct i2c_emul_config {
@@ -236,6 +266,196 @@ static int i2c_emul_transfer(const struct device *dev, struct i2c_msg *msgs, uin
 	return api->transfer(emul->target, msgs, num_msgs, addr);
 }
 
+#ifdef CONFIG_I2C_EMUL_DMA
+static void i2c_emul_dma_start(const struct device *dev);
+static void i2c_emul_dma_callback(const struct device *dma_dev, void *user_data,
+				  uint32_t channel, int status);
+
+static void i2c_emul_dma_finish(const struct device *dev, int status)
+{
+	struct i2c_emul_data *data = dev->data;
+	struct i2c_rtio *ctx = data->dma->rtio_ctx;
+
+	/* The whole transaction is done at once */
+	if (status == 0) {
+		ctx->txn_curr = data->dma->txn_last;
+	}
+
+	if (i2c_rtio_complete(ctx, status)) {
+		i2c_emul_dma_start(dev);
+	}
+}
+
+static struct dma_config i2c_emul_dma_cfg(const struct device *dev)
+{
+	/* The emulated controller only copies memory, in bursts of equal size */
+	struct dma_config cfg = {
+		.channel_direction = MEMORY_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.dma_callback = i2c_emul_dma_callback,
+		.user_data = (void *)dev,
+	};
+
+	return cfg;
+}
+
+/* Let the emulator see the content of the TX window, then receive from the RX window */
+static void i2c_emul_dma_exchange(const struct device *dev)
+{
+	struct i2c_emul_data *data = dev->data;
+	struct i2c_emul_dma *dma = data->dma;
+	const struct i2c_dt_spec *dt_spec = dma->rtio_ctx->txn_head->sqe.iodev->data;
+	int rc;
+
+	rc = i2c_emul_transfer(dev, dma->msgs, dma->num_msgs, dt_spec->addr);
+	if (rc == 0 && dma->rx_chain->count > 0) {
+		struct dma_config cfg = i2c_emul_dma_cfg(dev);
+
+		rc = dma_rtio_chain_start(dma->dev, dma->rx_channel, &cfg, dma->rx_chain);
+		if (rc == 0) {
+			return;
+		}
+	}
+
+	i2c_emul_dma_finish(dev, rc);
+}
+
+static void i2c_emul_dma_callback(const struct device *dma_dev, void *user_data,
+				  uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct i2c_emul_data *data = dev->data;
+
+	ARG_UNUSED(dma_dev);
+
+	if (status < 0) {
+		LOG_ERR("DMA transfer failed: %d", status);
+		i2c_emul_dma_finish(dev, status);
+	} else if (channel == data->dma->tx_channel) {
+		i2c_emul_dma_exchange(dev);
+	} else {
+		i2c_emul_dma_finish(dev, 0);
+	}
+}
+
+/* Lay the messages of a transaction out in the windows, one after the other */
+static int i2c_emul_dma_prepare(struct i2c_emul_dma *dma, struct rtio_iodev_sqe *txn_head)
+{
+	const struct dma_rtio_port tx_port = {
+		.addr = (uintptr_t)dma->tx_window,
+		.window_size = CONFIG_I2C_EMUL_DMA_WINDOW_SIZE,
+	};
+	const struct dma_rtio_port rx_port = {
+		.addr = (uintptr_t)dma->rx_window,
+		.window_size = CONFIG_I2C_EMUL_DMA_WINDOW_SIZE,
+	};
+	uint32_t offset = 0;
+	int rc;
+
+	dma->num_msgs = 0;
+	for (struct rtio_iodev_sqe *curr = txn_head; curr != NULL; curr = rtio_txn_next(curr)) {
+		const struct rtio_sqe *sqe = &curr->sqe;
+		struct i2c_msg *msg = &dma->msgs[dma->num_msgs];
+		uint32_t len;
+
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			len = sqe->rx.buf_len;
+			break;
+		case RTIO_OP_TX:
+			len = sqe->tx.buf_len;
+			break;
+		default:
+			/* RTIO_OP_TINY_TX, see i2c_emul_dma_supported() */
+			len = sqe->tiny_tx.buf_len;
+			break;
+		}
+
+		if (dma->num_msgs == ARRAY_SIZE(dma->msgs) ||
+		    len > CONFIG_I2C_EMUL_DMA_WINDOW_SIZE - offset) {
+			return -ENOMEM;
+		}
+
+		msg->buf = sqe->op == RTIO_OP_RX ? &dma->rx_window[offset] : &dma->tx_window[offset];
+		msg->len = len;
+		msg->flags = ((sqe->iodev_flags & RTIO_IODEV_I2C_STOP) ? I2C_MSG_STOP : 0) |
+			     ((sqe->iodev_flags & RTIO_IODEV_I2C_RESTART) ? I2C_MSG_RESTART : 0) |
+			     ((sqe->iodev_flags & RTIO_IODEV_I2C_10_BITS) ? I2C_MSG_ADDR_10_BITS : 0) |
+			     (sqe->op == RTIO_OP_RX ? I2C_MSG_READ : I2C_MSG_WRITE);
+		dma->num_msgs++;
+		dma->txn_last = curr;
+		offset += len;
+	}
+
+	rc = dma_rtio_chain_build(dma->tx_chain, DMA_RTIO_TX, &tx_port, txn_head, NULL);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return dma_rtio_chain_build(dma->rx_chain, DMA_RTIO_RX, &rx_port, txn_head, NULL);
+}
+
+static void i2c_emul_dma_start(const struct device *dev)
+{
+	struct i2c_emul_data *data = dev->data;
+	struct i2c_emul_dma *dma = data->dma;
+	struct dma_config cfg = i2c_emul_dma_cfg(dev);
+	int rc;
+
+	rc = i2c_emul_dma_prepare(dma, dma->rtio_ctx->txn_head);
+	if (rc != 0) {
+		i2c_emul_dma_finish(dev, rc);
+		return;
+	}
+
+	if (dma->tx_chain->count == 0) {
+		/* Nothing to gather for a transaction only reading */
+		i2c_emul_dma_exchange(dev);
+		return;
+	}
+
+	rc = dma_rtio_chain_start(dma->dev, dma->tx_channel, &cfg, dma->tx_chain);
+	if (rc != 0) {
+		i2c_emul_dma_finish(dev, rc);
+	}
+}
+
+/* Only transactions made of messages go through the DMA windows */
+static bool i2c_emul_dma_supported(struct rtio_iodev_sqe *txn_head)
+{
+	for (struct rtio_iodev_sqe *curr = txn_head; curr != NULL; curr = rtio_txn_next(curr)) {
+		switch (curr->sqe.op) {
+		case RTIO_OP_RX:
+		case RTIO_OP_TX:
+		case RTIO_OP_TINY_TX:
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void i2c_emul_iodev_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct i2c_emul_data *data = dev->data;
+
+	/* Configure, recover and anything else is left to the work queue */
+	if (data->dma == NULL || !i2c_emul_dma_supported(iodev_sqe)) {
+		i2c_iodev_submit_fallback(dev, iodev_sqe);
+		return;
+	}
+
+	if (i2c_rtio_submit(data->dma->rtio_ctx, iodev_sqe)) {
+		i2c_emul_dma_start(dev);
+	}
+}
+#endif /* CONFIG_I2C_EMUL_DMA */
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -248,6 +468,16 @@ static int i2c_emul_init(const struct device *dev)
 
 	sys_slist_init(&data->emuls);
 
+#ifdef CONFIG_I2C_EMUL_DMA
+	if (data->dma != NULL) {
+		if (!device_is_ready(data->dma->dev)) {
+			LOG_ERR("DMA controller %s not ready", data->dma->dev->name);
+			return -ENODEV;
+		}
+		i2c_rtio_init(data->dma->rtio_ctx, dev);
+	}
+#endif
+
 	rc = emul_init_for_bus(dev);
 
 	/* Set config to an uninitialized state */
@@ -300,7 +530,9 @@ static DEVICE_API(i2c, i2c_emul_api) = {
 	.target_register = i2c_emul_target_register,
 	.target_unregister = i2c_emul_target_unregister,
 #endif
-#ifdef CONFIG_I2C_RTIO
+#if defined(CONFIG_I2C_EMUL_DMA)
+	.iodev_submit = i2c_emul_iodev_submit,
+#elif defined(CONFIG_I2C_RTIO)
 	.iodev_submit = i2c_iodev_submit_fallback,
 #endif
 };
@@ -316,6 +548,31 @@ static DEVICE_API(i2c, i2c_emul_api) = {
 		.addr = DT_PHA_BY_IDX(node_id, prop, idx, addr),                                   \
 	},
 
+#ifdef CONFIG_I2C_EMUL_DMA
+#define I2C_EMUL_DMA_DEFINE(n)                                                                     \
+	I2C_RTIO_DEFINE(i2c_emul_rtio_##n, 1, 1);                                                  \
+	DMA_RTIO_CHAIN_DEFINE(i2c_emul_tx_chain_##n, CONFIG_I2C_RTIO_FALLBACK_MSGS);               \
+	DMA_RTIO_CHAIN_DEFINE(i2c_emul_rx_chain_##n, CONFIG_I2C_RTIO_FALLBACK_MSGS);               \
+	static uint8_t i2c_emul_tx_window_##n[CONFIG_I2C_EMUL_DMA_WINDOW_SIZE];                    \
+	static uint8_t i2c_emul_rx_window_##n[CONFIG_I2C_EMUL_DMA_WINDOW_SIZE];                    \
+	static struct i2c_emul_dma i2c_emul_dma_##n = {                                            \
+		.dev = DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(n, tx)),                            \
+		.tx_channel = DT_INST_DMAS_CELL_BY_NAME(n, tx, channel),                           \
+		.rx_channel = DT_INST_DMAS_CELL_BY_NAME(n, rx, channel),                           \
+		.rtio_ctx = &i2c_emul_rtio_##n,                                                    \
+		.tx_chain = &i2c_emul_tx_chain_##n,                                                \
+		.rx_chain = &i2c_emul_rx_chain_##n,                                                \
+		.tx_window = i2c_emul_tx_window_##n,                                               \
+		.rx_window = i2c_emul_rx_window_##n,                                               \
+	};
+
+#define I2C_EMUL_DMA_INIT(n)                                                                       \
+	IF_ENABLED(DT_INST_DMAS_HAS_NAME(n, tx), (.dma = &i2c_emul_dma_##n,))
+#else
+#define I2C_EMUL_DMA_DEFINE(n)
+#define I2C_EMUL_DMA_INIT(n)
+#endif /* CONFIG_I2C_EMUL_DMA */
+
 #define I2C_EMUL_INIT(n)                                                                           \
 	static const struct emul_link_for_bus emuls_##n[] = {                                      \
 		DT_FOREACH_CHILD_STATUS_OKAY(DT_DRV_INST(n), EMUL_LINK_AND_COMMA)};                \
@@ -332,8 +589,10 @@ static DEVICE_API(i2c, i2c_emul_api) = {
 		.forward_list = emul_forward_list_##n,                                             \
 		.forward_list_size = ARRAY_SIZE(emul_forward_list_##n),                            \
 	};                                                                                         \
+	IF_ENABLED(DT_INST_DMAS_HAS_NAME(n, tx), (I2C_EMUL_DMA_DEFINE(n)))                         \
 	static struct i2c_emul_data i2c_emul_data_##n = {                                          \
 		.bitrate = DT_INST_PROP(n, clock_frequency),                                       \
+		I2C_EMUL_DMA_INIT(n)                                                               \
 	};                                                                                         \
 	I2C_DEVICE_DT_INST_DEFINE(n, i2c_emul_init, NULL, &i2c_emul_data_##n, &i2c_emul_cfg_##n,   \
 				  POST_KERNEL, CONFIG_I2C_INIT_PRIORITY, &i2c_emul_api);
@@ -51,6 +51,19 @@ static inline void i2c_msg_from_tiny_tx(const struct rtio_iodev_sqe *iodev_sqe,
 		I2C_MSG_WRITE;
 }
 
+/* Bus operations run in order with the messages of their transaction */
+static int i2c_iodev_bus_op(const struct device *dev, const struct rtio_sqe *sqe)
+{
+	switch (sqe->op) {
+	case RTIO_OP_I2C_CONFIGURE:
+		return i2c_configure(dev, sqe->i2c_config);
+	case RTIO_OP_I2C_RECOVER:
+		return i2c_recover_bus(dev);
+	default:
+		return -EIO;
+	}
+}
+
 void i2c_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
 {
 	const struct i2c_dt_spec *dt_spec = (const struct i2c_dt_spec *)txn_first->sqe.iodev->data;
@@ -72,6 +85,9 @@ void i2c_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
 		case RTIO_OP_TINY_TX:
 			num_msgs++;
 			break;
+		case RTIO_OP_I2C_CONFIGURE:
+		case RTIO_OP_I2C_RECOVER:
+			break;
 		default:
 			LOG_ERR("Invalid op code %d for submission %p", txn_last->sqe.op,
 				(void *)&txn_last->sqe);
@@ -100,32 +116,39 @@ void i2c_iodev_submit_work_handler(struct rtio_iodev_sqe *txn_first)
 	}
 	struct i2c_msg msgs[CONFIG_I2C_RTIO_FALLBACK_MSGS];
 
-	rc = 0;
+	num_msgs = 0;
 	txn_last = txn_first;
 
-	/* Copy the transaction into the stack allocated msgs */
-	for (int i = 0; i < num_msgs; i++) {
+	/* Copy the transaction into the stack allocated msgs, the messages
+	 * preceding a bus operation are transferred before it runs
+	 */
+	while (rc == 0 && txn_last != NULL) {
 		switch (txn_last->sqe.op) {
 		case RTIO_OP_RX:
-			i2c_msg_from_rx(txn_last, &msgs[i]);
+			i2c_msg_from_rx(txn_last, &msgs[num_msgs++]);
 			break;
 		case RTIO_OP_TX:
-			i2c_msg_from_tx(txn_last, &msgs[i]);
+			i2c_msg_from_tx(txn_last, &msgs[num_msgs++]);
 			break;
 		case RTIO_OP_TINY_TX:
-			i2c_msg_from_tiny_tx(txn_last, &msgs[i]);
+			i2c_msg_from_tiny_tx(txn_last, &msgs[num_msgs++]);
 			break;
 		default:
-			rc = -EIO;
+			if (num_msgs > 0) {
+				rc = i2c_transfer(dev, msgs, num_msgs, dt_spec->addr);
+				num_msgs = 0;
+			}
+
+			if (rc == 0) {
+				rc = i2c_iodev_bus_op(dev, &txn_last->sqe);
+			}
 			break;
 		}
 
 		txn_last = rtio_txn_next(txn_last);
 	}
 
-	if (rc == 0) {
-		__ASSERT_NO_MSG(num_msgs > 0);
-
+	if (rc == 0 && num_msgs > 0) {
 		rc = i2c_transfer(dev, msgs, num_msgs, dt_spec->addr);
 	}
 
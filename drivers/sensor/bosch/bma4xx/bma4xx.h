@@ -12,6 +12,7 @@
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor_fifo_stream.h>
 #include "bma4xx_defs.h"
 
 #if DT_ANY_INST_ON_BUS_STATUS_OKAY(spi)
@@ -85,10 +86,7 @@ struct bma4xx_data {
 	struct rtio *r;
 	struct rtio_iodev *iodev;
 #ifdef CONFIG_BMA4XX_STREAM
-	struct rtio_iodev_sqe *streaming_sqe;
-	uint8_t int_status;
-	uint16_t fifo_count;
-	uint64_t timestamp;
+	struct sensor_fifo_stream stream;
 	const struct device *dev;
 	struct gpio_callback gpio_cb;
 #endif /* CONFIG_BMA4XX_STREAM */
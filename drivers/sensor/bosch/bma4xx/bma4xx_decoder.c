@@ -392,7 +392,27 @@ static int bma4xx_decoder_decode(const uint8_t *buffer, struct sensor_chan_spec
 
 static bool bma4xx_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger)
 {
+#ifdef CONFIG_BMA4XX_STREAM
+	const struct bma4xx_fifo_data *edata = (const struct bma4xx_fifo_data *)buffer;
+
+	if (!edata->header.is_fifo) {
+		return false;
+	}
+
+	switch (trigger) {
+	case SENSOR_TRIG_FIFO_WATERMARK:
+		return FIELD_GET(BMA4XX_BIT_INT_STAT_1_FWM_INT, edata->int_status) != 0;
+	case SENSOR_TRIG_FIFO_FULL:
+		return FIELD_GET(BMA4XX_BIT_INT_STAT_1_FFULL_INT, edata->int_status) != 0;
+	default:
+		return false;
+	}
+#else
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(trigger);
+
 	return false;
+#endif /* CONFIG_BMA4XX_STREAM */
 }
 
 SENSOR_DECODER_API_DT_DEFINE() = {
@@ -24,9 +24,22 @@
 
 LOG_MODULE_DECLARE(bma4xx, CONFIG_SENSOR_LOG_LEVEL);
 
+#define BMA4XX_EMUL_FIFO_SIZE 1024
+
+/* Regular FIFO frame holding acceleration, in header mode */
+#define BMA4XX_EMUL_FIFO_HEADER_ACCEL                                                              \
+	(BMA4XX_BIT_FIFO_HEADER_REGULAR | BMA4XX_BIT_FIFO_HEADER_ACCEL)
+#define BMA4XX_EMUL_FIFO_FRAME_SIZE (BMA4XX_FIFO_HEADER_LENGTH + BMA4XX_FIFO_A_LENGTH)
+
+/* Returned when reading past the FIFO level */
+#define BMA4XX_EMUL_FIFO_OVER_READ 0x80
+
 struct bma4xx_emul_data {
 	/* Holds register data. */
 	uint8_t regs[BMA4XX_NUM_REGS];
+	/* Holds FIFO frames, oldest first */
+	uint8_t fifo[BMA4XX_EMUL_FIFO_SIZE];
+	uint16_t fifo_len;
 };
 
 struct bma4xx_emul_cfg {
@@ -60,8 +73,62 @@ uint8_t bma4xx_emul_get_interrupt_config(const struct emul *target, uint8_t *int
 	return data->regs[BMA4XX_REG_INT_MAP_DATA];
 }
 
+uint8_t bma4xx_emul_get_accel_config(const struct emul *target)
+{
+	const struct bma4xx_emul_data *data = target->data;
+
+	return data->regs[BMA4XX_REG_ACCEL_CONFIG];
+}
+
+uint16_t bma4xx_emul_get_fifo_len(const struct emul *target)
+{
+	const struct bma4xx_emul_data *data = target->data;
+
+	return data->fifo_len;
+}
+
+static uint16_t bma4xx_emul_fifo_wm(const struct bma4xx_emul_data *data)
+{
+	return ((data->regs[BMA4XX_REG_FIFO_WTM_1] & 0x1F) << 8) | data->regs[BMA4XX_REG_FIFO_WTM_0];
+}
+
+static void bma4xx_emul_fifo_read(struct bma4xx_emul_data *data, uint8_t *val, int bytes)
+{
+	int len = MIN(bytes, data->fifo_len);
+
+	memcpy(val, data->fifo, len);
+	memset(val + len, BMA4XX_EMUL_FIFO_OVER_READ, bytes - len);
+	data->fifo_len -= len;
+	memmove(data->fifo, data->fifo + len, data->fifo_len);
+}
+
 static int bma4xx_emul_read_byte(const struct emul *target, int reg, uint8_t *val, int bytes)
 {
+	struct bma4xx_emul_data *data = target->data;
+	uint16_t wm = bma4xx_emul_fifo_wm(data);
+
+	switch (reg) {
+	case BMA4XX_REG_FIFO_DATA:
+		bma4xx_emul_fifo_read(data, val, bytes);
+		return 0;
+	case BMA4XX_REG_FIFO_LENGTH_0:
+		data->regs[BMA4XX_REG_FIFO_LENGTH_0] = data->fifo_len & 0xFF;
+		data->regs[BMA4XX_REG_FIFO_LENGTH_1] = (data->fifo_len >> 8) & 0x3F;
+		break;
+	case BMA4XX_REG_INT_STAT_1:
+		/* FIFO interrupts are not latched, they follow the FIFO level */
+		data->regs[reg] &= ~(BMA4XX_BIT_INT_STAT_1_FWM_INT | BMA4XX_BIT_INT_STAT_1_FFULL_INT);
+		if (wm > 0 && data->fifo_len >= wm) {
+			data->regs[reg] |= BMA4XX_BIT_INT_STAT_1_FWM_INT;
+		}
+		if (data->fifo_len + BMA4XX_EMUL_FIFO_FRAME_SIZE > BMA4XX_EMUL_FIFO_SIZE) {
+			data->regs[reg] |= BMA4XX_BIT_INT_STAT_1_FFULL_INT;
+		}
+		break;
+	default:
+		break;
+	}
+
 	bma4xx_emul_get_reg(target, reg, val, bytes);
 
 	return 0;
@@ -78,11 +145,18 @@ static int bma4xx_emul_write_byte(const struct emul *target, int reg, uint8_t va
 
 	switch (reg) {
 	case BMA4XX_REG_ACCEL_CONFIG:
-		if ((val & 0xF0) != 0xA0) {
+		/* ODR 0 leaves the data rate unset until the accelerometer is enabled */
+		if (FIELD_GET(BMA4XX_MASK_ACC_CONF_ODR, val) > BMA4XX_ODR_1600) {
+			LOG_ERR("unsupported acc_odr: %#x", val);
+			return -EINVAL;
+		}
+		/* Only the filter settings up to CIC_AVG8 exist in performance mode */
+		if ((val & BMA4XX_BIT_ACC_PERF_MODE) != 0 &&
+		    FIELD_GET(BMA4XX_MASK_ACC_CONF_BWP, val) > BMA4XX_BWP_CIC_AVG8) {
 			LOG_ERR("unsupported acc_bwp/acc_perf_mode: %#x", val);
 			return -EINVAL;
 		}
-		data->regs[reg] = val & GENMASK(1, 0);
+		data->regs[reg] = val;
 		return 0;
 	case BMA4XX_REG_ACCEL_RANGE:
 		if ((val & GENMASK(1, 0)) != val) {
@@ -92,13 +166,17 @@ static int bma4xx_emul_write_byte(const struct emul *target, int reg, uint8_t va
 		data->regs[reg] = val;
 		return 0;
 	case BMA4XX_REG_FIFO_CONFIG_1:
-		if (val & ~BMA4XX_FIFO_ACC_EN) {
+		if (val & ~(BMA4XX_FIFO_ACC_EN | BMA4XX_FIFO_HEADER_EN)) {
 			LOG_ERR("unsupported bits set in FIFO_CONFIG_1"
 				" write: %#x",
 				val);
 			return -EINVAL;
 		}
-		data->regs[reg] = (val & BMA4XX_FIFO_ACC_EN) != 0;
+		data->regs[reg] = val;
+		return 0;
+	case BMA4XX_REG_FIFO_WTM_0:
+	case BMA4XX_REG_FIFO_WTM_1:
+		data->regs[reg] = val;
 		return 0;
 	case BMA4XX_REG_INT1_IO_CTRL:
 		data->regs[reg] = val;
@@ -130,13 +208,14 @@ static int bma4xx_emul_write_byte(const struct emul *target, int reg, uint8_t va
 			LOG_ERR("unhandled bits in POWER_CTRL write: %#x", val);
 			return -ENOTSUP;
 		}
-		data->regs[reg] = (val & BMA4XX_BIT_POWER_CTRL_ACC_EN) != 0;
+		data->regs[reg] = val;
+		return 0;
+	case BMA4XX_REG_POWER_CONF:
+		data->regs[reg] = val;
 		return 0;
 	case BMA4XX_REG_CMD:
-		if (val == BMA4XX_CMD_FIFO_FLUSH) { /* fifo_flush */
-			data->regs[BMA4XX_REG_FIFO_DATA] = 0;
-			data->regs[BMA4XX_REG_FIFO_LENGTH_0] = 0;
-			data->regs[BMA4XX_REG_FIFO_LENGTH_1] = 0;
+		if (val == BMA4XX_CMD_FIFO_FLUSH || val == BMA4XX_CMD_SOFT_RESET) {
+			data->fifo_len = 0;
 			return 0;
 		}
 		break;
@@ -161,12 +240,24 @@ static int bma4xx_emul_transfer_i2c(const struct emul *target, struct i2c_msg *m
 				    int addr)
 {
 	__ASSERT_NO_MSG(msgs && num_msgs);
+
+	i2c_dump_msgs_rw(target->dev, msgs, num_msgs, addr, false);
+
+	if (num_msgs == 1 && !(msgs->flags & I2C_MSG_READ) && msgs->len >= 2) {
+		/* Register address followed by the values, as with i2c_reg_write_byte() */
+		for (uint32_t i = 1; i < msgs->len; i++) {
+			int rc = bma4xx_emul_write_byte(target, msgs->buf[0] + i - 1, msgs->buf[i], 1);
+
+			if (rc != 0) {
+				return rc;
+			}
+		}
+		return 0;
+	}
 	if (num_msgs != 2) {
 		return 0;
 	}
 
-	i2c_dump_msgs_rw(target->dev, msgs, num_msgs, addr, false);
-
 	if (msgs->flags & I2C_MSG_READ) {
 		LOG_ERR("Unexpected read");
 		return -EIO;
@@ -190,11 +281,10 @@ static int bma4xx_emul_transfer_i2c(const struct emul *target, struct i2c_msg *m
 	return 0;
 };
 
-void bma4xx_emul_set_accel_data(const struct emul *target, q31_t value, int8_t shift, int8_t reg)
+/* Encode an acceleration in the 12 bit, left aligned, format of data registers and FIFO frames */
+static void bma4xx_emul_encode_accel(const struct bma4xx_emul_data *data, q31_t value,
+				     int8_t shift, uint8_t *out)
 {
-
-	struct bma4xx_emul_data *data = target->data;
-
 	/* floor(9.80665 * 2^(31−4)) q31_t in (-2^4, 2^4) => range_g = shift of 4 */
 	int64_t g = 1316226282;
 	int64_t range_g = 4;
@@ -216,8 +306,15 @@ void bma4xx_emul_set_accel_data(const struct emul *target, q31_t value, int8_t s
 	reg_val = CLAMP(intermediate, -2048, 2047);
 
 	/* lsb register uses top 12 of 16 bits to hold value so shift by 4 to fill it */
-	data->regs[reg] = FIELD_GET(GENMASK(3, 0), reg_val) << 4;
-	data->regs[reg + 1] = FIELD_GET(GENMASK(11, 4), reg_val);
+	out[0] = FIELD_GET(GENMASK(3, 0), reg_val) << 4;
+	out[1] = FIELD_GET(GENMASK(11, 4), reg_val);
+}
+
+void bma4xx_emul_set_accel_data(const struct emul *target, q31_t value, int8_t shift, int8_t reg)
+{
+	struct bma4xx_emul_data *data = target->data;
+
+	bma4xx_emul_encode_accel(data, value, shift, &data->regs[reg]);
 }
 
 static int bma4xx_emul_backend_set_channel(const struct emul *target, struct sensor_chan_spec ch,
@@ -313,9 +410,38 @@ static int bma4xx_emul_backend_get_sample_range(const struct emul *target,
 	return 0;
 }
 
+static int bma4xx_emul_backend_fifo_fill(const struct emul *target, struct sensor_chan_spec ch,
+					 const q31_t *values, int8_t shift, uint16_t count)
+{
+	struct bma4xx_emul_data *data = target->data;
+	uint16_t i;
+
+	if (ch.chan_type != SENSOR_CHAN_ACCEL_XYZ) {
+		return -ENOTSUP;
+	}
+
+	for (i = 0; i < count; i++) {
+		uint8_t *frame = &data->fifo[data->fifo_len];
+
+		if (data->fifo_len + BMA4XX_EMUL_FIFO_FRAME_SIZE > BMA4XX_EMUL_FIFO_SIZE) {
+			break;
+		}
+
+		frame[0] = BMA4XX_EMUL_FIFO_HEADER_ACCEL;
+		for (int axis = 0; axis < 3; axis++) {
+			bma4xx_emul_encode_accel(data, values[i * 3 + axis], shift,
+						 &frame[BMA4XX_FIFO_HEADER_LENGTH + axis * 2]);
+		}
+		data->fifo_len += BMA4XX_EMUL_FIFO_FRAME_SIZE;
+	}
+
+	return i;
+}
+
 static const struct emul_sensor_driver_api bma4xx_emul_sensor_driver_api = {
 	.set_channel = bma4xx_emul_backend_set_channel,
 	.get_sample_range = bma4xx_emul_backend_get_sample_range,
+	.fifo_fill = bma4xx_emul_backend_fifo_fill,
 };
 
 static struct i2c_emul_api bma4xx_emul_api_i2c = {
@@ -16,6 +16,12 @@ extern "C" {
 /** Set the sensor's current acceleration reading. */
 void bma4xx_emul_set_accel_data(const struct emul *target, q31_t value, int8_t shift, int8_t reg);
 
+/** Return the value of the ACC_CONF register, holding ODR and bandwidth. */
+uint8_t bma4xx_emul_get_accel_config(const struct emul *target);
+
+/** Return the number of bytes in the emulated FIFO. */
+uint16_t bma4xx_emul_get_fifo_len(const struct emul *target);
+
 /**
  * Return the current interrupt configuration.
  *
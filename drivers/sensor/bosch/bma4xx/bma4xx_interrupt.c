@@ -62,6 +62,7 @@ int bma4xx_init_interrupt(const struct device *dev)
 	}
 
 	data->dev = dev;
+	bma4xx_stream_init(dev);
 
 	return 0;
 }
@@ -0,0 +1,275 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <zephyr/drivers/sensor_convert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/clock.h>
+#include <zephyr/toolchain.h>
+
+#if defined(CONFIG_SENSOR_CONVERT_SIMD) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define SENSOR_CONVERT_HAS_MVE 1
+#endif
+#if defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#define SENSOR_CONVERT_HAS_DSP 1
+#endif
+#endif
+
+/* Keeps the products of 24 bit samples and their shift within 64 bits */
+#define SENSOR_CONVERT_MAX_RSHIFT 62
+
+int sensor_convert_scale_init(struct sensor_convert_scale *scale, int64_t nano_per_lsb,
+			      int8_t shift)
+{
+	uint64_t n = nano_per_lsb < 0 ? -(uint64_t)nano_per_lsb : (uint64_t)nano_per_lsb;
+	uint64_t q = n / NSEC_PER_SEC;
+	uint64_t r = n % NSEC_PER_SEC;
+	int exp = 31 - shift;
+	int rshift = 0;
+
+	if (exp < 0) {
+		rshift = -exp;
+		exp = 0;
+	}
+
+	/*
+	 * mult / 2^rshift = n * 2^exp / 10^9, doubled one bit at a time so that
+	 * nothing overflows, then for as long as the multiplier gains precision.
+	 */
+	while (exp > 0 || rshift < SENSOR_CONVERT_MAX_RSHIFT) {
+		uint64_t q2 = (q << 1) + (r >= NSEC_PER_SEC / 2);
+
+		if (q2 > INT32_MAX) {
+			if (exp > 0) {
+				return -ERANGE;
+			}
+			break;
+		}
+
+		q = q2;
+		r = (r << 1) % NSEC_PER_SEC;
+		if (exp > 0) {
+			exp--;
+		} else {
+			rshift++;
+		}
+	}
+
+	if (q > INT32_MAX || rshift > SENSOR_CONVERT_MAX_RSHIFT) {
+		return -ERANGE;
+	}
+
+	/* Round to nearest */
+	if (r >= NSEC_PER_SEC / 2 && q < INT32_MAX) {
+		q++;
+	}
+
+	scale->mult = nano_per_lsb < 0 ? -(int32_t)q : (int32_t)q;
+	scale->rshift = rshift;
+
+	return 0;
+}
+
+static ALWAYS_INLINE int32_t sensor_convert_read(const uint8_t *p,
+						 enum sensor_convert_format format)
+{
+	switch (format) {
+	case SENSOR_CONVERT_S16_LE:
+		return (int16_t)sys_get_le16(p);
+	case SENSOR_CONVERT_S16_BE:
+		return (int16_t)sys_get_be16(p);
+	case SENSOR_CONVERT_S24_LE:
+		return sign_extend(sys_get_le24(p), 23);
+	case SENSOR_CONVERT_S24_BE:
+		return sign_extend(sys_get_be24(p), 23);
+	default:
+		return 0;
+	}
+}
+
+/* Called with a constant format, so that each format gets its own loop */
+static ALWAYS_INLINE void sensor_convert_block(const uint8_t *raw, size_t stride, size_t count,
+					       enum sensor_convert_format format,
+					       const struct sensor_convert_scale *scale, q31_t bias,
+					       q31_t *out)
+{
+	for (size_t i = 0; i < count; i++, raw += stride) {
+		out[i] = sensor_convert_one(sensor_convert_read(raw, format), scale, bias);
+	}
+}
+
+#ifdef SENSOR_CONVERT_HAS_MVE
+/* Four samples per iteration, the tail is left to the portable loop */
+static size_t sensor_convert_s16le_mve(const uint8_t *raw, size_t count,
+				       const struct sensor_convert_scale *scale, q31_t bias,
+				       q31_t *out)
+{
+	const int32x4_t mult = vdupq_n_s32(scale->mult);
+	const int32x4_t lshift = vdupq_n_s32(16 - scale->rshift);
+	size_t i;
+
+	if (!IS_ALIGNED(raw, sizeof(int16_t))) {
+		return 0;
+	}
+
+	for (i = 0; i + 4 <= count; i += 4) {
+		int32x4_t v = vldrhq_s32((const int16_t *)&raw[i * sizeof(int16_t)]);
+
+		/* (raw << 16) * mult >> 32 is exactly raw * mult >> 16 */
+		v = vmulhq_s32(vshlq_n_s32(v, 16), mult);
+		/* Negative shifts go right, left shifts saturate */
+		v = vqshlq_s32(v, lshift);
+		vst1q_s32(&out[i], vqaddq_n_s32(v, bias));
+	}
+
+	return i;
+}
+#endif /* SENSOR_CONVERT_HAS_MVE */
+
+#ifdef SENSOR_CONVERT_HAS_DSP
+/* Two samples per 32 bit load, the tail is left to the portable loop */
+static size_t sensor_convert_s16_dsp(const uint8_t *raw, size_t count, bool big_endian,
+				     const struct sensor_convert_scale *scale, q31_t bias,
+				     q31_t *out)
+{
+	const bool doubled = scale->rshift == 15;
+	const uint8_t rshift = doubled ? 0 : scale->rshift - 16;
+	size_t i;
+
+	for (i = 0; i + 2 <= count; i += 2) {
+		uint32_t w = UNALIGNED_GET((const uint32_t *)&raw[i * sizeof(int16_t)]);
+		int32_t lo, hi;
+
+		if (big_endian) {
+			w = __rev16(w);
+		}
+
+		/* raw * mult >> 16 for the bottom and the top halfword */
+		lo = __smulwb(scale->mult, (int32_t)w);
+		hi = __smulwt(scale->mult, (int32_t)w);
+		if (doubled) {
+			lo = __qadd(lo, lo);
+			hi = __qadd(hi, hi);
+		} else {
+			lo >>= rshift;
+			hi >>= rshift;
+		}
+
+		out[i] = __qadd(lo, bias);
+		out[i + 1] = __qadd(hi, bias);
+	}
+
+	return i;
+}
+#endif /* SENSOR_CONVERT_HAS_DSP */
+
+/* Convert what the SIMD kernels can, returns the number of samples converted */
+static size_t sensor_convert_s16_simd(const uint8_t *raw, size_t count,
+				      enum sensor_convert_format format,
+				      const struct sensor_convert_scale *scale, q31_t bias,
+				      q31_t *out)
+{
+	size_t done = 0;
+
+	/*
+	 * Both kernels compute raw * mult >> 16 first, which cannot overflow.
+	 * Full scale samples mapped to the full q31 range have a right shift of
+	 * 15, the last bit is then dropped. The remaining shift of the 32 bit
+	 * result must stay below 32.
+	 */
+	if (scale->rshift < 15 || scale->rshift - 16 >= 32) {
+		return 0;
+	}
+
+#ifdef SENSOR_CONVERT_HAS_MVE
+	if (format == SENSOR_CONVERT_S16_LE) {
+		done = sensor_convert_s16le_mve(raw, count, scale, bias, out);
+	}
+#endif
+#ifdef SENSOR_CONVERT_HAS_DSP
+	if (done == 0) {
+		done = sensor_convert_s16_dsp(raw, count, format == SENSOR_CONVERT_S16_BE, scale,
+					      bias, out);
+	}
+#endif
+
+	ARG_UNUSED(raw);
+	ARG_UNUSED(count);
+	ARG_UNUSED(format);
+	ARG_UNUSED(bias);
+	ARG_UNUSED(out);
+
+	return done;
+}
+
+void sensor_convert_q31(const uint8_t *raw, size_t stride, size_t count,
+			enum sensor_convert_format format, const struct sensor_convert_scale *scale,
+			q31_t bias, q31_t *out)
+{
+	if (stride == sizeof(int16_t) &&
+	    (format == SENSOR_CONVERT_S16_LE || format == SENSOR_CONVERT_S16_BE)) {
+		size_t done = sensor_convert_s16_simd(raw, count, format, scale, bias, out);
+
+		raw += done * stride;
+		out += done;
+		count -= done;
+	}
+
+	switch (format) {
+	case SENSOR_CONVERT_S16_LE:
+		sensor_convert_block(raw, stride, count, SENSOR_CONVERT_S16_LE, scale, bias, out);
+		break;
+	case SENSOR_CONVERT_S16_BE:
+		sensor_convert_block(raw, stride, count, SENSOR_CONVERT_S16_BE, scale, bias, out);
+		break;
+	case SENSOR_CONVERT_S24_LE:
+		sensor_convert_block(raw, stride, count, SENSOR_CONVERT_S24_LE, scale, bias, out);
+		break;
+	case SENSOR_CONVERT_S24_BE:
+		sensor_convert_block(raw, stride, count, SENSOR_CONVERT_S24_BE, scale, bias, out);
+		break;
+	}
+}
+
+static ALWAYS_INLINE void sensor_convert_frames(const uint8_t *frames, size_t frame_size,
+						size_t count, enum sensor_convert_format format,
+						const struct sensor_convert_axes *axes,
+						struct sensor_three_axis_sample_data *out)
+{
+	for (size_t i = 0; i < count; i++, frames += frame_size) {
+		for (int axis = 0; axis < 3; axis++) {
+			int32_t raw = sensor_convert_read(&frames[axes->offset[axis]], format);
+
+			out[i].values[axis] =
+				sensor_convert_one(raw, &axes->scale[axis], axes->bias[axis]);
+		}
+	}
+}
+
+void sensor_convert_three_axis(const uint8_t *frames, size_t frame_size, size_t count,
+			       enum sensor_convert_format format,
+			       const struct sensor_convert_axes *axes,
+			       struct sensor_three_axis_sample_data *out)
+{
+	switch (format) {
+	case SENSOR_CONVERT_S16_LE:
+		sensor_convert_frames(frames, frame_size, count, SENSOR_CONVERT_S16_LE, axes, out);
+		break;
+	case SENSOR_CONVERT_S16_BE:
+		sensor_convert_frames(frames, frame_size, count, SENSOR_CONVERT_S16_BE, axes, out);
+		break;
+	case SENSOR_CONVERT_S24_LE:
+		sensor_convert_frames(frames, frame_size, count, SENSOR_CONVERT_S24_LE, axes, out);
+		break;
+	case SENSOR_CONVERT_S24_BE:
+		sensor_convert_frames(frames, frame_size, count, SENSOR_CONVERT_S24_BE, axes, out);
+		break;
+	}
+}
@@ -0,0 +1,253 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/drivers/sensor_clock.h>
+#include <zephyr/drivers/sensor_fifo_stream.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/__assert.h>
+
+LOG_MODULE_REGISTER(sensor_fifo_stream, CONFIG_SENSOR_LOG_LEVEL);
+
+enum {
+	/* No streaming submission */
+	SENSOR_FIFO_STREAM_OFF,
+	/* Waiting for an interrupt */
+	SENSOR_FIFO_STREAM_ARMED,
+	/* Handling an interrupt */
+	SENSOR_FIFO_STREAM_BUSY,
+};
+
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r,
+			     struct rtio_iodev *iodev, uint32_t flags)
+{
+	__ASSERT_NO_MSG(cfg->status_len > 0 && cfg->status_len <= SENSOR_FIFO_STREAM_REG_MAX_LEN);
+	__ASSERT_NO_MSG(cfg->level_len > 0 && cfg->level_len <= SENSOR_FIFO_STREAM_REG_MAX_LEN);
+	__ASSERT_NO_MSG(cfg->frame_size > 0);
+	__ASSERT_NO_MSG(cfg->has_trigger != NULL && cfg->get_level != NULL &&
+			cfg->encode_header != NULL);
+
+	stream->dev = dev;
+	stream->cfg = cfg;
+	stream->r = r;
+	stream->iodev = iodev;
+	stream->flags = flags;
+	stream->iodev_sqe = NULL;
+	atomic_set(&stream->state, SENSOR_FIFO_STREAM_OFF);
+}
+
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe)
+{
+	stream->iodev_sqe = iodev_sqe;
+	atomic_set(&stream->state, SENSOR_FIFO_STREAM_ARMED);
+}
+
+static void sensor_fifo_stream_complete(struct sensor_fifo_stream *stream, int result)
+{
+	struct rtio_iodev_sqe *iodev_sqe = stream->iodev_sqe;
+
+	/* Multishot submissions come back through sensor_fifo_stream_submit()
+	 * before rtio_iodev_sqe_ok() returns, so let go of this one first.
+	 */
+	stream->iodev_sqe = NULL;
+	atomic_set(&stream->state, SENSOR_FIFO_STREAM_OFF);
+
+	if (result < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, result);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, result);
+	}
+}
+
+static void sensor_fifo_stream_skip(struct sensor_fifo_stream *stream)
+{
+	atomic_set(&stream->state, SENSOR_FIFO_STREAM_ARMED);
+
+	if (stream->cfg->rearm != NULL) {
+		stream->cfg->rearm(stream->dev);
+	}
+}
+
+/* Find what to do with the FIFO data, from the triggers reported by the sensor */
+static bool sensor_fifo_stream_get_opt(const struct sensor_fifo_stream *stream,
+				       const struct sensor_read_config *read_cfg,
+				       enum sensor_stream_data_opt *opt)
+{
+	bool triggered = false;
+
+	for (size_t i = 0; i < read_cfg->count; i++) {
+		const struct sensor_stream_trigger *trigger = &read_cfg->triggers[i];
+
+		if (!stream->cfg->has_trigger(stream->dev, stream->status, trigger->trigger)) {
+			continue;
+		}
+
+		/* Including the data wins over leaving it, which wins over dropping it */
+		*opt = triggered ? MIN(*opt, trigger->opt) : trigger->opt;
+		triggered = true;
+	}
+
+	return triggered;
+}
+
+static void sensor_fifo_stream_data_cb(struct rtio *r, const struct rtio_sqe *sqe, int result,
+				       void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+
+	if (result < 0) {
+		LOG_ERR("%s: FIFO data read failed: %d", stream->dev->name, result);
+	}
+
+	sensor_fifo_stream_complete(stream, MIN(result, 0));
+}
+
+static void sensor_fifo_stream_flush(struct sensor_fifo_stream *stream)
+{
+	struct rtio_sqe *sqe;
+
+	if (stream->cfg->prep_flush == NULL) {
+		return;
+	}
+
+	sqe = rtio_sqe_acquire(stream->r);
+	if (sqe == NULL) {
+		LOG_WRN("%s: no submission left to flush the FIFO", stream->dev->name);
+		return;
+	}
+
+	stream->cfg->prep_flush(stream->dev, sqe, stream->iodev);
+	sqe->flags |= RTIO_SQE_NO_RESPONSE;
+	rtio_submit(stream->r, 0);
+}
+
+static void sensor_fifo_stream_status_cb(struct rtio *r, const struct rtio_sqe *sqe, int result,
+					 void *arg)
+{
+	struct sensor_fifo_stream *stream = arg;
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	const struct sensor_read_config *read_cfg = stream->iodev_sqe->sqe.iodev->data;
+	enum sensor_stream_data_opt opt;
+	struct rtio_sqe *sqes[3];
+	uint32_t data_len = 0;
+	uint32_t buf_len;
+	uint8_t *buf;
+
+	ARG_UNUSED(sqe);
+
+	if (result < 0) {
+		LOG_ERR("%s: FIFO status read failed: %d", stream->dev->name, result);
+		sensor_fifo_stream_complete(stream, result);
+		return;
+	}
+
+	if (!sensor_fifo_stream_get_opt(stream, read_cfg, &opt)) {
+		sensor_fifo_stream_skip(stream);
+		return;
+	}
+
+	if (opt == SENSOR_STREAM_DATA_INCLUDE) {
+		data_len = cfg->get_level(stream->dev, stream->level);
+		data_len -= data_len % cfg->frame_size;
+	}
+
+	if (rtio_sqe_rx_buf(stream->iodev_sqe, cfg->header_size + MIN(data_len, cfg->frame_size),
+			    cfg->header_size + data_len, &buf, &buf_len) != 0) {
+		LOG_ERR("%s: no buffer for the FIFO data", stream->dev->name);
+		sensor_fifo_stream_complete(stream, -ENOMEM);
+		return;
+	}
+
+	/* Frames that do not fit are left in the FIFO for the next interrupt */
+	data_len = MIN(data_len, buf_len - cfg->header_size);
+	data_len -= data_len % cfg->frame_size;
+	cfg->encode_header(stream->dev, buf, stream->status, stream->timestamp, data_len);
+
+	if (data_len == 0) {
+		if (opt == SENSOR_STREAM_DATA_DROP) {
+			sensor_fifo_stream_flush(stream);
+		}
+		sensor_fifo_stream_complete(stream, 0);
+		return;
+	}
+
+	if (rtio_sqe_acquire_array(r, ARRAY_SIZE(sqes), sqes) != 0) {
+		LOG_ERR("%s: no submission left to read the FIFO", stream->dev->name);
+		sensor_fifo_stream_complete(stream, -ENOMEM);
+		return;
+	}
+
+	/* The frames go straight into the buffer of the streaming submission */
+	rtio_sqe_prep_tiny_write(sqes[0], stream->iodev, RTIO_PRIO_NORM, &cfg->data_reg, 1, NULL);
+	sqes[0]->flags = RTIO_SQE_TRANSACTION | RTIO_SQE_NO_RESPONSE;
+	rtio_sqe_prep_read(sqes[1], stream->iodev, RTIO_PRIO_NORM, buf + cfg->header_size,
+			   data_len, NULL);
+	sqes[1]->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+	if (stream->flags & SENSOR_FIFO_STREAM_BUS_I2C) {
+		sqes[1]->iodev_flags |= RTIO_IODEV_I2C_STOP | RTIO_IODEV_I2C_RESTART;
+	}
+	rtio_sqe_prep_callback_no_cqe(sqes[2], sensor_fifo_stream_data_cb, stream, NULL);
+
+	rtio_submit(r, 0);
+}
+
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream)
+{
+	const struct sensor_fifo_stream_config *cfg = stream->cfg;
+	struct rtio_sqe *sqes[5];
+	uint64_t cycles;
+	int rc;
+
+	if (!atomic_cas(&stream->state, SENSOR_FIFO_STREAM_ARMED, SENSOR_FIFO_STREAM_BUSY)) {
+		LOG_DBG("%s: ignoring FIFO event", stream->dev->name);
+		return;
+	}
+
+	if (FIELD_GET(RTIO_SQE_CANCELED, stream->iodev_sqe->sqe.flags)) {
+		sensor_fifo_stream_complete(stream, -ECANCELED);
+		return;
+	}
+
+	rc = sensor_clock_get_cycles(&cycles);
+	if (rc != 0) {
+		LOG_ERR("%s: failed to get sensor clock cycles", stream->dev->name);
+		sensor_fifo_stream_complete(stream, rc);
+		return;
+	}
+	stream->timestamp = sensor_clock_cycles_to_ns(cycles);
+
+	if (rtio_sqe_acquire_array(stream->r, ARRAY_SIZE(sqes), sqes) != 0) {
+		LOG_ERR("%s: no submission left to read the FIFO status", stream->dev->name);
+		sensor_fifo_stream_complete(stream, -ENOMEM);
+		return;
+	}
+
+	/* Interrupt status and FIFO level are read with one submission */
+	rtio_sqe_prep_tiny_write(sqes[0], stream->iodev, RTIO_PRIO_NORM, &cfg->status_reg, 1,
+				 NULL);
+	sqes[0]->flags = RTIO_SQE_TRANSACTION | RTIO_SQE_NO_RESPONSE;
+	rtio_sqe_prep_read(sqes[1], stream->iodev, RTIO_PRIO_NORM, stream->status,
+			   cfg->status_len, NULL);
+	sqes[1]->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+	rtio_sqe_prep_tiny_write(sqes[2], stream->iodev, RTIO_PRIO_NORM, &cfg->level_reg, 1,
+				 NULL);
+	sqes[2]->flags = RTIO_SQE_TRANSACTION | RTIO_SQE_NO_RESPONSE;
+	rtio_sqe_prep_read(sqes[3], stream->iodev, RTIO_PRIO_NORM, stream->level, cfg->level_len,
+			   NULL);
+	sqes[3]->flags = RTIO_SQE_CHAINED | RTIO_SQE_NO_RESPONSE;
+	if (stream->flags & SENSOR_FIFO_STREAM_BUS_I2C) {
+		sqes[1]->iodev_flags |= RTIO_IODEV_I2C_STOP | RTIO_IODEV_I2C_RESTART;
+		sqes[3]->iodev_flags |= RTIO_IODEV_I2C_STOP | RTIO_IODEV_I2C_RESTART;
+	}
+	rtio_sqe_prep_callback_no_cqe(sqes[4], sensor_fifo_stream_status_cb, stream, NULL);
+
+	rtio_submit(stream->r, 0);
+}
@@ -15,17 +15,46 @@
 LOG_MODULE_REGISTER(spi_emul_ctlr);
 
 #include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/rtio.h>
 #include <zephyr/drivers/emul.h>
 #include <zephyr/drivers/spi.h>
 #include <zephyr/drivers/spi/rtio.h>
 #include <zephyr/drivers/spi_emul.h>
 
+#ifdef CONFIG_SPI_EMUL_DMA
+/**
+ * Transfers of RTIO transactions through the emulated DMA controller
+ *
+ * The data sent by a transaction is gathered into the TX window by the TX
+ * channel, exchanged with the emulator, then scattered from the RX window by
+ * the RX channel, the windows playing the part of the FIFOs of a controller.
+ */
+struct spi_emul_dma {
+	const struct device *dev;
+	uint32_t tx_channel;
+	uint32_t rx_channel;
+	struct spi_rtio *rtio_ctx;
+	struct dma_rtio_chain *tx_chain;
+	struct dma_rtio_chain *rx_chain;
+	struct spi_buf tx_bufs[CONFIG_SPI_RTIO_FALLBACK_MSGS];
+	struct spi_buf rx_bufs[CONFIG_SPI_RTIO_FALLBACK_MSGS];
+	size_t num_bufs;
+	uint8_t *tx_window;
+	uint8_t *rx_window;
+};
+#endif /* CONFIG_SPI_EMUL_DMA */
+
 /** Working data for the device */
 struct spi_emul_data {
 	/* List of struct spi_emul associated with the device */
 	sys_slist_t emuls;
 	/* SPI host configuration */
 	uint32_t config;
+#ifdef CONFIG_SPI_EMUL_DMA
+	/* DMA transfers, NULL if the bus has no DMA channels */
+	struct spi_emul_dma *dma;
+#endif
 };
 
 uint32_t spi_emul_get_config(const struct device *dev)
@@ -90,6 +119,184 @@ static int spi_emul_io(const struct device *dev, const struct spi_config *config
 	return api->io(emul->target, config, tx_bufs, rx_bufs);
 }
 
+#ifdef CONFIG_SPI_EMUL_DMA
+static void spi_emul_dma_start(const struct device *dev);
+static void spi_emul_dma_callback(const struct device *dma_dev, void *user_data,
+				  uint32_t channel, int status);
+
+static void spi_emul_dma_finish(const struct device *dev, int status)
+{
+	struct spi_emul_data *data = dev->data;
+
+	if (spi_rtio_complete(data->dma->rtio_ctx, status)) {
+		spi_emul_dma_start(dev);
+	}
+}
+
+static struct dma_config spi_emul_dma_cfg(const struct device *dev)
+{
+	/* The emulated controller only copies memory, in bursts of equal size */
+	struct dma_config cfg = {
+		.channel_direction = MEMORY_TO_MEMORY,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.dma_callback = spi_emul_dma_callback,
+		.user_data = (void *)dev,
+	};
+
+	return cfg;
+}
+
+/* Let the emulator see the content of the TX window, then receive from the RX window */
+static void spi_emul_dma_exchange(const struct device *dev)
+{
+	struct spi_emul_data *data = dev->data;
+	struct spi_emul_dma *dma = data->dma;
+	const struct spi_dt_spec *dt_spec = dma->rtio_ctx->txn_head->sqe.iodev->data;
+	const struct spi_buf_set tx_set = {.buffers = dma->tx_bufs, .count = dma->num_bufs};
+	const struct spi_buf_set rx_set = {.buffers = dma->rx_bufs, .count = dma->num_bufs};
+	int rc;
+
+	rc = spi_emul_io(dev, &dt_spec->config, &tx_set, &rx_set);
+	if (rc == 0 && dma->rx_chain->count > 0) {
+		struct dma_config cfg = spi_emul_dma_cfg(dev);
+
+		rc = dma_rtio_chain_start(dma->dev, dma->rx_channel, &cfg, dma->rx_chain);
+		if (rc == 0) {
+			return;
+		}
+	}
+
+	spi_emul_dma_finish(dev, rc);
+}
+
+static void spi_emul_dma_callback(const struct device *dma_dev, void *user_data,
+				  uint32_t channel, int status)
+{
+	const struct device *dev = user_data;
+	struct spi_emul_data *data = dev->data;
+
+	ARG_UNUSED(dma_dev);
+
+	if (status < 0) {
+		LOG_ERR("DMA transfer failed: %d", status);
+		spi_emul_dma_finish(dev, status);
+	} else if (channel == data->dma->tx_channel) {
+		spi_emul_dma_exchange(dev);
+	} else {
+		spi_emul_dma_finish(dev, 0);
+	}
+}
+
+/* Lay the submissions of a transaction out in the windows, one after the other */
+static int spi_emul_dma_prepare(struct spi_emul_dma *dma, struct rtio_iodev_sqe *txn_head)
+{
+	const struct dma_rtio_port tx_port = {
+		.addr = (uintptr_t)dma->tx_window,
+		.window_size = CONFIG_SPI_EMUL_DMA_WINDOW_SIZE,
+	};
+	const struct dma_rtio_port rx_port = {
+		.addr = (uintptr_t)dma->rx_window,
+		.window_size = CONFIG_SPI_EMUL_DMA_WINDOW_SIZE,
+	};
+	uint32_t offset = 0;
+	int rc;
+
+	dma->num_bufs = 0;
+	for (struct rtio_iodev_sqe *curr = txn_head; curr != NULL; curr = rtio_txn_next(curr)) {
+		const struct rtio_sqe *sqe = &curr->sqe;
+		uint32_t len;
+		bool tx, rx;
+
+		switch (sqe->op) {
+		case RTIO_OP_RX:
+			len = sqe->rx.buf_len;
+			tx = false;
+			rx = true;
+			break;
+		case RTIO_OP_TX:
+			len = sqe->tx.buf_len;
+			tx = true;
+			rx = false;
+			break;
+		case RTIO_OP_TINY_TX:
+			len = sqe->tiny_tx.buf_len;
+			tx = true;
+			rx = false;
+			break;
+		case RTIO_OP_TXRX:
+			len = sqe->txrx.buf_len;
+			tx = true;
+			rx = true;
+			break;
+		default:
+			LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+			return -EIO;
+		}
+
+		if (dma->num_bufs == ARRAY_SIZE(dma->tx_bufs) ||
+		    len > CONFIG_SPI_EMUL_DMA_WINDOW_SIZE - offset) {
+			return -ENOMEM;
+		}
+
+		dma->tx_bufs[dma->num_bufs].buf = tx ? &dma->tx_window[offset] : NULL;
+		dma->tx_bufs[dma->num_bufs].len = len;
+		dma->rx_bufs[dma->num_bufs].buf = rx ? &dma->rx_window[offset] : NULL;
+		dma->rx_bufs[dma->num_bufs].len = len;
+		dma->num_bufs++;
+		offset += len;
+	}
+
+	rc = dma_rtio_chain_build(dma->tx_chain, DMA_RTIO_TX, &tx_port, txn_head, NULL);
+	if (rc != 0) {
+		return rc;
+	}
+
+	return dma_rtio_chain_build(dma->rx_chain, DMA_RTIO_RX, &rx_port, txn_head, NULL);
+}
+
+static void spi_emul_dma_start(const struct device *dev)
+{
+	struct spi_emul_data *data = dev->data;
+	struct spi_emul_dma *dma = data->dma;
+	struct dma_config cfg = spi_emul_dma_cfg(dev);
+	int rc;
+
+	rc = spi_emul_dma_prepare(dma, dma->rtio_ctx->txn_head);
+	if (rc != 0) {
+		spi_emul_dma_finish(dev, rc);
+		return;
+	}
+
+	if (dma->tx_chain->count == 0) {
+		/* Nothing to gather, the emulator gets no TX buffers */
+		spi_emul_dma_exchange(dev);
+		return;
+	}
+
+	rc = dma_rtio_chain_start(dma->dev, dma->tx_channel, &cfg, dma->tx_chain);
+	if (rc != 0) {
+		spi_emul_dma_finish(dev, rc);
+	}
+}
+
+static void spi_emul_iodev_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct spi_emul_data *data = dev->data;
+
+	if (data->dma == NULL) {
+		spi_rtio_iodev_default_submit(dev, iodev_sqe);
+		return;
+	}
+
+	if (spi_rtio_submit(data->dma->rtio_ctx, iodev_sqe)) {
+		spi_emul_dma_start(dev);
+	}
+}
+#endif /* CONFIG_SPI_EMUL_DMA */
+
 /**
  * @brief This is a no-op stub of the SPI API's `release` method to protect drivers under test
  *        from hitting a segmentation fault when using SPI_LOCK_ON plus spi_release()
@@ -113,6 +320,16 @@ static int spi_emul_init(const struct device *dev)
 
 	sys_slist_init(&data->emuls);
 
+#ifdef CONFIG_SPI_EMUL_DMA
+	if (data->dma != NULL) {
+		if (!device_is_ready(data->dma->dev)) {
+			LOG_ERR("DMA controller %s not ready", data->dma->dev->name);
+			return -ENODEV;
+		}
+		spi_rtio_init(data->dma->rtio_ctx, dev);
+	}
+#endif
+
 	return emul_init_for_bus(dev);
 }
 
@@ -132,7 +349,9 @@ int spi_emul_register(const struct device *dev, struct spi_emul *emul)
 
 static DEVICE_API(spi, spi_emul_api) = {
 	.transceive = spi_emul_io,
-#ifdef CONFIG_SPI_RTIO
+#if defined(CONFIG_SPI_EMUL_DMA)
+	.iodev_submit = spi_emul_iodev_submit,
+#elif defined(CONFIG_SPI_RTIO)
 	.iodev_submit = spi_rtio_iodev_default_submit,
 #endif
 	.release = spi_emul_release,
@@ -143,6 +362,31 @@ static DEVICE_API(spi, spi_emul_api) = {
 		.dev = DEVICE_DT_GET(node_id),                                                     \
 	},
 
+#ifdef CONFIG_SPI_EMUL_DMA
+#define SPI_EMUL_DMA_DEFINE(n)                                                                     \
+	SPI_RTIO_DEFINE(spi_emul_rtio_##n, 1, 1);                                                  \
+	DMA_RTIO_CHAIN_DEFINE(spi_emul_tx_chain_##n, CONFIG_SPI_RTIO_FALLBACK_MSGS);               \
+	DMA_RTIO_CHAIN_DEFINE(spi_emul_rx_chain_##n, CONFIG_SPI_RTIO_FALLBACK_MSGS);               \
+	static uint8_t spi_emul_tx_window_##n[CONFIG_SPI_EMUL_DMA_WINDOW_SIZE];                    \
+	static uint8_t spi_emul_rx_window_##n[CONFIG_SPI_EMUL_DMA_WINDOW_SIZE];                    \
+	static struct spi_emul_dma spi_emul_dma_##n = {                                            \
+		.dev = DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(n, tx)),                            \
+		.tx_channel = DT_INST_DMAS_CELL_BY_NAME(n, tx, channel),                           \
+		.rx_channel = DT_INST_DMAS_CELL_BY_NAME(n, rx, channel),                           \
+		.rtio_ctx = &spi_emul_rtio_##n,                                                    \
+		.tx_chain = &spi_emul_tx_chain_##n,                                                \
+		.rx_chain = &spi_emul_rx_chain_##n,                                                \
+		.tx_window = spi_emul_tx_window_##n,                                               \
+		.rx_window = spi_emul_rx_window_##n,                                               \
+	};
+
+#define SPI_EMUL_DMA_INIT(n)                                                                       \
+	IF_ENABLED(DT_INST_DMAS_HAS_NAME(n, tx), (.dma = &spi_emul_dma_##n,))
+#else
+#define SPI_EMUL_DMA_DEFINE(n)
+#define SPI_EMUL_DMA_INIT(n)
+#endif /* CONFIG_SPI_EMUL_DMA */
+
 #define SPI_EMUL_INIT(n)                                                                           \
 	static const struct emul_link_for_bus emuls_##n[] = {                                      \
 		DT_FOREACH_CHILD_STATUS_OKAY(DT_DRV_INST(n), EMUL_LINK_AND_COMMA)};                \
@@ -150,7 +394,10 @@ static DEVICE_API(spi, spi_emul_api) = {
 		.children = emuls_##n,                                                             \
 		.num_children = ARRAY_SIZE(emuls_##n),                                             \
 	};                                                                                         \
-	static struct spi_emul_data spi_emul_data_##n;                                             \
+	IF_ENABLED(DT_INST_DMAS_HAS_NAME(n, tx), (SPI_EMUL_DMA_DEFINE(n)))                         \
+	static struct spi_emul_data spi_emul_data_##n = {                                          \
+		SPI_EMUL_DMA_INIT(n)                                                               \
+	};                                                                                         \
 	SPI_DEVICE_DT_INST_DEFINE(n, spi_emul_init, NULL, &spi_emul_data_##n, &spi_emul_cfg_##n,   \
 				  POST_KERNEL, CONFIG_SPI_INIT_PRIORITY, &spi_emul_api);
 
@@ -700,6 +700,131 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+#if defined(CONFIG_JSON_LIBRARY_STREAM) || defined(__DOXYGEN__)
+
+/** Maximum length of a number decoded by the streaming parser */
+#define JSON_STREAM_NUMBER_MAX_LEN 32
+
+/** @cond INTERNAL_HIDDEN */
+struct json_stream_frame {
+	/* Object: descriptors of its fields. Array: descriptor of its elements */
+	const struct json_obj_descr *descr;
+	/* Object: struct holding its fields. Array: next element */
+	void *val;
+	union {
+		struct {
+			int64_t decoded;
+			size_t descr_len;
+			int current;
+		} obj;
+		struct {
+			size_t *elements;
+			size_t remaining;
+			ptrdiff_t elem_size;
+		} arr;
+	};
+	bool is_array;
+};
+/** @endcond */
+
+/**
+ * @brief Streaming JSON parser state
+ *
+ * Holds everything the parser needs between two chunks of input, so that no
+ * other memory is allocated and the input is not kept. Initialize it with
+ * json_stream_obj_parse_init() or json_stream_arr_parse_init().
+ */
+struct json_stream_parser {
+	/** @cond INTERNAL_HIDDEN */
+	struct json_stream_frame stack[CONFIG_JSON_LIBRARY_STREAM_MAX_DEPTH];
+	/* Descriptor and field of the scalar being decoded, NULL if skipped */
+	const struct json_obj_descr *descr;
+	void *field;
+	void *val;
+	/* Descriptors still matching the key being read */
+	uint64_t candidates;
+	/* Kind of each container nested in a skipped value, set for arrays */
+	uint32_t skip_arrays;
+	size_t len;
+	/* Length of the string being decoded as received, escapes included */
+	size_t escaped_len;
+	const char *literal;
+	int64_t result;
+	int error;
+	enum json_tokens root;
+	uint8_t depth;
+	uint8_t skip_depth;
+	uint8_t state;
+	uint8_t escape;
+	char number[JSON_STREAM_NUMBER_MAX_LEN + 1];
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize the streaming parsing of a JSON-encoded object
+ *
+ * The object is then fed to json_stream_parse() in chunks of any size, as
+ * they are received, and decoded according to @a descr into @a val as it
+ * goes, without ever holding the whole object in memory.
+ *
+ * As the chunks are not kept, the fields of the struct must hold their own
+ * values: JSON_TOK_STRING, JSON_TOK_OPAQUE, JSON_TOK_FLOAT, JSON_TOK_OBJ_ARRAY,
+ * JSON_TOK_ENCODED_OBJ and mixed array descriptors, which point into the input,
+ * are not supported. Use JSON_TOK_STRING_BUF for strings. Objects and arrays can
+ * be nested up to @kconfig{CONFIG_JSON_LIBRARY_STREAM_MAX_DEPTH} levels. Unknown
+ * fields are skipped whatever their depth.
+ *
+ * @param parser Parser state
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be less
+ * than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ */
+void json_stream_obj_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, size_t descr_len, void *val);
+
+/**
+ * @brief Initialize the streaming parsing of a JSON-encoded array
+ *
+ * Streaming counterpart of json_arr_parse(), see json_stream_obj_parse_init().
+ *
+ * @param parser Parser state
+ * @param descr Pointer to the array descriptor
+ * @param val Pointer to the struct to hold the decoded values
+ */
+void json_stream_arr_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, void *val);
+
+/**
+ * @brief Feed a chunk of a JSON-encoded value to a streaming parser
+ *
+ * The chunk is fully processed and can be reused as soon as this function
+ * returns. Tokens may be split across chunks anywhere.
+ *
+ * @param parser Parser state
+ * @param chunk Next bytes of the JSON-encoded value
+ * @param len Number of bytes in @a chunk
+ *
+ * @return 0 if the chunk was valid so far, or a negative error code, which is
+ * also returned for all the following chunks. -ENOTSUP is returned for
+ * descriptors that cannot be decoded by the streaming parser, -ENOSPC for
+ * arrays with too many elements and -ENOMEM for values nested too deep.
+ */
+int json_stream_parse(struct json_stream_parser *parser, const char *chunk, size_t len);
+
+/**
+ * @brief Finish the streaming parsing of a JSON-encoded value
+ *
+ * @param parser Parser state
+ *
+ * @return < 0 if error, including when the value is incomplete. For an object,
+ * bitmap of decoded fields on success like json_obj_parse(). For an array, 0 on
+ * success.
+ */
+int64_t json_stream_parse_finish(struct json_stream_parser *parser);
+
+#endif /* CONFIG_JSON_LIBRARY_STREAM */
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -812,6 +937,51 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+struct net_buf;
+struct net_buf_pool;
+
+/**
+ * @brief Encodes an object into a network buffer chain
+ *
+ * The JSON data is appended to the last fragment of @a buf. When it is full,
+ * new fragments are allocated from @a pool, without waiting, and added to the
+ * chain. The encoder copies the data straight into the fragments, without any
+ * intermediate buffer.
+ *
+ * @note Requires @kconfig{CONFIG_NET_BUF}.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ * @param buf Network buffer chain to append the JSON data to
+ * @param pool Pool to allocate more fragments from, or NULL to only use the
+ * room left in @a buf
+ *
+ * @return 0 if object has been successfully encoded. -ENOMEM if the chain is
+ * full, or another negative value as defined on errno.h.
+ */
+int json_obj_encode_net_buf(const struct json_obj_descr *descr, size_t descr_len,
+			    const void *val, struct net_buf *buf, struct net_buf_pool *pool);
+
+/**
+ * @brief Encodes an array into a network buffer chain
+ *
+ * See json_obj_encode_net_buf().
+ *
+ * @note Requires @kconfig{CONFIG_NET_BUF}.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param val Struct holding the values
+ * @param buf Network buffer chain to append the JSON data to
+ * @param pool Pool to allocate more fragments from, or NULL to only use the
+ * room left in @a buf
+ *
+ * @return 0 if array has been successfully encoded. -ENOMEM if the chain is
+ * full, or another negative value as defined on errno.h.
+ */
+int json_arr_encode_net_buf(const struct json_obj_descr *descr, const void *val,
+			    struct net_buf *buf, struct net_buf_pool *pool);
+
 /**
  * @brief Descriptor for a mixed-type JSON array.
  *
@@ -63,6 +63,12 @@ enum {
 	 * >   practical opportunity.
 	 */
 	BT_HCI_QUIRK_NO_AUTO_DLE = BIT(1),
+	/* The driver accepts ACL packets split over a fragment chain, the
+	 * first buffer holding the H:4 type and the ACL header and the
+	 * following ones the payload. The host then sends the fragments of a
+	 * PDU without waiting for the driver to release the previous one.
+	 */
+	BT_HCI_QUIRK_TX_FRAGS = BIT(2),
 };
 
 /** Possible values for the 'bus' member of the bt_hci_driver struct */
@@ -162,6 +168,9 @@ static inline int bt_hci_close(const struct device *dev)
  * that HCI drivers that use H:4 as their native encoding don't need to do any
  * special handling of the packet type.
  *
+ * Drivers with the tx-frags quirk may be given ACL packets whose payload is in
+ * the fragments chained to @c buf, see @ref net_buf_frag_add.
+ *
  * If the function returns 0 (success) the reference to @c buf was moved to the
  * HCI driver. On error, the caller still owns the reference and is responsible
  * for eventually calling @ref net_buf_unref on it.
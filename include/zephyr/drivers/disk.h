@@ -83,6 +83,7 @@ extern "C" {
 #define DISK_STATUS_WR_PROTECT		0x04
 
 struct disk_operations;
+struct rtio_iodev_sqe;
 
 /**
  * @brief Disk info
@@ -111,6 +112,14 @@ struct disk_operations {
 	int (*write)(struct disk_info *disk, const uint8_t *data_buf,
 		     uint32_t start_sector, uint32_t num_sector);
 	int (*ioctl)(struct disk_info *disk, uint8_t cmd, void *buff);
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+	/**
+	 * Optional, start a read or write without waiting for it, and
+	 * complete @p iodev_sqe from the completion interrupt. See
+	 * disk_access_rtio.h.
+	 */
+	void (*submit)(struct disk_info *disk, struct rtio_iodev_sqe *iodev_sqe);
+#endif
 };
 
 /**
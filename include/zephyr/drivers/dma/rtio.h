@@ -0,0 +1,140 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief DMA descriptor chains for RTIO transactions
+ *
+ * Bus controllers with scatter-gather DMA can run a whole RTIO transaction,
+ * or a segment of it, from one chain of DMA blocks per direction, without the
+ * CPU copying data or stepping from one submission to the next.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_
+#define ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA descriptor chains for RTIO transactions
+ * @defgroup dma_rtio DMA RTIO
+ * @ingroup dma_interface
+ * @{
+ */
+
+/** Direction of the data moved by a chain */
+enum dma_rtio_dir {
+	/** From the buffers of the submissions to the peripheral */
+	DMA_RTIO_TX,
+	/** From the peripheral to the buffers of the submissions */
+	DMA_RTIO_RX,
+};
+
+/**
+ * @brief Peripheral end of a chain
+ *
+ * Either the data register of the peripheral, always accessed at the same
+ * address, or a window of memory the peripheral works from, where the data of
+ * each submission of the transaction has its own place.
+ */
+struct dma_rtio_port {
+	/** Address of the data register, or of the start of the memory window */
+	uintptr_t addr;
+	/** Size of the memory window in bytes, 0 for a data register */
+	uint32_t window_size;
+	/**
+	 * Address of a byte in memory, sent when a submission has no data to
+	 * send and overwritten with the data received when a submission has no
+	 * buffer to receive to. Only used with data registers.
+	 */
+	uintptr_t dummy;
+};
+
+/**
+ * @brief Chain of DMA blocks
+ *
+ * Define with DMA_RTIO_CHAIN_DEFINE().
+ */
+struct dma_rtio_chain {
+	/** Blocks of the chain */
+	struct dma_block_config *blocks;
+	/** Number of blocks available */
+	uint16_t size;
+	/** Number of blocks in use */
+	uint16_t count;
+	/** Number of bytes moved by the chain */
+	uint32_t len;
+};
+
+/**
+ * @brief Statically define a chain of DMA blocks
+ *
+ * @param _name Name of the chain
+ * @param _size Maximum number of blocks in the chain
+ */
+#define DMA_RTIO_CHAIN_DEFINE(_name, _size)                                                        \
+	static struct dma_block_config CONCAT(_name, _blocks)[_size];                              \
+	static struct dma_rtio_chain _name = {                                                     \
+		.blocks = CONCAT(_name, _blocks),                                                  \
+		.size = (_size),                                                                   \
+	}
+
+/**
+ * @brief Build the chain of DMA blocks of a part of a transaction
+ *
+ * Adds a block per submission moving data in the direction of the chain,
+ * blocks contiguous on both ends being merged. Submissions which do not move
+ * data in that direction use the dummy byte of a data register port, or skip
+ * their place in a memory window.
+ *
+ * @param chain Chain to fill, emptied first
+ * @param dir Direction of the data
+ * @param port Peripheral end of the chain
+ * @param first First submission, usually the head of a transaction
+ * @param end Submission following the last one, NULL for the end of the transaction
+ *
+ * @retval 0 on success
+ * @retval -ENOTSUP if a submission is not a read, write or transceive
+ * @retval -EINVAL if a read has no buffer, or an address does not fit
+ *         the DMA addresses
+ * @retval -ENOMEM if the chain or the memory window is too small
+ */
+int dma_rtio_chain_build(struct dma_rtio_chain *chain, enum dma_rtio_dir dir,
+			 const struct dma_rtio_port *port, struct rtio_iodev_sqe *first,
+			 struct rtio_iodev_sqe *end);
+
+/**
+ * @brief Configure a DMA channel with a chain and start it
+ *
+ * The blocks of the chain are linked and given to the channel with the
+ * configuration of the caller, whose callback is called when the whole chain
+ * is done. The chain may be reused once the DMA controller completes it.
+ *
+ * @param dev DMA controller
+ * @param channel DMA channel
+ * @param cfg Configuration of the channel, except for its blocks
+ * @param chain Non empty chain of blocks
+ *
+ * @return 0 on success, or an error from dma_config() or dma_start()
+ */
+int dma_rtio_chain_start(const struct device *dev, uint32_t channel, struct dma_config *cfg,
+			 struct dma_rtio_chain *chain);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_DMA_RTIO_H_ */
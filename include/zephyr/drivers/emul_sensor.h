@@ -40,6 +40,9 @@ __subsystem struct emul_sensor_driver_api {
 	int (*get_attribute_metadata)(const struct emul *target, struct sensor_chan_spec ch,
 				      enum sensor_attribute attribute, q31_t *min, q31_t *max,
 				      q31_t *increment, int8_t *shift);
+	/** Queue samples in the emulated FIFO. */
+	int (*fifo_fill)(const struct emul *target, struct sensor_chan_spec ch,
+			 const q31_t *values, int8_t shift, uint16_t count);
 };
 /**
  * @endcond
@@ -180,6 +183,38 @@ static inline int emul_sensor_backend_get_attribute_metadata(const struct emul *
 	return api->get_attribute_metadata(target, ch, attribute, min, max, increment, shift);
 }
 
+/**
+ * @brief Queue samples in the FIFO of a sensor emulator
+ *
+ * Samples are queued as if the sensor had just measured them, updating the FIFO level and the
+ * FIFO interrupt status. Raising the interrupt line is left to the caller.
+ *
+ * @param[in] target Pointer to emulator instance to operate on
+ * @param[in] ch The channel of the samples. If \p ch is unsupported, return '-ENOTSUP'
+ * @param[in] values Samples, each made of as many values as emul_sensor_backend_set_channel()
+ *   takes for \p ch
+ * @param[in] shift Shift value (scaling factor) applied to \p values
+ * @param[in] count Number of samples
+ *
+ * @return Number of samples queued, less than \p count if the FIFO is full
+ * @return -ENOTSUP if no backend API, no emulated FIFO or if channel not supported by emul
+ */
+static inline int emul_sensor_backend_fifo_fill(const struct emul *target,
+						struct sensor_chan_spec ch, const q31_t *values,
+						int8_t shift, uint16_t count)
+{
+	if (!target || !target->backend_api) {
+		return -ENOTSUP;
+	}
+
+	struct emul_sensor_driver_api *api = (struct emul_sensor_driver_api *)target->backend_api;
+
+	if (api->fifo_fill == NULL) {
+		return -ENOTSUP;
+	}
+	return api->fifo_fill(target, ch, values, shift, count);
+}
+
 /**
  * @}
  */
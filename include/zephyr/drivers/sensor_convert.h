@@ -0,0 +1,153 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Conversion of raw sensor samples to q31 values, for decoders
+ *
+ * Decoders usually turn each raw sample into a q31 value with a multiplication
+ * and a shift, which only depend on the configuration of the sensor. These
+ * helpers compute that scale once, then convert whole blocks of samples,
+ * using the SIMD instructions of the CPU when there are some.
+ */
+
+#ifndef ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_
+#define ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/drivers/sensor_data_types.h>
+#include <zephyr/dsp/types.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sensor sample conversion
+ * @defgroup sensor_convert Sensor sample conversion
+ * @ingroup sensor_interface
+ * @{
+ */
+
+/** Formats of raw samples */
+enum sensor_convert_format {
+	/** Signed 16 bit, little endian */
+	SENSOR_CONVERT_S16_LE,
+	/** Signed 16 bit, big endian */
+	SENSOR_CONVERT_S16_BE,
+	/** Signed 24 bit, little endian */
+	SENSOR_CONVERT_S24_LE,
+	/** Signed 24 bit, big endian */
+	SENSOR_CONVERT_S24_BE,
+};
+
+/**
+ * @brief Scale from raw samples to q31 values
+ *
+ * A raw sample @c raw is converted to @c (raw * mult) >> rshift. Initialize
+ * with sensor_convert_scale_init().
+ */
+struct sensor_convert_scale {
+	/** Multiplier */
+	int32_t mult;
+	/** Right shift applied to the product */
+	uint8_t rshift;
+};
+
+/**
+ * @brief Scale and bias of the three axes of a frame
+ *
+ * Each output axis is read from any raw sample of the frame, so that the
+ * frame axes can be remapped to the board axes. Axes are flipped with a
+ * negative scale.
+ */
+struct sensor_convert_axes {
+	/** Offset of the raw sample of each output axis, in bytes from the frame start */
+	uint8_t offset[3];
+	/** Scale of each output axis */
+	struct sensor_convert_scale scale[3];
+	/** Bias added to each output axis, in the output unit */
+	q31_t bias[3];
+};
+
+/**
+ * @brief Compute the scale of raw samples
+ *
+ * @param scale Scale to initialize
+ * @param nano_per_lsb Value of one LSB of the raw samples, in billionths of
+ *        the unit of the channel. Negative to flip the sign of the samples.
+ * @param shift Shift of the q31 output values, as in the decoded data
+ *
+ * @retval 0 on success
+ * @retval -ERANGE if the scale does not fit 32 bits
+ */
+int sensor_convert_scale_init(struct sensor_convert_scale *scale, int64_t nano_per_lsb,
+			      int8_t shift);
+
+/**
+ * @brief Convert a single raw sample
+ *
+ * @param raw Raw sample, sign extended
+ * @param scale Scale of the raw sample
+ * @param bias Bias added to the result, in the output unit
+ *
+ * @return The q31 value, saturated
+ */
+static inline q31_t sensor_convert_one(int32_t raw, const struct sensor_convert_scale *scale,
+				       q31_t bias)
+{
+	int64_t value = (((int64_t)raw * scale->mult) >> scale->rshift) + bias;
+
+	return (q31_t)CLAMP(value, INT32_MIN, INT32_MAX);
+}
+
+/**
+ * @brief Convert a block of raw samples of a channel
+ *
+ * Blocks of contiguous 16 bit samples are converted with SIMD instructions
+ * when @kconfig{CONFIG_SENSOR_CONVERT_SIMD} is enabled and the CPU has some.
+ * Their results may be one LSB below the ones of sensor_convert_one().
+ *
+ * @param raw First raw sample
+ * @param stride Distance between two raw samples, in bytes
+ * @param count Number of samples
+ * @param format Format of the raw samples
+ * @param scale Scale of the raw samples
+ * @param bias Bias added to each value, in the output unit
+ * @param out Output values
+ */
+void sensor_convert_q31(const uint8_t *raw, size_t stride, size_t count,
+			enum sensor_convert_format format, const struct sensor_convert_scale *scale,
+			q31_t bias, q31_t *out);
+
+/**
+ * @brief Convert a block of three axis frames
+ *
+ * Timestamps of the readings are left untouched.
+ *
+ * @param frames First frame
+ * @param frame_size Distance between two frames, in bytes
+ * @param count Number of frames
+ * @param format Format of the raw samples
+ * @param axes Location, scale and bias of each axis
+ * @param out Output readings
+ */
+void sensor_convert_three_axis(const uint8_t *frames, size_t frame_size, size_t count,
+			       enum sensor_convert_format format,
+			       const struct sensor_convert_axes *axes,
+			       struct sensor_three_axis_sample_data *out);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DRIVERS_SENSOR_CONVERT_H_ */
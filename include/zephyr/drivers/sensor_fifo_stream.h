@@ -0,0 +1,170 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Helpers for sensor drivers streaming a hardware FIFO over RTIO
+ *
+ * Sensors with a FIFO raise an interrupt once a watermark is reached or the
+ * FIFO is full. On every interrupt the helpers read the interrupt status and
+ * the FIFO level with a single chained RTIO submission, then burst read all
+ * the complete frames straight into the buffer of the streaming submission,
+ * behind a header encoded by the driver. The decoder of the driver then
+ * decodes the frames in place.
+ *
+ * Drivers describe their registers and provide a few callbacks with
+ * @ref sensor_fifo_stream_config, embed a @ref sensor_fifo_stream in their
+ * data, hand streaming submissions to sensor_fifo_stream_submit() and call
+ * sensor_fifo_stream_event() from their interrupt handler.
+ */
+
+#ifndef ZEPHYR_DRIVERS_SENSOR_FIFO_STREAM_H_
+#define ZEPHYR_DRIVERS_SENSOR_FIFO_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/atomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Bus of the sensor is I2C, register reads need a repeated start */
+#define SENSOR_FIFO_STREAM_BUS_I2C BIT(0)
+
+/** Maximum length of the interrupt status and FIFO level registers */
+#define SENSOR_FIFO_STREAM_REG_MAX_LEN 4
+
+/**
+ * @brief Description of the FIFO of a sensor
+ *
+ * Register addresses are given as sent on the bus, including any read flag.
+ */
+struct sensor_fifo_stream_config {
+	/** Interrupt status register */
+	uint8_t status_reg;
+	/** Length of the interrupt status, in bytes */
+	uint8_t status_len;
+	/** FIFO level register */
+	uint8_t level_reg;
+	/** Length of the FIFO level, in bytes */
+	uint8_t level_len;
+	/** FIFO data register, read in bursts */
+	uint8_t data_reg;
+	/** Size of a FIFO frame, only whole frames are read */
+	uint16_t frame_size;
+	/** Size of the driver header placed before the FIFO data */
+	uint16_t header_size;
+
+	/**
+	 * @brief Check whether the interrupt status reports a trigger
+	 *
+	 * Called for each trigger of the stream, with the interrupt status.
+	 */
+	bool (*has_trigger)(const struct device *dev, const uint8_t *status,
+			    enum sensor_trigger_type trigger);
+
+	/**
+	 * @brief Get the number of bytes in the FIFO from its level register
+	 */
+	uint32_t (*get_level)(const struct device *dev, const uint8_t *level);
+
+	/**
+	 * @brief Encode the driver header
+	 *
+	 * @param dev Sensor device
+	 * @param buf Buffer of @ref sensor_fifo_stream_config.header_size bytes
+	 * @param status Interrupt status
+	 * @param timestamp Time of the interrupt, in nanoseconds
+	 * @param data_len Number of FIFO bytes following the header
+	 */
+	void (*encode_header)(const struct device *dev, uint8_t *buf, const uint8_t *status,
+			      uint64_t timestamp, uint32_t data_len);
+
+	/**
+	 * @brief Prepare a write that flushes the FIFO
+	 *
+	 * Optional, used for triggers requesting @ref SENSOR_STREAM_DATA_DROP.
+	 */
+	void (*prep_flush)(const struct device *dev, struct rtio_sqe *sqe,
+			   const struct rtio_iodev *iodev);
+
+	/**
+	 * @brief Enable the interrupt again
+	 *
+	 * Called when an interrupt is handled without completing the streaming
+	 * submission. Drivers enable the interrupt in their streaming submit
+	 * handler otherwise.
+	 */
+	void (*rearm)(const struct device *dev);
+};
+
+/**
+ * @brief State of a FIFO stream
+ *
+ * @warning Not to be manipulated without the helpers!
+ */
+struct sensor_fifo_stream {
+	/** @cond INTERNAL_HIDDEN */
+	const struct device *dev;
+	const struct sensor_fifo_stream_config *cfg;
+	struct rtio *r;
+	struct rtio_iodev *iodev;
+	uint32_t flags;
+	atomic_t state;
+	struct rtio_iodev_sqe *iodev_sqe;
+	uint64_t timestamp;
+	uint8_t status[SENSOR_FIFO_STREAM_REG_MAX_LEN];
+	uint8_t level[SENSOR_FIFO_STREAM_REG_MAX_LEN];
+	/** @endcond */
+};
+
+/**
+ * @brief Initialize a FIFO stream
+ *
+ * @param stream FIFO stream
+ * @param dev Sensor device
+ * @param cfg FIFO description
+ * @param r RTIO context of the driver, with room for 5 submissions
+ * @param iodev Bus I/O device of the sensor
+ * @param flags SENSOR_FIFO_STREAM_BUS_* flags
+ */
+void sensor_fifo_stream_init(struct sensor_fifo_stream *stream, const struct device *dev,
+			     const struct sensor_fifo_stream_config *cfg, struct rtio *r,
+			     struct rtio_iodev *iodev, uint32_t flags);
+
+/**
+ * @brief Queue a streaming submission
+ *
+ * To be called from the submit handler of the driver once the sensor is
+ * configured for the triggers of the stream, before the interrupt is
+ * enabled.
+ *
+ * @param stream FIFO stream
+ * @param iodev_sqe Streaming submission
+ */
+void sensor_fifo_stream_submit(struct sensor_fifo_stream *stream,
+			       struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @brief Handle a FIFO interrupt
+ *
+ * To be called from the interrupt handler of the driver, with the interrupt
+ * disabled. Interrupts while a previous one is being handled are ignored,
+ * the FIFO is read to its level anyway.
+ *
+ * @param stream FIFO stream
+ */
+void sensor_fifo_stream_event(struct sensor_fifo_stream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_DRIVERS_SENSOR_FIFO_STREAM_H_ */
@@ -409,6 +409,88 @@ ssize_t fs_read(struct fs_file_t *zfp, void *ptr, size_t size);
  */
 ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size);
 
+#if defined(CONFIG_FILE_SYSTEM_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief Read file without waiting
+ *
+ * Submits a read of @p size bytes from the file to the RTIO context @p r,
+ * which is run with fs_read() from the RTIO work queue. Its completion
+ * carries @p userdata, and the fs_read() result as its result.
+ *
+ * Reads and writes to a file happen at its current position, so several of
+ * them in flight on the same file should be chained to keep their order.
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer, must stay valid until completion
+ * @param size Number of bytes to be read
+ * @param r RTIO context to submit to
+ * @param userdata Value returned in the completion
+ *
+ * @retval 0 on successful submission;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when @p size is too large;
+ * @retval -ENOMEM when no submission queue entry is available in @p r.
+ */
+int fs_read_async(struct fs_file_t *zfp, void *ptr, size_t size, struct rtio *r,
+		  void *userdata);
+
+/**
+ * @brief Write file without waiting
+ *
+ * Asynchronous counterpart of fs_write(), see fs_read_async().
+ *
+ * @param zfp Pointer to the file object
+ * @param ptr Pointer to the data buffer, must stay valid until completion
+ * @param size Number of bytes to be written
+ * @param r RTIO context to submit to
+ * @param userdata Value returned in the completion
+ *
+ * @retval 0 on successful submission;
+ * @retval -EBADF when invoked on zfp that represents unopened/closed file;
+ * @retval -EINVAL when @p size is too large;
+ * @retval -ENOMEM when no submission queue entry is available in @p r.
+ */
+int fs_write_async(struct fs_file_t *zfp, const void *ptr, size_t size, struct rtio *r,
+		   void *userdata);
+
+/**
+ * @brief Prepare a file read submission
+ *
+ * Same as fs_read_async(), except that the caller acquires and submits the
+ * entry, so that it can be chained with other ones.
+ *
+ * @param sqe Submission queue entry to prepare
+ * @param zfp Pointer to an open file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be read
+ * @param userdata Value returned in the completion
+ */
+static inline void fs_sqe_prep_read(struct rtio_sqe *sqe, struct fs_file_t *zfp, void *ptr,
+				    uint32_t size, void *userdata)
+{
+	rtio_sqe_prep_read(sqe, &zfp->iodev, RTIO_PRIO_NORM, (uint8_t *)ptr, size, userdata);
+}
+
+/**
+ * @brief Prepare a file write submission
+ *
+ * Same as fs_write_async(), except that the caller acquires and submits the
+ * entry, so that it can be chained with other ones.
+ *
+ * @param sqe Submission queue entry to prepare
+ * @param zfp Pointer to an open file object
+ * @param ptr Pointer to the data buffer
+ * @param size Number of bytes to be written
+ * @param userdata Value returned in the completion
+ */
+static inline void fs_sqe_prep_write(struct rtio_sqe *sqe, struct fs_file_t *zfp, const void *ptr,
+				     uint32_t size, void *userdata)
+{
+	rtio_sqe_prep_write(sqe, &zfp->iodev, RTIO_PRIO_NORM, (const uint8_t *)ptr, size,
+			    userdata);
+}
+#endif /* CONFIG_FILE_SYSTEM_RTIO */
+
 /**
  * @brief Seek file
  *
@@ -9,6 +9,10 @@
 
 #include <stdint.h>
 
+#if defined(CONFIG_FILE_SYSTEM_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -84,6 +88,10 @@ struct fs_file_t {
 	const struct fs_mount_t *mp;
 	/** Open/create flags */
 	fs_mode_t flags;
+#if defined(CONFIG_FILE_SYSTEM_RTIO) || defined(__DOXYGEN__)
+	/** RTIO I/O device used by fs_read_async() and fs_write_async() */
+	struct rtio_iodev iodev;
+#endif
 };
 
 /**
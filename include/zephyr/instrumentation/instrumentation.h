@@ -75,6 +75,30 @@ struct instr_record {
 	};
 } __packed;
 
+/**
+ * @brief Profile of a function, in statistical mode.
+ */
+struct instr_func_profile {
+	/** Function address */
+	void *addr;
+	/** Number of calls */
+	uint32_t calls;
+	/** Cycles spent in the function and its callees, recursion counted once */
+	uint64_t inclusive_cycles;
+	/** Cycles spent in the function itself */
+	uint64_t exclusive_cycles;
+};
+
+/**
+ * @brief Callback of instr_profile_foreach().
+ *
+ * @param profile Profile of a function.
+ * @param user_data User data passed to instr_profile_foreach().
+ *
+ * @return true to continue with the next function, false to stop.
+ */
+typedef bool (*instr_profile_cb_t)(const struct instr_func_profile *profile, void *user_data);
+
 /**
  * @brief Checks if tracing feature is available.
  *
@@ -177,6 +201,16 @@ void instr_dump_buffer_uart(void);
  */
 void instr_dump_deltas_uart(void);
 
+/**
+ * @brief Walks the profiles of the functions called so far (profiling).
+ *
+ * Instrumentation is disabled during the walk, so that it is not profiled.
+ *
+ * @param cb Callback called for each function, in discovery order.
+ * @param user_data User data passed to the callback.
+ */
+void instr_profile_foreach(instr_profile_cb_t cb, void *user_data);
+
 /**
  * @brief Shared callback handler to process entry/exit events.
  *
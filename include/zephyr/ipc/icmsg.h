@@ -101,6 +101,10 @@ struct icmsg_data_t {
 	uint16_t remote_sid;
 	uint16_t local_sid;
 	atomic_t state;
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE
+	/* Messages sent since the last notification of the remote. */
+	uint16_t unnotified;
+#endif
 };
 
 /** @brief Open an icmsg instance
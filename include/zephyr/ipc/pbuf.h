@@ -35,6 +35,9 @@ extern "C" {
  */
 #define _PBUF_MIN_DATA_LEN ROUND_UP(PBUF_PACKET_LEN_SZ + 1 + _PBUF_IDX_SIZE, _PBUF_IDX_SIZE)
 
+/** @brief Space taken in the buffer by a packet of @p len bytes, length field included. */
+#define PBUF_PACKET_SIZE(len) (PBUF_PACKET_LEN_SZ + ROUND_UP(len, _PBUF_IDX_SIZE))
+
 #if defined(CONFIG_ARCH_POSIX)
 /* For the native simulated boards we need to modify some pointers at init */
 #define PBUF_MAYBE_CONST
@@ -217,6 +220,22 @@ int pbuf_rx_init(struct pbuf *pb);
 
 int pbuf_write(struct pbuf *pb, const char *buf, uint16_t len);
 
+/**
+ * @brief Get the amount of data written to the packet buffer but not read yet.
+ *
+ * This function is meant for the writer. It reads the index shared by the
+ * reader after a full memory barrier, so that when called after
+ * @ref pbuf_write, either the reader sees the written packet when checking
+ * for more data, or this function sees that the reader consumed everything
+ * written before it.
+ *
+ * @param pb	A buffer to which data is written.
+ * @retval int	Number of bytes not read yet, including the packet length fields
+ *		and padding, see @ref PBUF_PACKET_SIZE.
+ *		-EINVAL, if the read index is incorrect.
+ */
+int pbuf_unread(struct pbuf *pb);
+
 /**
  * @brief Read specified amount of data from the packet buffer.
  *
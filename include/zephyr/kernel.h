@@ -4956,6 +4956,7 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
 
 /**
  * @brief Message Queue Attributes
@@ -5065,6 +5066,7 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message slot is reserved with k_msgq_reserve().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -5091,9 +5093,89 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  *
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EBUSY A message slot is reserved with k_msgq_reserve().
  */
 __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
 
+/**
+ * @brief Send several messages to the end of a message queue.
+ *
+ * This routine sends up to @a num_msgs messages, stored back to back at
+ * @a data, to message queue @a msgq under a single lock acquisition. Threads
+ * waiting to receive a message are given one each first, then as many of the
+ * remaining messages as fit are copied into the queue's ring buffer.
+ *
+ * The routine only waits if none of the messages could be sent, in which
+ * case it behaves like k_msgq_put() for the first message.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Waiting period to send the first message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, which may be less than @a num_msgs.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message slot is reserved with k_msgq_reserve().
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
+/**
+ * @brief Reserve space for a message at the end of a message queue.
+ *
+ * This routine hands out the ring buffer slot where the next message of
+ * @a msgq is to be stored, so the caller can build the message in place
+ * instead of copying it in with k_msgq_put(). The message is only made
+ * available to receivers by k_msgq_commit().
+ *
+ * Only one slot may be reserved at a time, and other threads can't send
+ * messages to the end of the queue until the reservation is committed or
+ * cancelled. This is meant for queues with a single producer.
+ *
+ * @note This routine does not block, and is not available to user mode
+ * threads as the slot lives in the queue's ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Set to the address of the reserved message slot.
+ *
+ * @retval 0 Message slot reserved.
+ * @retval -ENOMSG The queue is full.
+ * @retval -EBUSY A message slot is already reserved.
+ */
+int k_msgq_reserve(struct k_msgq *msgq, void **msg);
+
+/**
+ * @brief Send a message previously reserved with k_msgq_reserve().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No message slot is reserved, or the queue was purged since
+ *                 the slot was reserved.
+ */
+int k_msgq_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Release a message slot reserved with k_msgq_reserve().
+ *
+ * The reserved slot is discarded without sending anything.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ */
+void k_msgq_cancel(struct k_msgq *msgq);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -5116,6 +5198,34 @@ __syscall int k_msgq_put_front(struct k_msgq *msgq, const void *data);
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a max_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner, under a single lock acquisition.
+ * The messages are stored back to back at @a data.
+ *
+ * The routine only waits if the queue is empty, in which case it behaves
+ * like k_msgq_get() and receives a single message.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param max_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t max_msgs,
+			      k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -5155,7 +5265,8 @@ __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
  *
  * This routine discards all unreceived messages in a message queue's ring
  * buffer. Any threads that are blocked waiting to send a message to the
- * message queue are unblocked and see an -ENOMSG error code.
+ * message queue are unblocked and see an -ENOMSG error code. A message slot
+ * reserved with k_msgq_reserve() is released, and committing it fails.
  *
  * @param msgq Address of the message queue.
  */
@@ -5384,6 +5495,19 @@ __syscall void k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_s
 enum pipe_flags {
 	PIPE_FLAG_OPEN = BIT(0),
 	PIPE_FLAG_RESET = BIT(1),
+	PIPE_FLAG_CLAIMED = BIT(2),
+};
+
+/**
+ * @brief Pipe I/O vector
+ *
+ * Describes one contiguous piece of a scatter-gather pipe transfer.
+ */
+struct k_pipe_iovec {
+	/** Address of the piece */
+	void *iov_base;
+	/** Size of the piece (in bytes) */
+	size_t iov_len;
 };
 
 struct k_pipe {
@@ -5470,10 +5594,98 @@ __syscall int k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len,
  * @retval -EAGAIN if no data could be read before the timeout expired
  * @retval -ECANCELED if the read was interrupted by k_pipe_reset(..)
  * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if data is claimed with k_pipe_peek()
  */
 __syscall int k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len,
 			  k_timeout_t timeout);
 
+/**
+ * @brief Write data from multiple buffers to a pipe
+ *
+ * This routine behaves like k_pipe_write(), gathering the data from
+ * @a iovcnt buffers which are written to @a pipe in order. Buffers are
+ * copied directly to waiting readers or the pipe's ring buffer, without
+ * first being assembled into a contiguous buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of buffers to write.
+ * @param iovcnt Number of elements in @a iov.
+ * @param timeout Waiting period to wait for the data to be written.
+ *
+ * @retval number of bytes written on success
+ * @retval -EAGAIN if no data could be written before the timeout expired
+ * @retval -ECANCELED if the write was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ * @retval -EINVAL if the total size of the buffers is too large
+ */
+__syscall int k_pipe_writev(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			    size_t iovcnt, k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into multiple buffers
+ *
+ * This routine behaves like k_pipe_read(), scattering the data read from
+ * @a pipe into @a iovcnt buffers, filling each one before moving on to
+ * the next.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of buffers to fill.
+ * @param iovcnt Number of elements in @a iov.
+ * @param timeout Waiting period to wait for the data to be read.
+ *
+ * @retval number of bytes read on success
+ * @retval -EAGAIN if no data could be read before the timeout expired
+ * @retval -ECANCELED if the read was interrupted by k_pipe_reset(..)
+ * @retval -EPIPE if the pipe was closed
+ * @retval -EBUSY if data is claimed with k_pipe_peek()
+ * @retval -EINVAL if the total size of the buffers is too large
+ */
+__syscall int k_pipe_readv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			   size_t iovcnt, k_timeout_t timeout);
+
+/**
+ * @brief Claim data in place in a pipe
+ *
+ * This routine provides direct access to the next unclaimed data held in
+ * the pipe's ring buffer, without copying it out. The data remains in the
+ * pipe until released with k_pipe_consume(), while other readers get
+ * -EBUSY. As data may wrap around the end of the ring buffer, this routine
+ * can be called again to claim the next contiguous piece.
+ *
+ * Only one thread may have data claimed at a time. This routine doesn't
+ * wait for data to become available: use k_poll() with
+ * K_POLL_TYPE_PIPE_DATA_AVAILABLE for that.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param len Maximum number of bytes to claim.
+ *
+ * @retval number of bytes claimed
+ * @retval -EAGAIN if there is no unclaimed data in the pipe
+ * @retval -ECANCELED if the pipe is being reset
+ * @retval -EPIPE if the pipe was closed and has no data left
+ */
+int k_pipe_peek(struct k_pipe *pipe, uint8_t **data, size_t len);
+
+/**
+ * @brief Release data claimed in place in a pipe
+ *
+ * This routine removes the first @a len bytes of the data claimed with
+ * k_pipe_peek() from the pipe, making room for writers. Any remaining
+ * claimed data is put back and gets returned by subsequent reads.
+ *
+ * @note Not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes to remove, possibly zero.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if no data is claimed or @a len exceeds the claimed data
+ */
+int k_pipe_consume(struct k_pipe *pipe, size_t len);
+
 /**
  * @brief Reset a pipe
  * This routine resets the pipe, discarding any unread data and unblocking any threads waiting to
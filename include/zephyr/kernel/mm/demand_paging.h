@@ -50,6 +50,9 @@ struct k_mem_paging_stats_t {
 		/** Number of page faults while in ISR */
 		unsigned long			in_isr;
 #endif /* !CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		/** Number of data pages prefetched while servicing page faults */
+		unsigned long			prefetched;
 	} pagefaults;
 
 	struct {
@@ -124,6 +124,11 @@ struct modem_cmux_dlci {
 	bool flow_control : 1;
 	bool rx_full : 1;
 	bool msc_sent : 1;
+
+	/* Transmit buffer position following the last frame queued by the DLCI */
+	uint32_t transmit_end;
+	bool transmit_pending;
+	bool transmit_done;
 };
 
 struct modem_cmux_frame {
@@ -168,11 +173,17 @@ struct modem_cmux {
 	uint16_t receive_buf_size;
 	uint16_t receive_buf_len;
 
+	/* DLCI receive buffer the data of the received frame is written to */
+	struct modem_cmux_dlci *receive_dlci;
+	uint16_t receive_claimed;
+
 	uint8_t work_buf[MODEM_CMUX_WORK_BUFFER_SIZE];
 
 	/* Transmit buffer */
 	struct ring_buf transmit_rb;
 	struct k_mutex transmit_rb_lock;
+	uint32_t transmit_put;
+	uint32_t transmit_sent;
 
 	/* Received frame */
 	struct modem_cmux_frame frame;
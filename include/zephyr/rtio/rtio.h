@@ -38,6 +38,7 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -517,6 +518,16 @@ struct rtio_iodev_sqe {
 	struct mpsc_node q;
 	struct rtio_iodev_sqe *next;
 	struct rtio *r;
+#ifdef CONFIG_RTIO_IODEV_SCHED
+	/* Node in the queue of the iodev scheduler */
+	sys_snode_t sched_node;
+	/* Scheduler which handed this submission to its iodev, if any */
+	struct rtio_iodev_sched *sched;
+	/* Submissions merged into this one by the scheduler */
+	struct rtio_iodev_sqe *merged;
+	/* Deadline given with rtio_sqe_set_deadline() */
+	k_timepoint_t deadline;
+#endif
 };
 
 /**
@@ -543,7 +554,49 @@ struct rtio_iodev {
 
 	/* Data associated with this iodev */
 	void *data;
+
+#ifdef CONFIG_RTIO_IODEV_SCHED
+	/* Scheduler of the submissions, may be shared by the iodevs of a bus */
+	struct rtio_iodev_sched *sched;
+#endif
+};
+
+#if defined(CONFIG_RTIO_IODEV_SCHED) || defined(__DOXYGEN__)
+/**
+ * @brief Merge contiguous reads and writes
+ *
+ * Queued reads, or writes, of an iodev whose buffers follow each other in
+ * memory are handed to the iodev as a single submission. Only suitable for
+ * iodevs where one long transfer is equivalent to several shorter ones, such
+ * as streams.
+ */
+#define RTIO_IODEV_SCHED_MERGE BIT(0)
+
+/**
+ * @brief Scheduler of the submissions of one or more iodevs
+ *
+ * Submissions to the iodevs are queued by priority, then by deadline, then
+ * in submission order. At most @c depth of them are in flight at the iodevs
+ * at a time. Sharing one scheduler between the iodevs of a bus orders the
+ * requests of all the devices on that bus.
+ *
+ * Define with RTIO_IODEV_SCHED_DEFINE().
+ */
+struct rtio_iodev_sched {
+	/* Protects the members below */
+	struct k_spinlock lock;
+	/* Submissions waiting for their iodev */
+	sys_slist_t pending;
+	/* Number of submissions in flight */
+	uint16_t in_flight;
+	/* Maximum number of submissions in flight */
+	const uint16_t depth;
+	/* RTIO_IODEV_SCHED_* flags */
+	const uint8_t flags;
+	/* Set while a context hands submissions to the iodevs */
+	bool dispatching;
 };
+#endif /* CONFIG_RTIO_IODEV_SCHED */
 
 /** An operation that does nothing and will complete immediately */
 #define RTIO_OP_NOP 0
@@ -827,6 +880,10 @@ static inline struct rtio_iodev_sqe *rtio_sqe_pool_alloc(struct rtio_sqe_pool *p
 
 	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
 
+#ifdef CONFIG_RTIO_IODEV_SCHED
+	iodev_sqe->deadline = sys_timepoint_calc(K_FOREVER);
+#endif
+
 	pool->pool_free--;
 
 	return iodev_sqe;
@@ -933,6 +990,38 @@ static inline void rtio_block_pool_free(struct rtio *r, void *buf, uint32_t buf_
 		.data = (iodev_data),				\
 	}
 
+/**
+ * @brief Statically define and initialize an RTIO IODev with a scheduler
+ *
+ * @param name Name of the iodev
+ * @param iodev_api Pointer to struct rtio_iodev_api
+ * @param iodev_data Data pointer
+ * @param iodev_sched Pointer to the struct rtio_iodev_sched of the iodev
+ */
+#define RTIO_IODEV_DEFINE_WITH_SCHED(name, iodev_api, iodev_data, iodev_sched)	\
+	STRUCT_SECTION_ITERABLE(rtio_iodev, name) = {		\
+		.api = (iodev_api),				\
+		.data = (iodev_data),				\
+		.sched = (iodev_sched),				\
+	}
+
+/**
+ * @brief Statically define and initialize an iodev scheduler
+ *
+ * Requires @kconfig{CONFIG_RTIO_IODEV_SCHED}.
+ *
+ * @param name Name of the scheduler
+ * @param sched_depth Maximum number of submissions in flight at the iodevs
+ * @param sched_flags RTIO_IODEV_SCHED_* flags
+ */
+#define RTIO_IODEV_SCHED_DEFINE(name, sched_depth, sched_flags)	\
+	BUILD_ASSERT((sched_depth) > 0, "An iodev scheduler needs a depth");	\
+	static struct rtio_iodev_sched name = {			\
+		.pending = SYS_SLIST_STATIC_INIT(&name.pending),	\
+		.depth = (sched_depth),				\
+		.flags = (sched_flags),				\
+	}
+
 #define Z_RTIO_SQE_POOL_DEFINE(name, sz)			\
 	static struct rtio_iodev_sqe CONCAT(_sqe_pool_, name)[sz];	\
 	STRUCT_SECTION_ITERABLE(rtio_sqe_pool, name) = {	\
@@ -1166,6 +1255,43 @@ static inline int rtio_sqe_acquire_array(struct rtio *r, size_t n, struct rtio_s
 	return 0;
 }
 
+#if defined(CONFIG_RTIO_IODEV_SCHED) || defined(__DOXYGEN__)
+/**
+ * @brief Set the deadline of an acquired submission queue event
+ *
+ * Among the submissions of the same priority queued by an iodev scheduler,
+ * the ones with the earliest deadline are handed to the iodev first, then
+ * the ones without a deadline. Missing the deadline does not fail the
+ * submission. Has no effect on iodevs without a scheduler.
+ *
+ * Requires @kconfig{CONFIG_RTIO_IODEV_SCHED}.
+ *
+ * @param sqe Submission queue event from rtio_sqe_acquire()
+ * @param timeout Deadline, relative to now
+ */
+static inline void rtio_sqe_set_deadline(struct rtio_sqe *sqe, k_timeout_t timeout)
+{
+	struct rtio_iodev_sqe *iodev_sqe = CONTAINER_OF(sqe, struct rtio_iodev_sqe, sqe);
+
+	iodev_sqe->deadline = sys_timepoint_calc(timeout);
+}
+
+/**
+ * @brief Give an iodev a scheduler
+ *
+ * Must be done before anything is submitted to the iodev.
+ *
+ * Requires @kconfig{CONFIG_RTIO_IODEV_SCHED}.
+ *
+ * @param iodev IO device
+ * @param sched Scheduler, NULL to hand submissions to the iodev right away
+ */
+static inline void rtio_iodev_set_sched(struct rtio_iodev *iodev, struct rtio_iodev_sched *sched)
+{
+	iodev->sched = sched;
+}
+#endif /* CONFIG_RTIO_IODEV_SCHED */
+
 /**
  * @brief Drop all previously acquired sqe
  *
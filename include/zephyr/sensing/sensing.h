@@ -154,6 +154,24 @@ typedef void (*sensing_data_event_t)(
 		const void *buf,
 		void *context);
 
+/**
+ * @brief Batched data event callback signature.
+ *
+ * Delivers the samples of the opened sensor due since the previous call at
+ * once, see @ref SENSING_SENSOR_ATTRIBUTE_LATENCY. The samples stay valid
+ * until the callback returns.
+ *
+ * @param handle  Sensor instance handle passed to @ref sensing_open_sensor.
+ * @param bufs    Pointers to sensor-type-specific sample buffers, oldest first.
+ * @param count   Number of samples.
+ * @param context User context pointer as provided in @ref sensing_callback_list::context.
+ */
+typedef void (*sensing_data_batch_event_t)(
+		sensing_sensor_handle_t handle,
+		const void *const *bufs,
+		uint16_t count,
+		void *context);
+
 /**
  * @brief Read-only description of a sensor instance.
  */
@@ -188,6 +206,11 @@ struct sensing_sensor_info {
  */
 struct sensing_callback_list {
 	sensing_data_event_t on_data_event; /**< Callback function for a sensor data event. */
+	/**
+	 * Callback function for a batch of sensor data events, called in place
+	 * of @ref sensing_callback_list::on_data_event when set.
+	 */
+	sensing_data_batch_event_t on_data_batch_event;
 	void *context;                      /**< Context that will be passed to the callback. */
 };
 
@@ -216,7 +239,8 @@ struct sensing_sensor_config {
 		/**
 		 * Maximum duration for batching sensor samples before reporting in
 		 * microseconds (us). This defines how long sensor samples can be
-		 * accumulated before they must be reported.
+		 * accumulated before they must be reported. Only honoured with
+		 * @kconfig{CONFIG_SENSING_BATCH}.
 		 */
 		uint64_t latency;
 	};
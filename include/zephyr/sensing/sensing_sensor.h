@@ -85,8 +85,32 @@ struct sensing_connection {
 	/** Next consume time of the connection. Unit is micro seconds. */
 	uint64_t next_consume_time;
 	struct sensing_callback_list *callback_list; /**< Callback list of the connection. */
+#if defined(CONFIG_SENSING_BATCH) || defined(__DOXYGEN__)
+	uint64_t latency;    /**< Maximum batching latency in micro seconds. */
+	uint64_t deadline;   /**< Uptime at which the pending batch is due, in micro seconds. */
+	uint32_t next_seq;   /**< Sequence number of the next sample of the source to look at. */
+	uint32_t next_sel;   /**< Sequence number of the next sample selected by decimation. */
+	uint32_t selected;   /**< Slots of the source ring holding the pending batch. */
+	uint16_t decimation; /**< One sample of the source out of this many is delivered. */
+#endif
 };
 
+#if defined(CONFIG_SENSING_BATCH) || defined(__DOXYGEN__)
+/**
+ * @brief Latest samples of a sensor, shared by all its clients
+ *
+ * Each sample is kept until every client it was selected for got it.
+ */
+struct sensing_sample_ring {
+	uint32_t head; /**< Sequence number of the next sample. */
+	/** Number of clients a sample is still due to, per slot. */
+	atomic_t refs[CONFIG_SENSING_BATCH_RING_SIZE];
+	/** Samples. */
+	uint8_t samples[CONFIG_SENSING_BATCH_RING_SIZE][CONFIG_SENSING_BATCH_SAMPLE_SIZE]
+		__aligned(8);
+};
+#endif
+
 /**
  * @brief Internal sensor instance data structure.
  *
@@ -113,6 +137,9 @@ struct sensing_sensor {
 	struct rtio_sqe *stream_sqe;      /**< Sqe for streaming mode. */
 	atomic_t flag;                    /**< Sensor flag of the sensor instance. */
 	struct sensing_connection *conns; /**< Pointer to sensor connections. */
+#if defined(CONFIG_SENSING_BATCH) || defined(__DOXYGEN__)
+	struct sensing_sample_ring *ring; /**< Latest samples of the sensor instance. */
+#endif
 };
 
 /**
@@ -296,6 +323,15 @@ extern const struct rtio_iodev_api __sensing_iodev_api;
 #define SENSING_SENSOR_NAME(node, idx)					\
 	_CONCAT(_CONCAT(__sensing_sensor_, idx), DEVICE_DT_NAME_GET(node))
 
+/**
+ * @brief Macro to generate a name for the sample ring of a sensor.
+ *
+ * @param node The devicetree node identifier.
+ * @param idx Logical index into the sensor-types array.
+ */
+#define SENSING_SENSOR_RING_NAME(node, idx)				\
+	_CONCAT(_CONCAT(__sensing_ring_, idx), DEVICE_DT_NAME_GET(node))
+
 /**
  * @brief Macro to define a sensor.
  *
@@ -312,6 +348,9 @@ extern const struct rtio_iodev_api __sensing_iodev_api;
 #define SENSING_SENSOR_DEFINE(node, prop, idx, reg_ptr, cb_list_ptr)	\
 	SENSING_SENSOR_INFO_DEFINE(node, idx)				\
 	SENSING_SENSOR_IODEV_DEFINE(node, idx)				\
+	IF_ENABLED(CONFIG_SENSING_BATCH,				\
+		   (static struct sensing_sample_ring			\
+			   SENSING_SENSOR_RING_NAME(node, idx);))	\
 	STRUCT_SECTION_ITERABLE(sensing_sensor,				\
 				SENSING_SENSOR_NAME(node, idx)) = {	\
 		.dev = DEVICE_DT_GET(node),				\
@@ -320,6 +359,8 @@ extern const struct rtio_iodev_api __sensing_iodev_api;
 		.reporter_num = DT_PROP_LEN_OR(node, reporters, 0),	\
 		.conns = SENSING_CONNECTIONS_NAME(node),		\
 		.iodev = &SENSING_SENSOR_IODEV_NAME(node, idx),		\
+		IF_ENABLED(CONFIG_SENSING_BATCH,			\
+			   (.ring = &SENSING_SENSOR_RING_NAME(node, idx),)) \
 	};
 
 /**
@@ -0,0 +1,134 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Disk Access RTIO API
+ *
+ * Disks exposed through the disk access layer can be used as RTIO I/O
+ * devices, so that reads and writes are submitted without waiting for them
+ * and several of them can be in flight at once. Disk drivers may implement
+ * submissions natively, otherwise they are run on the RTIO work queue with
+ * the blocking disk operations.
+ */
+
+#ifndef ZEPHYR_INCLUDE_STORAGE_DISK_ACCESS_RTIO_H_
+#define ZEPHYR_INCLUDE_STORAGE_DISK_ACCESS_RTIO_H_
+
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/rtio/rtio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup disk_access_interface
+ * @{
+ */
+
+/**
+ * @brief Data of a disk RTIO I/O device
+ *
+ * @warning Not to be manipulated without the macros!
+ */
+struct disk_access_iodev_data {
+	/** Disk name */
+	const char *name;
+	/** Disk, looked up at first submission */
+	struct disk_info *disk;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct rtio_iodev_api disk_access_iodev_api;
+/** @endcond */
+
+/**
+ * @brief Define an RTIO I/O device for a disk
+ *
+ * The disk must have been initialized with @ref disk_access_init or the
+ * @ref DISK_IOCTL_CTRL_INIT ioctl before submitting to it.
+ *
+ * @param name Name of the I/O device symbol to define
+ * @param disk_name Name of the disk, as given to disk_access_init()
+ */
+#define DISK_ACCESS_IODEV_DEFINE(name, disk_name)                                                  \
+	static struct disk_access_iodev_data _disk_access_iodev_data_##name = {                    \
+		.name = disk_name,                                                                 \
+	};                                                                                         \
+	RTIO_IODEV_DEFINE(name, &disk_access_iodev_api, &_disk_access_iodev_data_##name)
+
+/**
+ * @brief Prepare a read of disk sectors
+ *
+ * The completion result is 0 on success, or a negative errno code.
+ *
+ * @param sqe Submission to prepare
+ * @param iodev Disk I/O device defined with DISK_ACCESS_IODEV_DEFINE()
+ * @param start_sector First sector to read
+ * @param buf Buffer to read into, dword aligned for NVMe disks
+ * @param len Length of @p buf, a multiple of the disk sector size
+ * @param userdata Value returned in the completion
+ */
+static inline void disk_access_sqe_prep_read(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+					     uint32_t start_sector, uint8_t *buf, uint32_t len,
+					     void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	sqe->iodev_flags = start_sector;
+}
+
+/**
+ * @brief Prepare a write of disk sectors
+ *
+ * The completion result is 0 on success, or a negative errno code.
+ *
+ * @param sqe Submission to prepare
+ * @param iodev Disk I/O device defined with DISK_ACCESS_IODEV_DEFINE()
+ * @param start_sector First sector to write
+ * @param buf Buffer to write from, dword aligned for NVMe disks
+ * @param len Length of @p buf, a multiple of the disk sector size
+ * @param userdata Value returned in the completion
+ */
+static inline void disk_access_sqe_prep_write(struct rtio_sqe *sqe, const struct rtio_iodev *iodev,
+					      uint32_t start_sector, const uint8_t *buf,
+					      uint32_t len, void *userdata)
+{
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, buf, len, userdata);
+	sqe->iodev_flags = start_sector;
+}
+
+/**
+ * @brief Start sector of a disk submission
+ *
+ * For use by disk drivers implementing disk_operations::submit.
+ */
+static inline uint32_t disk_access_sqe_start_sector(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	return iodev_sqe->sqe.iodev_flags;
+}
+
+/**
+ * @brief Run a disk submission on the RTIO work queue
+ *
+ * Uses the blocking disk operations. This is what happens to submissions
+ * for disks without native support, disk drivers may also use it for
+ * submissions they cannot handle themselves.
+ *
+ * @param disk Disk to run the submission on
+ * @param iodev_sqe Submission
+ */
+void disk_access_iodev_submit_fallback(struct disk_info *disk, struct rtio_iodev_sqe *iodev_sqe);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_STORAGE_DISK_ACCESS_RTIO_H_ */
@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @ingroup hashmap_implementations
+ * @brief Swiss Table Hashmap Implementation
+ *
+ * Open-Addressing Hashmap storing one control byte per bucket, apart from the
+ * entries. The control bytes hold 7 bits of the hash of the key of each used
+ * bucket, and are probed a group at a time: 16 buckets with SSE2, 8 buckets
+ * otherwise. Most lookups compare a single key.
+ *
+ * Besides scalar keys, a Swiss Table Hashmap can store keys of any size and
+ * type, see @ref SYS_HASHMAP_SWISS_BLOB_DEFINE.
+ *
+ * @note Enable with @kconfig{CONFIG_SYS_HASH_MAP_SWISS}
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_MAP_SWISS_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_MAP_SWISS_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Hash a key of a Swiss Table Hashmap storing key blobs
+ *
+ * @param key Key, usually a pointer to the key blob cast to an integer.
+ * @return 32-bit hash of the key blob
+ */
+typedef uint32_t (*sys_hashmap_swiss_key_hash_t)(uint64_t key);
+
+/**
+ * @brief Compare two keys of a Swiss Table Hashmap storing key blobs
+ *
+ * @param key1 First key, usually a pointer to a key blob cast to an integer.
+ * @param key2 Second key, usually a pointer to a key blob cast to an integer.
+ * @return true if both keys refer to equal key blobs
+ */
+typedef bool (*sys_hashmap_swiss_key_eq_t)(uint64_t key1, uint64_t key2);
+
+/**
+ * @brief Swiss Table Hashmap configuration
+ *
+ * Variant of @ref sys_hashmap_config for Hashmaps storing key blobs.
+ */
+struct sys_hashmap_swiss_config {
+	/** Maximum number of entries */
+	size_t max_size;
+	/** Maximum load factor expressed in hundredths */
+	uint8_t load_factor;
+	/** Initial number of buckets to allocate */
+	uint8_t initial_n_buckets;
+	/** Hash function of the key blobs */
+	sys_hashmap_swiss_key_hash_t key_hash;
+	/** Equality function of the key blobs */
+	sys_hashmap_swiss_key_eq_t key_eq;
+};
+
+/**
+ * @brief Initialize a @ref sys_hashmap_swiss_config
+ *
+ * @param _max_size Maximum number of entries
+ * @param _load_factor Maximum load factor expressed in hundredths
+ * @param _key_hash Hash function of type @ref sys_hashmap_swiss_key_hash_t.
+ * @param _key_eq Equality function of type @ref sys_hashmap_swiss_key_eq_t.
+ */
+#define SYS_HASHMAP_SWISS_CONFIG(_max_size, _load_factor, _key_hash, _key_eq)                      \
+	{                                                                                          \
+		.max_size = (size_t)_max_size, .load_factor = (uint8_t)_load_factor,               \
+		.initial_n_buckets = NHPOT(DIV_ROUND_UP(100, _load_factor)),                       \
+		.key_hash = (_key_hash), .key_eq = (_key_eq),                                      \
+	}
+
+struct sys_hashmap_swiss_data {
+	void *buckets;
+	size_t n_buckets;
+	size_t size;
+	size_t n_tombstones;
+};
+
+/**
+ * @brief Declare a Swiss Table Hashmap (advanced)
+ *
+ * Declare a Swiss Table Hashmap with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc_func is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Variant-specific details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_SWISS_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                     \
+	SYS_HASHMAP_DEFINE_ADVANCED(_name, &sys_hashmap_swiss_api, sys_hashmap_config,             \
+				    sys_hashmap_swiss_data, _hash_func, _alloc_func, __VA_ARGS__)
+
+/**
+ * @brief Declare a Swiss Table Hashmap statically (advanced)
+ *
+ * Declare a Swiss Table Hashmap statically with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc_func is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_SWISS_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)              \
+	SYS_HASHMAP_DEFINE_STATIC_ADVANCED(_name, &sys_hashmap_swiss_api, sys_hashmap_config,      \
+					   sys_hashmap_swiss_data, _hash_func, _alloc_func,        \
+					   __VA_ARGS__)
+
+/**
+ * @brief Declare a Swiss Table Hashmap statically
+ *
+ * Declare a Swiss Table Hashmap statically with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_SWISS_DEFINE_STATIC(_name)                                                     \
+	SYS_HASHMAP_SWISS_DEFINE_STATIC_ADVANCED(                                                  \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+/**
+ * @brief Declare a Swiss Table Hashmap
+ *
+ * Declare a Swiss Table Hashmap with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_SWISS_DEFINE(_name)                                                            \
+	SYS_HASHMAP_SWISS_DEFINE_ADVANCED(                                                         \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+/**
+ * @brief Declare a Swiss Table Hashmap storing key blobs (advanced)
+ *
+ * The keys of such a Hashmap are hashed and compared with @p _key_hash and
+ * @p _key_eq rather than as integers, which lets them refer to keys of any
+ * size and type, e.g. strings. The key blobs are not copied: they must stay
+ * valid and unchanged as long as they are in the Hashmap.
+ *
+ * @note The allocator @p _alloc_func is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _key_hash Hash function of type @ref sys_hashmap_swiss_key_hash_t.
+ * @param _key_eq Equality function of type @ref sys_hashmap_swiss_key_eq_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param _max_size Maximum number of entries
+ * @param _load_factor Maximum load factor expressed in hundredths
+ */
+#define SYS_HASHMAP_SWISS_BLOB_DEFINE_ADVANCED(_name, _key_hash, _key_eq, _alloc_func, _max_size,  \
+					       _load_factor)                                       \
+	SYS_HASHMAP_DEFINE_ADVANCED(                                                               \
+		_name, &sys_hashmap_swiss_blob_api, sys_hashmap_swiss_config,                      \
+		sys_hashmap_swiss_data, NULL, _alloc_func,                                         \
+		SYS_HASHMAP_SWISS_CONFIG(_max_size, _load_factor, _key_hash, _key_eq))
+
+/**
+ * @brief Declare a Swiss Table Hashmap storing key blobs
+ *
+ * Declare a Swiss Table Hashmap storing key blobs with default parameters.
+ * See @ref SYS_HASHMAP_SWISS_BLOB_DEFINE_ADVANCED.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _key_hash Hash function of type @ref sys_hashmap_swiss_key_hash_t.
+ * @param _key_eq Equality function of type @ref sys_hashmap_swiss_key_eq_t.
+ */
+#define SYS_HASHMAP_SWISS_BLOB_DEFINE(_name, _key_hash, _key_eq)                                   \
+	SYS_HASHMAP_SWISS_BLOB_DEFINE_ADVANCED(_name, _key_hash, _key_eq,                          \
+					       SYS_HASHMAP_DEFAULT_ALLOCATOR, SIZE_MAX,            \
+					       SYS_HASHMAP_DEFAULT_LOAD_FACTOR)
+
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_SWISS
+#define SYS_HASHMAP_DEFAULT_DEFINE(_name)	 SYS_HASHMAP_SWISS_DEFINE(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC(_name) SYS_HASHMAP_SWISS_DEFINE_STATIC(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                   \
+	SYS_HASHMAP_SWISS_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)            \
+	SYS_HASHMAP_SWISS_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#endif
+
+extern const struct sys_hashmap_api sys_hashmap_swiss_api;
+extern const struct sys_hashmap_api sys_hashmap_swiss_blob_api;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_MAP_SWISS_H_ */
@@ -0,0 +1,257 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SYS_MPMC_LOCKFREE_H_
+#define ZEPHYR_SYS_MPMC_LOCKFREE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/toolchain/common.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util_macro.h>
+
+/**
+ * @brief Multiple Producer Multiple Consumer (MPMC) Lockfree Queue API
+ * @defgroup mpmc_lockfree MPMC API
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+/**
+ * @file mpmc_lockfree.h
+ *
+ * @brief A lock-free and type safe power of 2 fixed sized multiple producer
+ * multiple consumer (MPMC) queue using a ringbuffer and atomics to ensure
+ * coherency.
+ *
+ * This is the multiple producer, multiple consumer counterpart of the SPSC
+ * queue in spsc_lockfree.h and shares its acquire/produce, consume/release
+ * usage pattern. Elements are expected to be of a fixed size, and the API is
+ * type safe as the underlying buffer is typed and all usage is done through
+ * macros.
+ *
+ * Each element of the ringbuffer carries a sequence number telling whether
+ * it is ready to be produced into or consumed from for a given lap around the
+ * ringbuffer. Producers and consumers claim elements with a compare and swap
+ * on a shared index, then publish them by bumping the element's sequence
+ * number, so no interrupt masking or spinlock is ever needed. This makes it
+ * usable to hand off data between any mix of ISRs and threads, on any CPU.
+ *
+ * Claiming never waits on other contexts, however elements are handed over in
+ * order: a producer preempted between mpmc_acquire() and mpmc_produce() holds
+ * back consumers from the elements produced after its own until it resumes.
+ *
+ * Blocking on an empty or full queue is left to the user, which may pair the
+ * queue with a semaphore or a poll signal when needed.
+ */
+
+/**
+ * @private
+ * @brief Common MPMC attributes
+ *
+ * @warning Not to be manipulated without the macros!
+ */
+struct mpmc {
+	/* next position to be acquired by a producer */
+	atomic_t in;
+
+	/* next position to be consumed by a consumer */
+	atomic_t out;
+
+	/* per element sequence numbers, stored minus the element index so
+	 * that an all zero array is a valid initial state
+	 */
+	atomic_t *const seq;
+
+	/* mask used to automatically wrap values */
+	const unsigned long mask;
+};
+
+/**
+ * @brief Statically initialize an mpmc
+ *
+ * @param sz Size of the mpmc, must be power of 2 and at least 2 (ex: 2, 4, 8)
+ * @param buf Buffer pointer
+ * @param seq_buf Zero initialized array of @p sz atomic_t
+ */
+#define MPMC_INITIALIZER(sz, buf, seq_buf)                                                         \
+	{                                                                                          \
+		._mpmc =                                                                           \
+			{                                                                          \
+				.in = ATOMIC_INIT(0),                                              \
+				.out = ATOMIC_INIT(0),                                             \
+				.seq = seq_buf,                                                    \
+				.mask = sz - 1,                                                    \
+			},                                                                         \
+		.buffer = buf,                                                                     \
+	}
+
+/**
+ * @brief Declare an anonymous struct type for an mpmc
+ *
+ * @param name Name of the mpmc symbol to be provided
+ * @param type Type stored in the mpmc
+ */
+#define MPMC_DECLARE(name, type)                                                                   \
+	struct mpmc_##name {                                                                       \
+		struct mpmc _mpmc;                                                                 \
+		type * const buffer;                                                               \
+	}
+
+/**
+ * @brief Define an mpmc with a fixed size
+ *
+ * @param name Name of the mpmc symbol to be provided
+ * @param type Type stored in the mpmc
+ * @param sz Size of the mpmc, must be power of 2 and at least 2 (ex: 2, 4, 8)
+ */
+#define MPMC_DEFINE(name, type, sz)                                                                \
+	BUILD_ASSERT(IS_POWER_OF_TWO(sz) && (sz) >= 2);                                            \
+	static type __mpmc_buf_##name[sz];                                                         \
+	static atomic_t __mpmc_seq_##name[sz];                                                     \
+	MPMC_DECLARE(name, type) name =                                                            \
+		MPMC_INITIALIZER(sz, __mpmc_buf_##name, __mpmc_seq_##name);
+
+/**
+ * @brief Size of the MPMC queue
+ *
+ * @param mpmc MPMC reference
+ */
+#define mpmc_size(mpmc) ((mpmc)->_mpmc.mask + 1)
+
+/**
+ * @private
+ * @brief Claim the element at the position of @p pos_ptr once its sequence
+ * number reaches that position plus @p lag.
+ *
+ * @return Index of the claimed element, or -1 if the element at the current
+ * position isn't ready yet (queue full for producers, empty for consumers).
+ */
+static inline long z_mpmc_claim(struct mpmc *q, atomic_t *pos_ptr, unsigned long lag)
+{
+	unsigned long pos = (unsigned long)atomic_get(pos_ptr);
+
+	for (;;) {
+		unsigned long idx = pos & q->mask;
+		unsigned long seq = (unsigned long)atomic_get(&q->seq[idx]) + idx;
+		long diff = (long)(seq - (pos + lag));
+
+		if (diff == 0) {
+			if (atomic_cas(pos_ptr, (atomic_val_t)pos, (atomic_val_t)(pos + 1))) {
+				return (long)idx;
+			}
+		} else if (diff < 0) {
+			return -1;
+		} else {
+			/* Another context got there first, catch up */
+		}
+		pos = (unsigned long)atomic_get(pos_ptr);
+	}
+}
+
+/**
+ * @private
+ * @brief Element pointer from an index returned by z_mpmc_claim(), or NULL
+ */
+#define z_mpmc_elem(mpmc, idx) ((idx) < 0 ? NULL : &(mpmc)->buffer[(idx)])
+
+/**
+ * @private
+ * @brief Index of an element of the mpmc
+ */
+#define z_mpmc_idx(mpmc, item) ((unsigned long)((item) - (mpmc)->buffer))
+
+/**
+ * @brief Initialize/reset an mpmc such that its empty
+ *
+ * Note that this is not safe to do while being used in a producer/consumer
+ * situation with multiple calling contexts (isrs/threads).
+ *
+ * @param mpmc MPMC to initialize/reset
+ */
+#define mpmc_reset(mpmc)                                                                           \
+	({                                                                                         \
+		for (unsigned long i = 0; i < mpmc_size(mpmc); i++) {                              \
+			atomic_set(&(mpmc)->_mpmc.seq[i], 0);                                      \
+		}                                                                                  \
+		atomic_set(&(mpmc)->_mpmc.in, 0);                                                  \
+		atomic_set(&(mpmc)->_mpmc.out, 0);                                                 \
+	})
+
+/**
+ * @brief Acquire an element to produce from the MPMC
+ *
+ * Every acquired element must later be handed to mpmc_produce().
+ *
+ * @param mpmc MPMC to acquire an element from for producing
+ *
+ * @return A pointer to the acquired element or null if the mpmc is full
+ */
+#define mpmc_acquire(mpmc)                                                                         \
+	({                                                                                         \
+		long mpmc_idx = z_mpmc_claim(&(mpmc)->_mpmc, &(mpmc)->_mpmc.in, 0);                \
+		z_mpmc_elem(mpmc, mpmc_idx);                                                       \
+	})
+
+/**
+ * @brief Produce a previously acquired element to the MPMC
+ *
+ * This makes the element available to consumers, once all elements acquired
+ * before it are produced as well.
+ *
+ * @param mpmc MPMC to produce the element to
+ * @param item Element returned by mpmc_acquire()
+ */
+#define mpmc_produce(mpmc, item)                                                                   \
+	({                                                                                         \
+		(void)atomic_inc(&(mpmc)->_mpmc.seq[z_mpmc_idx(mpmc, item)]);                      \
+	})
+
+/**
+ * @brief Consume an element from the mpmc
+ *
+ * Every consumed element must later be handed to mpmc_release().
+ *
+ * @param mpmc MPMC to consume from
+ *
+ * @return Pointer to element or null if no consumable elements left
+ */
+#define mpmc_consume(mpmc)                                                                         \
+	({                                                                                         \
+		long mpmc_idx = z_mpmc_claim(&(mpmc)->_mpmc, &(mpmc)->_mpmc.out, 1);               \
+		z_mpmc_elem(mpmc, mpmc_idx);                                                       \
+	})
+
+/**
+ * @brief Release a consumed element
+ *
+ * This makes the element available to producers again.
+ *
+ * @param mpmc MPMC to release the element to
+ * @param item Element returned by mpmc_consume()
+ */
+#define mpmc_release(mpmc, item)                                                                   \
+	({                                                                                         \
+		(void)atomic_add(&(mpmc)->_mpmc.seq[z_mpmc_idx(mpmc, item)],                       \
+				 (atomic_val_t)(mpmc)->_mpmc.mask);                                \
+	})
+
+/**
+ * @brief Count of elements acquired but not consumed yet in the mpmc
+ *
+ * This is only a snapshot when other contexts are using the mpmc.
+ *
+ * @param mpmc MPMC to get item count for
+ */
+#define mpmc_consumable(mpmc)                                                                      \
+	({ (unsigned long)atomic_get(&(mpmc)->_mpmc.in) -                                          \
+	   (unsigned long)atomic_get(&(mpmc)->_mpmc.out); })
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_SYS_MPMC_LOCKFREE_H_ */
@@ -1488,6 +1488,76 @@
  */
 #define sys_port_trace_k_msgq_purge(msgq)
 
+/**
+ * @brief Trace Message Queue put of several messages attempt entry
+ * @param msgq Message Queue object
+ * @param num_msgs Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_enter(msgq, num_msgs, timeout)
+
+/**
+ * @brief Trace Message Queue put of several messages attempt blocking
+ * @param msgq Message Queue object
+ * @param num_msgs Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, num_msgs, timeout)
+
+/**
+ * @brief Trace Message Queue put of several messages attempt outcome
+ * @param msgq Message Queue object
+ * @param num_msgs Number of messages
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_many_exit(msgq, num_msgs, timeout, ret)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt entry
+ * @param msgq Message Queue object
+ * @param max_msgs Maximum number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_enter(msgq, max_msgs, timeout)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt blocking
+ * @param msgq Message Queue object
+ * @param max_msgs Maximum number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, max_msgs, timeout)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt outcome
+ * @param msgq Message Queue object
+ * @param max_msgs Maximum number of messages
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_many_exit(msgq, max_msgs, timeout, ret)
+
+/**
+ * @brief Trace Message Queue slot reservation
+ * @param msgq Message Queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_reserve(msgq, ret)
+
+/**
+ * @brief Trace Message Queue reserved slot commit
+ * @param msgq Message Queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_commit(msgq, ret)
+
+/**
+ * @brief Trace Message Queue reserved slot cancellation
+ * @param msgq Message Queue object
+ */
+#define sys_port_trace_k_msgq_cancel(msgq)
+
 /** @} */ /* end of subsys_tracing_apis_msgq */
 
 /**
@@ -1667,6 +1737,44 @@
  */
 #define sys_port_trace_k_pipe_read_exit(pipe, ret)
 
+/**
+ * @brief Trace Pipe vectored write attempt entry
+ *
+ * Blocking is traced by sys_port_trace_k_pipe_write_blocking().
+ *
+ * @param pipe Pipe object
+ * @param iov Pointer to the I/O vectors
+ * @param iovcnt Number of I/O vectors
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_writev_enter(pipe, iov, iovcnt, timeout)
+
+/**
+ * @brief Trace Pipe vectored write attempt outcome
+ * @param pipe Pipe object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_writev_exit(pipe, ret)
+
+/**
+ * @brief Trace Pipe vectored read attempt entry
+ *
+ * Blocking is traced by sys_port_trace_k_pipe_read_blocking().
+ *
+ * @param pipe Pipe object
+ * @param iov Pointer to the I/O vectors
+ * @param iovcnt Number of I/O vectors
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_readv_enter(pipe, iov, iovcnt, timeout)
+
+/**
+ * @brief Trace Pipe vectored read attempt outcome
+ * @param pipe Pipe object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_readv_exit(pipe, ret)
+
 /** @} */ /* end of subsys_tracing_apis_pipe */
 
 /**
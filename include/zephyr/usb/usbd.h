@@ -1077,6 +1077,97 @@ int usbd_ep_dequeue(struct usbd_context *uds_ctx, const uint8_t ep);
  */
 int usbd_ep_buf_free(struct usbd_context *uds_ctx, struct net_buf *buf);
 
+/**
+ * @brief Endpoint pipeline
+ *
+ * Keeps up to @c depth transfers queued on a bulk or interrupt endpoint, so
+ * that the controller always has a buffer to work on. Completed OUT transfers
+ * are resubmitted automatically with buffers from the pipeline pool, IN
+ * transfers are throttled to the pipeline depth.
+ *
+ * The members are internal, use @ref usbd_ep_pipe_init to set them up.
+ */
+struct usbd_ep_pipe {
+	/** Class instance owning the endpoint */
+	struct usbd_class_data *c_data;
+	/** Pool of the OUT transfer buffers */
+	struct net_buf_pool *pool;
+	/** Free IN transfer slots */
+	struct k_sem slots;
+	/** Number of transfers queued */
+	atomic_t queued;
+	/** Whether completed OUT transfers are resubmitted */
+	atomic_t running;
+	/** Endpoint address */
+	uint8_t ep;
+	/** Maximum number of transfers queued */
+	uint8_t depth;
+};
+
+/**
+ * @brief Initialize an endpoint pipeline
+ *
+ * @param[in] pipe   Pointer to the endpoint pipeline
+ * @param[in] c_data Pointer to USB device class data
+ * @param[in] pool   Pool to allocate OUT transfer buffers from, NULL for IN
+ * @param[in] depth  Maximum number of transfers queued
+ */
+void usbd_ep_pipe_init(struct usbd_ep_pipe *pipe, struct usbd_class_data *c_data,
+		       struct net_buf_pool *pool, uint8_t depth);
+
+/**
+ * @brief Start an endpoint pipeline
+ *
+ * For OUT endpoints, queue transfers until the pipeline is full.
+ *
+ * @param[in] pipe Pointer to the endpoint pipeline
+ * @param[in] ep   Endpoint address, for the current bus speed
+ *
+ * @return 0 on success, all other values should be treated as error.
+ */
+int usbd_ep_pipe_start(struct usbd_ep_pipe *pipe, uint8_t ep);
+
+/**
+ * @brief Stop an endpoint pipeline
+ *
+ * Completed OUT transfers are no longer resubmitted. Transfers already queued
+ * are cancelled by the stack when the endpoint gets disabled and must still
+ * be passed to @ref usbd_ep_pipe_done.
+ *
+ * @param[in] pipe Pointer to the endpoint pipeline
+ */
+void usbd_ep_pipe_stop(struct usbd_ep_pipe *pipe);
+
+/**
+ * @brief Queue an IN transfer on an endpoint pipeline
+ *
+ * Wait for the pipeline to have room for the transfer, then queue it.
+ *
+ * @param[in] pipe    Pointer to the endpoint pipeline
+ * @param[in] buf     Pointer to UDC request buffer
+ * @param[in] timeout Time to wait for room in the pipeline
+ *
+ * @return 0 on success, -EAGAIN if the pipeline stayed full, all other values
+ *         should be treated as error.
+ */
+int usbd_ep_pipe_enqueue(struct usbd_ep_pipe *pipe, struct net_buf *buf,
+			 k_timeout_t timeout);
+
+/**
+ * @brief Release a completed transfer of an endpoint pipeline
+ *
+ * To be called from the class request handler for every transfer of the
+ * pipeline, including failed and cancelled ones, in place of releasing the
+ * buffer. Transfers cancelled together are chained to one another and are all
+ * released. For a running OUT pipeline, the transfers are replaced.
+ *
+ * @param[in] pipe Pointer to the endpoint pipeline
+ * @param[in] buf  Pointer to UDC request buffer
+ *
+ * @return 0 on success, all other values are errors of the resubmission.
+ */
+int usbd_ep_pipe_done(struct usbd_ep_pipe *pipe, struct net_buf *buf);
+
 /**
  * @brief Checks whether the USB device controller is suspended.
  *
@@ -16,6 +16,8 @@
 extern "C" {
 #endif
 
+struct net_buf;
+
 /**
  * @brief Zbus API
  * @defgroup zbus_apis Zbus APIs
@@ -46,11 +48,24 @@ struct zbus_channel_data {
 	 */
 	struct k_sem sem;
 
+#if defined(CONFIG_ZBUS_SEQLOCK_READ) || defined(__DOXYGEN__)
+	/** Message sequence. Odd while the message may be modified, so that readers copying the
+	 * message without the semaphore can detect they raced with a writer.
+	 */
+	atomic_t seq;
+#endif /* CONFIG_ZBUS_SEQLOCK_READ */
+
+	/** Whether the channel message is loaned by zbus_chan_pub_loan(), until the commit. */
+	bool loaned;
+
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
 	/** Highest observer priority. Indicates the priority that the VDED will use to boost the
 	 * notification process avoiding preemptions.
 	 */
 	int highest_observer_priority;
+
+	/** Priority of the publisher loaning the channel message, restored on commit. */
+	int loan_priority;
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 
 #if defined(CONFIG_ZBUS_RUNTIME_OBSERVERS) || defined(__DOXYGEN__)
@@ -695,10 +710,54 @@ static inline int zbus_async_listener_set_work_queue(const struct zbus_observer
  */
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout);
 
+/**
+ * @brief Loan the channel message to publish it
+ *
+ * This routine claims the channel and gives the publisher its message to fill in place, saving
+ * the copy done by zbus_chan_pub(). The channel stays blocked, as when claimed, until
+ * zbus_chan_pub_commit() publishes the message.
+ *
+ * Channels with a validator cannot be loaned, since the message would be changed before it could
+ * be rejected.
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] msg The channel's message, to fill in.
+ * @param[in] timeout Waiting period to claim the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel message loaned.
+ * @retval -ENOTSUP The channel has a validator.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_pub_loan(const struct zbus_channel *chan, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Publish the loaned channel message
+ *
+ * This routine notifies the observers of the message filled after zbus_chan_pub_loan(), then
+ * releases the channel.
+ *
+ * @param chan The channel's reference.
+ * @param timeout Waiting period to notify the observers,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -EPERM The channel message is not loaned.
+ * @retval -ENOMEM There is not more buffer on the messgage buffers pool.
+ * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
+ * observer, or the function context is invalid (inside an ISR). The function only returns this
+ * value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_pub_commit(const struct zbus_channel *chan, k_timeout_t timeout);
+
 /**
  * @brief Read a channel
  *
- * This routine reads a message from a channel.
+ * This routine reads a message from a channel. With @kconfig{CONFIG_ZBUS_SEQLOCK_READ}, the
+ * message is copied without taking the channel's semaphore unless a writer holds it.
  *
  * @param[in] chan The channel's reference.
  * @param[out] msg Reference to the message where the read function copies the channel's
@@ -1259,6 +1318,27 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+/**
+ * @brief Wait for a channel message buffer.
+ *
+ * This routine makes the subscriber wait for the new message in case of channel publication, and
+ * hands it over without copying it. The buffer data is shared with the other message subscribers
+ * of the channel and must not be modified.
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The buffer holding the published message, to release with net_buf_unref().
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 /**
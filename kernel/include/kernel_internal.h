@@ -143,6 +143,14 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
  * not recommended.
  */
 extern struct k_spinlock z_mem_domain_lock;
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Hand an unlocked mutex over to @a owner, as if it had locked it once.
+ * Used to make sys_mutex owners which locked from user mode known to the
+ * kernel. Returns -EBUSY if the mutex is already locked.
+ */
+int z_mutex_owner_set(struct k_mutex *mutex, struct k_thread *owner);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_GDBSTUB
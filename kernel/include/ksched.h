@@ -65,6 +65,7 @@ void z_reschedule_irqlock(uint32_t key);
 void z_unpend_thread(struct k_thread *thread);
 int z_unpend_all(_wait_q_t *wait_q);
 bool z_thread_prio_set(struct k_thread *thread, int prio);
+bool z_thread_is_active_elsewhere(struct k_thread *thread);
 void *z_get_next_switch_handle(void *interrupted);
 
 void z_time_slice(void);
@@ -1577,6 +1577,21 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_prefetch_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.pagefaults.prefetched++;
+
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.pagefaults.prefetched++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 {
 	struct k_mem_page_frame *pf;
@@ -1611,6 +1626,75 @@ static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+/*
+ * Page in the data pages following a just serviced page fault at addr.
+ *
+ * Only free page frames are used, so that prefetching never causes any
+ * eviction. This stops at the first data page which isn't paged out to the
+ * backing store, or which is anonymous memory as there is nothing to gain
+ * from zero-filling those ahead of time.
+ *
+ * Must be called with z_mm_lock held. The lock is dropped around backing
+ * store accesses if CONFIG_DEMAND_PAGING_ALLOW_IRQ is enabled, and key is
+ * updated accordingly.
+ */
+static void do_page_prefetch(void *addr, struct k_thread *faulting_thread,
+			     k_spinlock_key_t *key)
+{
+	uint8_t *pos = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr),
+						  CONFIG_MMU_PAGE_SIZE));
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH_PAGES; i++) {
+		struct k_mem_page_frame *pf;
+		enum arch_page_location status;
+		uintptr_t location, phys;
+
+		pos += CONFIG_MMU_PAGE_SIZE;
+		if (pos >= K_MEM_VIRT_RAM_END || pos < K_MEM_VIRT_RAM_START) {
+			break;
+		}
+
+		status = arch_page_location_get(pos, &location);
+		if (status != ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+#ifdef CONFIG_DEMAND_MAPPING
+		if (location == ARCH_UNPAGED_ANON_ZERO ||
+		    location == ARCH_UNPAGED_ANON_UNINIT) {
+			break;
+		}
+#endif /* CONFIG_DEMAND_MAPPING */
+
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			break;
+		}
+		phys = k_mem_page_frame_to_phys(pf);
+		arch_mem_scratch(phys);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_BUSY);
+		k_spin_unlock(&z_mm_lock, *key);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+		do_backing_store_page_in(location);
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+		*key = k_spin_lock(&z_mm_lock);
+		k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+
+		frame_mapped_set(pf, pos);
+		arch_mem_page_in(pos, phys);
+		k_mem_paging_backing_store_page_finalize(pf, location);
+		if (IS_ENABLED(CONFIG_EVICTION_TRACKING)) {
+			k_mem_paging_eviction_add(pf);
+		}
+
+		paging_stats_prefetch_inc(faulting_thread);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct k_mem_page_frame *pf;
@@ -1752,6 +1836,11 @@ static bool do_page_fault(void *addr, bool pin)
 	if (IS_ENABLED(CONFIG_EVICTION_TRACKING) && (!pin)) {
 		k_mem_paging_eviction_add(pf);
 	}
+#if CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0
+	if (!pin) {
+		do_page_prefetch(addr, faulting_thread, &key);
+	}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0 */
 out:
 	k_spin_unlock(&z_mm_lock, key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -123,6 +123,44 @@ exit:
 	return ret;
 }
 
+/* Copy num_msgs messages to the back of the ring buffer, wrapping around */
+static void ring_write_msgs(struct k_msgq *msgq, const char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->write_ptr;
+
+	__ASSERT_NO_MSG(msgq->used_msgs + num_msgs <= msgq->max_msgs);
+
+	if (len < to_end) {
+		(void)memcpy(msgq->write_ptr, data, len);
+		msgq->write_ptr += len;
+	} else {
+		(void)memcpy(msgq->write_ptr, data, to_end);
+		(void)memcpy(msgq->buffer_start, data + to_end, len - to_end);
+		msgq->write_ptr = msgq->buffer_start + (len - to_end);
+	}
+	msgq->used_msgs += num_msgs;
+}
+
+/* Copy num_msgs messages out of the front of the ring buffer, wrapping around */
+static void ring_read_msgs(struct k_msgq *msgq, char *data, uint32_t num_msgs)
+{
+	size_t len = num_msgs * msgq->msg_size;
+	size_t to_end = msgq->buffer_end - msgq->read_ptr;
+
+	__ASSERT_NO_MSG(num_msgs <= msgq->used_msgs);
+
+	if (len < to_end) {
+		(void)memcpy(data, msgq->read_ptr, len);
+		msgq->read_ptr += len;
+	} else {
+		(void)memcpy(data, msgq->read_ptr, to_end);
+		(void)memcpy(data + to_end, msgq->buffer_start, len - to_end);
+		msgq->read_ptr = msgq->buffer_start + (len - to_end);
+	}
+	msgq->used_msgs -= num_msgs;
+}
+
 static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 			k_timeout_t timeout, bool put_at_back)
 {
@@ -141,7 +179,10 @@ static inline int put_msg_in_queue(struct k_msgq *msgq, const void *data,
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_front, msgq, timeout);
 	}
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		/* the next slot belongs to k_msgq_reserve() caller */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
 		if (unlikely(pending_thread != NULL)) {
@@ -232,6 +273,174 @@ int z_impl_k_msgq_put_front(struct k_msgq *msgq, const void *data)
 	return put_msg_in_queue(msgq, data, K_NO_WAIT, false);
 }
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count = 0U;
+	uint32_t num_free;
+	bool resched = false;
+	int result;
+
+	if (num_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, num_msgs, timeout);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, num_msgs, timeout, -EBUSY);
+		k_spin_unlock(&msgq->lock, key);
+		return -EBUSY;
+	}
+
+	if (msgq->used_msgs < msgq->max_msgs) {
+		/* message queue isn't full, so any waiting thread is a reader:
+		 * give them the first messages
+		 */
+		while (count < num_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			(void)memcpy(pending_thread->base.swap_data,
+				     src + (count * msgq->msg_size), msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+			count++;
+		}
+
+		/* and queue as many of the remaining ones as fit */
+		num_free = msgq->max_msgs - msgq->used_msgs;
+		if (count < num_msgs && num_free > 0U) {
+			uint32_t num_put = MIN(num_msgs - count, num_free);
+
+			ring_write_msgs(msgq, src + (count * msgq->msg_size), num_put);
+			count += num_put;
+			if (handle_poll_events(msgq)) {
+				resched = true;
+			}
+		}
+	}
+
+	if (count > 0U) {
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait for the first message to be taken in, like k_msgq_put() */
+		_current->base.swap_data = (void *)data;
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq, num_msgs, timeout);
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, num_msgs, timeout, result);
+
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, num_msgs, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
+int k_msgq_reserve(struct k_msgq *msgq, void **msg)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs == msgq->max_msgs) {
+		result = -ENOMSG;
+	} else {
+		__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+				msgq->write_ptr < msgq->buffer_end);
+		msgq->flags |= K_MSGQ_FLAG_RESERVED;
+		*msg = msgq->write_ptr;
+		result = 0;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, reserve, msgq, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_commit(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) {
+		/* never reserved, cancelled or purged in the meantime */
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, commit, msgq, -EINVAL);
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, commit, msgq, 0);
+
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (unlikely(pending_thread != NULL)) {
+		/* queue is empty, give message to waiting thread */
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		resched = true;
+	} else {
+		/* message was written in place, only publish it */
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+		resched = handle_poll_events(msgq);
+	}
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+void k_msgq_cancel(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, cancel, msgq);
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+	k_spin_unlock(&msgq->lock, key);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_put(struct k_msgq *msgq, const void *data,
 				    k_timeout_t timeout)
@@ -251,6 +460,16 @@ static inline int z_vrfy_k_msgq_put_front(struct k_msgq *msgq, const void *data)
 	return z_impl_k_msgq_put_front(msgq, data);
 }
 #include <zephyr/syscalls/k_msgq_put_front_mrsh.c>
+
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+					 uint32_t num_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_many_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
@@ -340,6 +559,70 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	return result;
 }
 
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data, uint32_t max_msgs,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t count;
+	bool resched = false;
+	int result;
+
+	if (max_msgs == 0U) {
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, max_msgs, timeout);
+
+	if (msgq->used_msgs > 0U) {
+		/* take as many messages as available from queue */
+		count = MIN(max_msgs, msgq->used_msgs);
+		ring_read_msgs(msgq, data, count);
+
+		/* then let in as many waiting writers as there is room for */
+		for (uint32_t i = 0U; i < count; i++) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+			ring_write_msgs(msgq, pending_thread->base.swap_data, 1U);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			resched = true;
+		}
+		result = (int)count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		/* wait for a single message, like k_msgq_get() */
+		_current->base.swap_data = data;
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq, max_msgs, timeout);
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, max_msgs, timeout, result);
+
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, max_msgs, timeout, result);
+
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return result;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 				    k_timeout_t timeout)
@@ -350,6 +633,16 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 	return z_impl_k_msgq_get(msgq, data, timeout);
 }
 #include <zephyr/syscalls/k_msgq_get_mrsh.c>
+
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t max_msgs, k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(data, max_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, max_msgs, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_many_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
@@ -453,6 +746,8 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	/* a reserved slot is discarded too, so that its commit fails */
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
 
 	if (resched) {
 		z_reschedule(&msgq->lock, key);
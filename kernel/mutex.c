@@ -30,6 +30,7 @@
 #include <zephyr/kernel_structs.h>
 #include <zephyr/toolchain.h>
 #include <ksched.h>
+#include <kernel_internal.h>
 #include <kthread.h>
 #include <wait_q.h>
 #include <errno.h>
@@ -102,6 +103,31 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/*
+ * While the owner of a contended mutex runs on another CPU, it is likely to
+ * release it sooner than it takes to pend and be switched back in: poll the
+ * mutex for a while with the lock dropped instead. Stop as soon as another
+ * thread waits though, as ownership then goes straight to that thread.
+ */
+static void mutex_spin_on_owner(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	for (int i = 0; i < CONFIG_MUTEX_ADAPTIVE_SPIN_LIMIT; i++) {
+		if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+		    !z_thread_is_active_elsewhere(mutex->owner)) {
+			return;
+		}
+
+		k_spin_unlock(&lock, *key);
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			return;
+		}
+	}
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -114,6 +140,13 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if ((mutex->lock_count != 0U) && (mutex->owner != _current) &&
+	    !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		mutex_spin_on_owner(mutex, &key);
+	}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
+
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -283,6 +316,26 @@ k_mutex_unlock_return:
 	return 0;
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+int z_mutex_owner_set(struct k_mutex *mutex, struct k_thread *owner)
+{
+	int ret = 0;
+
+	K_SPINLOCK(&lock) {
+		if (mutex->lock_count != 0U) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+
+		mutex->owner = owner;
+		mutex->owner_orig_prio = owner->base.prio;
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 {
@@ -6,6 +6,7 @@
 #include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/math_extras.h>
 #include <ksched.h>
 #include <kthread.h>
 #include <wait_q.h>
@@ -24,6 +25,11 @@ static inline bool pipe_resetting(struct k_pipe *pipe)
 	return (pipe->flags & PIPE_FLAG_RESET) != 0;
 }
 
+static inline bool pipe_claimed(struct k_pipe *pipe)
+{
+	return (pipe->flags & PIPE_FLAG_CLAIMED) != 0;
+}
+
 static inline bool pipe_full(struct k_pipe *pipe)
 {
 	return ring_buf_space_get(&pipe->buf) == 0;
@@ -84,18 +90,60 @@ void z_impl_k_pipe_init(struct k_pipe *pipe, uint8_t *buffer, size_t buffer_size
 	SYS_PORT_TRACING_OBJ_INIT(k_pipe, pipe, buffer, buffer_size);
 }
 
+/* Position within an array of I/O vectors */
+struct pipe_iov_cursor {
+	const struct k_pipe_iovec *iov;
+	size_t iovcnt;
+	size_t offset;
+};
+
+/* Contiguous piece of memory left at the cursor position, 0 if none */
+static inline size_t iov_cursor_get(struct pipe_iov_cursor *cur, uint8_t **ptr)
+{
+	while (cur->iovcnt != 0 && cur->offset == cur->iov->iov_len) {
+		cur->iov++;
+		cur->iovcnt--;
+		cur->offset = 0;
+	}
+	if (cur->iovcnt == 0) {
+		return 0;
+	}
+
+	*ptr = (uint8_t *)cur->iov->iov_base + cur->offset;
+	return cur->iov->iov_len - cur->offset;
+}
+
+static inline void iov_cursor_advance(struct pipe_iov_cursor *cur, size_t len)
+{
+	cur->offset += len;
+}
+
+static int iov_total_len(const struct k_pipe_iovec *iov, size_t iovcnt, size_t *len)
+{
+	*len = 0;
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (size_add_overflow(*len, iov[i].iov_len, len)) {
+			return -EINVAL;
+		}
+	}
+
+	return (*len > INT_MAX) ? -EINVAL : 0;
+}
+
 struct pipe_buf_spec {
-	uint8_t * const data;
+	struct pipe_iov_cursor dst;
 	const size_t len;
 	size_t used;
 };
 
 static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
-				      const uint8_t *data, size_t len)
+				      struct pipe_iov_cursor *src, size_t len)
 {
 	struct k_thread *reader = NULL;
 	struct pipe_buf_spec *reader_buf;
 	size_t copy_size, written = 0;
+	size_t src_len, dst_len;
+	uint8_t *src_ptr, *dst_ptr;
 
 	/*
 	 * Attempt a direct data copy to waiting readers if any.
@@ -112,13 +160,18 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 				K_SPINLOCK_BREAK;
 			}
 
+			/* Scatter/gather as long as both sides have room */
 			reader_buf = reader->base.swap_data;
-			copy_size = min(len - written,
-					reader_buf->len - reader_buf->used);
-			memcpy(&reader_buf->data[reader_buf->used],
-			       &data[written], copy_size);
-			written += copy_size;
-			reader_buf->used += copy_size;
+			while (written < len && reader_buf->used < reader_buf->len) {
+				src_len = iov_cursor_get(src, &src_ptr);
+				dst_len = iov_cursor_get(&reader_buf->dst, &dst_ptr);
+				copy_size = min(src_len, dst_len);
+				memcpy(dst_ptr, src_ptr, copy_size);
+				iov_cursor_advance(src, copy_size);
+				iov_cursor_advance(&reader_buf->dst, copy_size);
+				written += copy_size;
+				reader_buf->used += copy_size;
+			}
 
 			if (reader_buf->used < reader_buf->len) {
 				/* This reader wants more: don't unpend. */
@@ -144,16 +197,52 @@ static size_t copy_to_pending_readers(struct k_pipe *pipe, bool *need_resched,
 	return written;
 }
 
-int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_timeout_t timeout)
+static size_t put_from_cursor(struct k_pipe *pipe, struct pipe_iov_cursor *src, size_t len)
+{
+	size_t chunk, put, written = 0;
+	uint8_t *ptr;
+
+	while (written < len) {
+		chunk = iov_cursor_get(src, &ptr);
+		put = ring_buf_put(&pipe->buf, ptr, chunk);
+		iov_cursor_advance(src, put);
+		written += put;
+		if (put < chunk) {
+			break;
+		}
+	}
+
+	return written;
+}
+
+static size_t get_to_cursor(struct k_pipe *pipe, struct pipe_iov_cursor *dst, size_t len)
 {
+	size_t chunk, got, read = 0;
+	uint8_t *ptr;
+
+	while (read < len) {
+		chunk = iov_cursor_get(dst, &ptr);
+		got = ring_buf_get(&pipe->buf, ptr, chunk);
+		iov_cursor_advance(dst, got);
+		read += got;
+		if (got < chunk) {
+			break;
+		}
+	}
+
+	return read;
+}
+
+static int pipe_write(struct k_pipe *pipe, const struct k_pipe_iovec *iov, size_t iovcnt,
+		      size_t len, k_timeout_t timeout)
+{
+	struct pipe_iov_cursor src = { iov, iovcnt, 0 };
 	int rc;
 	size_t written = 0;
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 	bool need_resched = false;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, write, pipe, data, len, timeout);
-
 	if (unlikely(pipe_resetting(pipe))) {
 		rc = -ECANCELED;
 		goto exit;
@@ -179,8 +268,7 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 				need_resched = z_sched_wake_all(&pipe->data, 0, NULL);
 			} else if (pipe->waiting != 0) {
 				written += copy_to_pending_readers(pipe, &need_resched,
-								   &data[written],
-								   len - written);
+								   &src, len - written);
 				if (written >= len) {
 					rc = written;
 					break;
@@ -193,7 +281,7 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 							 K_POLL_STATE_PIPE_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
 
-		written += ring_buf_put(&pipe->buf, &data[written], len - written);
+		written += put_from_cursor(pipe, &src, len - written);
 		if (likely(written == len)) {
 			rc = written;
 			break;
@@ -208,7 +296,6 @@ int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 		}
 	}
 exit:
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, write, pipe, rc);
 	if (need_resched) {
 		z_reschedule(&pipe->lock, key);
 	} else {
@@ -217,28 +304,32 @@ exit:
 	return rc;
 }
 
-int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout_t timeout)
+static int pipe_read(struct k_pipe *pipe, const struct k_pipe_iovec *iov, size_t iovcnt,
+		     size_t len, k_timeout_t timeout)
 {
-	struct pipe_buf_spec buf = { data, len, 0 };
+	struct pipe_buf_spec buf = { { iov, iovcnt, 0 }, len, 0 };
 	int rc;
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 	bool need_resched = false;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, read, pipe, data, len, timeout);
-
 	if (unlikely(pipe_resetting(pipe))) {
 		rc = -ECANCELED;
 		goto exit;
 	}
 
 	for (;;) {
+		if (unlikely(pipe_claimed(pipe))) {
+			rc = buf.used ? buf.used : -EBUSY;
+			break;
+		}
+
 		if (pipe_full(pipe)) {
 			/* One or more pending writers may exist. */
 			need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
 		}
 
-		buf.used += ring_buf_get(&pipe->buf, &data[buf.used], len - buf.used);
+		buf.used += get_to_cursor(pipe, &buf.dst, len - buf.used);
 		if (likely(buf.used == len)) {
 			rc = buf.used;
 			break;
@@ -261,7 +352,122 @@ int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout
 		}
 	}
 exit:
+	if (need_resched) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+	return rc;
+}
+
+int z_impl_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_timeout_t timeout)
+{
+	const struct k_pipe_iovec iov = { (void *)data, len };
+	int rc;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, write, pipe, data, len, timeout);
+
+	rc = pipe_write(pipe, &iov, 1, len, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, write, pipe, rc);
+
+	return rc;
+}
+
+int z_impl_k_pipe_read(struct k_pipe *pipe, uint8_t *data, size_t len, k_timeout_t timeout)
+{
+	const struct k_pipe_iovec iov = { data, len };
+	int rc;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, read, pipe, data, len, timeout);
+
+	rc = pipe_read(pipe, &iov, 1, len, timeout);
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, read, pipe, rc);
+
+	return rc;
+}
+
+int z_impl_k_pipe_writev(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			 size_t iovcnt, k_timeout_t timeout)
+{
+	size_t len;
+	int rc;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, writev, pipe, iov, iovcnt, timeout);
+
+	if (iov_total_len(iov, iovcnt, &len) != 0) {
+		rc = -EINVAL;
+	} else {
+		rc = pipe_write(pipe, iov, iovcnt, len, timeout);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, writev, pipe, rc);
+
+	return rc;
+}
+
+int z_impl_k_pipe_readv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			size_t iovcnt, k_timeout_t timeout)
+{
+	size_t len;
+	int rc;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, readv, pipe, iov, iovcnt, timeout);
+
+	if (iov_total_len(iov, iovcnt, &len) != 0) {
+		rc = -EINVAL;
+	} else {
+		rc = pipe_read(pipe, iov, iovcnt, len, timeout);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, readv, pipe, rc);
+
+	return rc;
+}
+
+int k_pipe_peek(struct k_pipe *pipe, uint8_t **data, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	int rc;
+
+	if (unlikely(pipe_resetting(pipe))) {
+		rc = -ECANCELED;
+	} else if (pipe_empty(pipe)) {
+		rc = pipe_closed(pipe) && !pipe_claimed(pipe) ? -EPIPE : -EAGAIN;
+	} else {
+		rc = ring_buf_get_claim(&pipe->buf, data, MIN(len, INT_MAX));
+		if (rc > 0) {
+			pipe->flags |= PIPE_FLAG_CLAIMED;
+		}
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return rc;
+}
+
+int k_pipe_consume(struct k_pipe *pipe, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool need_resched = false;
+	int rc;
+
+	if (!pipe_claimed(pipe)) {
+		rc = -EINVAL;
+		goto exit;
+	}
+
+	if (len > 0 && pipe_full(pipe)) {
+		/* One or more pending writers may exist. */
+		need_resched = z_sched_wake_all(&pipe->space, 0, NULL);
+	}
+
+	rc = ring_buf_get_finish(&pipe->buf, len);
+	if (rc == 0) {
+		pipe->flags &= ~PIPE_FLAG_CLAIMED;
+	}
+exit:
 	if (need_resched) {
 		z_reschedule(&pipe->lock, key);
 	} else {
@@ -275,6 +481,7 @@ void z_impl_k_pipe_reset(struct k_pipe *pipe)
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, reset, pipe);
 	K_SPINLOCK(&pipe->lock) {
 		ring_buf_reset(&pipe->buf);
+		pipe->flags &= ~PIPE_FLAG_CLAIMED;
 		if (likely(pipe->waiting != 0)) {
 			pipe->flags |= PIPE_FLAG_RESET;
 			z_sched_wake_all(&pipe->data, 0, NULL);
@@ -288,7 +495,8 @@ void z_impl_k_pipe_close(struct k_pipe *pipe)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, close, pipe);
 	K_SPINLOCK(&pipe->lock) {
-		pipe->flags = 0;
+		/* Data claimed in place stays valid until consumed */
+		pipe->flags &= PIPE_FLAG_CLAIMED;
 		z_sched_wake_all(&pipe->data, 0, NULL);
 		z_sched_wake_all(&pipe->space, 0, NULL);
 	}
@@ -323,6 +531,75 @@ int z_vrfy_k_pipe_write(struct k_pipe *pipe, const uint8_t *data, size_t len, k_
 }
 #include <zephyr/syscalls/k_pipe_write_mrsh.c>
 
+/* Vectors up to this count are copied to the stack, larger arrays to the
+ * calling thread's resource pool.
+ */
+#define PIPE_VRFY_IOV_STACK_CNT 8
+
+static int pipe_vrfy_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov, size_t iovcnt,
+			 k_timeout_t timeout, bool write)
+{
+	struct k_pipe_iovec stack_iov[PIPE_VRFY_IOV_STACK_CNT];
+	struct k_pipe_iovec *iov_copy = stack_iov;
+	size_t bounds;
+	int rc;
+
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_VERIFY_MSG(!size_mul_overflow(iovcnt, sizeof(*iov), &bounds),
+				    "iovcnt too large"));
+
+	if (iovcnt > ARRAY_SIZE(stack_iov)) {
+		iov_copy = z_thread_malloc(bounds);
+		if (iov_copy == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	/* Validate a copy so the vectors can't change under our feet */
+	if (K_SYSCALL_MEMORY_READ(iov, bounds)) {
+		goto oops;
+	}
+	(void)memcpy(iov_copy, iov, bounds);
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (write ? K_SYSCALL_MEMORY_READ(iov_copy[i].iov_base, iov_copy[i].iov_len) :
+			    K_SYSCALL_MEMORY_WRITE(iov_copy[i].iov_base, iov_copy[i].iov_len)) {
+			goto oops;
+		}
+	}
+
+	rc = write ? z_impl_k_pipe_writev(pipe, iov_copy, iovcnt, timeout) :
+		     z_impl_k_pipe_readv(pipe, iov_copy, iovcnt, timeout);
+
+	if (iov_copy != stack_iov) {
+		k_free(iov_copy);
+	}
+
+	return rc;
+
+oops:
+	if (iov_copy != stack_iov) {
+		k_free(iov_copy);
+	}
+	K_OOPS(1);
+
+	CODE_UNREACHABLE;
+}
+
+int z_vrfy_k_pipe_writev(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			 size_t iovcnt, k_timeout_t timeout)
+{
+	return pipe_vrfy_iov(pipe, iov, iovcnt, timeout, true);
+}
+#include <zephyr/syscalls/k_pipe_writev_mrsh.c>
+
+int z_vrfy_k_pipe_readv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+			size_t iovcnt, k_timeout_t timeout)
+{
+	return pipe_vrfy_iov(pipe, iov, iovcnt, timeout, false);
+}
+#include <zephyr/syscalls/k_pipe_readv_mrsh.c>
+
 void z_vrfy_k_pipe_reset(struct k_pipe *pipe)
 {
 	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
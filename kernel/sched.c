@@ -324,6 +324,11 @@ static struct _cpu *thread_active_elsewhere(struct k_thread *thread)
 	return NULL;
 }
 
+bool z_thread_is_active_elsewhere(struct k_thread *thread)
+{
+	return thread_active_elsewhere(thread) != NULL;
+}
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
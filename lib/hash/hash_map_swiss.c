@@ -0,0 +1,524 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_swiss.h>
+#include <zephyr/sys/util.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Each bucket has a control byte, stored after all the entries. Used buckets
+ * have 7 bits of the hash of their key as control byte, so below 0x80.
+ */
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xFE
+
+struct swiss_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_config, max_size) ==
+	     offsetof(struct sys_hashmap_config, max_size));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_config, load_factor) ==
+	     offsetof(struct sys_hashmap_config, load_factor));
+BUILD_ASSERT(offsetof(struct sys_hashmap_swiss_config, initial_n_buckets) ==
+	     offsetof(struct sys_hashmap_config, initial_n_buckets));
+
+/*
+ * Control bytes are probed a group at a time. A group match is a mask with one
+ * bit per matching bucket, GROUP_MASK_SHIFT giving the number of bits per bucket.
+ */
+#if defined(__SSE2__)
+
+#define GROUP_WIDTH	 16
+#define GROUP_MASK_SHIFT 0
+typedef uint32_t group_mask_t;
+
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	__m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+
+	return (group_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline group_mask_t group_match_free(const uint8_t *ctrl)
+{
+	/* only empty and deleted buckets have the top bit set */
+	return (group_mask_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+}
+
+static inline unsigned int group_mask_leading(group_mask_t mask)
+{
+	return __builtin_clz(mask) - (32 - GROUP_WIDTH);
+}
+
+#else
+
+#define GROUP_WIDTH	 8
+#define GROUP_MASK_SHIFT 3
+typedef uint64_t group_mask_t;
+
+#define GROUP_LSBS 0x0101010101010101ULL
+#define GROUP_MSBS 0x8080808080808080ULL
+
+/*
+ * Sets the top bit of the bytes equal to h2. The byte following a matching one may also match,
+ * which only costs a key comparison.
+ */
+static inline group_mask_t group_match(const uint8_t *ctrl, uint8_t h2)
+{
+	uint64_t x = sys_get_le64(ctrl) ^ (GROUP_LSBS * h2);
+
+	return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+}
+
+static inline group_mask_t group_match_empty(const uint8_t *ctrl)
+{
+	uint64_t group = sys_get_le64(ctrl);
+
+	/* the top bit set and the second lowest bit clear is only CTRL_EMPTY */
+	return group & ~(group << 6) & GROUP_MSBS;
+}
+
+static inline group_mask_t group_match_free(const uint8_t *ctrl)
+{
+	return sys_get_le64(ctrl) & GROUP_MSBS;
+}
+
+static inline unsigned int group_mask_leading(group_mask_t mask)
+{
+	return __builtin_clzll(mask) >> GROUP_MASK_SHIFT;
+}
+
+#endif
+
+static inline unsigned int group_mask_first(group_mask_t mask)
+{
+	return __builtin_ctzll(mask) >> GROUP_MASK_SHIFT;
+}
+
+/*
+ * The hash is scrambled so that weak hash functions, such as the identity, still spread the
+ * keys over the buckets. The bits selecting the first group and those stored in the control
+ * byte are kept apart, so that colliding control bytes in a group are rare.
+ */
+#define HASH_SCRAMBLE 0x9E3779B1U
+#define H1(_hash)     ((_hash) >> 7)
+#define H2(_hash)     ((uint8_t)((_hash) >> 25))
+
+static ALWAYS_INLINE uint32_t swiss_hash(const struct sys_hashmap *map, uint64_t key, bool blob)
+{
+	uint32_t hash;
+
+	if (blob) {
+		hash = ((const struct sys_hashmap_swiss_config *)map->config)->key_hash(key);
+	} else {
+		hash = map->hash_func(&key, sizeof(key));
+	}
+
+	return hash * HASH_SCRAMBLE;
+}
+
+static ALWAYS_INLINE bool swiss_key_eq(const struct sys_hashmap *map, uint64_t key1,
+				       uint64_t key2, bool blob)
+{
+	if (blob) {
+		return ((const struct sys_hashmap_swiss_config *)map->config)->key_eq(key1, key2);
+	}
+
+	return key1 == key2;
+}
+
+/* The first GROUP_WIDTH - 1 control bytes are repeated at the end, to load groups anywhere */
+static inline size_t swiss_alloc_size(size_t n_buckets)
+{
+	return n_buckets * sizeof(struct swiss_entry) + n_buckets + GROUP_WIDTH - 1;
+}
+
+static inline uint8_t *swiss_ctrl(void *buckets, size_t n_buckets)
+{
+	return (uint8_t *)((struct swiss_entry *)buckets + n_buckets);
+}
+
+static inline void swiss_set_ctrl(uint8_t *ctrl, size_t n_buckets, size_t i, uint8_t value)
+{
+	ctrl[i] = value;
+	ctrl[((i - (GROUP_WIDTH - 1)) & (n_buckets - 1)) + (GROUP_WIDTH - 1)] = value;
+}
+
+/*
+ * Groups are probed with a growing stride, which visits each of them once as the number of
+ * buckets is a power of two.
+ */
+#define SWISS_PROBE_FOREACH(_hash, _n_buckets, _pos)                                               \
+	for (size_t _pos = H1(_hash) & ((_n_buckets) - 1), _stride = 0;                            \
+	     _stride < (_n_buckets);                                                               \
+	     _stride += GROUP_WIDTH, _pos = (_pos + _stride) & ((_n_buckets) - 1))
+
+static ALWAYS_INLINE struct swiss_entry *sys_hashmap_swiss_find(const struct sys_hashmap *map,
+								  uint64_t key, uint32_t hash,
+								  bool blob)
+{
+	const size_t n_buckets = map->data->n_buckets;
+	struct swiss_entry *const entries = map->data->buckets;
+	const uint8_t *ctrl;
+	group_mask_t match;
+	size_t i;
+
+	if (n_buckets == 0) {
+		return NULL;
+	}
+
+	ctrl = swiss_ctrl(entries, n_buckets);
+
+	SWISS_PROBE_FOREACH(hash, n_buckets, pos) {
+		for (match = group_match(&ctrl[pos], H2(hash)); match != 0; match &= match - 1) {
+			i = (pos + group_mask_first(match)) & (n_buckets - 1);
+			if (swiss_key_eq(map, entries[i].key, key, blob)) {
+				return &entries[i];
+			}
+		}
+
+		/* the key would have been inserted in the first empty bucket */
+		if (group_match_empty(&ctrl[pos]) != 0) {
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+static size_t sys_hashmap_swiss_find_free(const uint8_t *ctrl, size_t n_buckets, uint32_t hash)
+{
+	group_mask_t match;
+
+	SWISS_PROBE_FOREACH(hash, n_buckets, pos) {
+		match = group_match_free(&ctrl[pos]);
+		if (match != 0) {
+			return (pos + group_mask_first(match)) & (n_buckets - 1);
+		}
+	}
+
+	return SIZE_MAX;
+}
+
+static int sys_hashmap_swiss_rehash(struct sys_hashmap *map, bool grow, bool blob)
+{
+	size_t j;
+	size_t new_n_buckets = 0;
+	struct swiss_entry *new_buckets;
+	uint8_t *new_ctrl;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *const old_buckets = data->buckets;
+	const size_t old_n_buckets = data->n_buckets;
+	const uint8_t *old_ctrl;
+
+	if (!sys_hashmap_should_rehash(map, grow, data->n_tombstones, &new_n_buckets)) {
+		return 0;
+	}
+
+	/* a table holds at least one group */
+	if (new_n_buckets != 0 && new_n_buckets < GROUP_WIDTH) {
+		new_n_buckets = GROUP_WIDTH;
+	}
+
+	if (new_n_buckets == old_n_buckets) {
+		return 0;
+	}
+
+	new_buckets = NULL;
+	if (new_n_buckets != 0) {
+		new_buckets = map->alloc_func(NULL, swiss_alloc_size(new_n_buckets));
+		if (new_buckets == NULL) {
+			return -ENOMEM;
+		}
+
+		new_ctrl = swiss_ctrl(new_buckets, new_n_buckets);
+		memset(new_ctrl, CTRL_EMPTY, new_n_buckets + GROUP_WIDTH - 1);
+
+		/* re-insert all entries, which are known to be distinct */
+		old_ctrl = old_n_buckets != 0 ? swiss_ctrl(old_buckets, old_n_buckets) : NULL;
+		for (size_t i = 0; i < old_n_buckets; ++i) {
+			uint32_t hash;
+
+			if (old_ctrl[i] & CTRL_EMPTY) {
+				continue;
+			}
+
+			hash = swiss_hash(map, old_buckets[i].key, blob);
+			j = sys_hashmap_swiss_find_free(new_ctrl, new_n_buckets, hash);
+			if (j == SIZE_MAX) {
+				/* only possible with a load factor above 100, keep the old table */
+				map->alloc_func(new_buckets, 0);
+				return -ENOSPC;
+			}
+
+			swiss_set_ctrl(new_ctrl, new_n_buckets, j, H2(hash));
+			new_buckets[j] = old_buckets[i];
+		}
+	}
+
+	data->buckets = new_buckets;
+	data->n_buckets = new_n_buckets;
+	data->n_tombstones = 0;
+
+	/* free the old Hashmap */
+	map->alloc_func(old_buckets, 0);
+
+	return 0;
+}
+
+static void sys_hashmap_swiss_iter_next(struct sys_hashmap_iterator *it)
+{
+	size_t i;
+	const struct sys_hashmap *map = (const struct sys_hashmap *)it->map;
+	struct swiss_entry *buckets = map->data->buckets;
+	const uint8_t *ctrl = swiss_ctrl(buckets, map->data->n_buckets);
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	if (it->pos == 0) {
+		it->state = buckets;
+	}
+
+	i = (struct swiss_entry *)it->state - buckets;
+	__ASSERT(i < map->data->n_buckets, "Invalid iterator state %p", it->state);
+
+	for (; i < map->data->n_buckets; ++i) {
+		if ((ctrl[i] & CTRL_EMPTY) == 0) {
+			it->state = &buckets[i + 1];
+			it->key = buckets[i].key;
+			it->value = buckets[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+static ALWAYS_INLINE int sys_hashmap_swiss_insert_common(struct sys_hashmap *map, uint64_t key,
+							  uint64_t value, uint64_t *old_value,
+							  bool blob)
+{
+	int ret;
+	size_t i;
+	uint8_t *ctrl;
+	struct swiss_entry *entry;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const uint32_t hash = swiss_hash(map, key, blob);
+
+	entry = sys_hashmap_swiss_find(map, key, hash, blob);
+	if (entry != NULL) {
+		if (old_value != NULL) {
+			*old_value = entry->value;
+		}
+
+		entry->value = value;
+		return 0;
+	}
+
+	if (data->size >= map->config->max_size) {
+		return -ENOSPC;
+	}
+
+	ret = sys_hashmap_swiss_rehash(map, true, blob);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ctrl = swiss_ctrl(data->buckets, data->n_buckets);
+	i = sys_hashmap_swiss_find_free(ctrl, data->n_buckets, hash);
+	if (i == SIZE_MAX) {
+		/* only possible with a load factor above 100 */
+		return -ENOSPC;
+	}
+
+	if (ctrl[i] == CTRL_DELETED) {
+		--data->n_tombstones;
+	}
+
+	swiss_set_ctrl(ctrl, data->n_buckets, i, H2(hash));
+	entry = &((struct swiss_entry *)data->buckets)[i];
+	entry->key = key;
+	entry->value = value;
+	++data->size;
+
+	return 1;
+}
+
+static ALWAYS_INLINE bool sys_hashmap_swiss_remove_common(struct sys_hashmap *map, uint64_t key,
+							   uint64_t *value, bool blob)
+{
+	size_t i;
+	uint8_t *ctrl;
+	group_mask_t empty_before;
+	group_mask_t empty_after;
+	struct swiss_entry *entry;
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	const size_t mask = data->n_buckets - 1;
+
+	entry = sys_hashmap_swiss_find(map, key, swiss_hash(map, key, blob), blob);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	i = entry - (struct swiss_entry *)data->buckets;
+	ctrl = swiss_ctrl(data->buckets, data->n_buckets);
+
+	/*
+	 * The bucket can be emptied if no group loaded by a lookup ever saw it full without an
+	 * empty bucket, i.e. if there are empty buckets less than a group width apart around it.
+	 */
+	empty_before = group_match_empty(&ctrl[(i - GROUP_WIDTH) & mask]);
+	empty_after = group_match_empty(&ctrl[i]);
+	if (empty_before != 0 && empty_after != 0 &&
+	    group_mask_first(empty_after) + group_mask_leading(empty_before) < GROUP_WIDTH) {
+		swiss_set_ctrl(ctrl, data->n_buckets, i, CTRL_EMPTY);
+	} else {
+		swiss_set_ctrl(ctrl, data->n_buckets, i, CTRL_DELETED);
+		++data->n_tombstones;
+	}
+
+	--data->size;
+
+	/* ignore a possible -ENOMEM or -ENOSPC since the table will remain intact */
+	(void)sys_hashmap_swiss_rehash(map, false, blob);
+
+	return true;
+}
+
+static ALWAYS_INLINE bool sys_hashmap_swiss_get_common(const struct sys_hashmap *map,
+							uint64_t key, uint64_t *value, bool blob)
+{
+	struct swiss_entry *entry;
+
+	entry = sys_hashmap_swiss_find(map, key, swiss_hash(map, key, blob), blob);
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = entry->value;
+	}
+
+	return true;
+}
+
+/*
+ * Swiss Table Hashmap API
+ */
+
+static void sys_hashmap_swiss_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_swiss_iter_next;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_swiss_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb,
+				    void *cookie)
+{
+	struct sys_hashmap_swiss_data *data = (struct sys_hashmap_swiss_data *)map->data;
+	struct swiss_entry *buckets = data->buckets;
+	const uint8_t *ctrl;
+
+	if (buckets != NULL) {
+		ctrl = swiss_ctrl(buckets, data->n_buckets);
+
+		for (size_t i = 0, j = 0; cb != NULL && i < data->n_buckets && j < data->size;
+		     ++i) {
+			if ((ctrl[i] & CTRL_EMPTY) == 0) {
+				cb(buckets[i].key, buckets[i].value, cookie);
+				++j;
+			}
+		}
+
+		map->alloc_func(buckets, 0);
+		data->buckets = NULL;
+	}
+
+	data->n_buckets = 0;
+	data->size = 0;
+	data->n_tombstones = 0;
+}
+
+static int sys_hashmap_swiss_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				    uint64_t *old_value)
+{
+	return sys_hashmap_swiss_insert_common(map, key, value, old_value, false);
+}
+
+static bool sys_hashmap_swiss_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	return sys_hashmap_swiss_remove_common(map, key, value, false);
+}
+
+static bool sys_hashmap_swiss_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	return sys_hashmap_swiss_get_common(map, key, value, false);
+}
+
+static int sys_hashmap_swiss_blob_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+					 uint64_t *old_value)
+{
+	return sys_hashmap_swiss_insert_common(map, key, value, old_value, true);
+}
+
+static bool sys_hashmap_swiss_blob_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	return sys_hashmap_swiss_remove_common(map, key, value, true);
+}
+
+static bool sys_hashmap_swiss_blob_get(const struct sys_hashmap *map, uint64_t key,
+				       uint64_t *value)
+{
+	return sys_hashmap_swiss_get_common(map, key, value, true);
+}
+
+const struct sys_hashmap_api sys_hashmap_swiss_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_insert,
+	.remove = sys_hashmap_swiss_remove,
+	.get = sys_hashmap_swiss_get,
+};
+
+const struct sys_hashmap_api sys_hashmap_swiss_blob_api = {
+	.iter = sys_hashmap_swiss_iter,
+	.clear = sys_hashmap_swiss_clear,
+	.insert = sys_hashmap_swiss_blob_insert,
+	.remove = sys_hashmap_swiss_blob_remove,
+	.get = sys_hashmap_swiss_blob_get,
+};
@@ -8,6 +8,7 @@
 #include <zephyr/sys/mutex.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
+#include <kernel_internal.h>
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -30,6 +31,73 @@ static bool check_sys_mutex_addr(struct sys_mutex *addr)
 	return K_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Serializes changes to sys_mutex::val made by the kernel */
+static struct k_spinlock fast_path_lock;
+
+#define KERNEL_USERS_VAL(n) (((atomic_val_t)(n) << 1) | 1)
+#define KERNEL_USERS(val) ((atomic_val_t)(val) >> 1)
+#define IS_KERNEL_USERS_VAL(val) (((val) & 1) != 0)
+
+static bool fast_path_owner_valid(struct k_thread *owner)
+{
+	/* The mutex memory belongs to user mode, don't trust it */
+	return k_object_validate(k_object_find(owner), K_OBJ_THREAD,
+				 _OBJ_INIT_TRUE) == 0;
+}
+
+/*
+ * Switch the mutex over to the kernel mutex for the calling thread, so it
+ * can wait for it with priority inheritance. Returns whether the calling
+ * thread was added to the kernel users of the mutex, which is not the case
+ * when it already owns it.
+ */
+static bool kernel_users_enter(struct sys_mutex *mutex, struct k_mutex *kernel_mutex)
+{
+	k_spinlock_key_t key = k_spin_lock(&fast_path_lock);
+	struct k_thread *owner;
+	atomic_val_t val, users;
+	bool counted;
+
+	do {
+		val = atomic_get(&mutex->val);
+		owner = NULL;
+		if (val == 0) {
+			users = 0;
+		} else if (IS_KERNEL_USERS_VAL(val)) {
+			users = KERNEL_USERS(val);
+		} else {
+			/* Locked from user mode, the owner becomes a kernel user */
+			owner = (struct k_thread *)val;
+			users = 1;
+		}
+
+		counted = (owner != _current) && (kernel_mutex->owner != _current);
+		if (counted) {
+			users++;
+		}
+	} while (!atomic_cas(&mutex->val, val, KERNEL_USERS_VAL(users)));
+
+	if ((owner != NULL) && fast_path_owner_valid(owner)) {
+		(void)z_mutex_owner_set(kernel_mutex, owner);
+	}
+
+	k_spin_unlock(&fast_path_lock, key);
+
+	return counted;
+}
+
+static void kernel_users_exit(struct sys_mutex *mutex)
+{
+	K_SPINLOCK(&fast_path_lock) {
+		atomic_val_t users = KERNEL_USERS(atomic_get(&mutex->val)) - 1;
+
+		/* Nobody is left using the kernel mutex: back to the fast path */
+		atomic_set(&mutex->val, (users == 0) ? 0 : KERNEL_USERS_VAL(users));
+	}
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
@@ -38,7 +106,18 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	bool counted = kernel_users_enter(mutex, kernel_mutex);
+	int ret = k_mutex_lock(kernel_mutex, timeout);
+
+	if ((ret != 0) && counted) {
+		kernel_users_exit(mutex);
+	}
+
+	return ret;
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +135,40 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
-	if ((kernel_mutex == NULL) || (kernel_mutex->lock_count == 0)) {
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	k_spinlock_key_t key;
+	atomic_val_t val;
+	int ret;
+
+	/* A contender may have published the kernel users value without
+	 * having handed the ownership over to the kernel mutex yet
+	 */
+	key = k_spin_lock(&fast_path_lock);
+	val = atomic_get(&mutex->val);
+	k_spin_unlock(&fast_path_lock, key);
+
+	if (!IS_KERNEL_USERS_VAL(val)) {
+		/* Unlocked, or locked from user mode by another thread */
+		return (val == 0) ? -EINVAL : -EPERM;
+	}
+
+	ret = k_mutex_unlock(kernel_mutex);
+	if ((ret == 0) && (kernel_mutex->owner != _current)) {
+		kernel_users_exit(mutex);
+	}
+
+	return ret;
+#else
+	if (kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
@@ -9,6 +9,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <math.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/util.h>
 #include <stdbool.h>
@@ -18,6 +19,10 @@
 
 #include <zephyr/data/json.h>
 
+#ifdef CONFIG_NET_BUF
+#include <zephyr/net_buf.h>
+#endif
+
 struct json_obj_key_value {
 	const char *key;
 	size_t key_len;
@@ -1268,6 +1273,663 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+#ifdef CONFIG_JSON_LIBRARY_STREAM
+
+enum json_stream_state {
+	/* Expecting a value */
+	JSON_STREAM_VALUE,
+	/* After '[', expecting a value or ']' */
+	JSON_STREAM_ARR_FIRST,
+	/* After '{', expecting a key or '}' */
+	JSON_STREAM_OBJ_FIRST,
+	/* After ',' in an object, expecting a key */
+	JSON_STREAM_KEY_START,
+	JSON_STREAM_KEY,
+	JSON_STREAM_COLON,
+	/* After a value, expecting ',' or the end of the container */
+	JSON_STREAM_NEXT,
+	JSON_STREAM_STRING,
+	JSON_STREAM_NUMBER,
+	JSON_STREAM_LITERAL,
+	JSON_STREAM_DONE,
+};
+
+/* Escape states, after a backslash then while reading \uXXXX digits */
+#define JSON_STREAM_ESCAPE	  1
+#define JSON_STREAM_ESCAPE_HEX	  2
+#define JSON_STREAM_ESCAPE_HEX_END (JSON_STREAM_ESCAPE_HEX + 4)
+
+static void stream_init(struct json_stream_parser *parser, enum json_tokens root)
+{
+	memset(parser, 0, sizeof(*parser));
+	parser->root = root;
+	parser->state = JSON_STREAM_VALUE;
+}
+
+void json_stream_obj_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, size_t descr_len, void *val)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(parser->result) * CHAR_BIT - 1));
+
+	stream_init(parser, JSON_TOK_OBJECT_START);
+
+	/* Root descriptor, only read to push the first frame */
+	parser->stack[0].descr = descr;
+	parser->stack[0].val = val;
+	parser->stack[0].obj.descr_len = descr_len;
+}
+
+void json_stream_arr_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, void *val)
+{
+	stream_init(parser, JSON_TOK_ARRAY_START);
+
+	parser->stack[0].descr = descr;
+	parser->stack[0].val = val;
+}
+
+static bool stream_skipping(const struct json_stream_parser *parser)
+{
+	return parser->skip_depth > 0;
+}
+
+static bool stream_in_array(const struct json_stream_parser *parser)
+{
+	if (stream_skipping(parser)) {
+		return (parser->skip_arrays & BIT(parser->skip_depth - 1)) != 0;
+	}
+
+	return parser->stack[parser->depth - 1].is_array;
+}
+
+static int stream_push_obj(struct json_stream_parser *parser,
+			   const struct json_obj_descr *descr, size_t descr_len, void *val)
+{
+	struct json_stream_frame *frame;
+
+	if (parser->depth == ARRAY_SIZE(parser->stack)) {
+		return -ENOMEM;
+	}
+
+	frame = &parser->stack[parser->depth++];
+	frame->descr = descr;
+	frame->val = val;
+	frame->obj.decoded = 0;
+	frame->obj.descr_len = descr_len;
+	frame->obj.current = -1;
+	frame->is_array = false;
+
+	return 0;
+}
+
+/* Same as the beginning of arr_parse() */
+static int stream_push_arr(struct json_stream_parser *parser,
+			   const struct json_obj_descr *elem_descr, size_t max_elements,
+			   void *field, void *val)
+{
+	struct json_stream_frame *frame;
+
+	if (parser->depth == ARRAY_SIZE(parser->stack)) {
+		return -ENOMEM;
+	}
+
+	frame = &parser->stack[parser->depth++];
+	frame->arr.elements = (size_t *)((char *)val + elem_descr->offset);
+
+	/* For nested arrays, skip parent descriptor to get elements */
+	if (elem_descr->type == JSON_TOK_ARRAY_START) {
+		elem_descr = elem_descr->array.element_descr;
+	}
+
+	*frame->arr.elements = 0;
+	frame->descr = elem_descr;
+	frame->val = field;
+	frame->arr.remaining = max_elements;
+	frame->arr.elem_size = get_elem_size(elem_descr);
+	frame->is_array = true;
+
+	__ASSERT_NO_MSG(frame->arr.elem_size > 0);
+
+	return 0;
+}
+
+static int stream_push_skip(struct json_stream_parser *parser, bool is_array)
+{
+	if (parser->skip_depth == sizeof(parser->skip_arrays) * CHAR_BIT) {
+		return -ENOMEM;
+	}
+
+	WRITE_BIT(parser->skip_arrays, parser->skip_depth, is_array);
+	parser->skip_depth++;
+
+	return 0;
+}
+
+/* Account for the end of a value in the container holding it */
+static void stream_value_end(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame;
+
+	parser->state = JSON_STREAM_NEXT;
+
+	if (stream_skipping(parser)) {
+		return;
+	}
+
+	if (parser->depth == 0) {
+		parser->state = JSON_STREAM_DONE;
+		return;
+	}
+
+	frame = &parser->stack[parser->depth - 1];
+	if (frame->is_array) {
+		(*frame->arr.elements)++;
+		frame->arr.remaining--;
+		frame->val = (char *)frame->val + frame->arr.elem_size;
+	} else if (frame->obj.current >= 0) {
+		frame->obj.decoded |= (int64_t)1 << frame->obj.current;
+	}
+}
+
+static int stream_close(struct json_stream_parser *parser, bool is_array)
+{
+	if (stream_in_array(parser) != is_array) {
+		return -EINVAL;
+	}
+
+	if (stream_skipping(parser)) {
+		parser->skip_depth--;
+	} else {
+		parser->depth--;
+		if (parser->depth == 0 && !is_array) {
+			parser->result = parser->stack[0].obj.decoded;
+		}
+	}
+
+	stream_value_end(parser);
+
+	return 0;
+}
+
+static enum json_tokens stream_value_type(int chr)
+{
+	switch (chr) {
+	case '{':
+		return JSON_TOK_OBJECT_START;
+	case '[':
+		return JSON_TOK_ARRAY_START;
+	case '"':
+		return JSON_TOK_STRING;
+	case 't':
+		return JSON_TOK_TRUE;
+	case 'f':
+		return JSON_TOK_FALSE;
+	case 'n':
+		return JSON_TOK_NULL;
+#ifdef CONFIG_JSON_LIBRARY_FP_SUPPORT
+	case 'N':
+	case 'I':
+		return JSON_TOK_NUMBER;
+#endif
+	default:
+		if (chr == '-' || isdigit((unsigned char)chr) != 0) {
+			return JSON_TOK_NUMBER;
+		}
+
+		return JSON_TOK_ERROR;
+	}
+}
+
+static bool stream_supported(enum json_tokens type)
+{
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+	case JSON_TOK_ARRAY_START:
+	case JSON_TOK_STRING_BUF:
+	case JSON_TOK_NUMBER:
+	case JSON_TOK_INT:
+	case JSON_TOK_UINT:
+	case JSON_TOK_INT64:
+	case JSON_TOK_UINT64:
+	case JSON_TOK_FLOAT_FP:
+	case JSON_TOK_DOUBLE_FP:
+	case JSON_TOK_TRUE:
+	case JSON_TOK_FALSE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* Find where the value starting now goes, parser->descr is left NULL to skip it */
+static int stream_value_target(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame = &parser->stack[parser->depth - 1];
+
+	parser->descr = NULL;
+
+	if (stream_skipping(parser)) {
+		return 0;
+	}
+
+	if (frame->is_array) {
+		if (frame->arr.remaining == 0) {
+			return -ENOSPC;
+		}
+
+		parser->descr = frame->descr;
+		parser->field = frame->val;
+		/* For nested arrays, the length field is relative to the element */
+		parser->val = frame->val;
+	} else if (frame->obj.current >= 0) {
+		parser->descr = &frame->descr[frame->obj.current];
+		parser->field = (char *)frame->val + parser->descr->offset;
+		parser->val = frame->val;
+	}
+
+	return 0;
+}
+
+static int stream_value_start(struct json_stream_parser *parser, int chr)
+{
+	enum json_tokens type = stream_value_type(chr);
+	const struct json_obj_descr *descr;
+	int ret;
+
+	if (type == JSON_TOK_ERROR) {
+		return -EINVAL;
+	}
+
+	if (parser->depth == 0) {
+		struct json_stream_frame root = parser->stack[0];
+
+		if (type != parser->root) {
+			return -EINVAL;
+		}
+
+		if (type == JSON_TOK_OBJECT_START) {
+			ret = stream_push_obj(parser, root.descr, root.obj.descr_len, root.val);
+		} else {
+			ret = stream_push_arr(parser, root.descr->array.element_descr,
+					      root.descr->array.n_elements,
+					      (char *)root.val + root.descr->offset, root.val);
+		}
+
+		parser->state = (type == JSON_TOK_OBJECT_START) ? JSON_STREAM_OBJ_FIRST
+								: JSON_STREAM_ARR_FIRST;
+		return ret;
+	}
+
+	ret = stream_value_target(parser);
+	if (ret < 0) {
+		return ret;
+	}
+
+	descr = parser->descr;
+	if (descr != NULL) {
+		if (type == JSON_TOK_NULL || !equivalent_types(type, descr->type)) {
+			return -EINVAL;
+		}
+
+		if (!stream_supported(descr->type)) {
+			return -ENOTSUP;
+		}
+	}
+
+	parser->len = 0;
+
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+		parser->state = JSON_STREAM_OBJ_FIRST;
+		if (descr == NULL) {
+			return stream_push_skip(parser, false);
+		}
+
+		return stream_push_obj(parser, descr->object.sub_descr,
+				       descr->object.sub_descr_len, parser->field);
+	case JSON_TOK_ARRAY_START:
+		parser->state = JSON_STREAM_ARR_FIRST;
+		if (descr == NULL) {
+			return stream_push_skip(parser, true);
+		}
+
+		return stream_push_arr(parser, descr->array.element_descr,
+				       descr->array.n_elements, parser->field, parser->val);
+	case JSON_TOK_STRING:
+		parser->state = JSON_STREAM_STRING;
+		parser->escape = 0;
+		parser->escaped_len = 0;
+		return 0;
+	case JSON_TOK_NUMBER:
+		parser->state = JSON_STREAM_NUMBER;
+		parser->number[parser->len++] = chr;
+		return 0;
+	default:
+		parser->state = JSON_STREAM_LITERAL;
+		parser->literal = (type == JSON_TOK_TRUE)    ? "true"
+				  : (type == JSON_TOK_FALSE) ? "false"
+							     : "null";
+		parser->len = 1;
+		return 0;
+	}
+}
+
+static void stream_key_start(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame = &parser->stack[parser->depth - 1];
+
+	parser->state = JSON_STREAM_KEY;
+	parser->escape = 0;
+	parser->len = 0;
+	parser->candidates = 0;
+
+	/* Fields decoded already are skipped, as by obj_parse() */
+	if (!stream_skipping(parser)) {
+		parser->candidates = BIT64_MASK(frame->obj.descr_len) & ~frame->obj.decoded;
+	}
+}
+
+/* Narrow down the descriptors matching the key with its next character */
+static void stream_key_char(struct json_stream_parser *parser, char chr)
+{
+	const struct json_obj_descr *descr = parser->stack[parser->depth - 1].descr;
+
+	for (uint64_t m = parser->candidates; m != 0; m &= m - 1) {
+		int i = u64_count_trailing_zeros(m);
+
+		if (descr[i].field_name_len <= parser->len ||
+		    descr[i].field_name[parser->len] != chr) {
+			parser->candidates &= ~BIT64(i);
+		}
+	}
+
+	parser->len++;
+}
+
+static void stream_key_end(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame;
+
+	parser->state = JSON_STREAM_COLON;
+
+	if (stream_skipping(parser)) {
+		return;
+	}
+
+	frame = &parser->stack[parser->depth - 1];
+	frame->obj.current = -1;
+
+	for (uint64_t m = parser->candidates; m != 0; m &= m - 1) {
+		int i = u64_count_trailing_zeros(m);
+
+		if (frame->descr[i].field_name_len == parser->len) {
+			frame->obj.current = i;
+			break;
+		}
+	}
+}
+
+static int stream_string_char(struct json_stream_parser *parser, char chr)
+{
+	if (parser->state == JSON_STREAM_KEY) {
+		stream_key_char(parser, chr);
+		return 0;
+	}
+
+	if (parser->descr == NULL) {
+		return 0;
+	}
+
+	/* Bounded by stream_string(), the unescaped string is never longer */
+	((char *)parser->field)[parser->len++] = chr;
+
+	return 0;
+}
+
+/* Same unescaping as json_unescape_string(), \uXXXX is kept as is */
+static int stream_string(struct json_stream_parser *parser, char chr)
+{
+	int ret;
+
+	/*
+	 * As decode_string_buf() does, the escaped string must leave room for the
+	 * NUL character, even if it would fit once unescaped.
+	 */
+	if (parser->state == JSON_STREAM_STRING && parser->descr != NULL &&
+	    (chr != '"' || parser->escape != 0) &&
+	    ++parser->escaped_len >= parser->descr->field.size) {
+		return -EINVAL;
+	}
+
+	if (parser->escape >= JSON_STREAM_ESCAPE_HEX) {
+		if (isxdigit((unsigned char)chr) == 0) {
+			return -EINVAL;
+		}
+
+		if (++parser->escape == JSON_STREAM_ESCAPE_HEX_END) {
+			parser->escape = 0;
+		}
+
+		return stream_string_char(parser, chr);
+	}
+
+	if (parser->escape == JSON_STREAM_ESCAPE) {
+		parser->escape = 0;
+
+		switch (chr) {
+		case '"':
+		case '\\':
+		case '/':
+			break;
+		case 'b':
+			chr = '\b';
+			break;
+		case 'f':
+			chr = '\f';
+			break;
+		case 'n':
+			chr = '\n';
+			break;
+		case 'r':
+			chr = '\r';
+			break;
+		case 't':
+			chr = '\t';
+			break;
+		case 'u':
+			parser->escape = JSON_STREAM_ESCAPE_HEX;
+			ret = stream_string_char(parser, '\\');
+			if (ret < 0) {
+				return ret;
+			}
+			break;
+		default:
+			return -EINVAL;
+		}
+
+		return stream_string_char(parser, chr);
+	}
+
+	if (chr == '\\') {
+		parser->escape = JSON_STREAM_ESCAPE;
+		return 0;
+	}
+
+	if (chr != '"') {
+		return stream_string_char(parser, chr);
+	}
+
+	if (parser->state == JSON_STREAM_KEY) {
+		stream_key_end(parser);
+		return 0;
+	}
+
+	if (parser->descr != NULL) {
+		((char *)parser->field)[parser->len] = '\0';
+	}
+
+	stream_value_end(parser);
+
+	return 0;
+}
+
+static int stream_number_end(struct json_stream_parser *parser)
+{
+	struct json_token tok = {
+		.type = JSON_TOK_NUMBER,
+		.start = parser->number,
+		.end = &parser->number[parser->len],
+	};
+	int64_t ret = 0;
+
+	if (parser->descr != NULL) {
+		ret = decode_value(NULL, parser->descr, &tok, parser->field, parser->val);
+		if (ret < 0) {
+			return (int)ret;
+		}
+	}
+
+	stream_value_end(parser);
+
+	return 0;
+}
+
+static int stream_literal_end(struct json_stream_parser *parser)
+{
+	struct json_token tok = {
+		.type = (parser->literal[0] == 't') ? JSON_TOK_TRUE : JSON_TOK_FALSE,
+	};
+	int64_t ret = 0;
+
+	if (parser->descr != NULL) {
+		ret = decode_value(NULL, parser->descr, &tok, parser->field, parser->val);
+		if (ret < 0) {
+			return (int)ret;
+		}
+	}
+
+	stream_value_end(parser);
+
+	return 0;
+}
+
+/* Process one character, returns 1 if it has to be processed again */
+static int stream_char(struct json_stream_parser *parser, char chr)
+{
+	switch (parser->state) {
+	case JSON_STREAM_STRING:
+	case JSON_STREAM_KEY:
+		return stream_string(parser, chr);
+	case JSON_STREAM_NUMBER:
+		if (chr == ',' || chr == ']' || chr == '}' || isspace((unsigned char)chr) != 0) {
+			int ret = stream_number_end(parser);
+
+			return (ret < 0) ? ret : 1;
+		}
+
+		if (parser->len == JSON_STREAM_NUMBER_MAX_LEN) {
+			return -EINVAL;
+		}
+
+		parser->number[parser->len++] = chr;
+		return 0;
+	case JSON_STREAM_LITERAL:
+		if (parser->literal[parser->len] != chr) {
+			return -EINVAL;
+		}
+
+		if (parser->literal[++parser->len] == '\0') {
+			return stream_literal_end(parser);
+		}
+
+		return 0;
+	default:
+		break;
+	}
+
+	if (isspace((unsigned char)chr) != 0) {
+		return 0;
+	}
+
+	switch (parser->state) {
+	case JSON_STREAM_ARR_FIRST:
+		if (chr == ']') {
+			return stream_close(parser, true);
+		}
+
+		__fallthrough;
+	case JSON_STREAM_VALUE:
+		return stream_value_start(parser, chr);
+	case JSON_STREAM_OBJ_FIRST:
+		if (chr == '}') {
+			return stream_close(parser, false);
+		}
+
+		__fallthrough;
+	case JSON_STREAM_KEY_START:
+		if (chr != '"') {
+			return -EINVAL;
+		}
+
+		stream_key_start(parser);
+		return 0;
+	case JSON_STREAM_COLON:
+		if (chr != ':') {
+			return -EINVAL;
+		}
+
+		parser->state = JSON_STREAM_VALUE;
+		return 0;
+	case JSON_STREAM_NEXT:
+		if (chr == ',') {
+			parser->state = stream_in_array(parser) ? JSON_STREAM_VALUE
+								: JSON_STREAM_KEY_START;
+			return 0;
+		}
+
+		if (chr == ']' || chr == '}') {
+			return stream_close(parser, chr == ']');
+		}
+
+		return -EINVAL;
+	default:
+		/* Only whitespace is allowed after the value */
+		return -EINVAL;
+	}
+}
+
+int json_stream_parse(struct json_stream_parser *parser, const char *chunk, size_t len)
+{
+	size_t i = 0;
+
+	while (parser->error == 0 && i < len) {
+		int ret = stream_char(parser, chunk[i]);
+
+		if (ret < 0) {
+			parser->error = ret;
+		} else if (ret == 0) {
+			i++;
+		}
+	}
+
+	return parser->error;
+}
+
+int64_t json_stream_parse_finish(struct json_stream_parser *parser)
+{
+	if (parser->error != 0) {
+		return parser->error;
+	}
+
+	if (parser->state != JSON_STREAM_DONE) {
+		return -EINVAL;
+	}
+
+	return parser->result;
+}
+
+#endif /* CONFIG_JSON_LIBRARY_STREAM */
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -1302,14 +1964,26 @@ static int json_escape_internal(const char *str,
 	}
 
 	for (cur = str; ret == 0 && *cur; cur++) {
-		char escaped = escape_as(*cur);
+		const char *run = cur;
+		char escaped;
+
+		/* Append the characters not needing escaping at once */
+		while (*cur && !escape_as(*cur)) {
+			cur++;
+		}
+
+		if (cur != run) {
+			ret = append_bytes(run, cur - run, data);
+			if (ret != 0 || !*cur) {
+				break;
+			}
+		}
 
+		escaped = escape_as(*cur);
 		if (escaped) {
 			char bytes[2] = { '\\', escaped };
 
 			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
 		}
 	}
 
@@ -1822,6 +2496,63 @@ int json_arr_encode_buf(const struct json_obj_descr *descr, const void *val,
 	return json_arr_encode(descr, val, append_bytes_to_buf, &appender);
 }
 
+#ifdef CONFIG_NET_BUF
+struct net_buf_appender {
+	/* Fragment being filled */
+	struct net_buf *frag;
+	struct net_buf_pool *pool;
+};
+
+static int append_bytes_to_net_buf(const char *bytes, size_t len, void *data)
+{
+	struct net_buf_appender *appender = data;
+
+	while (len > 0) {
+		size_t room = net_buf_tailroom(appender->frag);
+
+		if (room == 0) {
+			struct net_buf *next;
+
+			if (appender->pool == NULL) {
+				return -ENOMEM;
+			}
+
+			next = net_buf_alloc(appender->pool, K_NO_WAIT);
+			if (next == NULL) {
+				return -ENOMEM;
+			}
+
+			net_buf_frag_insert(appender->frag, next);
+			appender->frag = next;
+			continue;
+		}
+
+		room = MIN(room, len);
+		net_buf_add_mem(appender->frag, bytes, room);
+		bytes += room;
+		len -= room;
+	}
+
+	return 0;
+}
+
+int json_obj_encode_net_buf(const struct json_obj_descr *descr, size_t descr_len,
+			    const void *val, struct net_buf *buf, struct net_buf_pool *pool)
+{
+	struct net_buf_appender appender = { .frag = net_buf_frag_last(buf), .pool = pool };
+
+	return json_obj_encode(descr, descr_len, val, append_bytes_to_net_buf, &appender);
+}
+
+int json_arr_encode_net_buf(const struct json_obj_descr *descr, const void *val,
+			    struct net_buf *buf, struct net_buf_pool *pool)
+{
+	struct net_buf_appender appender = { .frag = net_buf_frag_last(buf), .pool = pool };
+
+	return json_arr_encode(descr, val, append_bytes_to_net_buf, &appender);
+}
+#endif /* CONFIG_NET_BUF */
+
 static int measure_bytes(const char *bytes, size_t len, void *data)
 {
 	ssize_t *total = data;
@@ -34,5 +34,5 @@ def test_shell_perf(dut: DeviceAdapter, shell: Shell):
 
     i = 0
     while i < length:
-        i += int(lines[i], 16) + 1
+        i += int(lines[i], 16) + 2
         assert i <= length, 'one of the samples is not true to size'
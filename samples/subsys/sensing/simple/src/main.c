@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys_clock.h>
 #include <zephyr/sensing/sensing.h>
@@ -46,6 +48,111 @@ static struct sensing_callback_list hinge_angle_cb_list = {
 	.on_data_event = &hinge_angle_data_event_callback,
 };
 
+#if CONFIG_SAMPLE_SENSING_CLIENTS > 0
+/* 10 to 40 ms, half of the clients accepting 100 ms of latency */
+#define CLIENT_INTERVAL_US(i) (((i) % 4 + 1) * 10 * USEC_PER_MSEC)
+#define CLIENT_LATENCY_US(i)  (((i) % 2) * 100 * USEC_PER_MSEC)
+
+static sensing_sensor_handle_t clients[CONFIG_SAMPLE_SENSING_CLIENTS];
+static atomic_t client_samples;
+static atomic_t client_events;
+
+static void client_data_event_callback(sensing_sensor_handle_t handle, const void *buf,
+				       void *context)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(context);
+
+	atomic_inc(&client_samples);
+	atomic_inc(&client_events);
+}
+
+static void client_data_batch_event_callback(sensing_sensor_handle_t handle,
+					     const void *const *bufs, uint16_t count,
+					     void *context)
+{
+	ARG_UNUSED(handle);
+	ARG_UNUSED(bufs);
+	ARG_UNUSED(context);
+
+	atomic_add(&client_samples, count);
+	atomic_inc(&client_events);
+}
+
+static struct sensing_callback_list client_cb_list = {
+	.on_data_event = &client_data_event_callback,
+	.on_data_batch_event = &client_data_batch_event_callback,
+};
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+static void dispatch_usage(const struct k_thread *thread, void *user_data)
+{
+	const char *name = k_thread_name_get((k_tid_t)thread);
+	k_thread_runtime_stats_t stats;
+
+	if (name != NULL && strcmp(name, "sensing_dispatch") == 0 &&
+	    k_thread_runtime_stats_get((k_tid_t)thread, &stats) == 0) {
+		*(uint64_t *)user_data = stats.execution_cycles;
+	}
+}
+#endif
+
+static uint64_t dispatch_cycles(void)
+{
+	uint64_t cycles = 0;
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+	k_thread_foreach(dispatch_usage, &cycles);
+#endif
+
+	return cycles;
+}
+
+static void run_clients(const struct sensing_sensor_info *info)
+{
+	struct sensing_sensor_config config[2];
+	uint64_t cycles;
+	long samples;
+	int ret, i;
+
+	for (i = 0; i < CONFIG_SAMPLE_SENSING_CLIENTS; i++) {
+		ret = sensing_open_sensor(info, &client_cb_list, &clients[i]);
+		if (ret) {
+			LOG_ERR("client %d sensing_open_sensor error:%d", i, ret);
+			break;
+		}
+
+		config[0].attri = SENSING_SENSOR_ATTRIBUTE_INTERVAL;
+		config[0].interval = CLIENT_INTERVAL_US(i);
+		config[1].attri = SENSING_SENSOR_ATTRIBUTE_LATENCY;
+		config[1].latency = CLIENT_LATENCY_US(i);
+		ret = sensing_set_config(clients[i], config, ARRAY_SIZE(config));
+		if (ret) {
+			LOG_ERR("client %d sensing_set_config error:%d", i, ret);
+		}
+	}
+
+	atomic_clear(&client_samples);
+	atomic_clear(&client_events);
+	cycles = dispatch_cycles();
+
+	k_msleep(CONFIG_SAMPLE_SENSING_RUN_TIME_MS);
+
+	cycles = dispatch_cycles() - cycles;
+	samples = atomic_get(&client_samples);
+
+	LOG_INF("%d clients got %ld samples in %ld callbacks", i, samples,
+		atomic_get(&client_events));
+	LOG_INF("dispatch: %llu cycles per client sample",
+		samples > 0 ? cycles / samples : 0);
+
+	while (i-- > 0) {
+		sensing_close_sensor(&clients[i]);
+	}
+}
+#endif /* CONFIG_SAMPLE_SENSING_CLIENTS > 0 */
+
 int main(void)
 {
 	const struct sensing_sensor_info *info;
@@ -164,5 +271,9 @@ int main(void)
 		LOG_ERR("hinge_angle sensing_get_sensitivity error:%d\n", ret);
 	}
 
+#if CONFIG_SAMPLE_SENSING_CLIENTS > 0
+	run_clients(accle_info);
+#endif
+
 	return 0;
 }
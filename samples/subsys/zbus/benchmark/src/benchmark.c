@@ -45,6 +45,10 @@ static void producer_thread(void)
 			? "LISTENERS"
 			: (IS_ENABLED(CONFIG_BM_SUBSCRIBERS) ? "SUBSCRIBERS" : "MSG_SUBSCRIBERS"),
 		CONFIG_BM_MESSAGE_SIZE);
+	if (IS_ENABLED(CONFIG_BM_LOAN) || IS_ENABLED(CONFIG_BM_ZERO_COPY)) {
+		LOG_INF("Publishing %s, consuming %s", IS_ENABLED(CONFIG_BM_LOAN) ? "loans" : "copies",
+			IS_ENABLED(CONFIG_BM_ZERO_COPY) ? "shared buffers" : "copies");
+	}
 
 	struct bm_msg msg = {{0}};
 
@@ -56,7 +60,15 @@ static void producer_thread(void)
 
 	for (uint64_t internal_count = BYTES_TO_BE_SENT / CONFIG_BM_ONE_TO; internal_count > 0;
 	     internal_count -= CONFIG_BM_MESSAGE_SIZE) {
-		zbus_chan_pub(&bm_channel, &msg, K_FOREVER);
+		if (IS_ENABLED(CONFIG_BM_LOAN)) {
+			struct bm_msg *loaned;
+
+			zbus_chan_pub_loan(&bm_channel, (void **)&loaned, K_FOREVER);
+			memcpy(loaned->bytes, &message_size, sizeof(message_size));
+			zbus_chan_pub_commit(&bm_channel, K_FOREVER);
+		} else {
+			zbus_chan_pub(&bm_channel, &msg, K_FOREVER);
+		}
 	}
 
 	uint64_t end_ns = GET_ARCH_TIME_NS();
@@ -5,6 +5,7 @@
 #include "messages.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/sys/util_macro.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/zbus/zbus.h>
@@ -35,15 +36,26 @@ static int msg_sub_thread(void *msub_ref, void *ptr2, void *ptr3)
 	ARG_UNUSED(ptr3);
 
 	const struct zbus_channel *chan;
-	struct bm_msg msg_received;
+	struct bm_msg __maybe_unused msg_received;
 	struct zbus_observer *msub = msub_ref;
 
 	while (1) {
+#if defined(CONFIG_BM_ZERO_COPY)
+		struct net_buf *buf;
+
+		if (zbus_sub_wait_msg_buf(msub, &chan, &buf, K_FOREVER) == 0) {
+			atomic_add(&count, *((uint16_t *)buf->data));
+			net_buf_unref(buf);
+		} else {
+			k_oops();
+		}
+#else
 		if (zbus_sub_wait_msg(msub, &chan, &msg_received, K_FOREVER) == 0) {
 			atomic_add(&count, *((uint16_t *)msg_received.bytes));
 		} else {
 			k_oops();
 		}
+#endif /* CONFIG_BM_ZERO_COPY */
 	}
 
 	return -EFAULT;
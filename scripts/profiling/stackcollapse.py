@@ -39,11 +39,12 @@ def collapse(buf, elf):
     while buf:
         count, = struct.unpack_from(">Q", buf)
         assert count > 0
-        addrs = struct.unpack_from(f">{count}Q", buf, 8)
+        thread, = struct.unpack_from(">Q", buf, 8)
+        addrs = struct.unpack_from(f">{count}Q", buf, 16)
 
         func_trace = reversed(list(map(lambda a: addr_to_sym(a, elf), addrs)))
         prev_func = next(func_trace)
-        line = prev_func
+        line = f"thread_0x{thread:x};" + prev_func
         # merge dublicate functions
         for func in func_trace:
             if prev_func != func:
@@ -51,7 +52,7 @@ def collapse(buf, elf):
                 line += ";" + func
 
         print(line, 1)
-        buf = buf[8 + 8 * count:]
+        buf = buf[16 + 8 * count:]
 
 
 if __name__ == "__main__":
@@ -185,6 +185,84 @@ static struct net_buf *get_data_frag(struct net_buf *outside, size_t winsize)
 
 	return window;
 }
+
+/* With drivers taking fragment chains, the ACL headers are put in their own
+ * buffers, in front of the payload. Only the last fragment of a PDU is a view,
+ * which keeps the upper layer from adding the next PDU header in front of the
+ * data while it is being sent. The others only reference their parent, so that
+ * the next fragment can be given to the driver right away.
+ */
+static void ref_frag_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(acl_hdrs, CONFIG_BT_BUF_ACL_TX_COUNT,
+			  BT_BUF_RESERVE + BT_HCI_ACL_HDR_SIZE,
+			  CONFIG_BT_CONN_TX_USER_DATA_SIZE, NULL);
+NET_BUF_POOL_FIXED_DEFINE(ref_fragments, CONFIG_BT_BUF_ACL_TX_COUNT, 0, 0, ref_frag_destroy);
+
+static struct net_buf *ref_frag_parent[CONFIG_BT_BUF_ACL_TX_COUNT];
+
+static void ref_frag_destroy(struct net_buf *frag)
+{
+	struct net_buf **parent = &ref_frag_parent[net_buf_id(frag)];
+
+	/* Dropped before the parent is forgotten, see `ref_frags_holding()` */
+	net_buf_unref(*parent);
+	*parent = NULL;
+	net_buf_destroy(frag);
+
+	bt_tx_irq_raise();
+}
+
+/* Number of fragments sent by reference still holding `outside` */
+static size_t ref_frags_holding(struct net_buf *outside)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(ref_frag_parent); i++) {
+		if (ref_frag_parent[i] == outside) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static struct net_buf *get_data_frags(struct net_buf *outside, size_t winsize, bool last)
+{
+	struct net_buf *hdr, *payload;
+
+	hdr = net_buf_alloc(&acl_hdrs, K_NO_WAIT);
+	if (!hdr) {
+		return NULL;
+	}
+
+	/* The ACL header is pushed by `send_acl()` */
+	net_buf_reserve(hdr, hdr->size);
+
+	if (last) {
+		payload = get_data_frag(outside, winsize);
+	} else {
+		payload = net_buf_alloc_with_data(&ref_fragments, outside->data, winsize,
+						  K_NO_WAIT);
+		if (payload) {
+			/* The reference to `outside` is moved to the fragment */
+			ref_frag_parent[net_buf_id(payload)] = outside;
+			net_buf_pull(outside, winsize);
+		}
+	}
+
+	if (!payload) {
+		net_buf_unref(hdr);
+		return NULL;
+	}
+
+	net_buf_frag_add(hdr, payload);
+
+	LOG_DBG("get-acl-frags: outside %p hdr %p payload %p size %zu", outside, hdr, payload,
+		winsize);
+
+	return hdr;
+}
 #else /* !CONFIG_BT_CONN_TX */
 static struct net_buf *get_data_frag(struct net_buf *outside, size_t winsize)
 {
@@ -197,6 +275,22 @@ static struct net_buf *get_data_frag(struct net_buf *outside, size_t winsize)
 
 	return NULL;
 }
+
+static size_t ref_frags_holding(struct net_buf *outside)
+{
+	ARG_UNUSED(outside);
+
+	return 0;
+}
+
+static struct net_buf *get_data_frags(struct net_buf *outside, size_t winsize, bool last)
+{
+	ARG_UNUSED(outside);
+	ARG_UNUSED(winsize);
+	ARG_UNUSED(last);
+
+	return NULL;
+}
 #endif /* CONFIG_BT_CONN_TX */
 
 #if defined(CONFIG_BT_ISO)
@@ -549,9 +643,10 @@ static int send_acl(struct bt_conn *conn, struct net_buf *buf, uint8_t flags)
 		return -EINVAL;
 	}
 
+	/* The payload follows in the fragments when using `get_data_frags()` */
 	hdr = net_buf_push(buf, sizeof(*hdr));
 	hdr->handle = sys_cpu_to_le16(bt_acl_handle_pack(conn->handle, flags));
-	hdr->len = sys_cpu_to_le16(buf->len - sizeof(*hdr));
+	hdr->len = sys_cpu_to_le16(net_buf_frags_len(buf) - sizeof(*hdr));
 
 	net_buf_push_u8(buf, BT_HCI_H4_ACL);
 
@@ -645,6 +740,22 @@ static bool is_acl_conn(struct bt_conn *conn)
 	return bt_conn_is_le(conn) || bt_conn_is_br(conn);
 }
 
+static bool use_data_frags(struct bt_conn *conn)
+{
+	return IS_ENABLED(CONFIG_BT_CONN_TX) && bt_drv_quirk_tx_frags() && is_acl_conn(conn);
+}
+
+__maybe_unused static bool buf_ref_is_expected(struct bt_conn *conn, struct net_buf *buf)
+{
+	/* Fragments may be released meanwhile, so they are counted before
+	 * the references: the count can then only be too high.
+	 */
+	size_t frags = use_data_frags(conn) ? ref_frags_holding(buf) : 0;
+	uint8_t ref = buf->ref;
+
+	return (ref >= 1) && (ref <= 2 + frags);
+}
+
 static int send_buf(struct bt_conn *conn, struct net_buf *buf,
 		    size_t len, bt_conn_tx_cb_t cb, void *ud)
 {
@@ -703,13 +814,18 @@ static int send_buf(struct bt_conn *conn, struct net_buf *buf,
 	 * was the only reference (e.g. buf was removed
 	 * from the conn tx_queue). It would be 2 if the
 	 * tx_data_pull kept it on the tx_queue for segmentation.
+	 * Fragments sent by reference hold one more each until released.
 	 */
-	__ASSERT_NO_MSG((buf->ref == 1) || (buf->ref == 2));
+	__ASSERT_NO_MSG(buf_ref_is_expected(conn, buf));
 
 	/* The reference is always transferred to the frag, so when
 	 * the frag is destroyed, the parent reference is decremented.
 	 */
-	frag = get_data_frag(buf, frag_len);
+	if (use_data_frags(conn)) {
+		frag = get_data_frags(buf, frag_len, len <= conn_mtu(conn));
+	} else {
+		frag = get_data_frag(buf, frag_len);
+	}
 
 	/* Caller is supposed to check we have all resources to send */
 	__ASSERT_NO_MSG(frag != NULL);
@@ -897,19 +1013,29 @@ static bool cannot_send_to_controller(struct bt_conn *conn)
 	return k_sem_count_get(bt_conn_get_pkts(conn)) == 0;
 }
 
-static bool dont_have_viewbufs(void)
+__maybe_unused static bool pool_is_empty(struct net_buf_pool *pool)
 {
-#if defined(CONFIG_BT_CONN_TX)
 	/* The LIFO only tracks buffers that have been destroyed at least once,
 	 * hence the uninit check beforehand.
 	 */
-	if (fragments.uninit_count > 0) {
+	if (pool->uninit_count > 0) {
 		/* If there are uninitialized bufs, we are guaranteed allocation. */
 		return false;
 	}
 
 	/* In practice k_fifo == k_lifo ABI. */
-	return k_fifo_is_empty(&fragments.free);
+	return k_fifo_is_empty(&pool->free);
+}
+
+static bool dont_have_viewbufs(void)
+{
+#if defined(CONFIG_BT_CONN_TX)
+	if (bt_drv_quirk_tx_frags() &&
+	    (pool_is_empty(&acl_hdrs) || pool_is_empty(&ref_fragments))) {
+		return true;
+	}
+
+	return pool_is_empty(&fragments);
 
 #else  /* !CONFIG_BT_CONN_TX */
 	return false;
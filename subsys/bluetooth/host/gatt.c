@@ -1230,6 +1230,162 @@ BT_GATT_SERVICE_DEFINE(_1_gatt_svc,
 #endif /* CONFIG_BT_GATT_SERVICE_CHANGED */
 );
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+struct gatt_attr_index_entry {
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+	/* Value of the UUID if it is a 16-bit one, 0 otherwise */
+	uint16_t uuid16;
+};
+
+static struct {
+	/* Attributes of the local database, in handle order */
+	struct gatt_attr_index_entry entries[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+	/* Positions in entries, in 16-bit UUID order then handle order */
+	uint16_t by_uuid[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+	uint16_t count;
+	bool valid;
+} attr_index;
+
+static uint16_t attr_index_uuid16(const struct bt_uuid *uuid)
+{
+	uint32_t val;
+
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		return BT_UUID_16(uuid)->val;
+	case BT_UUID_TYPE_32:
+		val = BT_UUID_32(uuid)->val;
+		break;
+	case BT_UUID_TYPE_128:
+		/* Only a UUID based on the Bluetooth base UUID can be shortened */
+		val = sys_get_le16(&BT_UUID_128(uuid)->val[12]);
+		break;
+	default:
+		return 0U;
+	}
+
+	if (val > UINT16_MAX || bt_uuid_cmp(uuid, BT_UUID_DECLARE_16(val)) != 0) {
+		return 0U;
+	}
+
+	return val;
+}
+
+static bool attr_index_add(const struct bt_gatt_attr *attr, uint16_t handle)
+{
+	struct gatt_attr_index_entry *entry;
+
+	if (attr_index.count == ARRAY_SIZE(attr_index.entries)) {
+		return false;
+	}
+
+	/* Searches rely on handles in ascending order */
+	if (attr_index.count > 0 && attr_index.entries[attr_index.count - 1].handle >= handle) {
+		return false;
+	}
+
+	entry = &attr_index.entries[attr_index.count];
+	entry->attr = attr;
+	entry->handle = handle;
+	entry->uuid16 = attr_index_uuid16(attr->uuid);
+
+	attr_index.by_uuid[attr_index.count] = attr_index.count;
+	attr_index.count++;
+
+	return true;
+}
+
+static int attr_index_uuid_cmp(const void *a, const void *b)
+{
+	const struct gatt_attr_index_entry *entry_a = &attr_index.entries[*(const uint16_t *)a];
+	const struct gatt_attr_index_entry *entry_b = &attr_index.entries[*(const uint16_t *)b];
+
+	if (entry_a->uuid16 != entry_b->uuid16) {
+		return entry_a->uuid16 < entry_b->uuid16 ? -1 : 1;
+	}
+
+	return entry_a->handle < entry_b->handle ? -1 : 1;
+}
+
+static void gatt_attr_index_rebuild(void)
+{
+	uint16_t handle = 1;
+
+	attr_index.valid = false;
+	attr_index.count = 0U;
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!attr_index_add(&static_svc->attrs[i], handle)) {
+				goto overflow;
+			}
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			if (!attr_index_add(&svc->attrs[i], svc->attrs[i].handle)) {
+				goto overflow;
+			}
+		}
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	qsort(attr_index.by_uuid, attr_index.count, sizeof(attr_index.by_uuid[0]),
+	      attr_index_uuid_cmp);
+
+	attr_index.valid = true;
+
+	return;
+
+overflow:
+	LOG_WRN("Attribute index too small, falling back to walking the database");
+}
+
+/* Position of the first entry with a handle not below start_handle */
+static size_t attr_index_find(uint16_t start_handle)
+{
+	size_t low = 0, high = attr_index.count;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+
+		if (attr_index.entries[mid].handle < start_handle) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+/* Position in by_uuid of the first entry of uuid16 not below start_handle */
+static size_t attr_index_find_uuid(uint16_t uuid16, uint16_t start_handle)
+{
+	size_t low = 0, high = attr_index.count;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		const struct gatt_attr_index_entry *entry =
+			&attr_index.entries[attr_index.by_uuid[mid]];
+
+		if (entry->uuid16 < uuid16 ||
+		    (entry->uuid16 == uuid16 && entry->handle < start_handle)) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
 			  void *user_data)
@@ -1546,6 +1702,10 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_attr_index_rebuild();
+#endif
 }
 
 void bt_gatt_init(void)
@@ -1772,6 +1932,10 @@ int bt_gatt_service_register(struct bt_gatt_service *svc)
 		return err;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_attr_index_rebuild();
+#endif
+
 	/* Don't submit any work until the stack is initialized */
 	if (!atomic_test_bit(gatt_flags, GATT_INITIALIZED)) {
 		k_sched_unlock();
@@ -1810,6 +1974,10 @@ int bt_gatt_service_unregister(struct bt_gatt_service *svc)
 		return err;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_attr_index_rebuild();
+#endif
+
 	/* Don't submit any work until the stack is initialized */
 	if (!atomic_test_bit(gatt_flags, GATT_INITIALIZED)) {
 		k_sched_unlock();
@@ -2109,6 +2277,51 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static bool foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	const struct gatt_attr_index_entry *entry;
+	uint16_t uuid16 = uuid ? attr_index_uuid16(uuid) : 0U;
+
+	if (!attr_index.valid) {
+		return false;
+	}
+
+	if (uuid16) {
+		/* Only visit the attributes of that UUID */
+		for (size_t i = attr_index_find_uuid(uuid16, start_handle);
+		     i < attr_index.count; i++) {
+			entry = &attr_index.entries[attr_index.by_uuid[i]];
+
+			if (entry->uuid16 != uuid16 ||
+			    gatt_foreach_iter(entry->attr, entry->handle,
+					      start_handle, end_handle, NULL,
+					      attr_data, &num_matches, func,
+					      user_data) == BT_GATT_ITER_STOP) {
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	for (size_t i = attr_index_find(start_handle); i < attr_index.count; i++) {
+		entry = &attr_index.entries[i];
+
+		if (gatt_foreach_iter(entry->attr, entry->handle, start_handle,
+				      end_handle, uuid, attr_data, &num_matches,
+				      func, user_data) == BT_GATT_ITER_STOP) {
+			break;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2120,6 +2333,13 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (foreach_attr_type_index(start_handle, end_handle, uuid, attr_data,
+				    num_matches, func, user_data)) {
+		return;
+	}
+#endif
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
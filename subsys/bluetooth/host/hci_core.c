@@ -173,6 +173,11 @@ bool bt_drv_quirk_no_auto_dle(void)
 	return ((BT_HCI_QUIRKS & BT_HCI_QUIRK_NO_AUTO_DLE) != 0);
 }
 
+bool bt_drv_quirk_tx_frags(void)
+{
+	return ((BT_HCI_QUIRKS & BT_HCI_QUIRK_TX_FRAGS) != 0);
+}
+
 void bt_hci_cmd_state_set_init(struct net_buf *buf,
 			       struct bt_hci_cmd_state_set *state,
 			       atomic_t *target, int bit, bool val)
@@ -4322,7 +4327,12 @@ int bt_send(struct net_buf *buf)
 
 	LOG_DBG("buf %p len %u type %u", buf, buf->len, type);
 
-	bt_monitor_send(bt_monitor_opcode(type, BT_MONITOR_TX), buf->data + 1, buf->len - 1);
+	if (buf->frags) {
+		bt_monitor_send_frags(bt_monitor_opcode(type, BT_MONITOR_TX), buf, 1);
+	} else {
+		bt_monitor_send(bt_monitor_opcode(type, BT_MONITOR_TX), buf->data + 1,
+				buf->len - 1);
+	}
 
 	return bt_hci_send(bt_dev.hci, buf);
 }
@@ -580,5 +580,6 @@ int bt_hci_le_read_remote_features(struct bt_conn *conn);
 int bt_hci_le_read_max_data_len(uint16_t *tx_octets, uint16_t *tx_time);
 
 bool bt_drv_quirk_no_auto_dle(void);
+bool bt_drv_quirk_tx_frags(void);
 
 void bt_tx_irq_raise(void);
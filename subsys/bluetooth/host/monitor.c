@@ -250,6 +250,29 @@ void bt_monitor_send(uint16_t opcode, const void *data, size_t len)
 	atomic_clear_bit(&flags, BT_LOG_BUSY);
 }
 
+void bt_monitor_send_frags(uint16_t opcode, const struct net_buf *buf, size_t skip)
+{
+	struct bt_monitor_hdr hdr;
+
+	if (atomic_test_and_set_bit(&flags, BT_LOG_BUSY)) {
+		drop_add(opcode);
+		return;
+	}
+
+	encode_hdr(&hdr, monitor_ts_get(), opcode, net_buf_frags_len(buf) - skip);
+
+	monitor_send(&hdr, BT_MONITOR_BASE_HDR_LEN + hdr.hdr_len);
+
+	for (; buf; buf = buf->frags) {
+		size_t len = buf->len > skip ? buf->len - skip : 0;
+
+		monitor_send(buf->data + (buf->len - len), len);
+		skip -= buf->len - len;
+	}
+
+	atomic_clear_bit(&flags, BT_LOG_BUSY);
+}
+
 void bt_monitor_new_index(uint8_t type, uint8_t bus, const bt_addr_t *addr,
 			  const char *name)
 {
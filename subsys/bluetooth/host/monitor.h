@@ -113,6 +113,9 @@ static inline uint8_t bt_monitor_opcode(uint8_t type, enum bt_monitor_dir dir)
 
 void bt_monitor_send(uint16_t opcode, const void *data, size_t len);
 
+/* Send a packet spread over a fragment chain, skipping the first @p skip bytes */
+void bt_monitor_send_frags(uint16_t opcode, const struct net_buf *buf, size_t skip);
+
 void bt_monitor_new_index(uint8_t type, uint8_t bus, const bt_addr_t *addr,
 			  const char *name);
 
@@ -125,6 +128,14 @@ static inline void bt_monitor_send(uint16_t opcode, const void *data, size_t len
 	ARG_UNUSED(len);
 }
 
+static inline void bt_monitor_send_frags(uint16_t opcode, const struct net_buf *buf,
+					 size_t skip)
+{
+	ARG_UNUSED(opcode);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(skip);
+}
+
 static inline void bt_monitor_new_index(uint8_t type, uint8_t bus, const bt_addr_t *addr,
 					const char *name)
 {
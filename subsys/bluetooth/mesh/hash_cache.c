@@ -0,0 +1,98 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/hash_function.h>
+
+#include "hash_cache.h"
+
+/* Set in the stored keys to tell them from free entries */
+#define KEY_USED BIT64(63)
+
+static uint32_t bucket_of(const struct bt_mesh_hash_cache *cache, uint64_t key)
+{
+	key &= ~KEY_USED;
+
+	return sys_hash32_murmur3(&key, sizeof(key)) & cache->bucket_mask;
+}
+
+static inline uint32_t bucket_next(const struct bt_mesh_hash_cache *cache, uint32_t bucket)
+{
+	return (bucket + 1) & cache->bucket_mask;
+}
+
+bool bt_mesh_hash_cache_has(const struct bt_mesh_hash_cache *cache, uint64_t key)
+{
+	for (uint32_t b = bucket_of(cache, key); cache->buckets[b]; b = bucket_next(cache, b)) {
+		if (cache->keys[cache->buckets[b] - 1] == (key | KEY_USED)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void bucket_remove(struct bt_mesh_hash_cache *cache, uint16_t pos)
+{
+	uint32_t hole = bucket_of(cache, cache->keys[pos]);
+
+	while (cache->buckets[hole] != pos + 1) {
+		hole = bucket_next(cache, hole);
+	}
+
+	/* Shift back the following keys of the cluster that may use the hole,
+	 * so that probing never needs tombstones.
+	 */
+	for (uint32_t b = bucket_next(cache, hole); cache->buckets[b]; b = bucket_next(cache, b)) {
+		uint32_t home = bucket_of(cache, cache->keys[cache->buckets[b] - 1]);
+
+		if (((b - home) & cache->bucket_mask) >= ((b - hole) & cache->bucket_mask)) {
+			cache->buckets[hole] = cache->buckets[b];
+			hole = b;
+		}
+	}
+
+	cache->buckets[hole] = 0U;
+}
+
+void bt_mesh_hash_cache_add(struct bt_mesh_hash_cache *cache, uint64_t key)
+{
+	uint16_t pos = cache->next;
+	uint32_t b;
+
+	if (cache->keys[pos]) {
+		bucket_remove(cache, pos);
+	}
+
+	cache->keys[pos] = key | KEY_USED;
+
+	b = bucket_of(cache, key);
+	while (cache->buckets[b]) {
+		b = bucket_next(cache, b);
+	}
+
+	cache->buckets[b] = pos + 1;
+	cache->next = (pos + 1 == cache->size) ? 0U : pos + 1;
+}
+
+void bt_mesh_hash_cache_remove_last(struct bt_mesh_hash_cache *cache)
+{
+	uint16_t pos = cache->next ? cache->next - 1 : cache->size - 1;
+
+	if (cache->keys[pos]) {
+		bucket_remove(cache, pos);
+		cache->keys[pos] = 0U;
+	}
+
+	cache->next = pos;
+}
+
+void bt_mesh_hash_cache_clear(struct bt_mesh_hash_cache *cache)
+{
+	(void)memset(cache->keys, 0, cache->size * sizeof(cache->keys[0]));
+	(void)memset(cache->buckets, 0, (cache->bucket_mask + 1) * sizeof(cache->buckets[0]));
+	cache->next = 0U;
+}
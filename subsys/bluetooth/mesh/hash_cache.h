@@ -0,0 +1,51 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_BLUETOOTH_MESH_HASH_CACHE_H_
+#define ZEPHYR_SUBSYS_BLUETOOTH_MESH_HASH_CACHE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+/* Cache of the last keys added, evicting the oldest one when full. Keys are
+ * found through a hash table of at least twice as many buckets, with linear
+ * probing, so lookups do not depend on the size of the cache.
+ */
+struct bt_mesh_hash_cache {
+	/* Keys in the order they were added, 0 for free entries */
+	uint64_t *keys;
+	/* Position + 1 of a key in keys, 0 for free buckets */
+	uint16_t *buckets;
+	uint32_t bucket_mask;
+	uint16_t size;
+	uint16_t next;
+};
+
+#define BT_MESH_HASH_CACHE_BUCKETS(_size) NHPOT(2 * (_size))
+
+/** Define a cache of @p _size keys, which must be below BIT64(63). */
+#define BT_MESH_HASH_CACHE_DEFINE(_name, _size)                                 \
+	static uint64_t _name##_keys[_size];                                    \
+	static uint16_t _name##_buckets[BT_MESH_HASH_CACHE_BUCKETS(_size)];     \
+	static struct bt_mesh_hash_cache _name = {                              \
+		.keys = _name##_keys,                                           \
+		.buckets = _name##_buckets,                                     \
+		.bucket_mask = BT_MESH_HASH_CACHE_BUCKETS(_size) - 1,           \
+		.size = (_size),                                                \
+	}
+
+bool bt_mesh_hash_cache_has(const struct bt_mesh_hash_cache *cache, uint64_t key);
+
+/* Add a key, evicting the oldest one if the cache is full. */
+void bt_mesh_hash_cache_add(struct bt_mesh_hash_cache *cache, uint64_t key);
+
+/* Remove the last key added, as if it had never been. */
+void bt_mesh_hash_cache_remove_last(struct bt_mesh_hash_cache *cache);
+
+void bt_mesh_hash_cache_clear(struct bt_mesh_hash_cache *cache);
+
+#endif /* ZEPHYR_SUBSYS_BLUETOOTH_MESH_HASH_CACHE_H_ */
@@ -22,6 +22,7 @@
 #include "crypto.h"
 #include "mesh.h"
 #include "net.h"
+#include "hash_cache.h"
 #include "rpl.h"
 #include "lpn.h"
 #include "friend.h"
@@ -80,12 +81,10 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-		 seq : 17;
-	uint16_t net_idx;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
+/* Network message cache, keyed by source, 17 LSbs of the sequence number and
+ * NetKey index.
+ */
+BT_MESH_HASH_CACHE_DEFINE(msg_cache, CONFIG_BT_MESH_MSG_CACHE_SIZE);
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -117,65 +116,42 @@ K_MEM_SLAB_DEFINE(loopback_buf_pool,
 		  sizeof(struct loopback_buf),
 		  CONFIG_BT_MESH_LOOPBACK_BUFS, __alignof__(struct loopback_buf));
 
-static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static int   dup_cache_next;
+/* Cache of the last raw PDUs received, keyed by their last 8 bytes */
+BT_MESH_HASH_CACHE_DEFINE(dup_cache, CONFIG_BT_MESH_MSG_CACHE_SIZE);
 
 static bool check_dup(struct net_buf_simple *data)
 {
 	const uint8_t *tail = net_buf_simple_tail(data);
 	uint32_t val;
-	int i;
 
 	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
 
-	for (i = dup_cache_next; i > 0;) {
-		if (dup_cache[--i] == val) {
-			return true;
-		}
-	}
-
-	for (i = ARRAY_SIZE(dup_cache); i > dup_cache_next;) {
-		if (dup_cache[--i] == val) {
-			return true;
-		}
+	if (bt_mesh_hash_cache_has(&dup_cache, val)) {
+		return true;
 	}
 
-	dup_cache_next %= ARRAY_SIZE(dup_cache);
-	dup_cache[dup_cache_next++] = val;
+	bt_mesh_hash_cache_add(&dup_cache, val);
 
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu, uint16_t net_idx)
+static uint64_t msg_cache_key(uint16_t src, uint32_t seq, uint16_t net_idx)
 {
-	uint16_t i;
-
-	for (i = msg_cache_next; i > 0U;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17)) &&
-		    msg_cache[i].net_idx == net_idx) {
-			return true;
-		}
-	}
-
-	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17)) &&
-		    msg_cache[i].net_idx == net_idx) {
-			return true;
-		}
-	}
+	/* MSb of source is always 0 */
+	return (src & BIT_MASK(15)) | ((uint64_t)(seq & BIT_MASK(17)) << 15) |
+	       ((uint64_t)net_idx << 32);
+}
 
-	return false;
+static bool msg_cache_match(struct net_buf_simple *pdu, uint16_t net_idx)
+{
+	return bt_mesh_hash_cache_has(&msg_cache,
+				      msg_cache_key(SRC(pdu->data), SEQ(pdu->data), net_idx));
 }
 
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
-	msg_cache[msg_cache_next].src = rx->ctx.addr;
-	msg_cache[msg_cache_next].seq = rx->seq;
-	msg_cache[msg_cache_next].net_idx = rx->sub->net_idx;
-	msg_cache_next++;
+	bt_mesh_hash_cache_add(&msg_cache,
+			       msg_cache_key(rx->ctx.addr, rx->seq, rx->sub->net_idx));
 }
 
 static void store_iv(bool only_duration)
@@ -219,8 +195,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const struct bt_mesh_key *ke
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	bt_mesh_hash_cache_clear(&msg_cache);
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -914,9 +889,9 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 		 * it again in the future.
 		 */
 		LOG_WRN("Removing rejected message from Network Message Cache");
-		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
-		dup_cache[--dup_cache_next] = 0;
+		/* Rewind the caches now that we're not using these entries */
+		bt_mesh_hash_cache_remove_last(&msg_cache);
+		bt_mesh_hash_cache_remove_last(&dup_cache);
 		return;
 	} else if (err == -EBADMSG) {
 		LOG_DBG("Not relaying message rejected by the Transport layer");
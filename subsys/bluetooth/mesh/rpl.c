@@ -13,6 +13,7 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/hash_function.h>
 
 #include <zephyr/net_buf.h>
 #include <zephyr/bluetooth/bluetooth.h>
@@ -44,11 +45,117 @@ enum {
 };
 static ATOMIC_DEFINE(rpl_flags, RPL_FLAGS_COUNT);
 
+/* Index + 1 of the entries of replay_list, in a hash table of their sources
+ * with linear probing.
+ */
+#define RPL_BUCKETS NHPOT(2 * CONFIG_BT_MESH_CRPL)
+static uint16_t rpl_buckets[RPL_BUCKETS];
+static uint16_t rpl_count;
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static uint32_t rpl_bucket(uint16_t src)
+{
+	return sys_hash32_murmur3(&src, sizeof(src)) & (RPL_BUCKETS - 1);
+}
+
+static uint32_t rpl_bucket_next(uint32_t b)
+{
+	return (b + 1) & (RPL_BUCKETS - 1);
+}
+
+static void rpl_index_add(const struct bt_mesh_rpl *rpl)
+{
+	uint32_t b = rpl_bucket(rpl->src);
+
+	while (rpl_buckets[b]) {
+		b = rpl_bucket_next(b);
+	}
+
+	rpl_buckets[b] = rpl_idx(rpl) + 1;
+	rpl_count++;
+}
+
+/* Bucket of an entry, looked up by its source. */
+static uint32_t rpl_index_slot(const struct bt_mesh_rpl *rpl)
+{
+	uint32_t b = rpl_bucket(rpl->src);
+
+	while (rpl_buckets[b] != rpl_idx(rpl) + 1) {
+		b = rpl_bucket_next(b);
+	}
+
+	return b;
+}
+
+static void rpl_index_del(const struct bt_mesh_rpl *rpl)
+{
+	uint32_t b = rpl_index_slot(rpl);
+
+	/* Move back the entries that probed past the freed bucket. */
+	for (uint32_t n = rpl_bucket_next(b); rpl_buckets[n]; n = rpl_bucket_next(n)) {
+		uint32_t home = rpl_bucket(replay_list[rpl_buckets[n] - 1].src);
+
+		if (((n - home) & (RPL_BUCKETS - 1)) >= ((n - b) & (RPL_BUCKETS - 1))) {
+			rpl_buckets[b] = rpl_buckets[n];
+			b = n;
+		}
+	}
+
+	rpl_buckets[b] = 0U;
+	rpl_count--;
+}
+
+/* The entry at index from was copied to index to. */
+static void rpl_index_move(int from, int to)
+{
+	rpl_buckets[rpl_index_slot(&replay_list[from])] = to + 1;
+}
+
+/* Entries are only cleared in bulk, so rebuild the index then. */
+static void rpl_index_rebuild(void)
+{
+	(void)memset(rpl_buckets, 0, sizeof(rpl_buckets));
+	rpl_count = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_index_add(&replay_list[i]);
+		}
+	}
+}
+
+static struct bt_mesh_rpl *rpl_index_find(uint16_t src)
+{
+	for (uint32_t b = rpl_bucket(src); rpl_buckets[b]; b = rpl_bucket_next(b)) {
+		struct bt_mesh_rpl *rpl = &replay_list[rpl_buckets[b] - 1];
+
+		if (rpl->src == src) {
+			return rpl;
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_rpl *rpl_find_free(void)
+{
+	if (rpl_count == ARRAY_SIZE(replay_list)) {
+		return NULL;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (!replay_list[i].src) {
+			return &replay_list[i];
+		}
+	}
+
+	return NULL;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -92,7 +199,18 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	/* A segmented message holds its slot during reassembly, which another
+	 * source may have taken meanwhile.
+	 */
+	if (rpl->src != rx->ctx.addr) {
+		if (rpl->src) {
+			rpl_index_del(rpl);
+		}
+
+		rpl->src = rx->ctx.addr;
+		rpl_index_add(rpl);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -122,41 +240,41 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx, struct bt_mesh_rpl **match, bo
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		rpl = &replay_list[i];
-
+	rpl = rpl_index_find(rx->ctx.addr);
+	if (!rpl) {
 		/* Empty slot */
-		if (!rpl->src) {
+		rpl = rpl_find_free();
+		if (rpl) {
 			goto match;
 		}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (!rpl->old_iv &&
-			    atomic_test_bit(rpl_flags, PENDING_RESET) &&
-			    !atomic_test_bit(store, i)) {
-				/* Until rpl reset is finished, entry with old_iv == false and
-				 * without "store" bit set will be removed, therefore it can be
-				 * reused. If such entry is reused, "store" bit will be set and
-				 * the entry won't be removed.
-				 */
-				goto match;
-			}
+		LOG_ERR("RPL is full!");
+		return true;
+	}
 
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
+	/* Existing slot for given address */
+	i = rpl_idx(rpl);
+
+	if (!rpl->old_iv &&
+	    atomic_test_bit(rpl_flags, PENDING_RESET) &&
+	    !atomic_test_bit(store, i)) {
+		/* Until rpl reset is finished, entry with old_iv == false and
+		 * without "store" bit set will be removed, therefore it can be
+		 * reused. If such entry is reused, "store" bit will be set and
+		 * the entry won't be removed.
+		 */
+		goto match;
+	}
 
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				goto match;
-			} else {
-				return true;
-			}
-		}
+	if (rx->old_iv && !rpl->old_iv) {
+		return true;
+	}
+
+	if ((!rx->old_iv && rpl->old_iv) ||
+	    rpl->seq < rx->seq) {
+		goto match;
 	}
 
-	LOG_ERR("RPL is full!");
 	return true;
 
 match:
@@ -175,6 +293,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_index_rebuild();
 		return;
 	}
 
@@ -185,29 +304,19 @@ void bt_mesh_rpl_clear(void)
 
 static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
+	return rpl_index_find(src);
 }
 
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl = rpl_find_free();
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	if (rpl) {
+		rpl->src = src;
+		rpl_index_add(rpl);
 	}
 
-	return NULL;
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -261,6 +370,7 @@ void bt_mesh_rpl_reset(void)
 		}
 
 		(void)memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+		rpl_index_rebuild();
 	}
 }
 
@@ -287,6 +397,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		LOG_DBG("val (null)");
 		if (entry) {
+			rpl_index_del(entry);
 			(void)memset(entry, 0, sizeof(*entry));
 		} else {
 			LOG_WRN("Unable to find RPL entry for 0x%04x", src);
@@ -345,6 +456,14 @@ static void store_rpl(struct bt_mesh_rpl *entry)
 	}
 }
 
+/* Only the entries dropped while storing all of them are removed from the list. */
+static void rpl_pending_drop(const struct bt_mesh_rpl *rpl, uint16_t addr)
+{
+	if (addr == BT_MESH_ADDR_ALL_NODES && rpl->src) {
+		rpl_index_del(rpl);
+	}
+}
+
 void bt_mesh_rpl_pending_store(uint16_t addr)
 {
 	int shift = 0;
@@ -374,10 +493,12 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 
 		if (clr) {
 			clear_rpl(rpl);
+			rpl_pending_drop(rpl, addr);
 			shift++;
 		} else if (atomic_test_and_clear_bit(store, i)) {
 			if (shift > 0) {
 				replay_list[i - shift] = *rpl;
+				rpl_index_move(i, i - shift);
 			}
 
 			store_rpl(&replay_list[i - shift]);
@@ -388,9 +509,14 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 			 * Otherwise, increment shift counter.
 			 */
 			if (atomic_test_and_clear_bit(store, i)) {
-				replay_list[i - shift] = *rpl;
+				if (shift > 0) {
+					replay_list[i - shift] = *rpl;
+					rpl_index_move(i, i - shift);
+				}
+
 				atomic_set_bit(store, i - shift);
 			} else {
+				rpl_pending_drop(rpl, addr);
 				shift++;
 			}
 		}
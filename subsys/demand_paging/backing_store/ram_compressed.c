@@ -0,0 +1,218 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * RAM-based backing store keeping evicted data pages LZ4-compressed
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/spinlock.h>
+#include <lz4.h>
+
+/*
+ * Like the plain RAM backing store, locations are handed out from a fixed
+ * number of slots (CONFIG_BACKING_STORE_RAM_PAGES) and freed as soon as
+ * their data page is paged back in, so K_MEM_PAGE_FRAME_BACKED is never set.
+ *
+ * The contents of a slot however are stored compressed, spread over
+ * fixed-size chunks taken from a shared pool. Using chunks rather than a
+ * general purpose heap keeps space accounting exact: a location is only
+ * handed out if the pool can hold a worst-case, incompressible page, which
+ * is reserved until the page is actually written out and the real number
+ * of chunks needed is known. Pages which don't compress are stored as-is.
+ */
+#define CHUNK_SIZE	CONFIG_BACKING_STORE_RAM_COMPRESSION_CHUNK_SIZE
+#define PAGE_CHUNKS	DIV_ROUND_UP(CONFIG_MMU_PAGE_SIZE, CHUNK_SIZE)
+#define NUM_CHUNKS	(CONFIG_BACKING_STORE_RAM_COMPRESSION_POOL_SIZE / CHUNK_SIZE)
+#define NUM_SLOTS	CONFIG_BACKING_STORE_RAM_PAGES
+
+BUILD_ASSERT(NUM_CHUNKS >= (2 * PAGE_CHUNKS),
+	     "compression pool must be able to hold two uncompressed pages");
+BUILD_ASSERT(NUM_CHUNKS <= UINT16_MAX, "too many compression pool chunks");
+
+struct backing_slot {
+	/* Stored size in bytes, CONFIG_MMU_PAGE_SIZE if uncompressed,
+	 * 0 if the slot is only reserved and holds no data yet.
+	 */
+	uint32_t len;
+	uint16_t chunks[PAGE_CHUNKS];
+};
+
+static uint8_t chunk_pool[NUM_CHUNKS][CHUNK_SIZE] __aligned(sizeof(void *));
+static uint16_t free_chunks[NUM_CHUNKS];
+static unsigned int free_chunk_count;
+static unsigned int reserved_chunk_count;
+
+static struct backing_slot slots[NUM_SLOTS];
+static uint16_t free_slots[NUM_SLOTS];
+static unsigned int free_slot_count;
+
+static struct k_spinlock backing_lock;
+
+/* Page-out and page-in are serialized so these may be shared */
+static LZ4_stream_t lz4_state;
+static uint8_t bounce_buf[CONFIG_MMU_PAGE_SIZE] __aligned(sizeof(void *));
+
+static struct backing_slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location < (NUM_SLOTS * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static void slot_release_locked(struct backing_slot *slot)
+{
+	if (slot->len == 0U) {
+		reserved_chunk_count -= PAGE_CHUNKS;
+		return;
+	}
+
+	for (size_t i = 0; i < DIV_ROUND_UP(slot->len, CHUNK_SIZE); i++) {
+		free_chunks[free_chunk_count++] = slot->chunks[i];
+	}
+	slot->len = 0U;
+}
+
+int k_mem_paging_backing_store_location_get(struct k_mem_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	k_spinlock_key_t key;
+	unsigned int needed_chunks, needed_slots;
+	uint16_t idx;
+	int ret = 0;
+
+	ARG_UNUSED(pf);
+
+	/* Always keep room for one more page for page faults */
+	needed_slots = page_fault ? 1U : 2U;
+	needed_chunks = needed_slots * PAGE_CHUNKS;
+
+	key = k_spin_lock(&backing_lock);
+	if (free_slot_count < needed_slots ||
+	    (free_chunk_count - reserved_chunk_count) < needed_chunks) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	idx = free_slots[--free_slot_count];
+	slots[idx].len = 0U;
+	reserved_chunk_count += PAGE_CHUNKS;
+	*location = (uintptr_t)idx * CONFIG_MMU_PAGE_SIZE;
+out:
+	k_spin_unlock(&backing_lock, key);
+
+	return ret;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct backing_slot *slot = location_to_slot(location);
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&backing_lock);
+	slot_release_locked(slot);
+	free_slots[free_slot_count++] = slot - slots;
+	k_spin_unlock(&backing_lock, key);
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct backing_slot *slot = location_to_slot(location);
+	const uint8_t *src;
+	k_spinlock_key_t key;
+	size_t num_chunks;
+	int len;
+
+	/* Output is limited to less than a page so incompressible data
+	 * makes LZ4 bail out early, and gets stored as-is instead.
+	 */
+	len = LZ4_compress_fast_extState(&lz4_state, (const char *)K_MEM_SCRATCH_PAGE,
+					 (char *)bounce_buf, CONFIG_MMU_PAGE_SIZE,
+					 CONFIG_MMU_PAGE_SIZE - 1, 1);
+	if (len > 0) {
+		src = bounce_buf;
+	} else {
+		src = K_MEM_SCRATCH_PAGE;
+		len = CONFIG_MMU_PAGE_SIZE;
+	}
+	num_chunks = DIV_ROUND_UP(len, CHUNK_SIZE);
+
+	key = k_spin_lock(&backing_lock);
+	if (slot->len == 0U) {
+		/* Trade the worst-case reservation for the actual chunks */
+		reserved_chunk_count -= PAGE_CHUNKS;
+	} else {
+		/* Overwriting previous contents */
+		slot_release_locked(slot);
+	}
+	__ASSERT(free_chunk_count >= num_chunks, "chunk count mismatch");
+	for (size_t i = 0; i < num_chunks; i++) {
+		slot->chunks[i] = free_chunks[--free_chunk_count];
+	}
+	slot->len = len;
+	k_spin_unlock(&backing_lock, key);
+
+	for (size_t i = 0, offset = 0; i < num_chunks; i++, offset += CHUNK_SIZE) {
+		(void)memcpy(chunk_pool[slot->chunks[i]], src + offset,
+			     MIN(CHUNK_SIZE, len - offset));
+	}
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct backing_slot *slot = location_to_slot(location);
+	size_t num_chunks = DIV_ROUND_UP(slot->len, CHUNK_SIZE);
+	uint8_t *dst;
+	int ret;
+
+	__ASSERT(slot->len != 0U, "location 0x%lx holds no data", location);
+
+	dst = (slot->len == CONFIG_MMU_PAGE_SIZE) ? K_MEM_SCRATCH_PAGE : bounce_buf;
+	for (size_t i = 0, offset = 0; i < num_chunks; i++, offset += CHUNK_SIZE) {
+		(void)memcpy(dst + offset, chunk_pool[slot->chunks[i]],
+			     MIN(CHUNK_SIZE, slot->len - offset));
+	}
+
+	if (dst == bounce_buf) {
+		ret = LZ4_decompress_safe((const char *)bounce_buf,
+					  (char *)K_MEM_SCRATCH_PAGE,
+					  slot->len, CONFIG_MMU_PAGE_SIZE);
+		__ASSERT(ret == CONFIG_MMU_PAGE_SIZE,
+			 "corrupted data page at location 0x%lx (%d)",
+			 location, ret);
+		(void)ret;
+	}
+}
+
+void k_mem_paging_backing_store_page_finalize(struct k_mem_page_frame *pf,
+					      uintptr_t location)
+{
+#ifdef CONFIG_DEMAND_MAPPING
+	/* ignore those */
+	if (location == ARCH_UNPAGED_ANON_ZERO || location == ARCH_UNPAGED_ANON_UNINIT) {
+		return;
+	}
+#endif
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	for (unsigned int i = 0; i < NUM_CHUNKS; i++) {
+		free_chunks[i] = i;
+	}
+	free_chunk_count = NUM_CHUNKS;
+	reserved_chunk_count = 0U;
+
+	for (unsigned int i = 0; i < NUM_SLOTS; i++) {
+		free_slots[i] = i;
+	}
+	free_slot_count = NUM_SLOTS;
+}
@@ -0,0 +1,21 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_ACCESS_INTERNAL_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_ACCESS_INTERNAL_H_
+
+#include <zephyr/drivers/disk.h>
+
+/**
+ * @brief Look up a registered disk by name.
+ *
+ * @param name Disk name.
+ *
+ * @return Disk information, or NULL if no such disk is registered.
+ */
+struct disk_info *disk_access_get_di(const char *name);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_ACCESS_INTERNAL_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/storage/disk_access_rtio.h>
+#include <zephyr/rtio/work.h>
+
+#include "disk_access_internal.h"
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk, CONFIG_DISK_LOG_LEVEL);
+
+static int disk_access_iodev_rw(struct disk_info *disk, struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	uint32_t sector_size;
+	int rc;
+
+	rc = disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE, &sector_size);
+	if (rc != 0) {
+		return rc;
+	}
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		if (sqe->rx.buf_len == 0 || (sqe->rx.buf_len % sector_size) != 0) {
+			return -EINVAL;
+		}
+		return disk->ops->read(disk, sqe->rx.buf, disk_access_sqe_start_sector(iodev_sqe),
+				       sqe->rx.buf_len / sector_size);
+	case RTIO_OP_TX:
+		if (sqe->tx.buf_len == 0 || (sqe->tx.buf_len % sector_size) != 0) {
+			return -EINVAL;
+		}
+		return disk->ops->write(disk, sqe->tx.buf, disk_access_sqe_start_sector(iodev_sqe),
+					sqe->tx.buf_len / sector_size);
+	case RTIO_OP_NOP:
+		return 0;
+	default:
+		LOG_ERR("Invalid op code %d for submission %p", sqe->op, (void *)sqe);
+		return -ENOTSUP;
+	}
+}
+
+static void disk_access_iodev_work_handler(struct rtio_iodev_sqe *txn_first)
+{
+	const struct disk_access_iodev_data *data = txn_first->sqe.iodev->data;
+	struct rtio_iodev_sqe *txn_curr = txn_first;
+	int rc;
+
+	/* A transaction runs in order and stops at the first error */
+	do {
+		rc = disk_access_iodev_rw(data->disk, txn_curr);
+		txn_curr = rtio_txn_next(txn_curr);
+	} while (rc == 0 && txn_curr != NULL);
+
+	if (rc != 0) {
+		rtio_iodev_sqe_err(txn_first, rc);
+	} else {
+		rtio_iodev_sqe_ok(txn_first, 0);
+	}
+}
+
+void disk_access_iodev_submit_fallback(struct disk_info *disk, struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	ARG_UNUSED(disk);
+
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, disk_access_iodev_work_handler);
+}
+
+static void disk_access_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct disk_access_iodev_data *data = iodev_sqe->sqe.iodev->data;
+	struct disk_info *disk = data->disk;
+
+	if (disk == NULL) {
+		/* Lookups are cheap and ISR safe, racing ones find the same disk */
+		disk = disk_access_get_di(data->name);
+		if (disk == NULL || disk->ops == NULL) {
+			rtio_iodev_sqe_err(iodev_sqe, -ENODEV);
+			return;
+		}
+		data->disk = disk;
+	}
+
+	if (disk->ops->submit != NULL && (iodev_sqe->sqe.flags & RTIO_SQE_TRANSACTION) == 0U) {
+		disk->ops->submit(disk, iodev_sqe);
+	} else {
+		disk_access_iodev_submit_fallback(disk, iodev_sqe);
+	}
+}
+
+const struct rtio_iodev_api disk_access_iodev_api = {
+	.submit = disk_access_iodev_submit,
+};
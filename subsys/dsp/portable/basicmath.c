@@ -0,0 +1,418 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Portable implementation of the basic math functions, with the results of the
+ * CMSIS-DSP reference implementation. The loops are kept simple, without
+ * loop-carried dependencies, so that the compiler vectorizes them for the
+ * target. The ones it cannot vectorize are implemented in zdsp_simd.h.
+ */
+
+#include <zephyr/dsp/dsp.h>
+#include <zephyr/sys/util.h>
+
+#include "zdsp_simd.h"
+
+static inline q7_t sat_q7(int32_t x)
+{
+	return (q7_t)CLAMP(x, INT8_MIN, INT8_MAX);
+}
+
+static inline q15_t sat_q15(int32_t x)
+{
+	return (q15_t)CLAMP(x, INT16_MIN, INT16_MAX);
+}
+
+static inline q31_t sat_q31(q63_t x)
+{
+	return (q31_t)CLAMP(x, INT32_MIN, INT32_MAX);
+}
+
+void zdsp_mult_q7(const q7_t *src_a, const q7_t *src_b, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q7((src_a[i] * src_b[i]) >> 7);
+	}
+}
+
+void zdsp_mult_q15(const q15_t *src_a, const q15_t *src_b, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q15((src_a[i] * src_b[i]) >> 15);
+	}
+}
+
+void zdsp_mult_q31(const q31_t *src_a, const q31_t *src_b, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		q31_t prod = (q31_t)(((q63_t)src_a[i] * src_b[i]) >> 32);
+
+		/* Only -1 * -1 overflows, saturating to 0x7FFFFFFE as CMSIS-DSP does */
+		dst[i] = (q31_t)((uint32_t)MIN(prod, INT32_MAX >> 1) << 1);
+	}
+}
+
+void zdsp_mult_f32(const float32_t *src_a, const float32_t *src_b, float32_t *dst,
+		   uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = src_a[i] * src_b[i];
+	}
+}
+
+void zdsp_add_f32(const float32_t *src_a, const float32_t *src_b, float32_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = src_a[i] + src_b[i];
+	}
+}
+
+void zdsp_add_q7(const q7_t *src_a, const q7_t *src_b, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = ZDSP_SIMD(add_q7, src_a, src_b, dst, block_size); i < block_size; i++) {
+		dst[i] = sat_q7(src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_add_q15(const q15_t *src_a, const q15_t *src_b, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = ZDSP_SIMD(add_q15, src_a, src_b, dst, block_size); i < block_size;
+	     i++) {
+		dst[i] = sat_q15(src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_add_q31(const q31_t *src_a, const q31_t *src_b, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src_a[i] + src_b[i]);
+	}
+}
+
+void zdsp_sub_f32(const float32_t *src_a, const float32_t *src_b, float32_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = src_a[i] - src_b[i];
+	}
+}
+
+void zdsp_sub_q7(const q7_t *src_a, const q7_t *src_b, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = ZDSP_SIMD(sub_q7, src_a, src_b, dst, block_size); i < block_size; i++) {
+		dst[i] = sat_q7(src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_sub_q15(const q15_t *src_a, const q15_t *src_b, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = ZDSP_SIMD(sub_q15, src_a, src_b, dst, block_size); i < block_size;
+	     i++) {
+		dst[i] = sat_q15(src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_sub_q31(const q31_t *src_a, const q31_t *src_b, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src_a[i] - src_b[i]);
+	}
+}
+
+void zdsp_scale_f32(const float32_t *src, float32_t scale, float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+void zdsp_scale_q7(const q7_t *src, q7_t scale_fract, int8_t shift, q7_t *dst,
+		   uint32_t block_size)
+{
+	int8_t k_shift = 7 - shift;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q7((src[i] * scale_fract) >> k_shift);
+	}
+}
+
+void zdsp_scale_q15(const q15_t *src, q15_t scale_fract, int8_t shift, q15_t *dst,
+		    uint32_t block_size)
+{
+	int8_t k_shift = 15 - shift;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q15((src[i] * scale_fract) >> k_shift);
+	}
+}
+
+void zdsp_scale_q31(const q31_t *src, q31_t scale_fract, int8_t shift, q31_t *dst,
+		    uint32_t block_size)
+{
+	int8_t k_shift = shift + 1;
+
+	if (k_shift >= 0) {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			q63_t out = (((q63_t)src[i] * scale_fract) >> 32) * ((q63_t)1 << k_shift);
+
+			dst[i] = sat_q31(out);
+		}
+	} else {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = (q31_t)((((q63_t)src[i] * scale_fract) >> 32) >> -k_shift);
+		}
+	}
+}
+
+void zdsp_abs_f32(const float32_t *src, float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (src[i] < 0.0f) ? -src[i] : src[i];
+	}
+}
+
+void zdsp_abs_q7(const q7_t *src, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q7((src[i] < 0) ? -src[i] : src[i]);
+	}
+}
+
+void zdsp_abs_q15(const q15_t *src, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q15((src[i] < 0) ? -src[i] : src[i]);
+	}
+}
+
+void zdsp_abs_q31(const q31_t *src, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q31((src[i] < 0) ? -(q63_t)src[i] : src[i]);
+	}
+}
+
+void zdsp_dot_prod_f32(const float32_t *src_a, const float32_t *src_b, uint32_t block_size,
+		       float32_t *result)
+{
+	float32_t sum[4] = {0.0f};
+	float32_t simd = 0.0f;
+	uint32_t i = ZDSP_SIMD(dot_prod_f32, src_a, src_b, block_size, &simd);
+
+	/* Independent partial sums, as the compiler may not reassociate them */
+	for (; i + 4U <= block_size; i += 4U) {
+		sum[0] += src_a[i] * src_b[i];
+		sum[1] += src_a[i + 1U] * src_b[i + 1U];
+		sum[2] += src_a[i + 2U] * src_b[i + 2U];
+		sum[3] += src_a[i + 3U] * src_b[i + 3U];
+	}
+
+	for (; i < block_size; i++) {
+		sum[0] += src_a[i] * src_b[i];
+	}
+
+	*result = simd + (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+void zdsp_dot_prod_q7(const q7_t *src_a, const q7_t *src_b, uint32_t block_size, q31_t *result)
+{
+	q31_t sum = 0;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		sum += src_a[i] * src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_dot_prod_q15(const q15_t *src_a, const q15_t *src_b, uint32_t block_size,
+		       q63_t *result)
+{
+	q63_t sum = 0;
+	uint32_t i = ZDSP_SIMD(dot_prod_q15, src_a, src_b, block_size, &sum);
+
+	for (; i < block_size; i++) {
+		sum += src_a[i] * src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_dot_prod_q31(const q31_t *src_a, const q31_t *src_b, uint32_t block_size,
+		       q63_t *result)
+{
+	q63_t sum = 0;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		sum += ((q63_t)src_a[i] * src_b[i]) >> 14;
+	}
+
+	*result = sum;
+}
+
+void zdsp_shift_q7(const q7_t *src, int8_t shift_bits, q7_t *dst, uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = sat_q7(src[i] * (1 << shift_bits));
+		}
+	} else {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = (q7_t)(src[i] >> -shift_bits);
+		}
+	}
+}
+
+void zdsp_shift_q15(const q15_t *src, int8_t shift_bits, q15_t *dst, uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = sat_q15(src[i] * (1 << shift_bits));
+		}
+	} else {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = (q15_t)(src[i] >> -shift_bits);
+		}
+	}
+}
+
+void zdsp_shift_q31(const q31_t *src, int8_t shift_bits, q31_t *dst, uint32_t block_size)
+{
+	if (shift_bits >= 0) {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = sat_q31((q63_t)src[i] * ((q63_t)1 << shift_bits));
+		}
+	} else {
+		for (uint32_t i = 0U; i < block_size; i++) {
+			dst[i] = src[i] >> -shift_bits;
+		}
+	}
+}
+
+void zdsp_offset_f32(const float32_t *src, float32_t offset, float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = src[i] + offset;
+	}
+}
+
+void zdsp_offset_q7(const q7_t *src, q7_t offset, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q7(src[i] + offset);
+	}
+}
+
+void zdsp_offset_q15(const q15_t *src, q15_t offset, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q15(src[i] + offset);
+	}
+}
+
+void zdsp_offset_q31(const q31_t *src, q31_t offset, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q31((q63_t)src[i] + offset);
+	}
+}
+
+void zdsp_negate_f32(const float32_t *src, float32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = -src[i];
+	}
+}
+
+void zdsp_negate_q7(const q7_t *src, q7_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q7(-src[i]);
+	}
+}
+
+void zdsp_negate_q15(const q15_t *src, q15_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q15(-src[i]);
+	}
+}
+
+void zdsp_negate_q31(const q31_t *src, q31_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = sat_q31(-(q63_t)src[i]);
+	}
+}
+
+#define ZDSP_BITWISE_FUNC(name, type, op)                                                          \
+	void zdsp_##name(const type *src_a, const type *src_b, type *dst, uint32_t block_size)     \
+	{                                                                                          \
+		for (uint32_t i = 0U; i < block_size; i++) {                                       \
+			dst[i] = src_a[i] op src_b[i];                                             \
+		}                                                                                  \
+	}
+
+ZDSP_BITWISE_FUNC(and_u8, uint8_t, &)
+ZDSP_BITWISE_FUNC(and_u16, uint16_t, &)
+ZDSP_BITWISE_FUNC(and_u32, uint32_t, &)
+ZDSP_BITWISE_FUNC(or_u8, uint8_t, |)
+ZDSP_BITWISE_FUNC(or_u16, uint16_t, |)
+ZDSP_BITWISE_FUNC(or_u32, uint32_t, |)
+ZDSP_BITWISE_FUNC(xor_u8, uint8_t, ^)
+ZDSP_BITWISE_FUNC(xor_u16, uint16_t, ^)
+ZDSP_BITWISE_FUNC(xor_u32, uint32_t, ^)
+
+void zdsp_not_u8(const uint8_t *src, uint8_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (uint8_t)~src[i];
+	}
+}
+
+void zdsp_not_u16(const uint16_t *src, uint16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (uint16_t)~src[i];
+	}
+}
+
+void zdsp_not_u32(const uint32_t *src, uint32_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = ~src[i];
+	}
+}
+
+void zdsp_clip_f32(const float32_t *src, float32_t *dst, float32_t low, float32_t high,
+		   uint32_t num_samples)
+{
+	for (uint32_t i = 0U; i < num_samples; i++) {
+		dst[i] = CLAMP(src[i], low, high);
+	}
+}
+
+void zdsp_clip_q31(const q31_t *src, q31_t *dst, q31_t low, q31_t high, uint32_t num_samples)
+{
+	for (uint32_t i = 0U; i < num_samples; i++) {
+		dst[i] = CLAMP(src[i], low, high);
+	}
+}
+
+void zdsp_clip_q15(const q15_t *src, q15_t *dst, q15_t low, q15_t high, uint32_t num_samples)
+{
+	for (uint32_t i = 0U; i < num_samples; i++) {
+		dst[i] = CLAMP(src[i], low, high);
+	}
+}
+
+void zdsp_clip_q7(const q7_t *src, q7_t *dst, q7_t low, q7_t high, uint32_t num_samples)
+{
+	for (uint32_t i = 0U; i < num_samples; i++) {
+		dst[i] = CLAMP(src[i], low, high);
+	}
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Portable implementation of the 16 bit floating point basic math functions.
+ * The computations are done in single precision, which also keeps the dot
+ * product from losing precision as it grows.
+ */
+
+#include <zephyr/dsp/basicmath_f16.h>
+#include <zephyr/sys/util.h>
+
+void zdsp_mult_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		   uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] * (float32_t)src_b[i];
+	}
+}
+
+void zdsp_add_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] + (float32_t)src_b[i];
+	}
+}
+
+void zdsp_sub_f16(const float16_t *src_a, const float16_t *src_b, float16_t *dst,
+		  uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (float32_t)src_a[i] - (float32_t)src_b[i];
+	}
+}
+
+void zdsp_scale_f16(const float16_t *src, float16_t scale, float16_t *dst, uint32_t block_size)
+{
+	float32_t factor = scale;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (float32_t)src[i] * factor;
+	}
+}
+
+void zdsp_abs_f16(const float16_t *src, float16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		float32_t x = src[i];
+
+		dst[i] = (x < 0.0f) ? -x : x;
+	}
+}
+
+void zdsp_dot_prod_f16(const float16_t *src_a, const float16_t *src_b, uint32_t block_size,
+		       float16_t *result)
+{
+	float32_t sum = 0.0f;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		sum += (float32_t)src_a[i] * (float32_t)src_b[i];
+	}
+
+	*result = sum;
+}
+
+void zdsp_offset_f16(const float16_t *src, float16_t offset, float16_t *dst, uint32_t block_size)
+{
+	float32_t bias = offset;
+
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = (float32_t)src[i] + bias;
+	}
+}
+
+void zdsp_negate_f16(const float16_t *src, float16_t *dst, uint32_t block_size)
+{
+	for (uint32_t i = 0U; i < block_size; i++) {
+		dst[i] = -(float32_t)src[i];
+	}
+}
+
+void zdsp_clip_f16(const float16_t *src, float16_t *dst, float16_t low, float16_t high,
+		   uint32_t num_samples)
+{
+	float32_t lo = low, hi = high;
+
+	for (uint32_t i = 0U; i < num_samples; i++) {
+		dst[i] = CLAMP((float32_t)src[i], lo, hi);
+	}
+}
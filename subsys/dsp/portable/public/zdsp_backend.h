@@ -0,0 +1,15 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef SUBSYS_DSP_PORTABLE_PUBLIC_ZDSP_BACKEND_H_
+#define SUBSYS_DSP_PORTABLE_PUBLIC_ZDSP_BACKEND_H_
+
+/*
+ * The portable backend implements the functions declared by <zephyr/dsp/basicmath.h>
+ * in subsys/dsp/portable, so there is nothing to inline here.
+ */
+
+#endif /* SUBSYS_DSP_PORTABLE_PUBLIC_ZDSP_BACKEND_H_ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Explicitly vectorized kernels of the portable DSP backend, for the functions
+ * the compiler does not vectorize by itself: saturating q7/q15 arithmetic and
+ * the dot products, which need reassociating the sum.
+ *
+ * ZDSP_SIMD(op, ...) calls zdsp_simd_<op>() and evaluates to the number of
+ * samples it processed, leaving the remaining ones to the scalar loop of the
+ * caller. It evaluates to 0 on the targets without SSE2, which only use the
+ * scalar loops.
+ */
+
+#ifndef SUBSYS_DSP_PORTABLE_ZDSP_SIMD_H_
+#define SUBSYS_DSP_PORTABLE_ZDSP_SIMD_H_
+
+#include <stdint.h>
+#include <zephyr/dsp/types.h>
+
+#if defined(__SSE2__)
+
+#include <emmintrin.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#define ZDSP_SIMD(op, ...) zdsp_simd_##op(__VA_ARGS__)
+
+#ifdef __AVX2__
+#define ZDSP_SIMD_ELEMENTWISE(name, type, bytes, intrinsic)                                        \
+	static inline uint32_t zdsp_simd_##name(const type *src_a, const type *src_b, type *dst,   \
+						uint32_t block_size)                               \
+	{                                                                                          \
+		uint32_t n = block_size & ~(32U / (bytes) - 1U);                                   \
+                                                                                                   \
+		for (uint32_t i = 0U; i < n; i += 32U / (bytes)) {                                 \
+			__m256i a = _mm256_loadu_si256((const __m256i *)&src_a[i]);                \
+			__m256i b = _mm256_loadu_si256((const __m256i *)&src_b[i]);                \
+                                                                                                   \
+			_mm256_storeu_si256((__m256i *)&dst[i], intrinsic(a, b));                  \
+		}                                                                                  \
+                                                                                                   \
+		return n;                                                                          \
+	}
+
+ZDSP_SIMD_ELEMENTWISE(add_q7, q7_t, 1, _mm256_adds_epi8)
+ZDSP_SIMD_ELEMENTWISE(sub_q7, q7_t, 1, _mm256_subs_epi8)
+ZDSP_SIMD_ELEMENTWISE(add_q15, q15_t, 2, _mm256_adds_epi16)
+ZDSP_SIMD_ELEMENTWISE(sub_q15, q15_t, 2, _mm256_subs_epi16)
+#else
+#define ZDSP_SIMD_ELEMENTWISE(name, type, bytes, intrinsic)                                        \
+	static inline uint32_t zdsp_simd_##name(const type *src_a, const type *src_b, type *dst,   \
+						uint32_t block_size)                               \
+	{                                                                                          \
+		uint32_t n = block_size & ~(16U / (bytes) - 1U);                                   \
+                                                                                                   \
+		for (uint32_t i = 0U; i < n; i += 16U / (bytes)) {                                 \
+			__m128i a = _mm_loadu_si128((const __m128i *)&src_a[i]);                   \
+			__m128i b = _mm_loadu_si128((const __m128i *)&src_b[i]);                   \
+                                                                                                   \
+			_mm_storeu_si128((__m128i *)&dst[i], intrinsic(a, b));                     \
+		}                                                                                  \
+                                                                                                   \
+		return n;                                                                          \
+	}
+
+ZDSP_SIMD_ELEMENTWISE(add_q7, q7_t, 1, _mm_adds_epi8)
+ZDSP_SIMD_ELEMENTWISE(sub_q7, q7_t, 1, _mm_subs_epi8)
+ZDSP_SIMD_ELEMENTWISE(add_q15, q15_t, 2, _mm_adds_epi16)
+ZDSP_SIMD_ELEMENTWISE(sub_q15, q15_t, 2, _mm_subs_epi16)
+#endif /* __AVX2__ */
+
+static inline uint32_t zdsp_simd_dot_prod_f32(const float32_t *src_a, const float32_t *src_b,
+					      uint32_t block_size, float32_t *result)
+{
+	uint32_t n = block_size & ~7U;
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+	float32_t lanes[4];
+
+	/* Two accumulators hide the latency of the additions */
+	for (uint32_t i = 0U; i < n; i += 8U) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&src_a[i]), _mm_loadu_ps(&src_b[i])));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&src_a[i + 4U]),
+						   _mm_loadu_ps(&src_b[i + 4U])));
+	}
+
+	_mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+	*result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+	return n;
+}
+
+/*
+ * _mm_madd_epi16() wraps to INT32_MIN when both pairs of samples are -32768,
+ * instead of +2^31. Such lanes are counted and corrected once at the end.
+ */
+static inline uint32_t zdsp_simd_dot_prod_q15(const q15_t *src_a, const q15_t *src_b,
+					      uint32_t block_size, q63_t *result)
+{
+	uint32_t n = block_size & ~7U;
+	const __m128i wrapped = _mm_set1_epi32(INT32_MIN);
+	__m128i acc = _mm_setzero_si128();
+	__m128i count = _mm_setzero_si128();
+	int64_t sums[2];
+	int32_t counts[4];
+
+	for (uint32_t i = 0U; i < n; i += 8U) {
+		__m128i a = _mm_loadu_si128((const __m128i *)&src_a[i]);
+		__m128i b = _mm_loadu_si128((const __m128i *)&src_b[i]);
+		__m128i prod = _mm_madd_epi16(a, b);
+		__m128i sign = _mm_srai_epi32(prod, 31);
+
+		count = _mm_sub_epi32(count, _mm_cmpeq_epi32(prod, wrapped));
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(prod, sign));
+		acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(prod, sign));
+	}
+
+	_mm_storeu_si128((__m128i *)sums, acc);
+	_mm_storeu_si128((__m128i *)counts, count);
+	*result = sums[0] + sums[1] +
+		  (((q63_t)counts[0] + counts[1] + counts[2] + counts[3]) << 32);
+
+	return n;
+}
+
+#else
+
+#define ZDSP_SIMD(op, ...) 0U
+
+#endif
+
+#endif /* SUBSYS_DSP_PORTABLE_ZDSP_SIMD_H_ */
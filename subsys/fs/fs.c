@@ -15,6 +15,9 @@
 #include <zephyr/fs/fs.h>
 #include <zephyr/fs/fs_sys.h>
 #include <zephyr/sys/check.h>
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+#include <zephyr/rtio/work.h>
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(fs, CONFIG_FS_LOG_LEVEL);
@@ -128,6 +131,10 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 }
 
 /* File operations */
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+static const struct rtio_iodev_api fs_iodev_api;
+#endif
+
 int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 {
 	struct fs_mount_t *mp;
@@ -183,6 +190,11 @@ int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 	/* Copy flags to zfp for use with other fs_ API calls */
 	zfp->flags = flags;
 
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+	zfp->iodev.api = &fs_iodev_api;
+	zfp->iodev.data = zfp;
+#endif
+
 	if (truncate_file) {
 		/* Truncate the opened file to 0 length */
 		rc = mp->fs->truncate(zfp, 0);
@@ -259,6 +271,98 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	return rc;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+static void fs_iodev_work_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	const struct rtio_sqe *sqe = &iodev_sqe->sqe;
+	struct fs_file_t *zfp = sqe->iodev->data;
+	ssize_t rc;
+
+	switch (sqe->op) {
+	case RTIO_OP_RX:
+		rc = fs_read(zfp, sqe->rx.buf, sqe->rx.buf_len);
+		break;
+	case RTIO_OP_TX:
+		rc = fs_write(zfp, sqe->tx.buf, sqe->tx.buf_len);
+		break;
+	default:
+		rc = -ENOTSUP;
+		break;
+	}
+
+	if (rc < 0) {
+		rtio_iodev_sqe_err(iodev_sqe, (int)rc);
+	} else {
+		rtio_iodev_sqe_ok(iodev_sqe, (int)rc);
+	}
+}
+
+static void fs_iodev_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req;
+
+	/* The result of a file operation is a byte count, which cannot be
+	 * reported for several of them at once.
+	 */
+	if ((iodev_sqe->sqe.flags & RTIO_SQE_TRANSACTION) != 0U) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+		return;
+	}
+
+	req = rtio_work_req_alloc();
+	if (req == NULL) {
+		rtio_iodev_sqe_err(iodev_sqe, -ENOMEM);
+		return;
+	}
+
+	rtio_work_req_submit(req, iodev_sqe, fs_iodev_work_handler);
+}
+
+static const struct rtio_iodev_api fs_iodev_api = {
+	.submit = fs_iodev_submit,
+};
+
+static int fs_submit_async(struct fs_file_t *zfp, bool write, void *ptr, size_t size,
+			   struct rtio *r, void *userdata)
+{
+	struct rtio_sqe *sqe;
+
+	if (zfp->mp == NULL) {
+		return -EBADF;
+	}
+
+	/* The completion result is a 32 bit byte count */
+	if (size > INT32_MAX) {
+		return -EINVAL;
+	}
+
+	sqe = rtio_sqe_acquire(r);
+	if (sqe == NULL) {
+		return -ENOMEM;
+	}
+
+	if (write) {
+		fs_sqe_prep_write(sqe, zfp, ptr, size, userdata);
+	} else {
+		fs_sqe_prep_read(sqe, zfp, ptr, size, userdata);
+	}
+
+	return rtio_submit(r, 0);
+}
+
+int fs_read_async(struct fs_file_t *zfp, void *ptr, size_t size, struct rtio *r,
+		  void *userdata)
+{
+	return fs_submit_async(zfp, false, ptr, size, r, userdata);
+}
+
+int fs_write_async(struct fs_file_t *zfp, const void *ptr, size_t size, struct rtio *r,
+		   void *userdata)
+{
+	return fs_submit_async(zfp, true, (void *)ptr, size, r, userdata);
+}
+#endif /* CONFIG_FILE_SYSTEM_RTIO */
+
 int fs_seek(struct fs_file_t *zfp, off_t offset, int whence)
 {
 	int rc = -ENOTSUP;
@@ -61,12 +61,34 @@ struct disco_func_entry {
 	uint64_t delta_t;			/* Accumulated (per function) delta time */
 	void *addr;				/* Function address/ID */
 	uint16_t call_depth;			/* Call depth */
+	uint32_t calls;				/* Number of calls */
+	uint64_t incl_cycles;			/* Accumulated cycles, callees included */
+	uint64_t excl_cycles;			/* Accumulated cycles, callees excluded */
 };
 
 #define MAX_NUM_DISCO_FUNC CONFIG_INSTRUMENTATION_MODE_STATISTICAL_MAX_NUM_FUNC
 static int num_disco_func;
 struct disco_func_entry disco_func[MAX_NUM_DISCO_FUNC] = { 0 };
 
+/*
+ * Shadow call stack of each CPU, to split the cycles of a call between the
+ * function and its callees. Calls deeper than the stack are accounted to the
+ * deepest frame.
+ */
+#define MAX_SHADOW_DEPTH CONFIG_INSTRUMENTATION_MODE_STATISTICAL_STACK_DEPTH
+struct shadow_frame {
+	int func;				/* Index in disco_func */
+	timing_t entry;				/* Counter at function entry */
+	uint64_t callee_cycles;			/* Cycles spent in callees */
+};
+
+struct shadow_stack {
+	int depth;
+	struct shadow_frame frames[MAX_SHADOW_DEPTH];
+};
+
+static struct shadow_stack shadow_stacks[CONFIG_MP_MAX_NUM_CPUS];
+
 /* To track the number of unbalanced/spurious entry/exist pairs, for debugging */
 static int unbalanced;
 #endif
@@ -336,6 +358,86 @@ void instr_dump_deltas_uart(void)
 }
 
 #if defined(CONFIG_INSTRUMENTATION_MODE_STATISTICAL)
+__no_instrumentation__
+void instr_profile_foreach(instr_profile_cb_t cb, void *user_data)
+{
+	struct instr_func_profile profile;
+	bool enabled = instr_enabled();
+
+	/* Keep the walk out of the statistics */
+	instr_disable();
+
+	for (int i = 0; i < num_disco_func; i++) {
+		profile.addr = disco_func[i].addr;
+		profile.calls = disco_func[i].calls;
+		profile.inclusive_cycles = disco_func[i].incl_cycles;
+		profile.exclusive_cycles = disco_func[i].excl_cycles;
+
+		if (!cb(&profile, user_data)) {
+			break;
+		}
+	}
+
+	if (enabled) {
+		instr_enable();
+	}
+}
+
+__no_instrumentation__
+static void push_shadow_frame(int func)
+{
+	struct shadow_stack *stack = &shadow_stacks[arch_curr_cpu()->id];
+
+	if (stack->depth < MAX_SHADOW_DEPTH) {
+		stack->frames[stack->depth].func = func;
+		stack->frames[stack->depth].entry = timing_counter_get();
+		stack->frames[stack->depth].callee_cycles = 0;
+	}
+
+	stack->depth++;
+}
+
+__no_instrumentation__
+static void pop_shadow_frame(int func)
+{
+	struct shadow_stack *stack = &shadow_stacks[arch_curr_cpu()->id];
+	timing_t now = timing_counter_get();
+	struct shadow_frame *frame;
+	uint64_t cycles;
+	int depth = stack->depth;
+
+	if (depth > MAX_SHADOW_DEPTH) {
+		stack->depth--;
+		return;
+	}
+
+	/*
+	 * Frames above the returning function belong to calls which did not
+	 * return on this CPU, e.g. of a thread switched out, drop them.
+	 */
+	while (depth > 0 && stack->frames[depth - 1].func != func) {
+		depth--;
+	}
+
+	if (depth == 0) {
+		return;
+	}
+
+	stack->depth = depth - 1;
+	frame = &stack->frames[depth - 1];
+	cycles = timing_cycles_get(&frame->entry, &now);
+
+	disco_func[func].excl_cycles += cycles - MIN(cycles, frame->callee_cycles);
+	if (disco_func[func].call_depth == 0) {
+		/* Recursive calls are included in the outermost one */
+		disco_func[func].incl_cycles += cycles;
+	}
+
+	if (depth > 1) {
+		stack->frames[depth - 2].callee_cycles += cycles;
+	}
+}
+
 __no_instrumentation__
 void push_callee_timestamp(void *callee)
 {
@@ -368,6 +470,9 @@ void push_callee_timestamp(void *callee)
 		disco_func[curr_func].entry_timestamp = instr_timestamp_ns();
 	}
 
+	disco_func[curr_func].calls++;
+	push_shadow_frame(curr_func);
+
 	/* Update call depth if not reached out maximum call depth */
 	if (disco_func[curr_func].call_depth < MAX_CALL_DEPTH) {
 		disco_func[curr_func].call_depth++;
@@ -399,6 +504,8 @@ void pop_callee_timestamp(void *callee)
 
 			}
 
+			pop_shadow_frame(curr_func);
+
 			return;
 		}
 	}
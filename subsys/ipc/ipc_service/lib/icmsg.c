@@ -110,6 +110,30 @@ static uint32_t data_available(struct icmsg_data_t *dev_data)
 	return pbuf_read(dev_data->rx_pb, NULL, 0);
 }
 
+/* Must be called right after writing a message of len bytes, with the Tx buffer reserved. */
+static bool notify_needed(struct icmsg_data_t *dev_data, uint16_t len)
+{
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE
+	int unread = pbuf_unread(dev_data->tx_pb);
+
+	/* The remote reads until its buffer is empty, so it has to be woken up
+	 * only if it had read everything sent before this message.
+	 */
+	if (unread < 0 || (uint32_t)unread <= PBUF_PACKET_SIZE(len) ||
+	    ++dev_data->unnotified >= CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE_MAX) {
+		dev_data->unnotified = 0;
+		return true;
+	}
+
+	return false;
+#else
+	ARG_UNUSED(dev_data);
+	ARG_UNUSED(len);
+
+	return true;
+#endif
+}
+
 #ifdef CONFIG_MULTITHREADING
 static void submit_mbox_work(struct icmsg_data_t *dev_data)
 {
@@ -337,10 +361,15 @@ static void workq_callback_process(struct k_work *item)
 	bool rerun;
 	struct icmsg_data_t *dev_data = CONTAINER_OF(item, struct icmsg_data_t, mbox_work);
 
-	rerun = callback_process(dev_data);
-	if (rerun) {
-		submit_mbox_work(dev_data);
+	for (int i = 0; i < CONFIG_IPC_SERVICE_ICMSG_RX_BATCH; i++) {
+		rerun = callback_process(dev_data);
+		if (!rerun) {
+			return;
+		}
 	}
+
+	/* Let other work items run before handling the remaining messages. */
+	submit_mbox_work(dev_data);
 }
 #endif /* def CONFIG_MULTITHREADING */
 
@@ -411,6 +440,9 @@ int icmsg_open(const struct icmsg_config_t *conf,
 #ifdef CONFIG_IPC_SERVICE_ICMSG_SHMEM_ACCESS_SYNC
 	k_mutex_init(&dev_data->tx_lock);
 #endif
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE
+	dev_data->unnotified = 0;
+#endif
 
 	ret = pbuf_rx_init(dev_data->rx_pb);
 
@@ -501,6 +533,7 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	int write_ret;
 	int release_ret;
 	int sent_bytes;
+	bool notify = false;
 	uint32_t state = atomic_get(&dev_data->state);
 
 	if (!is_endpoint_ready(state)) {
@@ -521,6 +554,9 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	}
 
 	write_ret = pbuf_write(dev_data->tx_pb, msg, len);
+	if (write_ret > 0) {
+		notify = notify_needed(dev_data, write_ret);
+	}
 
 	release_ret = release_tx_buffer(dev_data);
 	__ASSERT_NO_MSG(!release_ret);
@@ -532,6 +568,10 @@ int icmsg_send(const struct icmsg_config_t *conf,
 	}
 	sent_bytes = write_ret;
 
+	if (!notify) {
+		return sent_bytes;
+	}
+
 	__ASSERT_NO_MSG(conf->mbox_tx.dev != NULL);
 
 	ret = mbox_send_dt(&conf->mbox_tx, NULL);
@@ -179,6 +179,28 @@ int pbuf_write(struct pbuf *pb, const char *data, uint16_t len)
 	return len;
 }
 
+int pbuf_unread(struct pbuf *pb)
+{
+	if (pb == NULL) {
+		/* Incorrect call. */
+		return -EINVAL;
+	}
+
+	/* Invalidate rd_idx only, after the barrier ordering it with the wr_idx update. */
+	__sync_synchronize();
+	sys_cache_data_invd_range((void *)(pb->cfg->rd_idx_loc), sizeof(*(pb->cfg->rd_idx_loc)));
+	__sync_synchronize();
+
+	uint32_t rd_idx = *(pb->cfg->rd_idx_loc);
+
+	/* rd_idx is received from the reader, so it is validated before use. */
+	if (!IS_PTR_ALIGNED_BYTES(rd_idx, _PBUF_IDX_SIZE) || rd_idx >= pb->cfg->len) {
+		return -EINVAL;
+	}
+
+	return (int)idx_occupied(pb->cfg->len, pb->data.wr_idx, rd_idx);
+}
+
 int pbuf_get_initial_buf(struct pbuf *pb, volatile char **buf, uint16_t *len)
 {
 	uint32_t wr_idx;
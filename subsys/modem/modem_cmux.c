@@ -100,7 +100,7 @@ struct modem_cmux_msc_addr {
 };
 
 static struct modem_cmux_dlci *modem_cmux_find_dlci(struct modem_cmux *cmux, uint8_t dlci_address);
-static void modem_cmux_dlci_notify_transmit_idle(struct modem_cmux *cmux);
+static void modem_cmux_dlci_notify_transmit_idle(struct modem_cmux *cmux, bool all);
 
 static void set_state(struct modem_cmux *cmux, enum modem_cmux_state state)
 {
@@ -371,7 +371,8 @@ static void modem_cmux_log_transmit_frame(const struct modem_cmux_frame *frame)
 
 static void modem_cmux_log_received_frame(const struct modem_cmux_frame *frame)
 {
-	modem_cmux_log_frame(frame, "rcvd", frame->data_len);
+	/* Data received straight into a DLCI receive buffer is not logged */
+	modem_cmux_log_frame(frame, "rcvd", (frame->data != NULL) ? frame->data_len : 0);
 }
 
 #if CONFIG_MODEM_STATS
@@ -543,6 +544,7 @@ static uint16_t modem_cmux_transmit_frame(struct modem_cmux *cmux,
 	buf[0] = fcs;
 	buf[1] = MODEM_CMUX_SOF;
 	ring_buf_put(&cmux->transmit_rb, buf, 2);
+	cmux->transmit_put += buf_idx + data_len + 2;
 	modem_work_schedule(&cmux->transmit_work, K_NO_WAIT);
 	return data_len;
 }
@@ -573,10 +575,36 @@ static bool modem_cmux_transmit_cmd_frame(struct modem_cmux *cmux,
 	return true;
 }
 
+/*
+ * Transmit buffer space kept for a first frame of each other DLCI which has
+ * nothing queued, so a busy DLCI can not prevent the others from transmitting.
+ */
+static uint16_t modem_cmux_transmit_reserve(struct modem_cmux *cmux,
+					    const struct modem_cmux_dlci *dlci)
+{
+	sys_snode_t *node;
+	struct modem_cmux_dlci *other;
+	uint16_t reserve = 0;
+
+	SYS_SLIST_FOR_EACH_NODE(&cmux->dlcis, node) {
+		other = (struct modem_cmux_dlci *)node;
+		if ((other != dlci) && (other->state == MODEM_CMUX_DLCI_STATE_OPEN) &&
+		    !other->flow_control && !other->transmit_pending) {
+			reserve += MODEM_CMUX_DATA_FRAME_SIZE_MIN;
+		}
+	}
+
+	/* Never reserve so much that no DLCI could transmit */
+	return MIN(reserve, ring_buf_capacity_get(&cmux->transmit_rb) / 2);
+}
+
 static int16_t modem_cmux_transmit_data_frame(struct modem_cmux *cmux,
+					      struct modem_cmux_dlci *dlci,
 					      const struct modem_cmux_frame *frame)
 {
+	struct modem_cmux_frame data_frame = *frame;
 	uint16_t space;
+	uint16_t reserve;
 	int ret;
 
 	k_mutex_lock(&cmux->transmit_rb_lock, K_FOREVER);
@@ -595,13 +623,21 @@ static int16_t modem_cmux_transmit_data_frame(struct modem_cmux *cmux,
 	 * excessive wrapping overhead, since transmitting a single byte will require 8
 	 * bytes of wrapping.
 	 */
-	if (space < (MODEM_CMUX_CMD_FRAME_SIZE_MAX + MODEM_CMUX_DATA_FRAME_SIZE_MIN)) {
+	reserve = MODEM_CMUX_CMD_FRAME_SIZE_MAX + modem_cmux_transmit_reserve(cmux, dlci);
+	if (space < (reserve + MODEM_CMUX_DATA_FRAME_SIZE_MIN)) {
 		k_mutex_unlock(&cmux->transmit_rb_lock);
 		return 0;
 	}
 
-	modem_cmux_log_transmit_frame(frame);
-	ret = modem_cmux_transmit_frame(cmux, frame);
+	data_frame.data_len = MIN(frame->data_len, space - reserve - MODEM_CMUX_HEADER_SIZE);
+
+	modem_cmux_log_transmit_frame(&data_frame);
+	ret = modem_cmux_transmit_frame(cmux, &data_frame);
+
+	/* The DLCI is idle again once the transmit buffer is sent up to here */
+	dlci->transmit_end = cmux->transmit_put;
+	dlci->transmit_pending = true;
+
 	k_mutex_unlock(&cmux->transmit_rb_lock);
 	return ret;
 }
@@ -730,7 +766,7 @@ static void modem_cmux_on_fcon_command(struct modem_cmux *cmux)
 	cmux->flow_control_on = true;
 	k_mutex_unlock(&cmux->transmit_rb_lock);
 	modem_cmux_acknowledge_received_frame(cmux);
-	modem_cmux_dlci_notify_transmit_idle(cmux);
+	modem_cmux_dlci_notify_transmit_idle(cmux, true);
 }
 
 static void modem_cmux_on_fcoff_command(struct modem_cmux *cmux)
@@ -1039,7 +1075,14 @@ static void modem_cmux_on_dlci_frame_uih(struct modem_cmux_dlci *dlci)
 	}
 
 	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
-	written = ring_buf_put(&dlci->receive_rb, cmux->frame.data, cmux->frame.data_len);
+	if (cmux->receive_dlci == dlci) {
+		/* Data has already been written to the receive buffer, commit it */
+		written = cmux->receive_claimed;
+		ring_buf_put_finish(&dlci->receive_rb, written);
+		cmux->receive_dlci = NULL;
+	} else {
+		written = ring_buf_put(&dlci->receive_rb, cmux->frame.data, cmux->frame.data_len);
+	}
 	k_mutex_unlock(&dlci->receive_rb_lock);
 	if (written < cmux->frame.data_len) {
 		LOG_ERR("DLCI %u receive buffer overrun (dropped %u out of %u bytes)",
@@ -1152,6 +1195,47 @@ static void modem_cmux_on_frame(struct modem_cmux *cmux)
 	}
 }
 
+/*
+ * Select the DLCI receive buffer the data of the frame being received is written
+ * to directly, instead of the CMUX receive buffer. Only done for UIH frames
+ * to an open DLCI, which are the only frames the data of which is not parsed.
+ */
+static void modem_cmux_receive_dlci_select(struct modem_cmux *cmux)
+{
+	struct modem_cmux_dlci *dlci;
+
+	cmux->receive_dlci = NULL;
+	cmux->receive_claimed = 0;
+
+	if ((cmux->state != MODEM_CMUX_STATE_CONNECTED) ||
+	    (cmux->frame.type != MODEM_CMUX_FRAME_TYPE_UIH) ||
+	    (cmux->frame.dlci_address == 0)) {
+		return;
+	}
+
+	dlci = modem_cmux_find_dlci(cmux, cmux->frame.dlci_address);
+	if ((dlci == NULL) || (dlci->state != MODEM_CMUX_DLCI_STATE_OPEN)) {
+		return;
+	}
+
+	cmux->receive_dlci = dlci;
+}
+
+/* Discard the data of the frame written to a DLCI receive buffer, if any */
+static void modem_cmux_receive_dlci_abort(struct modem_cmux *cmux)
+{
+	struct modem_cmux_dlci *dlci = cmux->receive_dlci;
+
+	if (dlci == NULL) {
+		return;
+	}
+
+	k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+	ring_buf_put_finish(&dlci->receive_rb, 0);
+	k_mutex_unlock(&dlci->receive_rb_lock);
+	cmux->receive_dlci = NULL;
+}
+
 static void modem_cmux_drop_frame(struct modem_cmux *cmux)
 {
 #if CONFIG_MODEM_STATS
@@ -1165,8 +1249,57 @@ static void modem_cmux_drop_frame(struct modem_cmux *cmux)
 	struct modem_cmux_frame *frame = &cmux->frame;
 
 	frame->data = cmux->receive_buf;
-	modem_cmux_log_frame(frame, "dropped", MIN(frame->data_len, cmux->receive_buf_size));
+	modem_cmux_log_frame(frame, "dropped",
+			     (cmux->receive_dlci != NULL) ? 0 :
+			     MIN(frame->data_len, cmux->receive_buf_size));
 #endif
+
+	modem_cmux_receive_dlci_abort(cmux);
+}
+
+/*
+ * Receive data of the current frame, up to the end of its data field, and return
+ * the number of bytes consumed.
+ */
+static uint32_t modem_cmux_receive_data(struct modem_cmux *cmux, const uint8_t *data,
+					uint32_t len)
+{
+	struct modem_cmux_dlci *dlci = cmux->receive_dlci;
+	uint32_t claimed;
+	uint8_t *dst;
+
+	len = MIN(len, cmux->frame.data_len - cmux->receive_buf_len);
+
+	if (dlci != NULL) {
+		/*
+		 * Data which does not fit in the DLCI receive buffer is dropped, and
+		 * reported when the frame is committed.
+		 */
+		k_mutex_lock(&dlci->receive_rb_lock, K_FOREVER);
+		for (uint32_t written = 0; written < len; written += claimed) {
+			claimed = ring_buf_put_claim(&dlci->receive_rb, &dst, len - written);
+			if (claimed == 0) {
+				break;
+			}
+
+			memcpy(dst, &data[written], claimed);
+			cmux->receive_claimed += claimed;
+		}
+		k_mutex_unlock(&dlci->receive_rb_lock);
+	} else if (cmux->receive_buf_len < cmux->receive_buf_size) {
+		memcpy(&cmux->receive_buf[cmux->receive_buf_len], data,
+		       MIN(len, cmux->receive_buf_size - cmux->receive_buf_len));
+	}
+
+	cmux->receive_buf_len += len;
+
+	/* Check if datalen reached */
+	if (cmux->frame.data_len == cmux->receive_buf_len) {
+		/* Await FCS */
+		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_FCS;
+	}
+
+	return len;
 }
 
 static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t byte)
@@ -1256,6 +1389,7 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		}
 
 		/* Await data */
+		modem_cmux_receive_dlci_select(cmux);
 		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_DATA;
 		break;
 
@@ -1282,22 +1416,12 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		}
 
 		/* Await data */
+		modem_cmux_receive_dlci_select(cmux);
 		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_DATA;
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_DATA:
-		/* Copy byte to data */
-		if (cmux->receive_buf_len < cmux->receive_buf_size) {
-			cmux->receive_buf[cmux->receive_buf_len] = byte;
-		}
-		cmux->receive_buf_len++;
-
-		/* Check if datalen reached */
-		if (cmux->frame.data_len == cmux->receive_buf_len) {
-			/* Await FCS */
-			cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_FCS;
-		}
-
+		modem_cmux_receive_data(cmux, &byte, 1);
 		break;
 
 	case MODEM_CMUX_RECEIVE_STATE_FCS:
@@ -1314,7 +1438,7 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		if (cmux->frame.type == MODEM_CMUX_FRAME_TYPE_UIH) {
 			fcs = 0xFF - fcs;
 		} else {
-			fcs = 0xFF - crc8_rohc(fcs, cmux->frame.data, cmux->frame.data_len);
+			fcs = 0xFF - crc8_rohc(fcs, cmux->receive_buf, cmux->frame.data_len);
 		}
 
 		/* Validate FCS */
@@ -1337,9 +1461,12 @@ static void modem_cmux_process_received_byte(struct modem_cmux *cmux, uint8_t by
 		}
 
 		/* Process frame */
-		cmux->frame.data = cmux->receive_buf;
+		cmux->frame.data = (cmux->receive_dlci == NULL) ? cmux->receive_buf : NULL;
 		modem_cmux_on_frame(cmux);
 
+		/* Data received for a DLCI which did not take the frame is discarded */
+		modem_cmux_receive_dlci_abort(cmux);
+
 		/* Await start of next frame */
 		cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_SOF;
 		break;
@@ -1364,23 +1491,50 @@ static void modem_cmux_receive_handler(struct k_work *item)
 		return;
 	}
 
-	/* Process received data */
-	for (int i = 0; i < ret; i++) {
-		modem_cmux_process_received_byte(cmux, cmux->work_buf[i]);
+	/* Process received data, copying frame data in one go */
+	for (int i = 0; i < ret;) {
+		if (cmux->receive_state == MODEM_CMUX_RECEIVE_STATE_DATA) {
+			i += modem_cmux_receive_data(cmux, &cmux->work_buf[i], ret - i);
+		} else {
+			modem_cmux_process_received_byte(cmux, cmux->work_buf[i]);
+			i++;
+		}
 	}
 
 	/* Reschedule received work */
 	modem_work_schedule(&cmux->receive_work, K_NO_WAIT);
 }
 
-static void modem_cmux_dlci_notify_transmit_idle(struct modem_cmux *cmux)
+static void modem_cmux_dlci_update_transmit_done(struct modem_cmux *cmux)
 {
 	sys_snode_t *node;
 	struct modem_cmux_dlci *dlci;
 
 	SYS_SLIST_FOR_EACH_NODE(&cmux->dlcis, node) {
 		dlci = (struct modem_cmux_dlci *)node;
-		if (!dlci->flow_control) {
+		if (dlci->transmit_pending &&
+		    ((int32_t)(cmux->transmit_sent - dlci->transmit_end) >= 0)) {
+			dlci->transmit_pending = false;
+			dlci->transmit_done = true;
+		}
+	}
+}
+
+/*
+ * Notify the DLCIs whose frames have all been sent, without waiting for the
+ * frames of the other DLCIs, or all DLCIs once the transmit buffer is empty.
+ */
+static void modem_cmux_dlci_notify_transmit_idle(struct modem_cmux *cmux, bool all)
+{
+	sys_snode_t *node;
+	struct modem_cmux_dlci *dlci;
+	bool done;
+
+	SYS_SLIST_FOR_EACH_NODE(&cmux->dlcis, node) {
+		dlci = (struct modem_cmux_dlci *)node;
+		done = dlci->transmit_done;
+		dlci->transmit_done = false;
+		if ((all || done) && !dlci->flow_control) {
 			modem_pipe_notify_transmit_idle(&dlci->pipe);
 		}
 	}
@@ -1421,6 +1575,7 @@ static void modem_cmux_transmit_handler(struct k_work *item)
 		}
 
 		ring_buf_get_finish(&cmux->transmit_rb, (uint32_t)ret);
+		cmux->transmit_sent += ret;
 
 		if (ret < reserved_size) {
 			LOG_DBG("Transmitted only %u out of %u bytes at once.", ret, reserved_size);
@@ -1428,11 +1583,10 @@ static void modem_cmux_transmit_handler(struct k_work *item)
 		}
 	}
 
+	modem_cmux_dlci_update_transmit_done(cmux);
 	k_mutex_unlock(&cmux->transmit_rb_lock);
 
-	if (transmit_rb_empty) {
-		modem_cmux_dlci_notify_transmit_idle(cmux);
-	}
+	modem_cmux_dlci_notify_transmit_idle(cmux, transmit_rb_empty);
 }
 
 static void modem_cmux_connect_handler(struct k_work *item)
@@ -1583,7 +1737,7 @@ static int modem_cmux_dlci_pipe_api_transmit(void *data, const uint8_t *buf, siz
 			.data_len = size,
 		};
 
-		ret = modem_cmux_transmit_data_frame(cmux, &frame);
+		ret = modem_cmux_transmit_data_frame(cmux, dlci, &frame);
 	}
 
 	return ret;
@@ -1716,6 +1870,18 @@ static void modem_cmux_dlci_pipes_release(struct modem_cmux *cmux)
 	}
 }
 
+static void modem_cmux_dlci_reset_transmit(struct modem_cmux *cmux)
+{
+	sys_snode_t *node;
+	struct modem_cmux_dlci *dlci;
+
+	SYS_SLIST_FOR_EACH_NODE(&cmux->dlcis, node) {
+		dlci = (struct modem_cmux_dlci *)node;
+		dlci->transmit_pending = false;
+		dlci->transmit_done = false;
+	}
+}
+
 void modem_cmux_init(struct modem_cmux *cmux, const struct modem_cmux_config *config)
 {
 	__ASSERT_NO_MSG(cmux != NULL);
@@ -1781,7 +1947,11 @@ int modem_cmux_attach(struct modem_cmux *cmux, struct modem_pipe *pipe)
 
 	cmux->pipe = pipe;
 	ring_buf_reset(&cmux->transmit_rb);
+	cmux->transmit_put = 0;
+	cmux->transmit_sent = 0;
+	modem_cmux_dlci_reset_transmit(cmux);
 	cmux->receive_state = MODEM_CMUX_RECEIVE_STATE_SOF;
+	modem_cmux_receive_dlci_abort(cmux);
 	modem_pipe_attach(cmux->pipe, modem_cmux_bus_callback, cmux);
 
 	K_SPINLOCK(&cmux->work_lock) {
@@ -1893,6 +2063,9 @@ void modem_cmux_release(struct modem_cmux *cmux)
 	k_work_cancel_delayable_sync(&cmux->transmit_work, &sync);
 	k_work_cancel_delayable_sync(&cmux->receive_work, &sync);
 
+	/* Discard partially received DLCI data */
+	modem_cmux_receive_dlci_abort(cmux);
+
 	/* Unreference pipe */
 	cmux->pipe = NULL;
 
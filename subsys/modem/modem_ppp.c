@@ -5,7 +5,6 @@
  */
 
 #include <zephyr/net/ppp.h>
-#include <zephyr/sys/crc.h>
 #include <zephyr/modem/ppp.h>
 #include <zephyr/pm/device_runtime.h>
 #include <string.h>
@@ -22,14 +21,60 @@ LOG_MODULE_REGISTER(modem_ppp, CONFIG_MODEM_MODULES_LOG_LEVEL);
 #define MODEM_PPP_CODE_ESCAPE		(0x7D)
 #define MODEM_PPP_VALUE_ESCAPE		(0x20)
 
-static uint16_t modem_ppp_fcs_init(uint8_t byte)
+/* Bytes of a word which may be zero, exact when no byte is */
+#define MODEM_PPP_WORD_HAS_ZERO(word) (((word) - 0x01010101U) & ~(word) & 0x80808080U)
+
+/* Bytes of a word which may be below 0x20, exact when no byte is */
+#define MODEM_PPP_WORD_HAS_CONTROL(word) (((word) - 0x20202020U) & ~(word) & 0x80808080U)
+
+/* FCS-16 lookup table of RFC 1662, the reflected CRC-CCITT one byte at a time */
+static const uint16_t modem_ppp_fcs_table[256] = {
+	0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+	0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+	0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+	0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+	0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+	0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+	0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+	0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+	0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+	0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+	0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+	0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+	0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+	0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+	0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+	0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+	0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+	0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+	0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+	0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+	0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+	0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+	0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+	0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+	0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+	0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+	0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+	0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+	0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+	0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+	0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+	0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78,
+};
+
+static uint16_t modem_ppp_fcs_update(uint16_t fcs, const uint8_t *data, size_t len)
 {
-	return crc16_ccitt(0xFFFF, &byte, 1);
+	for (size_t i = 0; i < len; i++) {
+		fcs = (fcs >> 8) ^ modem_ppp_fcs_table[(fcs ^ data[i]) & 0xFF];
+	}
+
+	return fcs;
 }
 
-static uint16_t modem_ppp_fcs_update(uint16_t fcs, uint8_t byte)
+static uint16_t modem_ppp_fcs_init(uint8_t byte)
 {
-	return crc16_ccitt(fcs, &byte, 1);
+	return modem_ppp_fcs_update(0xFFFF, &byte, 1);
 }
 
 static uint16_t modem_ppp_fcs_final(uint16_t fcs)
@@ -67,6 +112,68 @@ static bool modem_ppp_needs_escape(uint32_t async_map, uint8_t byte)
 	return byte_bit & async_map;
 }
 
+/* Number of leading bytes of data which can be sent or received as is */
+static size_t modem_ppp_unescaped_len(uint32_t async_map, const uint8_t *data, size_t len)
+{
+	size_t i = 0;
+	uint32_t word;
+
+	/* Skip whole words holding no flag, escape or control character */
+	for (; (i + sizeof(word)) <= len; i += sizeof(word)) {
+		memcpy(&word, &data[i], sizeof(word));
+
+		if (MODEM_PPP_WORD_HAS_ZERO(word ^ 0x7E7E7E7EU) ||
+		    MODEM_PPP_WORD_HAS_ZERO(word ^ 0x7D7D7D7DU) ||
+		    ((async_map != 0) && MODEM_PPP_WORD_HAS_CONTROL(word))) {
+			break;
+		}
+	}
+
+	for (; i < len; i++) {
+		if (modem_ppp_needs_escape(async_map, data[i])) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+static uint32_t modem_ppp_wrap_data(struct modem_ppp *ppp, uint32_t async_map, uint8_t *buffer,
+				    uint32_t available)
+{
+	struct net_pkt_cursor *cursor = &ppp->tx_pkt->cursor;
+	uint32_t offset = 0;
+	size_t len;
+	uint8_t byte;
+
+	/* Space available, taking into account possible escapes */
+	while (((available - offset) >= 2) && (net_pkt_remaining_data(ppp->tx_pkt) > 0)) {
+		/* Copy the run of bytes needing no escape in the current fragment at once */
+		len = cursor->buf->len - (cursor->pos - cursor->buf->data);
+		len = modem_ppp_unescaped_len(async_map, cursor->pos,
+					      MIN(len, available - offset));
+		if (len > 0) {
+			/* FCS is computed without the escape/modification */
+			ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, cursor->pos, len);
+			(void)net_pkt_read(ppp->tx_pkt, &buffer[offset], len);
+			offset += len;
+			continue;
+		}
+
+		/* Pull next byte we're sending */
+		(void)net_pkt_read_u8(ppp->tx_pkt, &byte);
+		ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, &byte, 1);
+		/* Push encoded bytes into buffer*/
+		if (modem_ppp_needs_escape(async_map, byte)) {
+			buffer[offset++] = MODEM_PPP_CODE_ESCAPE;
+			byte ^= MODEM_PPP_VALUE_ESCAPE;
+		}
+		buffer[offset++] = byte;
+	}
+
+	return offset;
+}
+
 static uint32_t modem_ppp_wrap(struct modem_ppp *ppp, uint8_t *buffer, uint32_t available)
 {
 	uint32_t async_map = ppp_peer_async_control_character_map(ppp->iface);
@@ -75,7 +182,6 @@ static uint32_t modem_ppp_wrap(struct modem_ppp *ppp, uint8_t *buffer, uint32_t
 	uint16_t protocol;
 	uint8_t upper;
 	uint8_t lower;
-	uint8_t byte;
 
 	while (offset < available) {
 		remaining = available - offset;
@@ -119,8 +225,8 @@ static uint32_t modem_ppp_wrap(struct modem_ppp *ppp, uint8_t *buffer, uint32_t
 			upper = (protocol >> 8) & 0xFF;
 			lower = (protocol >> 0) & 0xFF;
 			/* FCS is computed without the escape/modification */
-			ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, upper);
-			ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, lower);
+			ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, &upper, 1);
+			ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, &lower, 1);
 			/* Push protocol bytes (with required escaping) */
 			if (modem_ppp_needs_escape(async_map, upper)) {
 				buffer[offset++] = MODEM_PPP_CODE_ESCAPE;
@@ -136,24 +242,10 @@ static uint32_t modem_ppp_wrap(struct modem_ppp *ppp, uint8_t *buffer, uint32_t
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_DATA;
 			break;
 		case MODEM_PPP_TRANSMIT_STATE_DATA:
-			/* Push all data bytes into the buffer */
-			while (net_pkt_remaining_data(ppp->tx_pkt) > 0) {
-				/* Space available, taking into account possible escapes */
-				if (remaining < 2) {
-					goto end;
-				}
-				/* Pull next byte we're sending */
-				(void)net_pkt_read_u8(ppp->tx_pkt, &byte);
-				/* FCS is computed without the escape/modification */
-				ppp->tx_pkt_fcs = modem_ppp_fcs_update(ppp->tx_pkt_fcs, byte);
-				/* Push encoded bytes into buffer*/
-				if (modem_ppp_needs_escape(async_map, byte)) {
-					buffer[offset++] = MODEM_PPP_CODE_ESCAPE;
-					byte ^= MODEM_PPP_VALUE_ESCAPE;
-					remaining--;
-				}
-				buffer[offset++] = byte;
-				remaining--;
+			/* Push as many data bytes as fit into the buffer */
+			offset += modem_ppp_wrap_data(ppp, async_map, &buffer[offset], remaining);
+			if (net_pkt_remaining_data(ppp->tx_pkt) > 0) {
+				goto end;
 			}
 			/* Data phase finished */
 			ppp->transmit_state = MODEM_PPP_TRANSMIT_STATE_EOF;
@@ -201,6 +293,44 @@ static bool modem_ppp_is_byte_expected(uint8_t byte, uint8_t expected_byte)
 	return false;
 }
 
+static void modem_ppp_receive_data(struct modem_ppp *ppp, const uint8_t *data, size_t len)
+{
+	size_t available;
+	size_t written;
+
+	while (len > 0) {
+		/* Always keep one byte available, extending the packet before it gets used */
+		available = net_pkt_available_buffer(ppp->rx_pkt);
+		if (available == 1) {
+			if (net_pkt_alloc_buffer(ppp->rx_pkt, CONFIG_MODEM_PPP_NET_BUF_FRAG_SIZE,
+						 NET_AF_INET, K_NO_WAIT) < 0) {
+				LOG_WRN("Failed to alloc buffer");
+				net_pkt_unref(ppp->rx_pkt);
+				ppp->rx_pkt = NULL;
+				ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+				return;
+			}
+
+			available = net_pkt_available_buffer(ppp->rx_pkt);
+		}
+
+		written = MIN(len, MAX(available, 2) - 1);
+		if (net_pkt_write(ppp->rx_pkt, data, written) < 0) {
+			LOG_WRN("Dropped PPP frame");
+			net_pkt_unref(ppp->rx_pkt);
+			ppp->rx_pkt = NULL;
+			ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
+#if defined(CONFIG_NET_STATISTICS_PPP)
+			ppp->stats.drop++;
+#endif
+			return;
+		}
+
+		data += written;
+		len -= written;
+	}
+}
+
 static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 {
 	switch (ppp->receive_state) {
@@ -268,51 +398,55 @@ static void modem_ppp_process_received_byte(struct modem_ppp *ppp, uint8_t byte)
 			break;
 		}
 
-		if (net_pkt_available_buffer(ppp->rx_pkt) == 1) {
-			if (net_pkt_alloc_buffer(ppp->rx_pkt, CONFIG_MODEM_PPP_NET_BUF_FRAG_SIZE,
-						 NET_AF_INET, K_NO_WAIT) < 0) {
-				LOG_WRN("Failed to alloc buffer");
-				net_pkt_unref(ppp->rx_pkt);
-				ppp->rx_pkt = NULL;
-				ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
-				break;
-			}
-		}
-
 		if (byte == MODEM_PPP_CODE_ESCAPE) {
 			ppp->receive_state = MODEM_PPP_RECEIVE_STATE_UNESCAPING;
 			break;
 		}
 
-		if (net_pkt_write_u8(ppp->rx_pkt, byte) < 0) {
-			LOG_WRN("Dropped PPP frame");
-			net_pkt_unref(ppp->rx_pkt);
-			ppp->rx_pkt = NULL;
-			ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
-#if defined(CONFIG_NET_STATISTICS_PPP)
-			ppp->stats.drop++;
-#endif
-		}
-
+		modem_ppp_receive_data(ppp, &byte, 1);
 		break;
 
 	case MODEM_PPP_RECEIVE_STATE_UNESCAPING:
-		if (net_pkt_write_u8(ppp->rx_pkt, (byte ^ MODEM_PPP_VALUE_ESCAPE)) < 0) {
-			LOG_WRN("Dropped PPP frame");
-			net_pkt_unref(ppp->rx_pkt);
-			ppp->rx_pkt = NULL;
-			ppp->receive_state = MODEM_PPP_RECEIVE_STATE_HDR_SOF;
-#if defined(CONFIG_NET_STATISTICS_PPP)
-			ppp->stats.drop++;
-#endif
-			break;
-		}
-
 		ppp->receive_state = MODEM_PPP_RECEIVE_STATE_WRITING;
+		byte ^= MODEM_PPP_VALUE_ESCAPE;
+		modem_ppp_receive_data(ppp, &byte, 1);
 		break;
 	}
 }
 
+static void modem_ppp_process_received(struct modem_ppp *ppp, const uint8_t *data, size_t len)
+{
+	const uint8_t *delimiter;
+	size_t span;
+
+	while (len > 0) {
+		if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_HDR_SOF) {
+			/* Skip everything up to the next start of frame at once */
+			delimiter = memchr(data, MODEM_PPP_CODE_DELIMITER, len);
+			span = (delimiter != NULL) ? (size_t)(delimiter - data) : len;
+			if (span > 0) {
+				LOG_DBG("Dropping %zu bytes before start of frame", span);
+			}
+		} else if (ppp->receive_state == MODEM_PPP_RECEIVE_STATE_WRITING) {
+			/* Write the run of bytes up to the next delimiter or escape at once */
+			span = modem_ppp_unescaped_len(0, data, len);
+			if (span > 0) {
+				modem_ppp_receive_data(ppp, data, span);
+			}
+		} else {
+			span = 0;
+		}
+
+		if (span == 0) {
+			modem_ppp_process_received_byte(ppp, *data);
+			span = 1;
+		}
+
+		data += span;
+		len -= span;
+	}
+}
+
 #if CONFIG_MODEM_STATS
 static uint32_t get_transmit_buf_length(struct modem_ppp *ppp)
 {
@@ -424,9 +558,7 @@ static void modem_ppp_process_handler(struct k_work *item)
 	advertise_receive_buf_stats(ppp, ret);
 #endif
 
-	for (int i = 0; i < ret; i++) {
-		modem_ppp_process_received_byte(ppp, ppp->receive_buf[i]);
-	}
+	modem_ppp_process_received(ppp, ppp->receive_buf, ret);
 
 	modem_work_submit(&ppp->process_work);
 }
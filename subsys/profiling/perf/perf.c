@@ -8,13 +8,29 @@
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/arch/cpu.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/instrumentation/instrumentation.h>
 #include <zephyr/shell/shell.h>
 #include <zephyr/shell/shell_uart.h>
+#include <zephyr/sys/atomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size);
 
+/*
+ * A sample is the length of the stack trace, the interrupted thread, then the
+ * return addresses of the stack trace, innermost first.
+ */
+#define PERF_SAMPLE_HDR_LEN 2
+
+struct perf_cpu_data {
+	size_t idx;
+	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
+	bool buf_full;
+};
+
 struct perf_data_t {
 	struct k_timer timer;
 
@@ -22,9 +38,12 @@ struct perf_data_t {
 
 	struct k_work_delayable dwork;
 
-	size_t idx;
-	uintptr_t buf[CONFIG_PROFILING_PERF_BUFFER_SIZE];
-	bool buf_full;
+#if defined(CONFIG_SMP)
+	/* Samples the other CPUs from the timer of the current one */
+	struct k_ipi_work ipi_work;
+#endif
+
+	struct perf_cpu_data cpu[CONFIG_MP_MAX_NUM_CPUS];
 };
 
 static void perf_tracer(struct k_timer *timer);
@@ -34,36 +53,89 @@ static struct perf_data_t perf_data = {
 	.dwork = Z_WORK_DELAYABLE_INITIALIZER(perf_dwork_handler),
 };
 
-static void perf_tracer(struct k_timer *timer)
-{
-	struct perf_data_t *perf_data_ptr =
-		(struct perf_data_t *)k_timer_user_data_get(timer);
+/* Samples already folded into a collapsed stack, by CPU and buffer index */
+static ATOMIC_DEFINE(perf_folded, CONFIG_MP_MAX_NUM_CPUS * CONFIG_PROFILING_PERF_BUFFER_SIZE);
 
+static void perf_sample(struct perf_data_t *perf_data_ptr)
+{
+	struct perf_cpu_data *cpu = &perf_data_ptr->cpu[_current_cpu->id];
 	size_t trace_length = 0;
 
-	if (++perf_data_ptr->idx < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
+	if (cpu->buf_full) {
+		return;
+	}
+
+	if (cpu->idx + PERF_SAMPLE_HDR_LEN < CONFIG_PROFILING_PERF_BUFFER_SIZE) {
 		trace_length = arch_perf_current_stack_trace(
-					perf_data_ptr->buf + perf_data_ptr->idx,
-					CONFIG_PROFILING_PERF_BUFFER_SIZE - perf_data_ptr->idx);
+					cpu->buf + cpu->idx + PERF_SAMPLE_HDR_LEN,
+					CONFIG_PROFILING_PERF_BUFFER_SIZE - cpu->idx -
+						PERF_SAMPLE_HDR_LEN);
 	}
 
 	if (trace_length != 0) {
-		perf_data_ptr->buf[perf_data_ptr->idx - 1] = trace_length;
-		perf_data_ptr->idx += trace_length;
+		cpu->buf[cpu->idx] = trace_length;
+		cpu->buf[cpu->idx + 1] = (uintptr_t)_current;
+		cpu->idx += PERF_SAMPLE_HDR_LEN + trace_length;
 	} else {
-		--perf_data_ptr->idx;
-		perf_data_ptr->buf_full = true;
+		cpu->buf_full = true;
 		k_work_reschedule(&perf_data_ptr->dwork, K_NO_WAIT);
 	}
 }
 
+#if defined(CONFIG_SMP)
+static void perf_ipi_tracer(struct k_ipi_work *work)
+{
+	perf_sample(CONTAINER_OF(work, struct perf_data_t, ipi_work));
+}
+#endif
+
+static void perf_tracer(struct k_timer *timer)
+{
+	struct perf_data_t *perf_data_ptr =
+		(struct perf_data_t *)k_timer_user_data_get(timer);
+
+#if defined(CONFIG_SMP)
+	uint32_t others = BIT_MASK(arch_num_cpus()) & ~BIT(_current_cpu->id);
+
+	/* CPUs still busy with the previous sample miss this one */
+	if (others != 0 && k_ipi_work_add(&perf_data_ptr->ipi_work, others,
+					  perf_ipi_tracer) == 0) {
+		k_ipi_work_signal();
+	}
+#endif
+
+	perf_sample(perf_data_ptr);
+}
+
+static bool perf_any_buf_full(void)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (perf_data.cpu[i].buf_full) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static size_t perf_total_length(void)
+{
+	size_t length = 0;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		length += perf_data.cpu[i].idx;
+	}
+
+	return length;
+}
+
 static void perf_dwork_handler(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
 	struct perf_data_t *perf_data_ptr = CONTAINER_OF(dwork, struct perf_data_t, dwork);
 
 	k_timer_stop(&perf_data_ptr->timer);
-	if (perf_data_ptr->buf_full) {
+	if (perf_any_buf_full()) {
 		shell_error(perf_data_ptr->sh, "Perf buf overflow!");
 	} else {
 		shell_print(perf_data_ptr->sh, "Perf done!");
@@ -77,7 +149,7 @@ static int cmd_perf_record(const struct shell *sh, size_t argc, char **argv)
 		return -EINPROGRESS;
 	}
 
-	if (perf_data.buf_full) {
+	if (perf_any_buf_full()) {
 		shell_warn(sh, "Perf buffer is full");
 		return -ENOBUFS;
 	}
@@ -107,8 +179,10 @@ static int cmd_perf_clear(const struct shell *sh, size_t argc, char **argv)
 		shell_print(sh, "Perf buffer cleared");
 	}
 
-	perf_data.idx = 0;
-	perf_data.buf_full = false;
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		perf_data.cpu[i].idx = 0;
+		perf_data.cpu[i].buf_full = false;
+	}
 
 	return 0;
 }
@@ -119,8 +193,11 @@ static int cmd_perf_info(const struct shell *sh, size_t argc, char **argv)
 		shell_print(sh, "Perf is running");
 	}
 
-	shell_print(sh, "Perf buf: %zu/%d %s", perf_data.idx, CONFIG_PROFILING_PERF_BUFFER_SIZE,
-		    perf_data.buf_full ? "(full)" : "");
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		shell_print(sh, "Perf buf cpu%u: %zu/%d %s", i, perf_data.cpu[i].idx,
+			    CONFIG_PROFILING_PERF_BUFFER_SIZE,
+			    perf_data.cpu[i].buf_full ? "(full)" : "");
+	}
 
 	return 0;
 }
@@ -132,9 +209,131 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 		return -EINPROGRESS;
 	}
 
-	shell_print(sh, "Perf buf length %zu", perf_data.idx);
-	for (size_t i = 0; i < perf_data.idx; i++) {
-		shell_print(sh, "%016lx", perf_data.buf[i]);
+	shell_print(sh, "Perf buf length %zu", perf_total_length());
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		for (size_t i = 0; i < perf_data.cpu[cpu].idx; i++) {
+			shell_print(sh, "%016lx", perf_data.cpu[cpu].buf[i]);
+		}
+	}
+
+	cmd_perf_clear(NULL, 0, NULL);
+
+	return 0;
+}
+
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_NAME)
+struct perf_thread_lookup {
+	k_tid_t thread;
+	bool found;
+};
+
+static void perf_thread_match(const struct k_thread *thread, void *user_data)
+{
+	struct perf_thread_lookup *lookup = user_data;
+
+	if (thread == lookup->thread) {
+		lookup->found = true;
+	}
+}
+#endif
+
+static void perf_print_thread(const struct shell *sh, k_tid_t thread)
+{
+#if defined(CONFIG_THREAD_MONITOR) && defined(CONFIG_THREAD_NAME)
+	/* The thread may have exited since it was sampled */
+	struct perf_thread_lookup lookup = {.thread = thread};
+	const char *name;
+
+	k_thread_foreach_unlocked(perf_thread_match, &lookup);
+	if (lookup.found) {
+		name = k_thread_name_get(thread);
+		if (name != NULL && name[0] != '\0') {
+			shell_fprintf(sh, SHELL_NORMAL, "%s", name);
+			return;
+		}
+	}
+#endif
+
+	shell_fprintf(sh, SHELL_NORMAL, "thread_%p", (void *)thread);
+}
+
+static void perf_print_frame(const struct shell *sh, uintptr_t addr)
+{
+#if defined(CONFIG_SYMTAB)
+	uint32_t offset;
+
+	shell_fprintf(sh, SHELL_NORMAL, ";%s", symtab_find_symbol_name(addr, &offset));
+#else
+	shell_fprintf(sh, SHELL_NORMAL, ";0x%lx", addr);
+#endif
+}
+
+static bool perf_same_frame(uintptr_t a, uintptr_t b)
+{
+#if defined(CONFIG_SYMTAB)
+	uint32_t offset_a, offset_b;
+
+	return symtab_find_symbol_name(a, &offset_a) == symtab_find_symbol_name(b, &offset_b);
+#else
+	return a == b;
+#endif
+}
+
+/* Print a sample as thread;outermost;...;innermost, folding recursions */
+static void perf_print_stack(const struct shell *sh, const uintptr_t *sample, uint32_t count)
+{
+	const uintptr_t *trace = sample + PERF_SAMPLE_HDR_LEN;
+	size_t length = sample[0];
+
+	perf_print_thread(sh, (k_tid_t)sample[1]);
+
+	for (size_t i = length; i > 0; i--) {
+		if (i == length || !perf_same_frame(trace[i - 1], trace[i])) {
+			perf_print_frame(sh, trace[i - 1]);
+		}
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, " %u\n", count);
+}
+
+static int cmd_perf_collapse(const struct shell *sh, size_t argc, char **argv)
+{
+	if (k_work_delayable_is_pending(&perf_data.dwork)) {
+		shell_warn(sh, "Perf is running");
+		return -EINPROGRESS;
+	}
+
+	memset(perf_folded, 0, sizeof(perf_folded));
+
+	/* Count the identical samples of all CPUs together */
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		const struct perf_cpu_data *data = &perf_data.cpu[cpu];
+
+		for (size_t i = 0; i < data->idx; i += PERF_SAMPLE_HDR_LEN + data->buf[i]) {
+			const uintptr_t *sample = &data->buf[i];
+			size_t sample_size = (PERF_SAMPLE_HDR_LEN + sample[0]) * sizeof(uintptr_t);
+			uint32_t count = 0;
+
+			for (unsigned int other = cpu; other < arch_num_cpus(); other++) {
+				const struct perf_cpu_data *odata = &perf_data.cpu[other];
+				size_t j = other == cpu ? i : 0;
+
+				for (; j < odata->idx; j += PERF_SAMPLE_HDR_LEN + odata->buf[j]) {
+					size_t bit = other * CONFIG_PROFILING_PERF_BUFFER_SIZE + j;
+
+					if (!atomic_test_bit(perf_folded, bit) &&
+					    odata->buf[j] == sample[0] &&
+					    memcmp(&odata->buf[j], sample, sample_size) == 0) {
+						atomic_set_bit(perf_folded, bit);
+						count++;
+					}
+				}
+			}
+
+			if (count > 0) {
+				perf_print_stack(sh, sample, count);
+			}
+		}
 	}
 
 	cmd_perf_clear(NULL, 0, NULL);
@@ -142,6 +341,45 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 	return 0;
 }
 
+#if defined(CONFIG_PROFILING_PERF_DETERMINISTIC)
+static bool perf_print_func(const struct instr_func_profile *profile, void *user_data)
+{
+	const struct shell *sh = user_data;
+	const char *name = "?";
+
+#if defined(CONFIG_SYMTAB)
+	uint32_t offset;
+
+	name = symtab_find_symbol_name((uintptr_t)profile->addr, &offset);
+#endif
+
+	shell_print(sh, "%10u %20llu %20llu %p %s", profile->calls, profile->inclusive_cycles,
+		    profile->exclusive_cycles, profile->addr, name);
+
+	return true;
+}
+
+static int cmd_perf_funcs(const struct shell *sh, size_t argc, char **argv)
+{
+	shell_print(sh, "%10s %20s %20s %s", "calls", "inclusive cycles", "exclusive cycles",
+		    "function");
+	instr_profile_foreach(perf_print_func, (void *)sh);
+
+	return 0;
+}
+#endif /* CONFIG_PROFILING_PERF_DETERMINISTIC */
+
+#if defined(CONFIG_SMP)
+static int perf_init(void)
+{
+	k_ipi_work_init(&perf_data.ipi_work);
+
+	return 0;
+}
+
+SYS_INIT(perf_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif
+
 #define CMD_HELP_RECORD                                                                            \
 	"Start recording for <duration> ms on <frequency> Hz\n"                                    \
 	"Usage: record <duration> <frequency>"
@@ -149,6 +387,12 @@ static int cmd_perf_print(const struct shell *sh, size_t argc, char **argv)
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_perf,
 	SHELL_CMD_ARG(record, NULL, CMD_HELP_RECORD, cmd_perf_record, 3, 0),
 	SHELL_CMD_ARG(printbuf, NULL, "Print the perf buffer", cmd_perf_print, 0, 0),
+	SHELL_CMD_ARG(collapse, NULL, "Print the samples as collapsed stacks",
+		      cmd_perf_collapse, 0, 0),
+#if defined(CONFIG_PROFILING_PERF_DETERMINISTIC)
+	SHELL_CMD_ARG(funcs, NULL, "Print the cycles of the instrumented functions",
+		      cmd_perf_funcs, 0, 0),
+#endif
 	SHELL_CMD_ARG(clear, NULL, "Clear the perf buffer", cmd_perf_clear, 0, 0),
 	SHELL_CMD_ARG(info, NULL, "Print the perf info", cmd_perf_info, 0, 0),
 	SHELL_SUBCMD_SET_END
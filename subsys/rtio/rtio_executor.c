@@ -8,6 +8,9 @@
 #include <zephyr/kernel.h>
 
 #include "rtio_sched.h"
+#ifdef CONFIG_RTIO_IODEV_SCHED
+#include "rtio_iodev_sched.h"
+#endif
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(rtio_executor, CONFIG_RTIO_LOG_LEVEL);
@@ -72,6 +75,14 @@ static inline void rtio_iodev_submit(struct rtio_iodev_sqe *iodev_sqe, int last_
 		return;
 	}
 
+#ifdef CONFIG_RTIO_IODEV_SCHED
+	/* The scheduler decides when the iodev gets it */
+	if (iodev_sqe->sqe.iodev->sched != NULL) {
+		rtio_iodev_sched_submit(iodev_sqe->sqe.iodev->sched, iodev_sqe);
+		return;
+	}
+#endif
+
 	iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
 }
 
@@ -231,7 +242,8 @@ static inline void rtio_executor_handle_oneshot(struct rtio_iodev_sqe *iodev_sqe
 	}
 }
 
-static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int result, bool is_ok)
+static inline void rtio_executor_complete(struct rtio_iodev_sqe *iodev_sqe, int result,
+					  bool is_ok)
 {
 	const bool is_multishot = FIELD_GET(RTIO_SQE_MULTISHOT, iodev_sqe->sqe.flags) == 1;
 
@@ -242,6 +254,35 @@ static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int resu
 	}
 }
 
+static inline void rtio_executor_done(struct rtio_iodev_sqe *iodev_sqe, int result, bool is_ok)
+{
+#ifdef CONFIG_RTIO_IODEV_SCHED
+	struct rtio_iodev_sched *sched = iodev_sqe->sched;
+
+	if (sched != NULL) {
+		struct rtio_iodev_sqe *merged = rtio_iodev_sched_unmerge(iodev_sqe);
+
+		/* Completing may submit again, to the same scheduler */
+		iodev_sqe->sched = NULL;
+		rtio_executor_complete(iodev_sqe, result, is_ok);
+
+		/* Submissions merged into this one share its result */
+		while (merged != NULL) {
+			struct rtio_iodev_sqe *next = merged->merged;
+
+			merged->merged = NULL;
+			rtio_executor_complete(merged, result, is_ok);
+			merged = next;
+		}
+
+		rtio_iodev_sched_release(sched);
+		return;
+	}
+#endif
+
+	rtio_executor_complete(iodev_sqe, result, is_ok);
+}
+
 /**
  * @brief Callback from an iodev describing success
  */
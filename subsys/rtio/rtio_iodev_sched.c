@@ -0,0 +1,183 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#include "rtio_iodev_sched.h"
+
+/* Flags of submissions which are never merged */
+#define RTIO_IODEV_SCHED_NO_MERGE_FLAGS                                                            \
+	(RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION | RTIO_SQE_MEMPOOL_BUFFER | RTIO_SQE_CANCELED |  \
+	 RTIO_SQE_MULTISHOT)
+
+/* True if a should be handed to its iodev before b */
+static bool rtio_iodev_sched_before(const struct rtio_iodev_sqe *a, const struct rtio_iodev_sqe *b)
+{
+	if (a->sqe.prio != b->sqe.prio) {
+		return a->sqe.prio > b->sqe.prio;
+	}
+
+	return sys_timepoint_cmp(a->deadline, b->deadline) < 0;
+}
+
+static void rtio_iodev_sched_insert(struct rtio_iodev_sched *sched,
+				    struct rtio_iodev_sqe *iodev_sqe)
+{
+	sys_snode_t *prev = NULL;
+	struct rtio_iodev_sqe *curr;
+
+	/* Behind everything of the same priority and deadline, to keep the submission order */
+	SYS_SLIST_FOR_EACH_CONTAINER(&sched->pending, curr, sched_node) {
+		if (rtio_iodev_sched_before(iodev_sqe, curr)) {
+			break;
+		}
+		prev = &curr->sched_node;
+	}
+
+	sys_slist_insert(&sched->pending, prev, &iodev_sqe->sched_node);
+}
+
+static uint32_t *rtio_iodev_sched_buf_len(struct rtio_iodev_sqe *iodev_sqe)
+{
+	return iodev_sqe->sqe.op == RTIO_OP_RX ? &iodev_sqe->sqe.rx.buf_len
+					       : &iodev_sqe->sqe.tx.buf_len;
+}
+
+static const uint8_t *rtio_iodev_sched_buf(const struct rtio_iodev_sqe *iodev_sqe)
+{
+	return iodev_sqe->sqe.op == RTIO_OP_RX ? iodev_sqe->sqe.rx.buf : iodev_sqe->sqe.tx.buf;
+}
+
+static bool rtio_iodev_sched_can_merge(const struct rtio_iodev_sqe *head,
+				       struct rtio_iodev_sqe *next, uint32_t len)
+{
+	const struct rtio_sqe *sqe = &next->sqe;
+
+	return sqe->iodev == head->sqe.iodev && sqe->op == head->sqe.op &&
+	       sqe->iodev_flags == head->sqe.iodev_flags &&
+	       (sqe->flags & RTIO_IODEV_SCHED_NO_MERGE_FLAGS) == 0 &&
+	       rtio_iodev_sched_buf(next) == rtio_iodev_sched_buf(head) + len &&
+	       *rtio_iodev_sched_buf_len(next) <= UINT32_MAX - len;
+}
+
+/*
+ * Append to the submission about to be handed to its iodev the queued ones
+ * which directly follow it in memory. Called with the lock held.
+ */
+static void rtio_iodev_sched_merge(struct rtio_iodev_sched *sched,
+				   struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev_sqe **tail = &iodev_sqe->merged;
+	uint32_t *len = rtio_iodev_sched_buf_len(iodev_sqe);
+	sys_snode_t *node;
+
+	if ((iodev_sqe->sqe.op != RTIO_OP_RX && iodev_sqe->sqe.op != RTIO_OP_TX) ||
+	    (iodev_sqe->sqe.flags & RTIO_IODEV_SCHED_NO_MERGE_FLAGS) != 0) {
+		return;
+	}
+
+	for (node = sys_slist_peek_head(&sched->pending); node != NULL;
+	     node = sys_slist_peek_head(&sched->pending)) {
+		struct rtio_iodev_sqe *next = CONTAINER_OF(node, struct rtio_iodev_sqe, sched_node);
+
+		if (!rtio_iodev_sched_can_merge(iodev_sqe, next, *len)) {
+			break;
+		}
+
+		(void)sys_slist_get_not_empty(&sched->pending);
+		*len += *rtio_iodev_sched_buf_len(next);
+		*tail = next;
+		tail = &next->merged;
+	}
+}
+
+struct rtio_iodev_sqe *rtio_iodev_sched_unmerge(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_iodev_sqe *merged = iodev_sqe->merged;
+	uint32_t *len = rtio_iodev_sched_buf_len(iodev_sqe);
+
+	for (struct rtio_iodev_sqe *curr = merged; curr != NULL; curr = curr->merged) {
+		*len -= *rtio_iodev_sched_buf_len(curr);
+	}
+	iodev_sqe->merged = NULL;
+
+	return merged;
+}
+
+static void rtio_iodev_sched_dispatch(struct rtio_iodev_sched *sched)
+{
+	k_spinlock_key_t key = k_spin_lock(&sched->lock);
+
+	/*
+	 * Iodevs may complete submissions before returning, which comes back
+	 * here. The context already dispatching picks up whatever they queued,
+	 * so that the recursion stays one level deep.
+	 */
+	if (sched->dispatching) {
+		k_spin_unlock(&sched->lock, key);
+		return;
+	}
+	sched->dispatching = true;
+
+	while (sched->in_flight < sched->depth) {
+		sys_snode_t *node = sys_slist_get(&sched->pending);
+		struct rtio_iodev_sqe *iodev_sqe;
+
+		if (node == NULL) {
+			break;
+		}
+
+		iodev_sqe = CONTAINER_OF(node, struct rtio_iodev_sqe, sched_node);
+		if (FIELD_GET(RTIO_SQE_CANCELED, iodev_sqe->sqe.flags)) {
+			/* Canceled while queued, it does not take a slot */
+			k_spin_unlock(&sched->lock, key);
+			rtio_iodev_sqe_err(iodev_sqe, -ECANCELED);
+			key = k_spin_lock(&sched->lock);
+			continue;
+		}
+
+		if (sched->flags & RTIO_IODEV_SCHED_MERGE) {
+			rtio_iodev_sched_merge(sched, iodev_sqe);
+		}
+
+		sched->in_flight++;
+		iodev_sqe->sched = sched;
+		k_spin_unlock(&sched->lock, key);
+
+		iodev_sqe->sqe.iodev->api->submit(iodev_sqe);
+
+		key = k_spin_lock(&sched->lock);
+	}
+
+	sched->dispatching = false;
+	k_spin_unlock(&sched->lock, key);
+}
+
+void rtio_iodev_sched_submit(struct rtio_iodev_sched *sched, struct rtio_iodev_sqe *iodev_sqe)
+{
+	k_spinlock_key_t key = k_spin_lock(&sched->lock);
+
+	iodev_sqe->sched = NULL;
+	iodev_sqe->merged = NULL;
+	rtio_iodev_sched_insert(sched, iodev_sqe);
+
+	k_spin_unlock(&sched->lock, key);
+
+	rtio_iodev_sched_dispatch(sched);
+}
+
+void rtio_iodev_sched_release(struct rtio_iodev_sched *sched)
+{
+	k_spinlock_key_t key = k_spin_lock(&sched->lock);
+
+	__ASSERT_NO_MSG(sched->in_flight > 0);
+	sched->in_flight--;
+
+	k_spin_unlock(&sched->lock, key);
+
+	rtio_iodev_sched_dispatch(sched);
+}
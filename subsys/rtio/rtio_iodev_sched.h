@@ -0,0 +1,21 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_RTIO_IODEV_SCHED_H_
+#define ZEPHYR_SUBSYS_RTIO_IODEV_SCHED_H_
+
+#include <zephyr/rtio/rtio.h>
+
+/* Queue a submission, and hand it to its iodev if there is room */
+void rtio_iodev_sched_submit(struct rtio_iodev_sched *sched, struct rtio_iodev_sqe *iodev_sqe);
+
+/* Undo the merge of a completed submission, returns the submissions merged into it */
+struct rtio_iodev_sqe *rtio_iodev_sched_unmerge(struct rtio_iodev_sqe *iodev_sqe);
+
+/* Release the slot of a completed submission, and hand the next ones to their iodevs */
+void rtio_iodev_sched_release(struct rtio_iodev_sched *sched);
+
+#endif /* ZEPHYR_SUBSYS_RTIO_IODEV_SCHED_H_ */
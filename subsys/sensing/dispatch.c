@@ -11,6 +11,190 @@
 
 LOG_MODULE_DECLARE(sensing, CONFIG_SENSING_LOG_LEVEL);
 
+/* serializes the delivery to the clients with their connections being closed */
+K_MUTEX_DEFINE(sensing_dispatch_lock);
+
+#ifdef CONFIG_SENSING_BATCH
+#define RING_SIZE CONFIG_SENSING_BATCH_RING_SIZE
+
+static void flush_timer_expiry(struct k_timer *timer);
+
+/* wakes the dispatch thread up at the latency deadline of the earliest pending batch */
+static K_TIMER_DEFINE(flush_timer, flush_timer_expiry, NULL);
+
+static void call_client(struct sensing_connection *conn, const void *const *samples,
+			uint16_t count)
+{
+	const struct sensing_callback_list *cb = conn->callback_list;
+
+	if (cb == NULL || (!cb->on_data_batch_event && !cb->on_data_event)) {
+		LOG_WRN("sensor:%s event callback not registered", conn->source->dev->name);
+	} else if (cb->on_data_batch_event) {
+		cb->on_data_batch_event(conn, samples, count, cb->context);
+	} else {
+		for (int i = 0; i < count; i++) {
+			cb->on_data_event(conn, samples[i], cb->context);
+		}
+	}
+}
+
+/* hand the samples of the pending batch over to the client, oldest first */
+static void deliver_batch(struct sensing_sensor *sensor,
+			  struct sensing_connection *conn)
+{
+	struct sensing_sample_ring *ring = sensor->ring;
+	const void *samples[RING_SIZE];
+	uint8_t slots[RING_SIZE];
+	uint16_t count = 0;
+	uint32_t seq;
+
+	/* nothing older than the ring can be pending */
+	seq = ring->head - conn->next_seq > RING_SIZE ? ring->head - RING_SIZE : conn->next_seq;
+	for (; seq != ring->head; seq++) {
+		uint32_t slot = seq % RING_SIZE;
+
+		if (conn->selected & BIT(slot)) {
+			slots[count] = slot;
+			samples[count++] = ring->samples[slot];
+		}
+	}
+
+	conn->next_seq = ring->head;
+	conn->selected = 0;
+
+	if (count == 0) {
+		return;
+	}
+
+	call_client(conn, samples, count);
+
+	/* a slot may be reused once every client it was selected for got it */
+	for (int i = 0; i < count; i++) {
+		atomic_dec(&ring->refs[slots[i]]);
+	}
+}
+
+/* select the sample for the clients due to get it by decimation of the sensor rate */
+static inline bool select_sample(struct sensing_connection *conn, uint32_t seq)
+{
+	if (!is_client_request_data(conn) || (int32_t)(seq - conn->next_sel) < 0) {
+		return false;
+	}
+
+	conn->next_sel = seq + MAX(conn->decimation, 1);
+
+	return true;
+}
+
+/* store the sample once in the ring of the sensor, clients read it from there */
+static void send_data_to_clients(struct sensing_sensor *sensor,
+				 const void *data, uint32_t data_len)
+{
+	struct sensing_sample_ring *ring = sensor->ring;
+	uint32_t seq = ring->head;
+	uint32_t slot = seq % RING_SIZE;
+	struct sensing_connection *conn;
+	uint64_t now = get_us();
+
+	if (data_len > CONFIG_SENSING_BATCH_SAMPLE_SIZE) {
+		/* too large for the ring, handed over as is */
+		ring->head++;
+		for_each_client_conn(sensor, conn) {
+			if (select_sample(conn, seq)) {
+				call_client(conn, &data, 1);
+			}
+		}
+		return;
+	}
+
+	/* clients a whole ring behind get their batch before it is overwritten */
+	if (atomic_get(&ring->refs[slot]) != 0) {
+		for_each_client_conn(sensor, conn) {
+			if (ring->head - conn->next_seq >= RING_SIZE) {
+				deliver_batch(sensor, conn);
+			}
+		}
+	}
+
+	memcpy(ring->samples[slot], data, data_len);
+	ring->head++;
+
+	for_each_client_conn(sensor, conn) {
+		if (select_sample(conn, seq)) {
+			if (conn->selected == 0) {
+				conn->next_seq = seq;
+				conn->deadline = now + conn->latency;
+			}
+			conn->selected |= BIT(slot);
+			atomic_inc(&ring->refs[slot]);
+		} else if (conn->selected == 0) {
+			conn->next_seq = ring->head;
+		}
+	}
+}
+
+static void flush_noop(struct rtio *r, const struct rtio_sqe *sqe, int result, void *arg0)
+{
+	ARG_UNUSED(r);
+	ARG_UNUSED(sqe);
+	ARG_UNUSED(result);
+	ARG_UNUSED(arg0);
+}
+
+static void flush_timer_expiry(struct k_timer *timer)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&sensing_rtio_ctx);
+
+	/* with the queue full, the batches are flushed on the next completion anyway */
+	if (sqe == NULL) {
+		return;
+	}
+
+	rtio_sqe_prep_callback(sqe, flush_noop, NULL, timer);
+	rtio_submit(&sensing_rtio_ctx, 0);
+}
+
+/* deliver the batches due by now and arm the timer for the next one */
+static void flush_batches(void)
+{
+	struct sensing_connection *conn;
+	uint64_t next = UINT64_MAX;
+	uint64_t now = get_us();
+
+	for_each_sensor(sensor) {
+		for_each_client_conn(sensor, conn) {
+			if (conn->selected == 0) {
+				continue;
+			}
+
+			if (now >= conn->deadline) {
+				deliver_batch(sensor, conn);
+			} else {
+				next = MIN(next, conn->deadline);
+			}
+		}
+	}
+
+	if (next == UINT64_MAX) {
+		k_timer_stop(&flush_timer);
+	} else {
+		k_timer_start(&flush_timer, K_USEC(next - now), K_NO_WAIT);
+	}
+}
+
+void sensing_release_batch(struct sensing_connection *conn)
+{
+	struct sensing_sample_ring *ring = conn->source->ring;
+
+	for (uint32_t slot = 0; slot < RING_SIZE; slot++) {
+		if (conn->selected & BIT(slot)) {
+			atomic_dec(&ring->refs[slot]);
+		}
+	}
+
+	conn->selected = 0;
+}
+#else
 /* check whether it is right time for client to consume this sample */
 static inline bool sensor_test_consume_time(struct sensing_sensor *sensor,
 				     struct sensing_connection *conn,
@@ -59,17 +243,22 @@ static int send_data_to_clients(struct sensing_sensor *sensor,
 
 		update_client_consume_time(sensor, conn);
 
-		if (!conn->callback_list->on_data_event) {
+		if (conn->callback_list->on_data_event) {
+			conn->callback_list->on_data_event(conn, data,
+					conn->callback_list->context);
+		} else if (conn->callback_list->on_data_batch_event) {
+			conn->callback_list->on_data_batch_event(conn,
+					(const void *const *)&data, 1,
+					conn->callback_list->context);
+		} else {
 			LOG_WRN("sensor:%s event callback not registered",
 					conn->source->dev->name);
-			continue;
 		}
-		conn->callback_list->on_data_event(conn, data,
-				conn->callback_list->context);
 	}
 
 	return 0;
 }
+#endif /* CONFIG_SENSING_BATCH */
 
 STRUCT_SECTION_START_EXTERN(sensing_sensor);
 STRUCT_SECTION_END_EXTERN(sensing_sensor);
@@ -87,6 +276,10 @@ static void dispatch_task(void *a, void *b, void *c)
 
 	if (IS_ENABLED(CONFIG_USERSPACE) && !k_is_user_context()) {
 		rtio_access_grant(&sensing_rtio_ctx, k_current_get());
+		k_object_access_grant(&sensing_dispatch_lock, k_current_get());
+#ifdef CONFIG_SENSING_BATCH
+		k_object_access_grant(&flush_timer, k_current_get());
+#endif
 		k_thread_user_mode_enter(dispatch_task, a, b, c);
 	}
 
@@ -101,6 +294,15 @@ static void dispatch_task(void *a, void *b, void *c)
 		/* Cache the data from the CQE */
 		rc = cqe.result;
 
+#ifdef CONFIG_SENSING_BATCH
+		if (cqe.userdata == &flush_timer) {
+			k_mutex_lock(&sensing_dispatch_lock, K_FOREVER);
+			flush_batches();
+			k_mutex_unlock(&sensing_dispatch_lock);
+			continue;
+		}
+#endif
+
 		/* Get the associated data */
 		get_data_rc =
 			rtio_cqe_get_mempool_buffer(&sensing_rtio_ctx, &cqe, &data, &data_len);
@@ -113,7 +315,15 @@ static void dispatch_task(void *a, void *b, void *c)
 		    (uintptr_t)cqe.userdata < (uintptr_t)STRUCT_SECTION_END(sensing_sensor)) {
 			struct sensing_sensor *sensor = cqe.userdata;
 
+			k_mutex_lock(&sensing_dispatch_lock, K_FOREVER);
+#ifdef CONFIG_SENSING_BATCH
+			send_data_to_clients(sensor, data,
+					     MIN(data_len, sensor->register_info->sample_size));
+			flush_batches();
+#else
 			send_data_to_clients(sensor, data);
+#endif
+			k_mutex_unlock(&sensing_dispatch_lock);
 		}
 
 		rtio_release_buffer(&sensing_rtio_ctx, data, data_len);
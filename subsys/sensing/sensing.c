@@ -99,6 +99,9 @@ int sensing_set_config(sensing_sensor_handle_t handle,
 			break;
 
 		case SENSING_SENSOR_ATTRIBUTE_LATENCY:
+#ifdef CONFIG_SENSING_BATCH
+			ret |= set_latency(handle, cfg->latency);
+#endif
 			break;
 
 		default:
@@ -139,6 +142,9 @@ int sensing_get_config(sensing_sensor_handle_t handle,
 			break;
 
 		case SENSING_SENSOR_ATTRIBUTE_LATENCY:
+#ifdef CONFIG_SENSING_BATCH
+			ret |= get_latency(handle, &cfg->latency);
+#endif
 			break;
 
 		default:
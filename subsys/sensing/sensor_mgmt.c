@@ -119,13 +119,43 @@ static int set_arbitrate_interval(struct sensing_sensor *sensor, uint32_t interv
 	return ret;
 }
 
+#ifdef CONFIG_SENSING_BATCH
+/* clients get one sample out of as many as their interval spans at the sensor rate */
+static void update_decimation(struct sensing_sensor *sensor)
+{
+	struct sensing_connection *conn;
+
+	for_each_client_conn(sensor, conn) {
+		if (sensor->interval == 0 || conn->interval <= sensor->interval) {
+			conn->decimation = 1;
+		} else {
+			conn->decimation = MIN((conn->interval + sensor->interval / 2) /
+					       sensor->interval, UINT16_MAX);
+		}
+	}
+}
+#endif
+
 static int config_interval(struct sensing_sensor *sensor)
 {
 	uint32_t interval = arbitrate_interval(sensor);
+	int ret = 0;
 
 	LOG_INF("config interval, sensor:%s, interval:%d", sensor->dev->name, interval);
 
-	return set_arbitrate_interval(sensor, interval);
+	/*
+	 * with batching, a client changing its interval does not always change
+	 * the sensor rate, only its decimation
+	 */
+	if (!IS_ENABLED(CONFIG_SENSING_BATCH) || interval != sensor->interval) {
+		ret = set_arbitrate_interval(sensor, interval);
+	}
+
+#ifdef CONFIG_SENSING_BATCH
+	update_decimation(sensor);
+#endif
+
+	return ret;
 }
 
 static uint32_t arbitrate_sensitivity(struct sensing_sensor *sensor, int index)
@@ -160,6 +190,11 @@ static int set_arbitrate_sensitivity(struct sensing_sensor *sensor, int index, u
 	struct sensor_value threshold = {.val1 = sensitivity};
 	int i;
 
+	/* with batching, skip the sensor update when nothing changed */
+	if (IS_ENABLED(CONFIG_SENSING_BATCH) && sensor->sensitivity[index] == sensitivity) {
+		return 0;
+	}
+
 	/* update sensor sensitivity */
 	sensor->sensitivity[index] = sensitivity;
 
@@ -275,6 +310,13 @@ static void init_connection(struct sensing_connection *conn,
 
 	conn->interval = 0;
 	memset(conn->sensitivity, 0x00, sizeof(conn->sensitivity));
+#ifdef CONFIG_SENSING_BATCH
+	conn->latency = 0;
+	conn->selected = 0;
+	conn->decimation = 1;
+	conn->next_seq = conn->source->ring->head;
+	conn->next_sel = conn->next_seq;
+#endif
 	/* link connection to its reporter's client_list */
 	sys_slist_append(&conn->source->client_list, &conn->snode);
 }
@@ -378,8 +420,17 @@ int close_sensor(struct sensing_connection **conn)
 
 	__ASSERT(tmp_conn->source, "reporter should not be NULL");
 
+	/* the dispatch thread may be delivering to the connection */
+	k_mutex_lock(&sensing_dispatch_lock, K_FOREVER);
+
 	sys_slist_find_and_remove(&tmp_conn->source->client_list, &tmp_conn->snode);
 
+#ifdef CONFIG_SENSING_BATCH
+	sensing_release_batch(tmp_conn);
+#endif
+
+	k_mutex_unlock(&sensing_dispatch_lock);
+
 	save_config_and_notify(tmp_conn->source);
 
 	free(*conn);
@@ -421,6 +472,10 @@ int set_interval(struct sensing_connection *conn, uint32_t interval)
 
 	conn->interval = interval;
 	conn->next_consume_time = EXEC_TIME_INIT;
+#ifdef CONFIG_SENSING_BATCH
+	/* start over with the next sample */
+	conn->next_sel = conn->source->ring->head;
+#endif
 
 	LOG_INF("set interval, sensor:%s, conn:%p, interval:%d",
 		conn->source->dev->name, conn, interval);
@@ -440,6 +495,28 @@ int get_interval(struct sensing_connection *conn, uint32_t *interval)
 	return 0;
 }
 
+#ifdef CONFIG_SENSING_BATCH
+int set_latency(struct sensing_connection *conn, uint64_t latency)
+{
+	__ASSERT(conn && conn->source, "set latency, connection or reporter not be NULL");
+
+	conn->latency = latency;
+
+	LOG_INF("set latency, sensor:%s, conn:%p, latency:%llu(us)",
+		conn->source->dev->name, conn, latency);
+
+	return 0;
+}
+
+int get_latency(struct sensing_connection *conn, uint64_t *latency)
+{
+	__ASSERT(conn, "get latency, connection not be NULL");
+	*latency = conn->latency;
+
+	return 0;
+}
+#endif
+
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t sensitivity)
 {
 	int i;
@@ -39,6 +39,7 @@ extern "C" {
 #define EXEC_TIME_OFF UINT64_MAX
 
 extern struct rtio sensing_rtio_ctx;
+extern struct k_mutex sensing_dispatch_lock;
 /**
  * @struct sensing_context
  * @brief sensing subsystem context to include global variables
@@ -57,6 +58,12 @@ int set_interval(struct sensing_connection *conn, uint32_t interval);
 int get_interval(struct sensing_connection *con, uint32_t *sensitivity);
 int set_sensitivity(struct sensing_connection *conn, int8_t index, uint32_t interval);
 int get_sensitivity(struct sensing_connection *con, int8_t index, uint32_t *sensitivity);
+#ifdef CONFIG_SENSING_BATCH
+int set_latency(struct sensing_connection *conn, uint64_t latency);
+int get_latency(struct sensing_connection *conn, uint64_t *latency);
+/* to be called with sensing_dispatch_lock held */
+void sensing_release_batch(struct sensing_connection *conn);
+#endif
 
 static inline struct sensing_sensor *get_sensor_by_dev(const struct device *dev)
 {
@@ -49,14 +49,26 @@
 		tracing_format_raw_data(epacket, sizeof(epacket));                                 \
 	}
 
+/*
+ * Keeps timestamps in the order of the events in the buffer. Per-CPU buffers
+ * only need that order on the local CPU.
+ */
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+#define CTF_INTERNAL_LOCK()        arch_irq_lock()
+#define CTF_INTERNAL_UNLOCK(key)   arch_irq_unlock(key)
+#else
+#define CTF_INTERNAL_LOCK()        irq_lock()
+#define CTF_INTERNAL_UNLOCK(key)   irq_unlock(key)
+#endif
+
 #ifdef CONFIG_TRACING_CTF_TIMESTAMP
 #define CTF_EVENT(...)                                                                             \
 	{                                                                                          \
-		int key = irq_lock();                                                              \
+		int key = CTF_INTERNAL_LOCK();                                                     \
 		const uint32_t tstamp = k_cyc_to_ns_floor64(k_cycle_get_32());                     \
                                                                                                    \
 		CTF_GATHER_FIELDS(tstamp, __VA_ARGS__)                                             \
-		irq_unlock(key);                                                                   \
+		CTF_INTERNAL_UNLOCK(key);                                                          \
 	}
 #else
 #define CTF_EVENT(...) {CTF_GATHER_FIELDS(__VA_ARGS__)}
@@ -306,6 +306,15 @@ extern "C" {
 	sys_trace_k_msgq_get_exit(msgq, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)     sys_trace_k_msgq_purge(msgq)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, num_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, max_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_reserve(msgq, ret)
+#define sys_port_trace_k_msgq_commit(msgq, ret)
+#define sys_port_trace_k_msgq_cancel(msgq)
 
 #define sys_port_trace_k_mbox_init(mbox) sys_trace_k_mbox_init(mbox)
 #define sys_port_trace_k_mbox_message_put_enter(mbox, timeout)                                     \
@@ -337,6 +346,10 @@ extern "C" {
 #define sys_port_trace_k_pipe_read_enter(pipe, data, len, timeout)
 #define sys_port_trace_k_pipe_read_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_read_exit(pipe, ret)
+#define sys_port_trace_k_pipe_writev_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_writev_exit(pipe, ret)
+#define sys_port_trace_k_pipe_readv_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_readv_exit(pipe, ret)
 
 #define sys_port_trace_k_heap_init(heap)
 #define sys_port_trace_k_heap_aligned_alloc_enter(heap, timeout)
@@ -9,6 +9,7 @@
 
 #include <stdbool.h>
 #include <zephyr/types.h>
+#include <zephyr/tracing/tracing_format.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -113,6 +114,43 @@ uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
  */
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+/**
+ * @brief Initialize the tracing buffers of all CPUs.
+ */
+void tracing_buffer_cpu_init(void);
+
+/**
+ * @brief Put a record to the tracing buffer of the current CPU.
+ *
+ * The segments are timestamped and stored as one contiguous record, without
+ * taking any lock shared with the other CPUs.
+ *
+ * @param data Segments of the record.
+ * @param count Number of segments.
+ * @param was_empty Set to true if the buffer was empty before this put.
+ *
+ * @return True if the record was stored; False if the buffer is full.
+ */
+bool tracing_buffer_cpu_put(const tracing_data_t *data, uint32_t count, bool *was_empty);
+
+/**
+ * @brief Tracing buffers of all CPUs are empty or not.
+ *
+ * @return true if no CPU has a record to output, or false if not.
+ */
+bool tracing_buffer_cpu_is_empty(void);
+
+/**
+ * @brief Output the records of all CPUs, in timestamp order.
+ *
+ * Must only be called from the tracing thread.
+ *
+ * @return Number of records output.
+ */
+uint32_t tracing_buffer_cpu_drain(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
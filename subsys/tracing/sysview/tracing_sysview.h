@@ -570,6 +570,16 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_purge(msgq)                                                          \
 	SEGGER_SYSVIEW_RecordU32(TID_MSGQ_PURGE, (uint32_t)(uintptr_t)msgq)
 
+#define sys_port_trace_k_msgq_put_many_enter(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, num_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, max_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_reserve(msgq, ret)
+#define sys_port_trace_k_msgq_commit(msgq, ret)
+#define sys_port_trace_k_msgq_cancel(msgq)
+
 #define sys_port_trace_k_mbox_init(mbox)                                                           \
 	SEGGER_SYSVIEW_RecordU32(TID_MBOX_INIT, (uint32_t)(uintptr_t)mbox)
 
@@ -616,6 +626,10 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_pipe_read_enter(pipe, data, len, timeout)
 #define sys_port_trace_k_pipe_read_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_read_exit(pipe, ret)
+#define sys_port_trace_k_pipe_writev_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_writev_exit(pipe, ret)
+#define sys_port_trace_k_pipe_readv_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_readv_exit(pipe, ret)
 
 #define sys_port_trace_k_pipe_cleanup_enter(pipe)
 #define sys_port_trace_k_pipe_cleanup_exit(pipe, ret)
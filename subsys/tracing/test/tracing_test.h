@@ -328,6 +328,15 @@
 	sys_trace_k_msgq_get_exit(msgq, data, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, num_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, max_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, max_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_reserve(msgq, ret)
+#define sys_port_trace_k_msgq_commit(msgq, ret)
+#define sys_port_trace_k_msgq_cancel(msgq)
 
 #define sys_port_trace_k_mbox_init(mbox) sys_trace_k_mbox_init(mbox)
 #define sys_port_trace_k_mbox_message_put_enter(mbox, timeout)                                     \
@@ -367,6 +376,10 @@
 	sys_trace_k_pipe_read_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_read_exit(pipe, ret) \
 	sys_trace_k_pipe_read_exit(pipe, ret)
+#define sys_port_trace_k_pipe_writev_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_writev_exit(pipe, ret)
+#define sys_port_trace_k_pipe_readv_enter(pipe, iov, iovcnt, timeout)
+#define sys_port_trace_k_pipe_readv_exit(pipe, ret)
 
 #define sys_port_trace_k_heap_init(h) sys_trace_k_heap_init(h, mem, bytes)
 #define sys_port_trace_k_heap_aligned_alloc_enter(h, timeout)                                      \
@@ -0,0 +1,223 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DISABLE_SYSCALL_TRACING
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/util.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_TRACING_BUFFER_SIZE),
+	     "Per-CPU tracing buffers need a power of two size");
+
+#define TRACING_CPU_BUFFER_MASK (CONFIG_TRACING_BUFFER_SIZE - 1)
+
+/* Length of the record ending the buffer when the next one did not fit */
+#define TRACING_RECORD_WRAP UINT16_MAX
+
+struct tracing_record {
+	uint16_t length;
+	uint16_t reserved;
+	uint32_t timestamp;
+	uint8_t data[];
+};
+
+/*
+ * Records are 4 byte aligned, so that a record header never straddles the
+ * end of the buffer.
+ */
+#define TRACING_RECORD_SIZE(length) ROUND_UP(sizeof(struct tracing_record) + (length), 4)
+
+/*
+ * Only the owning CPU moves the head, with its interrupts locked, and only the
+ * tracing thread moves the tail, so the CPUs share no lock. Both indexes run
+ * freely and are masked on access.
+ */
+struct tracing_cpu_buffer {
+	atomic_t head;
+	atomic_t tail;
+	uint8_t buf[CONFIG_TRACING_BUFFER_SIZE] __aligned(4);
+};
+
+static struct tracing_cpu_buffer tracing_cpu_buffers[CONFIG_MP_MAX_NUM_CPUS];
+static uint8_t tracing_drain_buffer[CONFIG_TRACING_DRAIN_BUFFER_SIZE];
+
+void tracing_buffer_cpu_init(void)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		atomic_set(&tracing_cpu_buffers[i].head, 0);
+		atomic_set(&tracing_cpu_buffers[i].tail, 0);
+	}
+}
+
+bool tracing_buffer_cpu_put(const tracing_data_t *data, uint32_t count, bool *was_empty)
+{
+	struct tracing_cpu_buffer *cpu_buf;
+	struct tracing_record *record;
+	uint32_t length = 0U, head, tail, pos, pad, size;
+	uint8_t *cursor;
+	unsigned int key;
+
+	for (uint32_t i = 0; i < count; i++) {
+		length += data[i].length;
+	}
+
+	size = TRACING_RECORD_SIZE(length);
+	if (length >= TRACING_RECORD_WRAP || size > CONFIG_TRACING_BUFFER_SIZE) {
+		return false;
+	}
+
+	/* Only keeps the local interrupts away, other CPUs use their own buffer */
+	key = arch_irq_lock();
+	cpu_buf = &tracing_cpu_buffers[_current_cpu->id];
+
+	head = (uint32_t)atomic_get(&cpu_buf->head);
+	tail = (uint32_t)atomic_get(&cpu_buf->tail);
+	pos = head & TRACING_CPU_BUFFER_MASK;
+	pad = (CONFIG_TRACING_BUFFER_SIZE - pos < size) ? CONFIG_TRACING_BUFFER_SIZE - pos : 0U;
+
+	if (CONFIG_TRACING_BUFFER_SIZE - (head - tail) < pad + size) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	*was_empty = (head == tail);
+
+	if (pad != 0U) {
+		((struct tracing_record *)&cpu_buf->buf[pos])->length = TRACING_RECORD_WRAP;
+		pos = 0U;
+	}
+
+	record = (struct tracing_record *)&cpu_buf->buf[pos];
+	record->length = length;
+	record->timestamp = k_cycle_get_32();
+
+	cursor = record->data;
+	for (uint32_t i = 0; i < count; i++) {
+		memcpy(cursor, data[i].data, data[i].length);
+		cursor += data[i].length;
+	}
+
+	/* Publish the record only once it is complete */
+	barrier_dmem_fence_full();
+	atomic_set(&cpu_buf->head, (atomic_val_t)(head + pad + size));
+
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+bool tracing_buffer_cpu_is_empty(void)
+{
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (atomic_get(&tracing_cpu_buffers[i].head) !=
+		    atomic_get(&tracing_cpu_buffers[i].tail)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static struct tracing_record *tracing_cpu_peek(struct tracing_cpu_buffer *cpu_buf)
+{
+	uint32_t tail = (uint32_t)atomic_get(&cpu_buf->tail);
+	uint32_t head = (uint32_t)atomic_get(&cpu_buf->head);
+	struct tracing_record *record;
+
+	if (head == tail) {
+		return NULL;
+	}
+
+	/* Read the record only after having seen it published */
+	barrier_dmem_fence_full();
+
+	record = (struct tracing_record *)&cpu_buf->buf[tail & TRACING_CPU_BUFFER_MASK];
+	if (record->length == TRACING_RECORD_WRAP) {
+		/* A wrap is always published together with the record after it */
+		atomic_add(&cpu_buf->tail,
+			   CONFIG_TRACING_BUFFER_SIZE - (tail & TRACING_CPU_BUFFER_MASK));
+		record = (struct tracing_record *)&cpu_buf->buf[0];
+	}
+
+	return record;
+}
+
+static void tracing_cpu_consume(struct tracing_cpu_buffer *cpu_buf,
+				const struct tracing_record *record)
+{
+	uint32_t size = TRACING_RECORD_SIZE(record->length);
+
+	/* Done with the record before giving its room back to the CPU */
+	barrier_dmem_fence_full();
+	atomic_add(&cpu_buf->tail, size);
+}
+
+static void tracing_drain_flush(uint32_t *staged)
+{
+	if (*staged != 0U) {
+		tracing_buffer_handle(tracing_drain_buffer, *staged);
+		*staged = 0U;
+	}
+}
+
+uint32_t tracing_buffer_cpu_drain(void)
+{
+	struct tracing_record *next[CONFIG_MP_MAX_NUM_CPUS];
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t records = 0U, staged = 0U;
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		next[i] = tracing_cpu_peek(&tracing_cpu_buffers[i]);
+	}
+
+	/*
+	 * Merge the CPUs by timestamp. A record still being written when an
+	 * older one of another CPU is output may end up slightly out of order.
+	 */
+	while (true) {
+		struct tracing_record *record;
+		int oldest = -1;
+
+		for (unsigned int i = 0; i < num_cpus; i++) {
+			if (next[i] != NULL &&
+			    (oldest < 0 ||
+			     (int32_t)(next[i]->timestamp - next[oldest]->timestamp) < 0)) {
+				oldest = i;
+			}
+		}
+
+		if (oldest < 0) {
+			break;
+		}
+
+		record = next[oldest];
+
+		/* Gather the packets to give the backend fewer, larger chunks */
+		if (staged + record->length > sizeof(tracing_drain_buffer)) {
+			tracing_drain_flush(&staged);
+		}
+
+		if (record->length > sizeof(tracing_drain_buffer)) {
+			tracing_buffer_handle(record->data, record->length);
+		} else {
+			memcpy(&tracing_drain_buffer[staged], record->data, record->length);
+			staged += record->length;
+		}
+
+		tracing_cpu_consume(&tracing_cpu_buffers[oldest], record);
+		next[oldest] = tracing_cpu_peek(&tracing_cpu_buffers[oldest]);
+		records++;
+	}
+
+	tracing_drain_flush(&staged);
+
+	return records;
+}
@@ -40,6 +40,20 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		if (tracing_buffer_cpu_is_empty()) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		} else {
+			tracing_buffer_cpu_drain();
+		}
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -63,6 +77,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
@@ -78,7 +93,11 @@ static void tracing_set_state(enum tracing_state state)
 static int tracing_init(void)
 {
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+	tracing_buffer_cpu_init();
+#else
 	tracing_buffer_init();
+#endif
 
 	working_backend = tracing_backend_get(CONFIG_TRACING_BACKEND_NAME);
 	tracing_backend_init(working_backend);
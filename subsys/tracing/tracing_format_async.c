@@ -9,7 +9,65 @@
 #include <tracing_core.h>
 #include <tracing_buffer.h>
 #include <tracing_format_common.h>
+#include <zephyr/sys/printk.h>
 
+#ifdef CONFIG_TRACING_BUFFER_PER_CPU
+static void tracing_format_cpu_put(const tracing_data_t *data, uint32_t count)
+{
+	bool was_empty = false;
+
+	if (tracing_buffer_cpu_put(data, count, &was_empty)) {
+		tracing_trigger_output(was_empty);
+	} else {
+		tracing_packet_drop_handle();
+	}
+}
+
+void tracing_format_string(const char *str, ...)
+{
+	uint8_t buf[CONFIG_TRACING_PACKET_MAX_SIZE];
+	tracing_data_t data = {.data = buf};
+	va_list args;
+	int length;
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	va_start(args, str);
+	length = vsnprintk((char *)buf, sizeof(buf), str, args);
+	va_end(args);
+
+	if (length < 0) {
+		tracing_packet_drop_handle();
+		return;
+	}
+
+	/* Strings longer than a packet are truncated */
+	data.length = MIN((uint32_t)length, sizeof(buf) - 1);
+	tracing_format_cpu_put(&data, 1);
+}
+
+void tracing_format_raw_data(uint8_t *data, uint32_t length)
+{
+	tracing_data_t tracing_data = {.data = data, .length = length};
+
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_format_cpu_put(&tracing_data, 1);
+}
+
+void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
+{
+	if (!is_tracing_enabled() || is_tracing_thread()) {
+		return;
+	}
+
+	tracing_format_cpu_put(tracing_data_array, count);
+}
+#else
 void tracing_format_string(const char *str, ...)
 {
 	va_list args;
@@ -74,3 +132,4 @@ void tracing_format_data(tracing_data_t *tracing_data_array, uint32_t count)
 		tracing_packet_drop_handle();
 	}
 }
+#endif /* CONFIG_TRACING_BUFFER_PER_CPU */
@@ -35,7 +35,6 @@ enum {
 	CDC_NCM_IFACE_UP,
 	CDC_NCM_DATA_IFACE_ENABLED,
 	CDC_NCM_CLASS_SUSPENDED,
-	CDC_NCM_OUT_ENGAGED,
 };
 
 /* Chapter 6.2.7 table 6-4 */
@@ -171,13 +170,16 @@ union recv_ntb {
 } __packed;
 
 /*
- * Transfers through two endpoints proceed in a synchronous manner,
- * with maximum block of CDC_NCM_SEND_NTB_MAX_SIZE.
+ * Each bulk endpoint keeps a pipeline of transfers queued, with blocks of up
+ * to CDC_NCM_SEND_NTB_MAX_SIZE and CDC_NCM_RECV_NTB_MAX_SIZE.
  */
-UDC_BUF_POOL_DEFINE(cdc_ncm_ep_pool,
-		    DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * 2,
-		    MAX(CDC_NCM_SEND_NTB_MAX_SIZE, CDC_NCM_RECV_NTB_MAX_SIZE),
-		    sizeof(struct udc_buf_info), NULL);
+UDC_BUF_POOL_DEFINE(cdc_ncm_in_pool,
+		    DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * CONFIG_USBD_CDC_NCM_IN_BUFFERS,
+		    CDC_NCM_SEND_NTB_MAX_SIZE, sizeof(struct udc_buf_info), NULL);
+
+UDC_BUF_POOL_DEFINE(cdc_ncm_out_pool,
+		    DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) * CONFIG_USBD_CDC_NCM_OUT_BUFFERS,
+		    CDC_NCM_RECV_NTB_MAX_SIZE, sizeof(struct udc_buf_info), NULL);
 
 /*
  * Collection of descriptors used to assemble specific function descriptors.
@@ -230,7 +232,8 @@ struct cdc_ncm_eth_data {
 	uint16_t tx_seq;
 	uint16_t rx_seq;
 
-	struct k_sem sync_sem;
+	struct usbd_ep_pipe in_pipe;
+	struct usbd_ep_pipe out_pipe;
 
 	struct k_work_delayable notif_work;
 };
@@ -299,49 +302,20 @@ static uint8_t cdc_ncm_get_bulk_out(struct usbd_class_data *const c_data)
 	return desc->if1_1_out_ep.bEndpointAddress;
 }
 
-static struct net_buf *cdc_ncm_buf_alloc(const uint8_t ep)
-{
-	struct net_buf *buf = NULL;
-	struct udc_buf_info *bi;
-
-	buf = net_buf_alloc(&cdc_ncm_ep_pool, K_NO_WAIT);
-	if (!buf) {
-		return NULL;
-	}
-
-	bi = udc_get_buf_info(buf);
-	bi->ep = ep;
-
-	return buf;
-}
-
-static int cdc_ncm_out_start(struct usbd_class_data *const c_data)
+static int cdc_ncm_pipes_start(struct usbd_class_data *const c_data)
 {
 	const struct device *dev = usbd_class_get_private(c_data);
 	struct cdc_ncm_eth_data *data = dev->data;
-	struct net_buf *buf;
-	uint8_t ep;
-	int ret;
-
-	if (atomic_test_and_set_bit(&data->state, CDC_NCM_OUT_ENGAGED)) {
-		return -EBUSY;
-	}
 
-	ep = cdc_ncm_get_bulk_out(c_data);
-	buf = cdc_ncm_buf_alloc(ep);
-	if (buf == NULL) {
-		return -ENOMEM;
-	}
+	(void)usbd_ep_pipe_start(&data->in_pipe, cdc_ncm_get_bulk_in(c_data));
 
-	ret = usbd_ep_enqueue(c_data, buf);
-	if (ret) {
-		LOG_ERR("Failed to enqueue net_buf for 0x%02x", ep);
-		net_buf_unref(buf);
-	} else {
-		LOG_DBG("enqueue out %u", buf->size);
-	}
+	return usbd_ep_pipe_start(&data->out_pipe, cdc_ncm_get_bulk_out(c_data));
+}
 
-	return  ret;
+static void cdc_ncm_pipes_stop(struct cdc_ncm_eth_data *const data)
+{
+	usbd_ep_pipe_stop(&data->in_pipe);
+	usbd_ep_pipe_stop(&data->out_pipe);
 }
 
 static int verify_nth16(struct cdc_ncm_eth_data *const data,
@@ -606,14 +580,8 @@ unref_packet:
 	net_pkt_unref(src);
 
 restart_out_transfer:
-	net_buf_unref(buf);
-
-	atomic_clear_bit(&data->state, CDC_NCM_OUT_ENGAGED);
-	if (atomic_test_bit(&data->state, CDC_NCM_DATA_IFACE_ENABLED)) {
-		return cdc_ncm_out_start(c_data);
-	}
-
-	return 0;
+	/* Replaced by a new transfer as long as the data interface is enabled */
+	return usbd_ep_pipe_done(&data->out_pipe, buf);
 }
 
 static void ncm_handle_notifications(const struct device *dev, const int err)
@@ -654,8 +622,11 @@ static int usbd_cdc_ncm_request(struct usbd_class_data *const c_data,
 	}
 
 	if (bi->ep == cdc_ncm_get_bulk_in(c_data)) {
-		k_sem_give(&data->sync_sem);
-		return 0;
+		if (err != 0 && err != -ECONNABORTED) {
+			LOG_ERR("Bulk IN transfer error (%d)", err);
+		}
+
+		return usbd_ep_pipe_done(&data->in_pipe, buf);
 	}
 
 	if (bi->ep == cdc_ncm_get_int_in(c_data)) {
@@ -840,6 +811,7 @@ static void usbd_cdc_ncm_update(struct usbd_class_data *const c_data,
 
 	if (data_iface == iface && alternate == 0) {
 		atomic_clear_bit(&data->state, CDC_NCM_DATA_IFACE_ENABLED);
+		cdc_ncm_pipes_stop(data);
 		data->tx_seq = 0;
 		data->rx_seq = 0;
 	}
@@ -848,7 +820,7 @@ static void usbd_cdc_ncm_update(struct usbd_class_data *const c_data,
 		atomic_set_bit(&data->state, CDC_NCM_DATA_IFACE_ENABLED);
 		data->if_state = IF_STATE_INIT;
 		(void)k_work_reschedule(&data->notif_work, K_MSEC(100));
-		ret = cdc_ncm_out_start(c_data);
+		ret = cdc_ncm_pipes_start(c_data);
 		if (ret < 0) {
 			LOG_ERR("Failed to start OUT transfer (%d)", ret);
 		}
@@ -867,6 +839,7 @@ static void usbd_cdc_ncm_disable(struct usbd_class_data *const c_data)
 
 	atomic_clear_bit(&data->state, CDC_NCM_DATA_IFACE_ENABLED);
 	atomic_clear_bit(&data->state, CDC_NCM_CLASS_SUSPENDED);
+	cdc_ncm_pipes_stop(data);
 
 	LOG_INF("Disabled %s", c_data->name);
 }
@@ -987,6 +960,10 @@ static int usbd_cdc_ncm_init(struct usbd_class_data *const c_data)
 	desc->if0_union.bControlInterface = if_num;
 	desc->if0_union.bSubordinateInterface0 = if_num + 1;
 
+	usbd_ep_pipe_init(&data->in_pipe, c_data, NULL, CONFIG_USBD_CDC_NCM_IN_BUFFERS);
+	usbd_ep_pipe_init(&data->out_pipe, c_data, &cdc_ncm_out_pool,
+			  CONFIG_USBD_CDC_NCM_OUT_BUFFERS);
+
 	LOG_DBG("CDC NCM class initialized");
 
 	if (desc->if0_ecm.iMACAddress == 0) {
@@ -1030,6 +1007,7 @@ static int cdc_ncm_send(const struct device *dev, struct net_pkt *const pkt)
 	size_t len = net_pkt_get_len(pkt);
 	struct net_buf *buf;
 	union send_ntb *ntb;
+	int ret;
 
 	if (len > NET_ETH_MAX_FRAME_SIZE) {
 		LOG_WRN("Trying to send too large packet, drop");
@@ -1044,11 +1022,8 @@ static int cdc_ncm_send(const struct device *dev, struct net_pkt *const pkt)
 		return -EACCES;
 	}
 
-	buf = cdc_ncm_buf_alloc(cdc_ncm_get_bulk_in(c_data));
-	if (buf == NULL) {
-		LOG_ERR("Failed to allocate buffer");
-		return -ENOMEM;
-	}
+	/* Wait for one of the NTBs in flight to be released */
+	buf = net_buf_alloc(&cdc_ncm_in_pool, K_FOREVER);
 
 	ntb = (union send_ntb *)buf->data;
 
@@ -1085,12 +1060,16 @@ static int cdc_ncm_send(const struct device *dev, struct net_pkt *const pkt)
 		udc_ep_buf_set_zlp(buf);
 	}
 
-	usbd_ep_enqueue(c_data, buf);
-	k_sem_take(&data->sync_sem, K_FOREVER);
-
-	net_buf_unref(buf);
+	/* The buffer is released once transferred, so the next NTB can be
+	 * assembled while this one is on the bus.
+	 */
+	ret = usbd_ep_pipe_enqueue(&data->in_pipe, buf, K_FOREVER);
+	if (ret) {
+		LOG_ERR("Failed to enqueue NTB (%d)", ret);
+		net_buf_unref(buf);
+	}
 
-	return 0;
+	return ret;
 }
 
 static int cdc_ncm_set_config(const struct device *dev,
@@ -1387,7 +1366,6 @@ const static struct usb_desc_header *cdc_ncm_hs_desc_##n[] = {			\
 	static struct cdc_ncm_eth_data eth_data_##n = {				\
 		.c_data = &cdc_ncm_##n,						\
 		.mac_addr = DT_INST_PROP_OR(n, local_mac_address, {0}),		\
-		.sync_sem = Z_SEM_INITIALIZER(eth_data_##n.sync_sem, 0, 1),	\
 		.mac_desc_data = &mac_desc_data_##n,				\
 		.desc = &cdc_ncm_desc_##n,					\
 		.fs_desc = cdc_ncm_fs_desc_##n,					\
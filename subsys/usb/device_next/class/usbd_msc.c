@@ -60,7 +60,11 @@ struct CSW {
 /* Single instance is likely enough because it can support multiple LUNs */
 #define MSC_NUM_INSTANCES CONFIG_USBD_MSC_INSTANCES_COUNT
 
-#define MSC_NUM_BUFFERS UTIL_INC(IS_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING))
+#define MSC_NUM_BUFFERS CONFIG_USBD_MSC_NUM_BUFFERS
+
+/* SCSI buffers of an instance are contiguous, each one suitably aligned */
+#define MSC_SCSI_BUF_STRIDE ROUND_UP(ROUND_UP(CONFIG_USBD_MSC_SCSI_BUFFER_SIZE,	\
+					      UDC_BUF_GRANULARITY), UDC_BUF_ALIGN)
 
 #if USBD_MAX_BULK_MPS > CONFIG_USBD_MSC_SCSI_BUFFER_SIZE
 #error "SCSI buffer must be at least USB bulk endpoint wMaxPacketSize"
@@ -78,8 +82,11 @@ struct msc_event {
 	int err;
 };
 
-/* Each instance has 2 endpoints and can receive bulk only reset command */
-K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event), MSC_NUM_INSTANCES * 3, 4);
+/* Each instance can have all its buffers queued on an endpoint, one more on
+ * the other one, and can receive bulk only reset command.
+ */
+K_MSGQ_DEFINE(msc_msgq, sizeof(struct msc_event),
+	      MSC_NUM_INSTANCES * (MSC_NUM_BUFFERS + 2), 4);
 
 /* Make supported vendor request visible for the device stack */
 static const struct usbd_cctx_vendor_req msc_bot_vregs =
@@ -115,7 +122,7 @@ struct msc_bot_ctx {
 	struct msc_bot_desc *const desc;
 	const struct usb_desc_header **const fs_desc;
 	const struct usb_desc_header **const hs_desc;
-	uint8_t *scsi_bufs[MSC_NUM_BUFFERS];
+	uint8_t *const scsi_bufs;
 	atomic_t bits;
 	enum msc_bot_state state;
 	uint8_t scsi_bufs_used;
@@ -150,12 +157,17 @@ static struct net_buf *msc_buf_alloc_data(const uint8_t ep, uint8_t *data, size_
 	return buf;
 }
 
+static inline uint8_t *msc_scsi_buf(struct msc_bot_ctx *ctx, int i)
+{
+	return &ctx->scsi_bufs[i * MSC_SCSI_BUF_STRIDE];
+}
+
 static uint8_t *msc_alloc_scsi_buf(struct msc_bot_ctx *ctx)
 {
 	for (int i = 0; i < MSC_NUM_BUFFERS; i++) {
 		if (!(ctx->scsi_bufs_used & BIT(i))) {
 			ctx->scsi_bufs_used |= BIT(i);
-			return ctx->scsi_bufs[i];
+			return msc_scsi_buf(ctx, i);
 		}
 	}
 
@@ -167,7 +179,7 @@ static uint8_t *msc_alloc_scsi_buf(struct msc_bot_ctx *ctx)
 void msc_free_scsi_buf(struct msc_bot_ctx *ctx, uint8_t *buf)
 {
 	for (int i = 0; i < MSC_NUM_BUFFERS; i++) {
-		if (buf == ctx->scsi_bufs[i]) {
+		if (buf == msc_scsi_buf(ctx, i)) {
 			ctx->scsi_bufs_used &= ~BIT(i);
 			return;
 		}
@@ -213,21 +225,16 @@ static size_t msc_next_out_transfer_length(struct usbd_class_data *const c_data)
 	struct msc_bot_ctx *ctx = usbd_class_get_private(c_data);
 	struct scsi_ctx *lun = &ctx->luns[ctx->cbw.bCBWLUN];
 	size_t remaining = scsi_cmd_remaining_data_len(lun);
-	size_t len = clamp_transfer_length(uds_ctx, lun, remaining);
 
-	/* This function can only estimate one more transfer after the current
-	 * one. Queueing more buffers is not supported.
+	/* MSC BOT specification requires host to send all the data it intends
+	 * to send. Therefore it should be safe to skip the data of the
+	 * transfers already queued, which are all full but the last one.
 	 */
-	__ASSERT_NO_MSG(ctx->num_out_queued < 2);
-
-	if (ctx->num_out_queued == 0) {
-		return len;
+	for (int i = 0; i < ctx->num_out_queued; i++) {
+		remaining -= clamp_transfer_length(uds_ctx, lun, remaining);
 	}
 
-	/* MSC BOT specification requires host to send all the data it intends
-	 * to send. Therefore it should be safe to use "remaining - len" here.
-	 */
-	return clamp_transfer_length(uds_ctx, lun, remaining - len);
+	return clamp_transfer_length(uds_ctx, lun, remaining);
 }
 
 static uint8_t msc_get_bulk_in(struct usbd_class_data *const c_data)
@@ -429,14 +436,16 @@ static void msc_process_read(struct msc_bot_ctx *ctx)
 	if (ctx->scsi_bytes) {
 		__ASSERT_NO_MSG(ctx->scsi_bufs_used == 0);
 		ctx->scsi_bufs_used = BIT(0);
-		msc_queue_bulk_in_ep(ctx, ctx->scsi_bufs[0], ctx->scsi_bytes);
+		msc_queue_bulk_in_ep(ctx, msc_scsi_buf(ctx, 0), ctx->scsi_bytes);
 		/* All data is submitted in one go. Any potential new data will
 		 * have to be retrieved using scsi_read_data() later.
 		 */
 		ctx->scsi_bytes = 0;
 	}
 
-	/* Fill SCSI Data IN buffer if there is avaialble buffer and data */
+	/* Fill SCSI Data IN buffer if there is avaialble buffer and data. With
+	 * more than one buffer, disk reads overlap the bulk IN transfers.
+	 */
 	while ((ctx->num_in_queued < MSC_NUM_BUFFERS) &&
 	       (ctx->state == MSC_BBB_PROCESS_READ) &&
 	       (len = msc_next_in_transfer_length(ctx->class_node))) {
@@ -457,7 +466,7 @@ static void msc_process_cbw(struct msc_bot_ctx *ctx)
 	__ASSERT_NO_MSG(ctx->scsi_bufs_used == 0);
 
 	cb_len = scsi_usb_boot_cmd_len(ctx->cbw.CBWCB, ctx->cbw.bCBWCBLength);
-	data_len = scsi_cmd(lun, ctx->cbw.CBWCB, cb_len, ctx->scsi_bufs[0]);
+	data_len = scsi_cmd(lun, ctx->cbw.CBWCB, cb_len, msc_scsi_buf(ctx, 0));
 	ctx->scsi_bytes = data_len;
 	cmd_is_data_read = scsi_cmd_is_data_read(lun);
 	cmd_is_data_write = scsi_cmd_is_data_write(lun);
@@ -991,18 +1000,10 @@ struct usbd_class_api msc_bot_api = {
 	.init = msc_bot_init,
 };
 
-#define BUF_NAME(x, i) scsi_buf##i##_##x
-
-#define DEFINE_SCSI_BUF(x, i)							\
-	UDC_STATIC_BUF_DEFINE(BUF_NAME(x, i), CONFIG_USBD_MSC_SCSI_BUFFER_SIZE);
+#define BUF_NAME(x) scsi_bufs_##x
 
 #define DEFINE_SCSI_BUFS(x)							\
-	DEFINE_SCSI_BUF(x, 0)							\
-	IF_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING, (DEFINE_SCSI_BUF(x, 1)))
-
-#define NAME_SCSI_BUFS(x)							\
-	BUF_NAME(x, 0)								\
-	IF_ENABLED(CONFIG_USBD_MSC_DOUBLE_BUFFERING, (, BUF_NAME(x, 1)))
+	UDC_STATIC_BUF_DEFINE(BUF_NAME(x), MSC_NUM_BUFFERS * MSC_SCSI_BUF_STRIDE);
 
 #define DEFINE_MSC_BOT_CLASS_DATA(x, _)						\
 	DEFINE_SCSI_BUFS(x)							\
@@ -1011,7 +1012,7 @@ struct usbd_class_api msc_bot_api = {
 		.desc = &msc_bot_desc_##x,					\
 		.fs_desc = msc_bot_fs_desc_##x,					\
 		.hs_desc = msc_bot_hs_desc_##x,					\
-		.scsi_bufs = { NAME_SCSI_BUFS(x) },				\
+		.scsi_bufs = BUF_NAME(x),					\
 	};									\
 										\
 	USBD_DEFINE_CLASS(msc_##x, &msc_bot_api, &msc_bot_ctx_##x,		\
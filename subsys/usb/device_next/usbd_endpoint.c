@@ -157,6 +157,110 @@ int usbd_ep_dequeue(struct usbd_context *const uds_ctx, const uint8_t ep)
 	return udc_ep_dequeue(uds_ctx->dev, ep);
 }
 
+void usbd_ep_pipe_init(struct usbd_ep_pipe *const pipe, struct usbd_class_data *const c_data,
+		       struct net_buf_pool *const pool, const uint8_t depth)
+{
+	__ASSERT_NO_MSG(depth > 0);
+
+	pipe->c_data = c_data;
+	pipe->pool = pool;
+	pipe->depth = depth;
+	atomic_set(&pipe->queued, 0);
+	atomic_set(&pipe->running, 0);
+	k_sem_init(&pipe->slots, depth, depth);
+}
+
+static int usbd_ep_pipe_fill(struct usbd_ep_pipe *const pipe)
+{
+	struct net_buf *buf;
+	struct udc_buf_info *bi;
+	int ret;
+
+	while (atomic_get(&pipe->running) && atomic_get(&pipe->queued) < pipe->depth) {
+		buf = net_buf_alloc(pipe->pool, K_NO_WAIT);
+		if (buf == NULL) {
+			LOG_ERR("No buffer to queue on 0x%02x", pipe->ep);
+			return -ENOMEM;
+		}
+
+		bi = udc_get_buf_info(buf);
+		bi->ep = pipe->ep;
+
+		atomic_inc(&pipe->queued);
+		ret = usbd_ep_enqueue(pipe->c_data, buf);
+		if (ret) {
+			LOG_ERR("Failed to enqueue net_buf for 0x%02x", pipe->ep);
+			atomic_dec(&pipe->queued);
+			net_buf_unref(buf);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int usbd_ep_pipe_start(struct usbd_ep_pipe *const pipe, const uint8_t ep)
+{
+	pipe->ep = ep;
+	atomic_set(&pipe->running, 1);
+
+	if (USB_EP_DIR_IS_IN(ep)) {
+		return 0;
+	}
+
+	return usbd_ep_pipe_fill(pipe);
+}
+
+void usbd_ep_pipe_stop(struct usbd_ep_pipe *const pipe)
+{
+	atomic_set(&pipe->running, 0);
+}
+
+int usbd_ep_pipe_enqueue(struct usbd_ep_pipe *const pipe, struct net_buf *const buf,
+			 const k_timeout_t timeout)
+{
+	struct udc_buf_info *bi = udc_get_buf_info(buf);
+	int ret;
+
+	if (k_sem_take(&pipe->slots, timeout)) {
+		return -EAGAIN;
+	}
+
+	bi->ep = pipe->ep;
+
+	atomic_inc(&pipe->queued);
+	ret = usbd_ep_enqueue(pipe->c_data, buf);
+	if (ret) {
+		atomic_dec(&pipe->queued);
+		k_sem_give(&pipe->slots);
+	}
+
+	return ret;
+}
+
+int usbd_ep_pipe_done(struct usbd_ep_pipe *const pipe, struct net_buf *const buf)
+{
+	atomic_val_t count = 0;
+
+	/* Cancelled transfers are all handed over at once, in a chain */
+	for (struct net_buf *n = buf; n != NULL; n = n->frags) {
+		count++;
+	}
+
+	net_buf_unref(buf);
+	atomic_sub(&pipe->queued, count);
+
+	if (USB_EP_DIR_IS_IN(pipe->ep)) {
+		while (count-- > 0) {
+			k_sem_give(&pipe->slots);
+		}
+
+		return 0;
+	}
+
+	return usbd_ep_pipe_fill(pipe);
+}
+
 int usbd_ep_set_halt(struct usbd_context *const uds_ctx, const uint8_t ep)
 {
 	struct usbd_ch9_data *ch9_data = &uds_ctx->ch9_data;
@@ -7,6 +7,7 @@
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/net_buf.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/sys/printk.h>
@@ -22,34 +23,119 @@ static struct k_spinlock obs_slock;
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 
+/* The buffers handed to the message subscribers are clones sharing the data of a single copy of
+ * the message, released from the threads of the subscribers. Its reference count is kept in front
+ * of the data and updated atomically.
+ */
+#define _ZBUS_MSG_DATA_HDR_SIZE ROUND_UP(sizeof(atomic_t), sizeof(uint64_t))
+
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC)
 
-NET_BUF_POOL_HEAP_DEFINE(_zbus_msg_subscribers_pool, CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
-			 sizeof(struct zbus_channel *), NULL);
+static inline void *_zbus_msg_data_malloc(size_t size, k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
 
-static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, size_t size,
-						   k_timeout_t timeout)
+	return k_malloc(size);
+}
+
+static inline void _zbus_msg_data_free(void *ptr)
 {
-	return net_buf_alloc_len(pool, size, timeout);
+	k_free(ptr);
 }
 
 #else
 
-NET_BUF_POOL_FIXED_DEFINE(_zbus_msg_subscribers_pool,
-			  (CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE),
-			  (CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE),
-			  sizeof(struct zbus_channel *), NULL);
+/* Every message takes a heap chunk with its header, at most 8 bytes, and the reference count */
+#define _ZBUS_MSG_DATA_CHUNK_SIZE                                                                  \
+	ROUND_UP(8 + _ZBUS_MSG_DATA_HDR_SIZE + CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE, 8)
+
+#define _ZBUS_MSG_DATA_CHUNKS_SIZE                                                                 \
+	(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE * _ZBUS_MSG_DATA_CHUNK_SIZE)
+
+/* On top of the chunks, the heap keeps its own header and end chunk, which Z_HEAP_MIN_SIZE covers,
+ * and a free list bucket per power of two of its size.
+ */
+K_HEAP_DEFINE(_zbus_msg_data_heap,
+	      _ZBUS_MSG_DATA_CHUNKS_SIZE + Z_HEAP_MIN_SIZE +
+		      LOG2CEIL(_ZBUS_MSG_DATA_CHUNKS_SIZE / 8) * sizeof(uint32_t));
+
+static inline void *_zbus_msg_data_malloc(size_t size, k_timeout_t timeout)
+{
+	return k_heap_alloc(&_zbus_msg_data_heap, size, timeout);
+}
+
+static inline void _zbus_msg_data_free(void *ptr)
+{
+	k_heap_free(&_zbus_msg_data_heap, ptr);
+}
+
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC */
+
+static uint8_t *_zbus_msg_data_alloc(struct net_buf *buf, size_t *size, k_timeout_t timeout)
+{
+	atomic_t *refs = _zbus_msg_data_malloc(_ZBUS_MSG_DATA_HDR_SIZE + *size, timeout);
+
+	ARG_UNUSED(buf);
+
+	if (refs == NULL) {
+		return NULL;
+	}
+
+	atomic_set(refs, 1);
+
+	return (uint8_t *)refs + _ZBUS_MSG_DATA_HDR_SIZE;
+}
+
+static uint8_t *_zbus_msg_data_ref(struct net_buf *buf, uint8_t *data)
+{
+	ARG_UNUSED(buf);
+
+	atomic_inc((atomic_t *)(data - _ZBUS_MSG_DATA_HDR_SIZE));
+
+	return data;
+}
+
+static void _zbus_msg_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	atomic_t *refs = (atomic_t *)(data - _ZBUS_MSG_DATA_HDR_SIZE);
+
+	ARG_UNUSED(buf);
+
+	if (atomic_dec(refs) == 1) {
+		_zbus_msg_data_free(refs);
+	}
+}
+
+static const struct net_buf_data_cb _zbus_msg_data_cb = {
+	.alloc = _zbus_msg_data_alloc,
+	.ref = _zbus_msg_data_ref,
+	.unref = _zbus_msg_data_unref,
+};
+
+static const struct net_buf_data_alloc _zbus_msg_data_allocator = {
+	.cb = &_zbus_msg_data_cb,
+};
+
+_NET_BUF_ARRAY_DEFINE(_zbus_msg_subscribers_pool, CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
+		      sizeof(struct zbus_channel *));
+
+static STRUCT_SECTION_ITERABLE(net_buf_pool, _zbus_msg_subscribers_pool) =
+	NET_BUF_POOL_INITIALIZER(_zbus_msg_subscribers_pool, &_zbus_msg_data_allocator,
+				 _net_buf__zbus_msg_subscribers_pool,
+				 CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE,
+				 sizeof(struct zbus_channel *), NULL);
 
 static inline struct net_buf *_zbus_create_net_buf(struct net_buf_pool *pool, size_t size,
 						   k_timeout_t timeout)
 {
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_STATIC)
 	__ASSERT(size <= CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE,
 		 "CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_STATIC_DATA_SIZE must be greater or equal to "
 		 "%d",
 		 (int)size);
-	return net_buf_alloc(pool, timeout);
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_STATIC */
+	return net_buf_alloc_len(pool, size, timeout);
 }
-#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC */
 
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
@@ -156,9 +242,40 @@ const struct zbus_channel *zbus_chan_from_id(uint32_t channel_id)
 
 #endif /* CONFIG_ZBUS_CHANNEL_ID */
 
+#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+/* Copy the message once for all the message subscribers, when the first one is notified */
+static inline int _zbus_msg_buf_get(const struct zbus_channel *chan, k_timepoint_t end_time,
+				    struct net_buf **buf)
+{
+	if (*buf != NULL) {
+		return 0;
+	}
+
+	struct net_buf_pool *pool =
+		COND_CODE_1(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,
+			    (chan->data->msg_subscriber_pool), (&_zbus_msg_subscribers_pool));
+
+	*buf = _zbus_create_net_buf(pool, zbus_chan_msg_size(chan),
+				    sys_timepoint_timeout(end_time));
+
+	_ZBUS_ASSERT(*buf != NULL, "net_buf zbus_msg_subscribers_pool is "
+				   "unavailable or heap is full");
+
+	if (*buf == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(net_buf_user_data(*buf), &chan, sizeof(struct zbus_channel *));
+
+	net_buf_add_mem(*buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+
+	return 0;
+}
+#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 					const struct zbus_observer *obs, k_timepoint_t end_time,
-					struct net_buf *buf)
+					struct net_buf **buf)
 {
 	switch (obs->type) {
 	case ZBUS_OBSERVER_LISTENER_TYPE: {
@@ -171,7 +288,13 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 	case ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE: {
-		struct net_buf *cloned_buf = net_buf_clone(buf, sys_timepoint_timeout(end_time));
+		int err = _zbus_msg_buf_get(chan, end_time, buf);
+
+		if (err) {
+			return err;
+		}
+
+		struct net_buf *cloned_buf = net_buf_clone(*buf, sys_timepoint_timeout(end_time));
 
 		if (cloned_buf == NULL) {
 			return -ENOMEM;
@@ -185,7 +308,13 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 
 #if defined(CONFIG_ZBUS_ASYNC_LISTENER)
 	case ZBUS_OBSERVER_ASYNC_LISTENER_TYPE: {
-		struct net_buf *cloned_buf = net_buf_clone(buf, sys_timepoint_timeout(end_time));
+		int err = _zbus_msg_buf_get(chan, end_time, buf);
+
+		if (err) {
+			return err;
+		}
+
+		struct net_buf *cloned_buf = net_buf_clone(*buf, sys_timepoint_timeout(end_time));
 
 		if (cloned_buf == NULL) {
 			return -ENOMEM;
@@ -222,21 +351,6 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 	struct zbus_channel_observation *observation;
 	struct zbus_channel_observation_mask *observation_mask;
 
-#if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
-	struct net_buf_pool *pool =
-		COND_CODE_1(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,
-			    (chan->data->msg_subscriber_pool), (&_zbus_msg_subscribers_pool));
-
-	buf = _zbus_create_net_buf(pool, zbus_chan_msg_size(chan), sys_timepoint_timeout(end_time));
-
-	_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
-				  "unavailable or heap is full");
-
-	memcpy(net_buf_user_data(buf), &chan, sizeof(struct zbus_channel *));
-
-	net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
-#endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
-
 	LOG_DBG("Notifing %s's observers. Starting VDED:", _ZBUS_CHAN_NAME(chan));
 
 	int __maybe_unused index = 0;
@@ -254,14 +368,14 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 			continue;
 		}
 
-		err = _zbus_notify_observer(chan, obs, end_time, buf);
+		err = _zbus_notify_observer(chan, obs, end_time, &buf);
 
 		if (err) {
 			last_error = err;
 			LOG_ERR("could not deliver notification to observer %s. Error code %d",
 				_ZBUS_OBS_NAME(obs), err);
 			if (err == -ENOMEM) {
-				if (IS_ENABLED(CONFIG_ZBUS_MSG_SUBSCRIBER)) {
+				if (IS_ENABLED(CONFIG_ZBUS_MSG_SUBSCRIBER) && buf != NULL) {
 					net_buf_unref(buf);
 				}
 				return err;
@@ -282,7 +396,7 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 			continue;
 		}
 
-		err = _zbus_notify_observer(chan, obs, end_time, buf);
+		err = _zbus_notify_observer(chan, obs, end_time, &buf);
 
 		if (err) {
 			last_error = err;
@@ -290,7 +404,9 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 	}
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS */
 
-	IF_ENABLED(CONFIG_ZBUS_MSG_SUBSCRIBER, (net_buf_unref(buf);))
+	if (IS_ENABLED(CONFIG_ZBUS_MSG_SUBSCRIBER) && buf != NULL) {
+		net_buf_unref(buf);
+	}
 
 	return last_error;
 }
@@ -432,6 +548,63 @@ static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 }
 
+#if defined(CONFIG_ZBUS_SEQLOCK_READ)
+
+/* Attempts of a lock-free read before waiting for the channel semaphore */
+#define _ZBUS_SEQLOCK_READ_ATTEMPTS 3
+
+/* The sequence is odd while the message may be modified, which happens with the channel
+ * semaphore taken only.
+ */
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+	atomic_inc(&chan->data->seq);
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+	atomic_inc(&chan->data->seq);
+}
+
+static inline bool chan_read_seqlock(const struct zbus_channel *chan, void *msg)
+{
+	for (int i = 0; i < _ZBUS_SEQLOCK_READ_ATTEMPTS; ++i) {
+		atomic_val_t seq = atomic_get(&chan->data->seq);
+
+		if (seq & 1) {
+			/* A writer holds the channel, wait for it on the semaphore */
+			return false;
+		}
+
+		memcpy(msg, chan->message, chan->message_size);
+
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&chan->data->seq) == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#else
+
+static inline void chan_write_begin(const struct zbus_channel *chan)
+{
+}
+
+static inline void chan_write_end(const struct zbus_channel *chan)
+{
+}
+
+static inline bool chan_read_seqlock(const struct zbus_channel *chan, void *msg)
+{
+	return false;
+}
+
+#endif /* CONFIG_ZBUS_SEQLOCK_READ */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -463,7 +636,97 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 	chan->data->publish_count += 1;
 #endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
 
+	chan_write_begin(chan);
 	memcpy(chan->message, msg, chan->message_size);
+	chan_write_end(chan);
+
+	err = _zbus_vded_exec(chan, end_time);
+
+	chan_unlock(chan, context_priority);
+
+	return err;
+}
+
+int zbus_chan_pub_loan(const struct zbus_channel *chan, void **msg, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+	_ZBUS_ASSERT(k_is_in_isr() ? K_TIMEOUT_EQ(timeout, K_NO_WAIT) : true,
+		     "inside an ISR, the timeout must be K_NO_WAIT");
+
+	if (chan->validator != NULL) {
+		/* The message is written in place, it could not be rejected anymore */
+		return -ENOTSUP;
+	}
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+	err = chan_lock(chan, timeout, &context_priority);
+	if (err) {
+		return err;
+	}
+
+#if defined(CONFIG_ZBUS_PRIORITY_BOOST)
+	chan->data->loan_priority = context_priority;
+#endif /* CONFIG_ZBUS_PRIORITY_BOOST */
+
+	K_SPINLOCK(&_zbus_chan_slock) {
+		chan->data->loaned = true;
+	}
+
+	chan_write_begin(chan);
+
+	*msg = chan->message;
+
+	return 0;
+}
+
+int zbus_chan_pub_commit(const struct zbus_channel *chan, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(k_is_in_isr() ? K_TIMEOUT_EQ(timeout, K_NO_WAIT) : true,
+		     "inside an ISR, the timeout must be K_NO_WAIT");
+
+	bool loaned = false;
+
+	/* Only one commit ends a loan */
+	K_SPINLOCK(&_zbus_chan_slock) {
+		loaned = chan->data->loaned;
+		chan->data->loaned = false;
+	}
+
+	_ZBUS_ASSERT(loaned, "the channel message is not loaned");
+
+	if (!loaned) {
+		return -EPERM;
+	}
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+#if defined(CONFIG_ZBUS_PRIORITY_BOOST)
+	context_priority = chan->data->loan_priority;
+#endif /* CONFIG_ZBUS_PRIORITY_BOOST */
+
+#if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS)
+	chan->data->publish_timestamp = k_uptime_ticks();
+	chan->data->publish_count += 1;
+#endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
+
+	chan_write_end(chan);
 
 	err = _zbus_vded_exec(chan, end_time);
 
@@ -483,6 +746,10 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		timeout = K_NO_WAIT;
 	}
 
+	if (chan_read_seqlock(chan, msg)) {
+		return 0;
+	}
+
 	int err = k_sem_take(&chan->data->sem, timeout);
 	if (err) {
 		return err;
@@ -539,6 +806,9 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The message may be modified during the claim */
+	chan_write_begin(chan);
+
 	return 0;
 }
 
@@ -546,6 +816,8 @@ int zbus_chan_finish(const struct zbus_channel *chan)
 {
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 
+	chan_write_end(chan);
+
 	k_sem_give(&chan->data->sem);
 
 	return 0;
@@ -591,6 +863,28 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 	return 0;
 }
 
+int zbus_sub_wait_msg_buf(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_msg_buf cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	*buf = k_fifo_get(sub->message_fifo, timeout);
+
+	if (*buf == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(*buf));
+
+	return 0;
+}
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 int zbus_obs_set_chan_notification_mask(const struct zbus_observer *obs,
@@ -31,6 +31,7 @@
 #define SLINE_LEN 256
 
 #define NR_OF_MSGQ_RUNS 500
+#define MSGQ_BATCH_SIZE 10
 #define NR_OF_SEMA_RUNS 500
 #define NR_OF_MUTEX_RUNS 1000
 #define NR_OF_MAP_RUNS 1000
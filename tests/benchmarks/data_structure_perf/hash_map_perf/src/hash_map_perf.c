@@ -0,0 +1,94 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Compare the cost of the operations of the Hashmap implementations, with the
+ * same keys and the default load factor.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/timing/timing.h>
+
+#define NUM_ENTRIES 1024
+
+SYS_HASHMAP_SC_DEFINE(sc_map);
+SYS_HASHMAP_OA_LP_DEFINE(oa_lp_map);
+SYS_HASHMAP_SWISS_DEFINE(swiss_map);
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+SYS_HASHMAP_CXX_DEFINE(cxx_map);
+#endif
+
+/* Keys spread over the whole range, not in insertion order */
+static uint64_t key_of(uint32_t i)
+{
+	return (uint64_t)i * 0x9E3779B97F4A7C15ULL;
+}
+
+static uint32_t ns_per_op(timing_t *start, timing_t *end)
+{
+	return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(start, end)) / NUM_ENTRIES);
+}
+
+static void measure(const char *label, struct sys_hashmap *map)
+{
+	uint32_t insert_ns, hit_ns, miss_ns, remove_ns;
+	timing_t start, end;
+	uint64_t value;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		zassert_equal(1, sys_hashmap_insert(map, key_of(i), i, NULL));
+	}
+	end = timing_counter_get();
+	insert_ns = ns_per_op(&start, &end);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		zassert_true(sys_hashmap_get(map, key_of(i), &value));
+	}
+	end = timing_counter_get();
+	hit_ns = ns_per_op(&start, &end);
+
+	start = timing_counter_get();
+	for (uint32_t i = NUM_ENTRIES; i < 2 * NUM_ENTRIES; i++) {
+		zassert_false(sys_hashmap_get(map, key_of(i), &value));
+	}
+	end = timing_counter_get();
+	miss_ns = ns_per_op(&start, &end);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < NUM_ENTRIES; i++) {
+		zassert_true(sys_hashmap_remove(map, key_of(i), NULL));
+	}
+	end = timing_counter_get();
+	remove_ns = ns_per_op(&start, &end);
+
+	zassert_true(sys_hashmap_is_empty(map));
+	sys_hashmap_clear(map, NULL, NULL);
+
+	TC_PRINT("%-8s insert %5u ns, get hit %5u ns, get miss %5u ns, remove %5u ns\n", label,
+		 insert_ns, hit_ns, miss_ns, remove_ns);
+}
+
+ZTEST(hash_map_perf, test_hash_map_perf)
+{
+	timing_init();
+	timing_start();
+
+	TC_PRINT("%u entries, per operation:\n", NUM_ENTRIES);
+	measure("sc", &sc_map);
+	measure("oa_lp", &oa_lp_map);
+	measure("swiss", &swiss_map);
+#ifdef CONFIG_SYS_HASH_MAP_CXX
+	measure("cxx", &cxx_map);
+#endif
+
+	timing_stop();
+}
+
+ZTEST_SUITE(hash_map_perf, NULL, NULL, NULL, NULL, NULL);
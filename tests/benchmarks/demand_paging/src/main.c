@@ -0,0 +1,108 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of faulting a paged out read-only data region back in,
+ * to compare page fault servicing with and without prefetching.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define REGION_SIZE (CONFIG_BENCHMARK_NUM_PAGES * CONFIG_MMU_PAGE_SIZE)
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, faults, prefetched, ns)                              \
+	printk("REC: %s - %s:%lu faults ,%lu prefetched ,%llu ns\n", label,      \
+	       label, faults, prefetched, ns)
+#else
+#define PRINT_RESULT(label, faults, prefetched, ns)                              \
+	printk("%-32s: %6lu faults , %6lu prefetched , %10llu ns\n", label,      \
+	       faults, prefetched, ns)
+#endif
+
+/* Not pinned, so this lives in the backing store like any paged data */
+static const uint8_t region[REGION_SIZE] __aligned(CONFIG_MMU_PAGE_SIZE) = {
+	[0 ... (REGION_SIZE - 1)] = 0x5a,
+};
+
+static uint32_t touch_pages(bool reverse)
+{
+	const volatile uint8_t *data = region;
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < CONFIG_BENCHMARK_NUM_PAGES; i++) {
+		size_t page = reverse ? (CONFIG_BENCHMARK_NUM_PAGES - 1 - i) : i;
+
+		sum += data[page * CONFIG_MMU_PAGE_SIZE];
+	}
+
+	return sum;
+}
+
+static int run_pattern(const char *label, bool reverse)
+{
+	struct k_mem_paging_stats_t before, after;
+	unsigned long faults = 0, prefetched = 0;
+	timing_t start, end;
+	uint64_t cycles = 0;
+	uint32_t sum;
+	int ret;
+
+	for (int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		ret = k_mem_page_out((void *)region, sizeof(region));
+		if (ret != 0) {
+			printk("k_mem_page_out() failed: %d\n", ret);
+			return ret;
+		}
+
+		k_mem_paging_stats_get(&before);
+		start = timing_counter_get();
+		sum = touch_pages(reverse);
+		end = timing_counter_get();
+		k_mem_paging_stats_get(&after);
+
+		if (sum != (0x5aU * CONFIG_BENCHMARK_NUM_PAGES)) {
+			printk("region corrupted, sum 0x%x\n", sum);
+			return -EIO;
+		}
+
+		cycles += timing_cycles_get(&start, &end);
+		faults += after.pagefaults.cnt - before.pagefaults.cnt;
+		prefetched += after.pagefaults.prefetched - before.pagefaults.prefetched;
+	}
+
+	PRINT_RESULT(label, faults / CONFIG_BENCHMARK_NUM_ITERATIONS,
+		     prefetched / CONFIG_BENCHMARK_NUM_ITERATIONS,
+		     timing_cycles_to_ns_avg(cycles, CONFIG_BENCHMARK_NUM_ITERATIONS));
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	timing_init();
+	timing_start();
+
+	printk("Demand paging benchmark: %d pages, prefetch %d pages\n",
+	       CONFIG_BENCHMARK_NUM_PAGES, CONFIG_DEMAND_PAGING_PREFETCH_PAGES);
+
+	ret = run_pattern("page_in.sequential", false);
+	if (ret == 0) {
+		ret = run_pattern("page_in.reverse", true);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret == 0 ? TC_PASS : TC_FAIL);
+
+	return 0;
+}
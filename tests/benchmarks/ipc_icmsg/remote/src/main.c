@@ -0,0 +1,74 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Remote side of the icmsg benchmark: count the messages received and send
+ * the count back when the short message ending the stream is received.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static K_SEM_DEFINE(end_sem, 0, 1);
+static uint32_t count;
+
+static void ep_bound(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	if (len > 1) {
+		count++;
+	} else {
+		k_sem_give(&end_sem);
+	}
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.cb = {
+		.bound = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+	struct ipc_ept ep;
+	uint32_t reply;
+	int ret;
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if (ret < 0 && ret != -EALREADY) {
+		printk("failed to open instance (%d)\n", ret);
+		return 0;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0) {
+		printk("failed to register endpoint (%d)\n", ret);
+		return 0;
+	}
+
+	k_sem_take(&bound_sem, K_FOREVER);
+
+	while (true) {
+		k_sem_take(&end_sem, K_FOREVER);
+
+		reply = count;
+		count = 0;
+		while (ipc_service_send(&ep, &reply, sizeof(reply)) == -ENOMEM) {
+			k_usleep(1);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the rate of icmsg messages sent to the remote core, which counts
+ * them and reports the count back once the end of the stream is received.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service.h>
+#include <zephyr/tc_util.h>
+#if defined(CONFIG_SOC_NRF5340_CPUAPP)
+#include <nrf53_cpunet_mgmt.h>
+#endif
+
+#define NUM_MSGS CONFIG_BENCHMARK_MESSAGES
+#define MSG_SIZE CONFIG_BENCHMARK_MESSAGE_SIZE
+
+/* Message ending the stream, shorter than all the measured ones */
+#define END_MSG_SIZE 1
+
+#ifdef CONFIG_IPC_SERVICE_ICMSG_NOTIFY_COALESCE
+#define MODE "coalesce"
+#else
+#define MODE "notify"
+#endif
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, rate)                                                \
+	printk("REC: %s - %s " MODE ":%u msg/s\n", label, label, rate)
+#else
+#define PRINT_RESULT(label, rate)                                                \
+	printk("%-24s (" MODE "): %8u msg/s\n", label, rate)
+#endif
+
+static K_SEM_DEFINE(bound_sem, 0, 1);
+static K_SEM_DEFINE(count_sem, 0, 1);
+static uint32_t remote_count;
+
+static uint8_t payload[MSG_SIZE];
+
+static void ep_bound(void *priv)
+{
+	k_sem_give(&bound_sem);
+}
+
+static void ep_recv(const void *data, size_t len, void *priv)
+{
+	if (len == sizeof(remote_count)) {
+		memcpy(&remote_count, data, sizeof(remote_count));
+		k_sem_give(&count_sem);
+	}
+}
+
+static struct ipc_ept_cfg ep_cfg = {
+	.cb = {
+		.bound = ep_bound,
+		.received = ep_recv,
+	},
+};
+
+static int send(struct ipc_ept *ep, const void *data, size_t len)
+{
+	int ret;
+
+	do {
+		ret = ipc_service_send(ep, data, len);
+		if (ret == -ENOMEM) {
+			/* Buffer full, let the remote catch up */
+			k_usleep(1);
+		}
+	} while (ret == -ENOMEM);
+
+	return ret;
+}
+
+static bool measure(struct ipc_ept *ep, const char *label)
+{
+	int64_t start, ticks;
+	int ret;
+
+	remote_count = 0;
+
+	start = k_uptime_ticks();
+	for (int i = 0; i < NUM_MSGS; i++) {
+		payload[0] = (uint8_t)i;
+		ret = send(ep, payload, sizeof(payload));
+		if (ret < 0) {
+			TC_ERROR("%s: failed to send message %d (%d)\n", label, i, ret);
+			return false;
+		}
+	}
+
+	ret = send(ep, payload, END_MSG_SIZE);
+	if (ret < 0 || k_sem_take(&count_sem, K_SECONDS(30)) < 0) {
+		TC_ERROR("%s: no count from the remote (%d)\n", label, ret);
+		return false;
+	}
+	ticks = k_uptime_ticks() - start;
+
+	if (remote_count != NUM_MSGS) {
+		TC_ERROR("%s: remote received %u of %u messages\n", label, remote_count, NUM_MSGS);
+		return false;
+	}
+
+	PRINT_RESULT(label, (uint32_t)((uint64_t)NUM_MSGS * USEC_PER_SEC /
+				       MAX(k_ticks_to_us_ceil64(ticks), 1)));
+
+	return true;
+}
+
+int main(void)
+{
+	const struct device *ipc0_instance = DEVICE_DT_GET(DT_NODELABEL(ipc0));
+	struct ipc_ept ep;
+	bool ok = true;
+	int ret;
+
+#if defined(CONFIG_SOC_NRF5340_CPUAPP)
+	nrf53_cpunet_enable(true);
+#endif
+
+	ret = ipc_service_open_instance(ipc0_instance);
+	if (ret < 0 && ret != -EALREADY) {
+		TC_ERROR("failed to open instance (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	ret = ipc_service_register_endpoint(ipc0_instance, &ep, &ep_cfg);
+	if (ret < 0 || k_sem_take(&bound_sem, K_SECONDS(10)) < 0) {
+		TC_ERROR("endpoint not bound (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	ok &= measure(&ep, "send " STRINGIFY(MSG_SIZE) " bytes");
+
+	TC_END_REPORT(ok ? TC_PASS : TC_FAIL);
+	return 0;
+}
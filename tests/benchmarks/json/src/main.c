@@ -0,0 +1,285 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Compare the throughput and the peak RAM usage of the JSON library when
+ * decoding a whole document held in memory and when decoding it as it is
+ * received in chunks, and when encoding to a flat buffer and to a chain of
+ * network buffers.
+ *
+ * The peak RAM usage counts the buffers each approach needs on top of the
+ * decoded structure, which is the same for all of them, plus the stack used.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/data/json.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_RECORDS CONFIG_BENCHMARK_RECORDS
+#define CHUNK_SIZE  CONFIG_BENCHMARK_CHUNK_SIZE
+#define ITERATIONS  CONFIG_BENCHMARK_ITERATIONS
+#define NUM_SAMPLES 8
+#define DOC_SIZE    (NUM_RECORDS * 192)
+#define STACK_SIZE  4096
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, mb_x100, ram)                                                          \
+	printk("REC: %s - %s:%u.%02u MB/s, %zu bytes\n", label, label, (mb_x100) / 100,            \
+	       (mb_x100) % 100, ram)
+#else
+#define PRINT_RESULT(label, mb_x100, ram)                                                          \
+	printk("%-24s: %4u.%02u MB/s, peak RAM %6zu bytes\n", label, (mb_x100) / 100,             \
+	       (mb_x100) % 100, ram)
+#endif
+
+struct record {
+	int32_t id;
+	char name[16];
+	int32_t value;
+	bool active;
+	int32_t samples[NUM_SAMPLES];
+	size_t samples_len;
+};
+
+struct document {
+	struct record records[NUM_RECORDS];
+	size_t records_len;
+};
+
+static const struct json_obj_descr record_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct record, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct record, name, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct record, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct record, active, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_ARRAY(struct record, samples, NUM_SAMPLES, samples_len, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr document_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct document, records, NUM_RECORDS, records_len, record_descr,
+				 ARRAY_SIZE(record_descr)),
+};
+
+/* Enough fragments for the whole document, plus one partially filled */
+NET_BUF_POOL_FIXED_DEFINE(chunk_pool, DOC_SIZE / CHUNK_SIZE + 1, CHUNK_SIZE, 0, NULL);
+
+static K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+static struct k_thread bench_thread;
+
+static struct document reference;
+static struct document decoded;
+static char doc[DOC_SIZE];
+static size_t doc_len;
+
+/* Buffers used by the measured operations */
+static char parse_buf[DOC_SIZE];
+static char chunk_buf[CHUNK_SIZE];
+static struct json_stream_parser parser;
+static char encode_buf[DOC_SIZE];
+
+/* Results of the last run */
+static uint64_t elapsed_ns;
+static size_t buffer_bytes;
+static bool run_ok;
+
+static void parse_whole(void *p1, void *p2, void *p3)
+{
+	timing_t start, end;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		/* The document is received into a buffer, then decoded in place */
+		memcpy(parse_buf, doc, doc_len);
+		run_ok = json_obj_parse(parse_buf, doc_len, document_descr,
+					ARRAY_SIZE(document_descr), &decoded) == BIT(0);
+	}
+	end = timing_counter_get();
+
+	elapsed_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	buffer_bytes = doc_len;
+}
+
+static void parse_chunks(void *p1, void *p2, void *p3)
+{
+	timing_t start, end;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		json_stream_obj_parse_init(&parser, document_descr, ARRAY_SIZE(document_descr),
+					   &decoded);
+
+		/* Each chunk is received into the same buffer and decoded right away */
+		for (size_t off = 0; off < doc_len; off += CHUNK_SIZE) {
+			size_t len = MIN(CHUNK_SIZE, doc_len - off);
+
+			memcpy(chunk_buf, &doc[off], len);
+			(void)json_stream_parse(&parser, chunk_buf, len);
+		}
+
+		run_ok = json_stream_parse_finish(&parser) == BIT(0);
+	}
+	end = timing_counter_get();
+
+	elapsed_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	buffer_bytes = sizeof(chunk_buf) + sizeof(parser);
+}
+
+static void encode_flat(void *p1, void *p2, void *p3)
+{
+	timing_t start, end;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		run_ok = json_obj_encode_buf(document_descr, ARRAY_SIZE(document_descr),
+					     &reference, encode_buf, sizeof(encode_buf)) == 0;
+	}
+	end = timing_counter_get();
+
+	run_ok = run_ok && strcmp(encode_buf, doc) == 0;
+	elapsed_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	buffer_bytes = doc_len + 1;
+}
+
+static void encode_net_buf(void *p1, void *p2, void *p3)
+{
+	struct net_buf *buf = NULL;
+	timing_t start, end;
+	size_t frags = 0;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		if (buf != NULL) {
+			net_buf_unref(buf);
+		}
+
+		buf = net_buf_alloc(&chunk_pool, K_NO_WAIT);
+		run_ok = buf != NULL &&
+			 json_obj_encode_net_buf(document_descr, ARRAY_SIZE(document_descr),
+						 &reference, buf, &chunk_pool) == 0;
+		if (!run_ok) {
+			break;
+		}
+	}
+	end = timing_counter_get();
+
+	if (run_ok && net_buf_frags_len(buf) == doc_len) {
+		net_buf_linearize(encode_buf, sizeof(encode_buf), buf, 0, doc_len);
+		run_ok = memcmp(encode_buf, doc, doc_len) == 0;
+	} else {
+		run_ok = false;
+	}
+
+	for (struct net_buf *frag = buf; frag != NULL; frag = frag->frags) {
+		frags++;
+	}
+
+	if (buf != NULL) {
+		net_buf_unref(buf);
+	}
+
+	elapsed_ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	buffer_bytes = frags * (CHUNK_SIZE + sizeof(struct net_buf));
+}
+
+/* Runs an operation in a thread of its own, to measure the stack it uses */
+static bool measure(const char *label, k_thread_entry_t entry)
+{
+	size_t unused;
+	int ret;
+
+	run_ok = false;
+	memset(&decoded, 0, sizeof(decoded));
+
+	k_thread_create(&bench_thread, bench_stack, K_THREAD_STACK_SIZEOF(bench_stack), entry,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()), 0, K_NO_WAIT);
+	k_thread_join(&bench_thread, K_FOREVER);
+
+	if (entry == parse_whole || entry == parse_chunks) {
+		run_ok = run_ok && memcmp(&decoded, &reference, sizeof(decoded)) == 0;
+	}
+
+	if (!run_ok) {
+		TC_ERROR("%s: wrong result\n", label);
+		return false;
+	}
+
+	ret = k_thread_stack_space_get(&bench_thread, &unused);
+	if (ret < 0) {
+		TC_ERROR("%s: no stack information (%d)\n", label, ret);
+		return false;
+	}
+
+	PRINT_RESULT(label, (uint32_t)((uint64_t)ITERATIONS * doc_len * 100U * 1000U / elapsed_ns),
+		     buffer_bytes + K_THREAD_STACK_SIZEOF(bench_stack) - unused);
+
+	return true;
+}
+
+int main(void)
+{
+	uint32_t prng = 1234;
+	bool ok = true;
+	int ret;
+
+	for (int i = 0; i < NUM_RECORDS; i++) {
+		struct record *record = &reference.records[i];
+
+		prng = 1103515245 * prng + 12345;
+		record->id = i;
+		record->value = (int32_t)prng;
+		record->active = (prng & BIT(31)) != 0;
+		snprintk(record->name, sizeof(record->name), "sensor \"%u\"", prng >> 20);
+
+		for (int j = 0; j < NUM_SAMPLES; j++) {
+			prng = 1103515245 * prng + 12345;
+			record->samples[j] = (int32_t)(prng >> 16) - 32768;
+		}
+		record->samples_len = NUM_SAMPLES;
+	}
+	reference.records_len = NUM_RECORDS;
+
+	ret = json_obj_encode_buf(document_descr, ARRAY_SIZE(document_descr), &reference, doc,
+				  sizeof(doc));
+	if (ret < 0) {
+		TC_ERROR("failed to encode the document (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	doc_len = strlen(doc);
+	printk("Document of %zu bytes, chunks of %u bytes\n", doc_len, CHUNK_SIZE);
+
+	timing_init();
+	timing_start();
+
+	ok &= measure("parse whole document", parse_whole);
+	ok &= measure("parse stream", parse_chunks);
+	ok &= measure("encode flat buffer", encode_flat);
+	ok &= measure("encode net_buf", encode_net_buf);
+
+	timing_stop();
+
+	TC_END_REPORT(ok ? TC_PASS : TC_FAIL);
+	return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the throughput of modem PPP framing and unframing, by sending IP
+ * packets through a modem pipe looped back to the same modem PPP instance.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_l2.h>
+#include <zephyr/net/ppp.h>
+#include <zephyr/modem/ppp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include <modem_backend_mock.h>
+
+#define NUM_PKTS      CONFIG_BENCHMARK_PACKETS
+#define PKT_SIZE      CONFIG_BENCHMARK_PACKET_SIZE
+#define PIPE_BUF_SIZE 4096
+#define PPP_BUF_SIZE  1536
+
+/* PPP protocol field received in front of each packet */
+#define PPP_PROTOCOL_SIZE 2
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, mb_x100)                                             \
+	printk("REC: %s - %s:%u.%02u MB/s\n", label, label, (mb_x100) / 100, (mb_x100) % 100)
+#else
+#define PRINT_RESULT(label, mb_x100)                                             \
+	printk("%-24s: %4u.%02u MB/s\n", label, (mb_x100) / 100, (mb_x100) % 100)
+#endif
+
+static struct modem_backend_mock mock;
+static uint8_t mock_rx_buf[PIPE_BUF_SIZE];
+static uint8_t mock_tx_buf[PIPE_BUF_SIZE];
+
+static K_SEM_DEFINE(in_flight, CONFIG_BENCHMARK_IN_FLIGHT, CONFIG_BENCHMARK_IN_FLIGHT);
+static K_SEM_DEFINE(all_received, 0, 1);
+static uint32_t received_pkts;
+static size_t received_bytes;
+
+static uint8_t payload[PKT_SIZE];
+
+static enum net_verdict bench_l2_recv(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+
+	received_bytes += net_pkt_get_len(pkt);
+	net_pkt_unref(pkt);
+
+	k_sem_give(&in_flight);
+	if (++received_pkts == NUM_PKTS) {
+		k_sem_give(&all_received);
+	}
+
+	return NET_OK;
+}
+
+/* Network interface emulated as in the modem PPP test suite */
+static struct net_l2 bench_l2 = {
+	.recv = bench_l2_recv,
+};
+
+static struct ppp_context bench_l2_data;
+
+static struct net_if_dev bench_if_dev = {
+	.l2 = &bench_l2,
+	.l2_data = &bench_l2_data,
+	.link_addr.addr = {0x00, 0x00, 0x5E, 0x00, 0x53, 0x01},
+	.link_addr.len = NET_ETH_ADDR_LEN,
+	.link_addr.type = NET_LINK_DUMMY,
+	.mtu = 1500,
+	.oper_state = NET_IF_OPER_UP,
+};
+
+static struct net_if bench_iface = {
+	.if_dev = &bench_if_dev,
+};
+
+static uint8_t ppp_receive_buf[PPP_BUF_SIZE];
+static uint8_t ppp_transmit_buf[PPP_BUF_SIZE];
+
+static struct modem_ppp ppp = {
+	.iface = &bench_iface,
+	.receive_buf = ppp_receive_buf,
+	.transmit_buf = ppp_transmit_buf,
+	.buf_size = PPP_BUF_SIZE,
+};
+
+extern const struct ppp_api modem_ppp_ppp_api;
+static const struct device ppp_net_dev = {.data = &ppp};
+
+static bool send_packet(void)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(&bench_iface, PKT_SIZE, AF_UNSPEC, 0, K_SECONDS(1));
+	if (pkt == NULL) {
+		TC_ERROR("no net_pkt available\n");
+		return false;
+	}
+
+	net_pkt_set_family(pkt, NET_AF_INET);
+	ret = net_pkt_write(pkt, payload, sizeof(payload));
+	if (ret == 0) {
+		/* Modem PPP takes its own reference */
+		ret = modem_ppp_ppp_api.send(&ppp_net_dev, pkt);
+	}
+
+	net_pkt_unref(pkt);
+
+	if (ret < 0) {
+		TC_ERROR("failed to send packet (%d)\n", ret);
+		return false;
+	}
+
+	return true;
+}
+
+static bool measure(const char *label, uint32_t async_map)
+{
+	timing_t start, end;
+	uint64_t ns;
+
+	bench_l2_data.lcp.peer_options.async_map = async_map;
+	received_pkts = 0;
+	received_bytes = 0;
+
+	start = timing_counter_get();
+	for (int i = 0; i < NUM_PKTS; i++) {
+		(void)k_sem_take(&in_flight, K_FOREVER);
+		if (!send_packet()) {
+			return false;
+		}
+	}
+
+	if (k_sem_take(&all_received, K_SECONDS(30)) < 0) {
+		TC_ERROR("%s: received %u of %u packets\n", label, received_pkts, NUM_PKTS);
+		return false;
+	}
+	end = timing_counter_get();
+
+	if (received_bytes != (size_t)NUM_PKTS * (PKT_SIZE + PPP_PROTOCOL_SIZE)) {
+		TC_ERROR("%s: received %zu bytes\n", label, received_bytes);
+		return false;
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	PRINT_RESULT(label, (uint32_t)((uint64_t)NUM_PKTS * PKT_SIZE * 100U * 1000U / ns));
+
+	return true;
+}
+
+int main(void)
+{
+	const struct modem_backend_mock_config mock_config = {
+		.rx_buf = mock_rx_buf,
+		.rx_buf_size = sizeof(mock_rx_buf),
+		.tx_buf = mock_tx_buf,
+		.tx_buf_size = sizeof(mock_tx_buf),
+		.limit = PIPE_BUF_SIZE,
+	};
+	struct modem_pipe *pipe;
+	uint32_t prng = 1234;
+	bool ok = true;
+
+	/* Random data, with about one byte out of eight to escape with the full ACCM */
+	for (int i = 0; i < PKT_SIZE; i++) {
+		prng = 1103515245 * prng + 12345;
+		payload[i] = (uint8_t)(prng >> 16);
+	}
+
+	modem_ppp_init_internal(&ppp_net_dev);
+	net_if_flag_set(&bench_iface, NET_IF_UP);
+
+	/* Everything sent by the modem PPP instance is received back by it */
+	pipe = modem_backend_mock_init(&mock, &mock_config);
+	modem_backend_mock_bridge(&mock, &mock);
+	if (modem_pipe_open(pipe, K_SECONDS(10)) < 0) {
+		TC_ERROR("failed to open pipe\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	modem_ppp_attach(&ppp, pipe);
+
+	timing_init();
+	timing_start();
+
+	ok &= measure("loopback accm all", 0xFFFFFFFF);
+	ok &= measure("loopback accm none", 0x00000000);
+
+	timing_stop();
+
+	TC_END_REPORT(ok ? TC_PASS : TC_FAIL);
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure mutex throughput when one thread per CPU keeps taking the same
+ * mutex to run a short critical section, to compare pending right away
+ * with spinning on an owner running on another CPU.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/tc_util.h>
+
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, threads, rate)                                       \
+	printk("REC: %s - %s:%u threads ,%llu locks/s\n", label, label,          \
+	       threads, rate)
+#else
+#define PRINT_RESULT(label, threads, rate)                                       \
+	printk("%-32s: %2u threads , %10llu locks/s\n", label, threads, rate)
+#endif
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static unsigned long lock_count[MAX_THREADS];
+
+static K_MUTEX_DEFINE(kmutex);
+static SYS_MUTEX_DEFINE(smutex);
+
+static atomic_t stop;
+static volatile uint32_t shared_counter;
+
+static void critical_section(void)
+{
+	for (int i = 0; i < CONFIG_BENCHMARK_CRITICAL_SECTION_LOOPS; i++) {
+		shared_counter++;
+	}
+}
+
+static void k_mutex_entry(void *p1, void *p2, void *p3)
+{
+	unsigned long *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&stop)) {
+		k_mutex_lock(&kmutex, K_FOREVER);
+		critical_section();
+		k_mutex_unlock(&kmutex);
+		(*count)++;
+	}
+}
+
+static void sys_mutex_entry(void *p1, void *p2, void *p3)
+{
+	unsigned long *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&stop)) {
+		sys_mutex_lock(&smutex, K_FOREVER);
+		critical_section();
+		sys_mutex_unlock(&smutex);
+		(*count)++;
+	}
+}
+
+static void run(const char *label, k_thread_entry_t entry, unsigned int num_threads)
+{
+	uint64_t total = 0;
+
+	atomic_clear(&stop);
+	for (unsigned int i = 0; i < num_threads; i++) {
+		lock_count[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entry,
+				&lock_count[i], NULL, NULL, K_PRIO_PREEMPT(1), 0,
+				K_NO_WAIT);
+	}
+
+	k_msleep(CONFIG_BENCHMARK_DURATION_MS);
+	atomic_set(&stop, 1);
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += lock_count[i];
+	}
+
+	PRINT_RESULT(label, num_threads, total * MSEC_PER_SEC / CONFIG_BENCHMARK_DURATION_MS);
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	printk("Mutex contention benchmark: %u CPUs, adaptive spin %s, sys_mutex fast path %s\n",
+	       num_cpus, IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) ? "on" : "off");
+
+	run("k_mutex.uncontended", k_mutex_entry, 1);
+	run("k_mutex.contended", k_mutex_entry, num_cpus);
+	run("sys_mutex.uncontended", sys_mutex_entry, 1);
+	run("sys_mutex.contended", sys_mutex_entry, num_cpus);
+
+	TC_END_REPORT(TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the latency of periodic high priority sensor reads sharing an
+ * emulated bus with a thread keeping low priority flash writes queued, with
+ * and without an iodev scheduler in front of the bus.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/sys/mpsc_lockfree.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_READS       CONFIG_BENCHMARK_SENSOR_READS
+#define OUTSTANDING     CONFIG_BENCHMARK_FLASH_OUTSTANDING
+#define STACK_SIZE      (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Emulated bus of about 8 MHz, with a fixed cost per transfer */
+#define BUS_TRANSFER_US 20
+#define BUS_BYTES_PER_US 1
+
+#define FLASH_WRITE_LEN 256
+#define SENSOR_READ_LEN 16
+
+#ifdef CONFIG_RTIO_IODEV_SCHED
+#define MODE "prio"
+#else
+#define MODE "fifo"
+#endif
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, us)                                                  \
+	printk("REC: %s - %s " MODE ":%u us\n", label, label, us)
+#else
+#define PRINT_RESULT(label, us)                                                  \
+	printk("%-24s (" MODE "): %8u us\n", label, us)
+#endif
+
+/* Serves the transfers of all its iodevs in order, like a bus driver */
+struct bench_bus {
+	struct k_timer timer;
+	struct mpsc io_q;
+	struct rtio_iodev_sqe *curr;
+	struct k_spinlock lock;
+};
+
+static struct bench_bus bus;
+
+static void bench_bus_next(struct bench_bus *b, bool completion)
+{
+	k_spinlock_key_t key = k_spin_lock(&b->lock);
+	struct mpsc_node *node;
+	uint32_t len;
+
+	if (!completion && b->curr != NULL) {
+		k_spin_unlock(&b->lock, key);
+		return;
+	}
+
+	node = mpsc_pop(&b->io_q);
+	if (node == NULL) {
+		b->curr = NULL;
+		k_spin_unlock(&b->lock, key);
+		return;
+	}
+
+	b->curr = CONTAINER_OF(node, struct rtio_iodev_sqe, q);
+	len = b->curr->sqe.op == RTIO_OP_RX ? b->curr->sqe.rx.buf_len : b->curr->sqe.tx.buf_len;
+	k_timer_start(&b->timer, K_USEC(BUS_TRANSFER_US + len / BUS_BYTES_PER_US), K_NO_WAIT);
+
+	k_spin_unlock(&b->lock, key);
+}
+
+static void bench_bus_timer_fn(struct k_timer *timer)
+{
+	struct bench_bus *b = CONTAINER_OF(timer, struct bench_bus, timer);
+
+	rtio_iodev_sqe_ok(b->curr, 0);
+	bench_bus_next(b, true);
+}
+
+static void bench_bus_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct bench_bus *b = iodev_sqe->sqe.iodev->data;
+
+	mpsc_push(&b->io_q, &iodev_sqe->q);
+	bench_bus_next(b, false);
+}
+
+static const struct rtio_iodev_api bench_bus_api = {
+	.submit = bench_bus_submit,
+};
+
+#ifdef CONFIG_RTIO_IODEV_SCHED
+RTIO_IODEV_SCHED_DEFINE(bus_sched, CONFIG_BENCHMARK_SCHED_DEPTH, 0);
+#define BUS_IODEV_DEFINE(name) RTIO_IODEV_DEFINE_WITH_SCHED(name, &bench_bus_api, &bus, &bus_sched)
+#else
+#define BUS_IODEV_DEFINE(name) RTIO_IODEV_DEFINE(name, &bench_bus_api, &bus)
+#endif
+
+BUS_IODEV_DEFINE(flash_iodev);
+BUS_IODEV_DEFINE(sensor_iodev);
+
+RTIO_DEFINE(r_flash, OUTSTANDING, OUTSTANDING);
+RTIO_DEFINE(r_sensor, 1, 1);
+
+static K_THREAD_STACK_DEFINE(flash_stack, STACK_SIZE);
+static struct k_thread flash_thread;
+static atomic_t stop;
+static uint32_t flash_writes;
+
+static uint8_t flash_buf[FLASH_WRITE_LEN];
+static uint8_t sensor_buf[SENSOR_READ_LEN];
+static uint32_t latency_us[NUM_READS];
+
+static void flash_write(void)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r_flash);
+
+	rtio_sqe_prep_write(sqe, &flash_iodev, RTIO_PRIO_LOW, flash_buf, sizeof(flash_buf), NULL);
+	rtio_submit(&r_flash, 0);
+}
+
+static void flash_entry(void *p1, void *p2, void *p3)
+{
+	int in_flight = 0;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (; in_flight < OUTSTANDING; in_flight++) {
+		flash_write();
+	}
+
+	while (in_flight > 0) {
+		struct rtio_cqe *cqe = rtio_cqe_consume_block(&r_flash);
+
+		rtio_cqe_release(&r_flash, cqe);
+		flash_writes++;
+		in_flight--;
+
+		if (!atomic_get(&stop)) {
+			flash_write();
+			in_flight++;
+		}
+	}
+}
+
+static uint32_t sensor_read(void)
+{
+	uint32_t start = k_cycle_get_32();
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r_sensor);
+	struct rtio_cqe *cqe;
+
+	rtio_sqe_prep_read(sqe, &sensor_iodev, RTIO_PRIO_HIGH, sensor_buf, sizeof(sensor_buf),
+			   NULL);
+	rtio_submit(&r_sensor, 0);
+	cqe = rtio_cqe_consume_block(&r_sensor);
+	rtio_cqe_release(&r_sensor, cqe);
+
+	return k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+}
+
+static void sort(uint32_t *values, int count)
+{
+	for (int i = 1; i < count; i++) {
+		uint32_t value = values[i];
+		int j = i;
+
+		for (; j > 0 && values[j - 1] > value; j--) {
+			values[j] = values[j - 1];
+		}
+		values[j] = value;
+	}
+}
+
+int main(void)
+{
+	mpsc_init(&bus.io_q);
+	k_timer_init(&bus.timer, bench_bus_timer_fn, NULL);
+
+	k_thread_create(&flash_thread, flash_stack, K_THREAD_STACK_SIZEOF(flash_stack),
+			flash_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+
+	/* Let the flash writes pile up on the bus */
+	k_msleep(10);
+
+	for (int i = 0; i < NUM_READS; i++) {
+		latency_us[i] = sensor_read();
+		k_usleep(CONFIG_BENCHMARK_SENSOR_PERIOD_US);
+	}
+
+	atomic_set(&stop, 1);
+	k_thread_join(&flash_thread, K_FOREVER);
+
+	sort(latency_us, NUM_READS);
+	PRINT_RESULT("sensor read p50", latency_us[NUM_READS / 2]);
+	PRINT_RESULT("sensor read p99", latency_us[NUM_READS * 99 / 100]);
+	PRINT_RESULT("sensor read max", latency_us[NUM_READS - 1]);
+	printk("%u flash writes completed\n", flash_writes);
+
+	TC_END_REPORT(flash_writes > 0 ? TC_PASS : TC_FAIL);
+	return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the conversion of FIFO frames of a three axis sensor to q31 values,
+ * with the per sample division decoders used to do and with the batch
+ * conversion helpers.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor_convert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define NUM_FRAMES  CONFIG_BENCHMARK_NUM_FRAMES
+#define NUM_SAMPLES (NUM_FRAMES * 3)
+
+/* +/-16 g over 16 bits, in nano m/s^2 per LSB */
+#define ACCEL_NANO_PER_LSB INT64_C(4788403)
+#define ACCEL_SHIFT        8
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, ns)                                                  \
+	printk("REC: %s - %s:%u ns/sample\n", label, label, ns)
+#else
+#define PRINT_RESULT(label, ns)                                                  \
+	printk("%-32s: %6u ns/sample\n", label, ns)
+#endif
+
+static uint8_t raw_le[NUM_SAMPLES * sizeof(int16_t)] __aligned(4);
+static uint8_t raw_be[NUM_SAMPLES * sizeof(int16_t)] __aligned(4);
+static q31_t reference[NUM_SAMPLES];
+static q31_t out[NUM_SAMPLES];
+static struct sensor_three_axis_sample_data readings[NUM_FRAMES];
+
+static struct sensor_convert_scale scale;
+static struct sensor_convert_axes axes;
+
+/* What decoders do without the helpers, one 64 bit division per sample */
+static void convert_division(const uint8_t *raw, size_t count, q31_t *values)
+{
+	for (size_t i = 0; i < count; i++) {
+		int64_t value = (int16_t)sys_get_le16(&raw[i * sizeof(int16_t)]);
+
+		value = value * ACCEL_NANO_PER_LSB * (int64_t)BIT64(31 - ACCEL_SHIFT);
+		values[i] = (q31_t)(value / NSEC_PER_SEC);
+	}
+}
+
+static void convert_one(const uint8_t *raw, size_t count, q31_t *values)
+{
+	for (size_t i = 0; i < count; i++) {
+		values[i] = sensor_convert_one((int16_t)sys_get_le16(&raw[i * sizeof(int16_t)]),
+					       &scale, 0);
+	}
+}
+
+static void convert_block_le(const uint8_t *raw, size_t count, q31_t *values)
+{
+	sensor_convert_q31(raw, sizeof(int16_t), count, SENSOR_CONVERT_S16_LE, &scale, 0, values);
+}
+
+static void convert_block_be(const uint8_t *raw, size_t count, q31_t *values)
+{
+	sensor_convert_q31(raw, sizeof(int16_t), count, SENSOR_CONVERT_S16_BE, &scale, 0, values);
+}
+
+static void convert_three_axis(const uint8_t *raw, size_t count, q31_t *values)
+{
+	sensor_convert_three_axis(raw, 3 * sizeof(int16_t), count / 3, SENSOR_CONVERT_S16_LE,
+				  &axes, readings);
+
+	for (size_t i = 0; i < count / 3; i++) {
+		values[i * 3] = readings[i].x;
+		values[i * 3 + 1] = readings[i].y;
+		values[i * 3 + 2] = readings[i].z;
+	}
+}
+
+static bool measure(const char *label, void (*convert)(const uint8_t *, size_t, q31_t *),
+		    const uint8_t *raw)
+{
+	timing_t start, end;
+	uint64_t ns;
+
+	memset(out, 0, sizeof(out));
+
+	start = timing_counter_get();
+	for (int i = 0; i < CONFIG_BENCHMARK_REPEAT; i++) {
+		convert(raw, NUM_SAMPLES, out);
+	}
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	PRINT_RESULT(label, (uint32_t)(ns / ((uint64_t)NUM_SAMPLES * CONFIG_BENCHMARK_REPEAT)));
+
+	for (int i = 0; i < NUM_SAMPLES; i++) {
+		/* Rounding of the scale and SIMD kernels each cost up to one LSB */
+		if (abs(out[i] - reference[i]) > 2) {
+			TC_ERROR("%s: sample %d is %d instead of %d\n", label, i, out[i],
+				 reference[i]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(void)
+{
+	bool ok = true;
+
+	for (int i = 0; i < NUM_SAMPLES; i++) {
+		int16_t value = (int16_t)(i * 2731 - 32768);
+
+		sys_put_le16(value, &raw_le[i * sizeof(int16_t)]);
+		sys_put_be16(value, &raw_be[i * sizeof(int16_t)]);
+	}
+
+	if (sensor_convert_scale_init(&scale, ACCEL_NANO_PER_LSB, ACCEL_SHIFT) != 0) {
+		TC_ERROR("scale out of range\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	for (int axis = 0; axis < 3; axis++) {
+		axes.offset[axis] = axis * sizeof(int16_t);
+		axes.scale[axis] = scale;
+	}
+
+	convert_division(raw_le, NUM_SAMPLES, reference);
+
+	timing_init();
+	timing_start();
+
+	ok &= measure("division", convert_division, raw_le);
+	ok &= measure("sensor_convert_one", convert_one, raw_le);
+	ok &= measure("sensor_convert_q31 le", convert_block_le, raw_le);
+	ok &= measure("sensor_convert_q31 be", convert_block_be, raw_be);
+	ok &= measure("sensor_convert_three_axis", convert_three_axis, raw_le);
+
+	timing_stop();
+
+	TC_END_REPORT(ok ? TC_PASS : TC_FAIL);
+	return 0;
+}
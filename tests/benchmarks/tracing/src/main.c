@@ -0,0 +1,105 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of traced kernel calls made by one thread per CPU, without
+ * tracing, with the single tracing buffer and with per-CPU tracing buffers.
+ * The difference with the run without tracing is the cost of the events.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#if defined(CONFIG_TRACING_BUFFER_PER_CPU)
+#define MODE "per_cpu"
+#elif defined(CONFIG_TRACING)
+#define MODE "ring"
+#else
+#define MODE "none"
+#endif
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, threads, ns)                                         \
+	printk("REC: %s %u threads - %s " MODE ":%u ns/call\n", label, threads, label, ns)
+#else
+#define PRINT_RESULT(label, threads, ns)                                         \
+	printk("%-16s %u threads (" MODE "): %6u ns/call\n", label, threads, ns)
+#endif
+
+struct worker {
+	struct k_thread thread;
+	struct k_sem sem;
+	uint64_t cycles;
+};
+
+static struct worker workers[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	struct worker *worker = p1;
+	timing_t start, end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int batch = 0; batch < CONFIG_BENCHMARK_BATCHES; batch++) {
+		start = timing_counter_get();
+		for (int i = 0; i < CONFIG_BENCHMARK_BATCH_SIZE; i++) {
+			k_sem_give(&worker->sem);
+			(void)k_sem_take(&worker->sem, K_NO_WAIT);
+		}
+		end = timing_counter_get();
+
+		worker->cycles += timing_cycles_get(&start, &end);
+
+		/* Let the tracing thread empty the buffers */
+		k_msleep(CONFIG_BENCHMARK_DRAIN_MS);
+	}
+}
+
+static uint32_t run(unsigned int num_threads)
+{
+	uint64_t cycles = 0;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		workers[i].cycles = 0;
+		k_sem_init(&workers[i].sem, 0, 1);
+		k_thread_create(&workers[i].thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]), worker_entry, &workers[i],
+				NULL, NULL, K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&workers[i].thread, K_FOREVER);
+		cycles += workers[i].cycles;
+	}
+
+	/* Threads run in parallel, so this is the cost seen by each of them */
+	return (uint32_t)(timing_cycles_to_ns(cycles) /
+			  ((uint64_t)num_threads * CONFIG_BENCHMARK_BATCHES *
+			   CONFIG_BENCHMARK_BATCH_SIZE * 2));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	PRINT_RESULT("sem give/take", 1, run(1));
+	if (arch_num_cpus() > 1) {
+		PRINT_RESULT("sem give/take", arch_num_cpus(), run(arch_num_cpus()));
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(TC_PASS);
+	return 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of the zDSP basic math functions of the selected backend,
+ * in cycles per sample, so that the backends can be compared on a target.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/dsp/dsp.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define BLOCK_SIZE CONFIG_BENCHMARK_BLOCK_SIZE
+#define ITERATIONS CONFIG_BENCHMARK_ITERATIONS
+
+#if defined(CONFIG_DSP_BACKEND_PORTABLE)
+#define BACKEND "portable"
+#elif defined(CONFIG_DSP_BACKEND_CMSIS)
+#define BACKEND "cmsis"
+#else
+#define BACKEND "custom"
+#endif
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+#define PRINT_RESULT(label, x100)                                                                  \
+	printk("REC: %s - %s " BACKEND ":%u.%02u cycles/sample\n", label, label, (x100) / 100,     \
+	       (x100) % 100)
+#else
+#define PRINT_RESULT(label, x100)                                                                  \
+	printk("%-16s (" BACKEND "): %4u.%02u cycles/sample\n", label, (x100) / 100, (x100) % 100)
+#endif
+
+/* Runs a call ITERATIONS times and prints its cost per sample */
+#define MEASURE(label, call)                                                                       \
+	do {                                                                                       \
+		timing_t start, end;                                                               \
+		uint64_t cycles;                                                                   \
+                                                                                                   \
+		start = timing_counter_get();                                                      \
+		for (int iter = 0; iter < ITERATIONS; iter++) {                                    \
+			call;                                                                      \
+			/* Keep the compiler from hoisting the call out of the loop */             \
+			compiler_barrier();                                                        \
+		}                                                                                  \
+		end = timing_counter_get();                                                        \
+                                                                                                   \
+		cycles = timing_cycles_get(&start, &end);                                          \
+		PRINT_RESULT(label,                                                                \
+			     (uint32_t)(cycles * 100U / ((uint64_t)ITERATIONS * BLOCK_SIZE)));     \
+	} while (false)
+
+static q7_t a_q7[BLOCK_SIZE], b_q7[BLOCK_SIZE], dst_q7[BLOCK_SIZE];
+static q15_t a_q15[BLOCK_SIZE], b_q15[BLOCK_SIZE], dst_q15[BLOCK_SIZE];
+static q31_t a_q31[BLOCK_SIZE], b_q31[BLOCK_SIZE], dst_q31[BLOCK_SIZE];
+static float32_t a_f32[BLOCK_SIZE], b_f32[BLOCK_SIZE], dst_f32[BLOCK_SIZE];
+
+static volatile q31_t result_q31;
+static volatile q63_t result_q63;
+static volatile float32_t result_f32;
+
+int main(void)
+{
+	uint32_t prng = 1234;
+	q31_t dot_q31;
+	q63_t dot_q63;
+	float32_t dot_f32;
+
+	for (int i = 0; i < BLOCK_SIZE; i++) {
+		prng = 1103515245 * prng + 12345;
+		a_q31[i] = (q31_t)prng;
+		a_q15[i] = (q15_t)(prng >> 16);
+		a_q7[i] = (q7_t)(prng >> 24);
+		a_f32[i] = (float32_t)a_q15[i] / 32768.0f;
+
+		prng = 1103515245 * prng + 12345;
+		b_q31[i] = (q31_t)prng;
+		b_q15[i] = (q15_t)(prng >> 16);
+		b_q7[i] = (q7_t)(prng >> 24);
+		b_f32[i] = (float32_t)b_q15[i] / 32768.0f;
+	}
+
+	timing_init();
+	timing_start();
+
+	MEASURE("add q7", zdsp_add_q7(a_q7, b_q7, dst_q7, BLOCK_SIZE));
+	MEASURE("add q15", zdsp_add_q15(a_q15, b_q15, dst_q15, BLOCK_SIZE));
+	MEASURE("add q31", zdsp_add_q31(a_q31, b_q31, dst_q31, BLOCK_SIZE));
+	MEASURE("add f32", zdsp_add_f32(a_f32, b_f32, dst_f32, BLOCK_SIZE));
+	MEASURE("mult q15", zdsp_mult_q15(a_q15, b_q15, dst_q15, BLOCK_SIZE));
+	MEASURE("mult q31", zdsp_mult_q31(a_q31, b_q31, dst_q31, BLOCK_SIZE));
+	MEASURE("mult f32", zdsp_mult_f32(a_f32, b_f32, dst_f32, BLOCK_SIZE));
+	MEASURE("scale q15", zdsp_scale_q15(a_q15, 0x4000, 1, dst_q15, BLOCK_SIZE));
+	MEASURE("scale f32", zdsp_scale_f32(a_f32, 0.5f, dst_f32, BLOCK_SIZE));
+	MEASURE("clip q15", zdsp_clip_q15(a_q15, dst_q15, -0x4000, 0x4000, BLOCK_SIZE));
+	MEASURE("clip f32", zdsp_clip_f32(a_f32, dst_f32, -0.5f, 0.5f, BLOCK_SIZE));
+
+	MEASURE("dot prod q7", {
+		zdsp_dot_prod_q7(a_q7, b_q7, BLOCK_SIZE, &dot_q31);
+		result_q31 = dot_q31;
+	});
+	MEASURE("dot prod q15", {
+		zdsp_dot_prod_q15(a_q15, b_q15, BLOCK_SIZE, &dot_q63);
+		result_q63 = dot_q63;
+	});
+	MEASURE("dot prod q31", {
+		zdsp_dot_prod_q31(a_q31, b_q31, BLOCK_SIZE, &dot_q63);
+		result_q63 = dot_q63;
+	});
+	MEASURE("dot prod f32", {
+		zdsp_dot_prod_f32(a_f32, b_f32, BLOCK_SIZE, &dot_f32);
+		result_f32 = dot_f32;
+	});
+
+	timing_stop();
+
+	TC_END_REPORT(TC_PASS);
+	return 0;
+}
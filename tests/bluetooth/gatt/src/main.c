@@ -421,6 +421,90 @@ ZTEST(test_gatt, test_gatt_foreach)
 	}
 }
 
+#define MANY_SVC_COUNT 24
+#define MANY_SVC_ATTRS 5
+
+static struct bt_gatt_attr many_attrs[MANY_SVC_COUNT][MANY_SVC_ATTRS] = {
+	[0 ... MANY_SVC_COUNT - 1] = {
+		BT_GATT_PRIMARY_SERVICE(BT_UUID_DIS),
+		BT_GATT_CHARACTERISTIC(BT_UUID_DIS_MODEL_NUMBER, BT_GATT_CHRC_READ,
+				       BT_GATT_PERM_READ, read_test, NULL, test_value),
+		BT_GATT_CHARACTERISTIC(&test_chrc_uuid.uuid, BT_GATT_CHRC_READ,
+				       BT_GATT_PERM_READ, read_test, NULL, test_value),
+	},
+};
+
+static struct bt_gatt_service many_svcs[MANY_SVC_COUNT];
+
+/* Lookups by handle and by UUID in a database of many services, which the
+ * attribute index serves with binary searches when enabled.
+ */
+ZTEST(test_gatt, test_gatt_foreach_many)
+{
+	const struct bt_gatt_attr *attr;
+	uint16_t first, last, removed_first, removed_last;
+	uint16_t num;
+
+	for (size_t i = 0; i < MANY_SVC_COUNT; i++) {
+		many_svcs[i].attrs = many_attrs[i];
+		many_svcs[i].attr_count = MANY_SVC_ATTRS;
+		zassert_false(bt_gatt_service_register(&many_svcs[i]),
+			      "Service %zu registration failed", i);
+	}
+
+	first = many_attrs[0][0].handle;
+	last = many_attrs[MANY_SVC_COUNT - 1][MANY_SVC_ATTRS - 1].handle;
+
+	for (size_t i = 0; i < MANY_SVC_COUNT; i++) {
+		for (size_t j = 0; j < MANY_SVC_ATTRS; j++) {
+			attr = NULL;
+			bt_gatt_foreach_attr(many_attrs[i][j].handle,
+					     many_attrs[i][j].handle, find_attr, &attr);
+			zassert_equal_ptr(attr, &many_attrs[i][j],
+					  "Wrong attribute at handle 0x%04x",
+					  many_attrs[i][j].handle);
+		}
+	}
+
+	num = 0;
+	bt_gatt_foreach_attr_type(first, last, BT_UUID_GATT_PRIMARY, NULL, 0,
+				  count_attr, &num);
+	zassert_equal(num, MANY_SVC_COUNT, "Number of services don't match");
+
+	num = 0;
+	bt_gatt_foreach_attr_type(first, last, &test_chrc_uuid.uuid, NULL, 0,
+				  count_attr, &num);
+	zassert_equal(num, MANY_SVC_COUNT, "Number of attributes don't match");
+
+	/* Only the first match of a 16-bit UUID after the start handle */
+	attr = NULL;
+	bt_gatt_foreach_attr_type(many_attrs[3][1].handle, last, BT_UUID_DIS_MODEL_NUMBER,
+				  NULL, 1, find_attr, &attr);
+	zassert_equal_ptr(attr, &many_attrs[3][2], "Attribute don't match");
+
+	/* Lookups follow unregistration */
+	removed_first = many_attrs[MANY_SVC_COUNT / 2][0].handle;
+	removed_last = many_attrs[MANY_SVC_COUNT / 2][MANY_SVC_ATTRS - 1].handle;
+	zassert_false(bt_gatt_service_unregister(&many_svcs[MANY_SVC_COUNT / 2]),
+		      "Service unregister failed");
+
+	num = 0;
+	bt_gatt_foreach_attr(removed_first, removed_last, count_attr, &num);
+	zassert_equal(num, 0, "Unregistered attributes found");
+
+	num = 0;
+	bt_gatt_foreach_attr_type(first, last, BT_UUID_GATT_CHRC, NULL, 0,
+				  count_attr, &num);
+	zassert_equal(num, (MANY_SVC_COUNT - 1) * 2, "Number of attributes don't match");
+
+	for (size_t i = 0; i < MANY_SVC_COUNT; i++) {
+		if (i != MANY_SVC_COUNT / 2) {
+			zassert_false(bt_gatt_service_unregister(&many_svcs[i]),
+				      "Service %zu unregister failed", i);
+		}
+	}
+}
+
 ZTEST(test_gatt, test_gatt_read)
 {
 	const struct bt_gatt_attr *attr;
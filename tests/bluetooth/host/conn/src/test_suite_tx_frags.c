@@ -0,0 +1,351 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/hci_types.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <host/buf_view.h>
+#include <host/conn_internal.h>
+#include <host/hci_core.h>
+
+#include "mocks/buf_view.h"
+#include "mocks/hci_core.h"
+#include "mocks/kernel.h"
+#include "mocks/spinlock.h"
+
+#define ACL_MTU 4
+
+/* The fragment pools of the host hold one buffer per controller buffer */
+#define FRAG_POOL_COUNT CONFIG_BT_BUF_ACL_TX_COUNT
+
+#define PDU_MAX_LEN ((FRAG_POOL_COUNT + 1) * ACL_MTU + 2)
+
+static bool pdu_destroyed;
+
+static void pdu_destroy(struct net_buf *buf)
+{
+	pdu_destroyed = true;
+	net_buf_destroy(buf);
+}
+
+NET_BUF_POOL_FIXED_DEFINE(pdu_pool, 1, PDU_MAX_LEN, 0, pdu_destroy);
+
+static struct bt_conn conn;
+static struct net_buf *pdu;
+static size_t pdu_pulls;
+
+/* Same contract as the L2CAP one: the PDU stays queued until its last fragment */
+static struct net_buf *pdu_pull(struct bt_conn *c, size_t amount, size_t *length)
+{
+	struct net_buf *buf = pdu;
+
+	pdu_pulls++;
+	*length = buf->len;
+
+	if (buf->len > amount) {
+		return net_buf_ref(buf);
+	}
+
+	pdu = NULL;
+
+	return buf;
+}
+
+static void pdu_get_and_clear_cb(struct bt_conn *c, struct net_buf *buf, bt_conn_tx_cb_t *cb,
+				 void **ud)
+{
+	*cb = NULL;
+	*ud = NULL;
+}
+
+static bool pdu_has_data(struct bt_conn *c)
+{
+	return pdu != NULL;
+}
+
+/* The kernel queues behind the buffer pools and the TX contexts */
+static void queue_init(struct k_queue *queue)
+{
+	sys_sflist_init(&queue->data_q);
+}
+
+static void queue_append(struct k_queue *queue, void *data)
+{
+	sys_sfnode_init(data, 0);
+	sys_sflist_append(&queue->data_q, data);
+}
+
+static void queue_prepend(struct k_queue *queue, void *data)
+{
+	sys_sfnode_init(data, 0);
+	sys_sflist_prepend(&queue->data_q, data);
+}
+
+static void *queue_get(struct k_queue *queue, k_timeout_t timeout)
+{
+	return sys_sflist_get(&queue->data_q);
+}
+
+static int queue_is_empty(struct k_queue *queue)
+{
+	return sys_sflist_is_empty(&queue->data_q);
+}
+
+static struct net_buf *make_view(struct net_buf *view, struct net_buf *parent, size_t len,
+				 struct bt_buf_view_meta *meta)
+{
+	net_buf_simple_clone(&parent->b, &view->b);
+	view->size = net_buf_headroom(parent) + len;
+	view->len = len;
+	view->flags = NET_BUF_EXTERNAL_DATA;
+	net_buf_pull(parent, len);
+
+	/* The reference to `parent` is moved to the view */
+	meta->parent = parent;
+
+	return view;
+}
+
+static void destroy_view(struct net_buf *view, struct bt_buf_view_meta *meta)
+{
+	net_buf_unref(meta->parent);
+	memset(meta, 0, sizeof(*meta));
+	net_buf_destroy(view);
+}
+
+static void new_pdu(size_t len)
+{
+	pdu = net_buf_alloc(&pdu_pool, K_NO_WAIT);
+	zassert_not_null(pdu);
+
+	for (size_t i = 0; i < len; i++) {
+		net_buf_add_u8(pdu, i);
+	}
+
+	pdu_destroyed = false;
+	bt_conn_data_ready(&conn);
+}
+
+/* What the controller does with a Number Of Completed Packets event */
+static void complete_packet(void)
+{
+	sys_snode_t *node = sys_slist_get(&conn.tx_pending);
+
+	zassert_not_null(node);
+	sys_slist_append(&conn.tx_complete, node);
+	atomic_dec(&conn.in_ll);
+
+	bt_conn_tx_notify(&conn, false);
+}
+
+static struct net_buf *sent(size_t i)
+{
+	zassert_true(i < bt_send_fake.call_count);
+
+	return bt_send_fake.arg0_history[i];
+}
+
+static void check_acl(struct net_buf *buf, uint8_t pb, size_t offset, size_t len)
+{
+	struct bt_hci_acl_hdr hdr;
+	struct net_buf *payload = buf->frags;
+
+	zassert_equal(buf->len, 1 + sizeof(hdr));
+	zassert_equal(buf->data[0], BT_HCI_H4_ACL);
+	memcpy(&hdr, &buf->data[1], sizeof(hdr));
+
+	zassert_equal(bt_acl_handle(sys_le16_to_cpu(hdr.handle)), conn.handle);
+	zassert_equal(bt_acl_flags_pb(bt_acl_flags(sys_le16_to_cpu(hdr.handle))), pb);
+	zassert_equal(sys_le16_to_cpu(hdr.len), len);
+
+	zassert_not_null(payload);
+	zassert_is_null(payload->frags);
+	zassert_equal(payload->len, len);
+	for (size_t i = 0; i < len; i++) {
+		zassert_equal(payload->data[i], offset + i);
+	}
+}
+
+static void tx_frags_before(void *f)
+{
+	k_queue_init_fake.custom_fake = queue_init;
+	k_queue_append_fake.custom_fake = queue_append;
+	k_queue_prepend_fake.custom_fake = queue_prepend;
+	k_queue_get_fake.custom_fake = queue_get;
+	k_queue_is_empty_fake.custom_fake = queue_is_empty;
+	bt_buf_make_view_fake.custom_fake = make_view;
+	bt_buf_destroy_view_fake.custom_fake = destroy_view;
+
+	z_spin_lock_valid_fake.return_val = true;
+	z_spin_unlock_valid_fake.return_val = true;
+
+	/* Controller buffers are always available */
+	k_sem_count_get_fake.return_val = 1;
+	/* TX notifications are processed in place */
+	k_sched_current_thread_query_fake.return_val = k_sys_work_q.thread_id;
+
+	bt_drv_quirk_tx_frags_fake.return_val = true;
+
+	/* Refills the TX contexts */
+	zassert_ok(bt_conn_init());
+
+	bt_dev.le.acl_mtu = ACL_MTU;
+	sys_slist_init(&bt_dev.le.conn_ready);
+
+	memset(&conn, 0, sizeof(conn));
+	conn.type = BT_CONN_TYPE_LE;
+	conn.state = BT_CONN_CONNECTED;
+	conn.handle = 0x0123;
+	conn.tx_data_pull = pdu_pull;
+	conn.get_and_clear_cb = pdu_get_and_clear_cb;
+	conn.has_data = pdu_has_data;
+	atomic_set(&conn.ref, 1);
+
+	pdu = NULL;
+	pdu_pulls = 0;
+}
+
+ZTEST_SUITE(conn_tx_frags, NULL, NULL, tx_frags_before, NULL, NULL);
+
+/*
+ * Test that the fragments of a PDU are sent back to back as chains, with the
+ * packet boundary flags and the payload of each in order.
+ */
+ZTEST(conn_tx_frags, test_fragment_order)
+{
+	new_pdu(2 * ACL_MTU + 2);
+
+	bt_conn_tx_processor();
+	zassert_true(conn.next_is_frag);
+	bt_conn_tx_processor();
+	zassert_true(conn.next_is_frag);
+	bt_conn_tx_processor();
+	zassert_false(conn.next_is_frag);
+
+	/* Nothing left, and none of the fragments had to be released first */
+	bt_conn_tx_processor();
+	zassert_equal(bt_send_fake.call_count, 3);
+	zassert_equal(pdu_pulls, 3);
+
+	check_acl(sent(0), BT_ACL_START_NO_FLUSH, 0, ACL_MTU);
+	check_acl(sent(1), BT_ACL_CONT, ACL_MTU, ACL_MTU);
+	check_acl(sent(2), BT_ACL_CONT, 2 * ACL_MTU, 2);
+
+	/* Only the last fragment is a view */
+	zassert_equal(bt_buf_make_view_fake.call_count, 1);
+	zassert_equal(bt_buf_make_view_fake.arg2_val, 2);
+
+	for (size_t i = 0; i < 3; i++) {
+		net_buf_unref(sent(i));
+	}
+
+	zassert_true(pdu_destroyed);
+}
+
+/*
+ * Test that a fragment sent by reference gives its reference to the PDU back
+ * when the driver releases it, in any order.
+ */
+ZTEST(conn_tx_frags, test_fragment_release)
+{
+	struct net_buf *buf;
+	int raised;
+
+	new_pdu(2 * ACL_MTU + 2);
+	buf = pdu;
+
+	for (size_t i = 0; i < 3; i++) {
+		bt_conn_tx_processor();
+		complete_packet();
+	}
+
+	zassert_equal(bt_send_fake.call_count, 3);
+
+	/* One reference per fragment */
+	zassert_equal(buf->ref, 3);
+
+	raised = bt_tx_irq_raise_fake.call_count;
+	net_buf_unref(sent(1));
+	zassert_equal(buf->ref, 2);
+	zassert_equal(bt_tx_irq_raise_fake.call_count, raised + 1);
+
+	net_buf_unref(sent(2));
+	zassert_equal(buf->ref, 1);
+	zassert_false(pdu_destroyed);
+
+	net_buf_unref(sent(0));
+	zassert_true(pdu_destroyed);
+
+	/* The fragments can be used again for the next PDU */
+	new_pdu(2 * ACL_MTU + 2);
+	zassert_equal_ptr(pdu, buf);
+
+	for (size_t i = 0; i < 3; i++) {
+		bt_conn_tx_processor();
+		complete_packet();
+	}
+
+	zassert_equal(bt_send_fake.call_count, 6);
+	zassert_equal(buf->ref, 3);
+
+	for (size_t i = 3; i < 6; i++) {
+		net_buf_unref(sent(i));
+	}
+
+	zassert_true(pdu_destroyed);
+}
+
+/*
+ * Test that nothing is pulled from the upper layer while the ACL header or
+ * the reference fragment pools are exhausted, and that sending resumes once
+ * the driver releases a fragment.
+ */
+ZTEST(conn_tx_frags, test_fragment_pools_exhausted)
+{
+	new_pdu(PDU_MAX_LEN);
+
+	for (size_t i = 0; i < FRAG_POOL_COUNT; i++) {
+		bt_conn_tx_processor();
+
+		/* Only the fragment pools may run out */
+		complete_packet();
+	}
+
+	zassert_equal(bt_send_fake.call_count, FRAG_POOL_COUNT);
+
+	bt_conn_tx_processor();
+	zassert_equal(bt_send_fake.call_count, FRAG_POOL_COUNT);
+	zassert_equal(pdu_pulls, FRAG_POOL_COUNT);
+
+	net_buf_unref(sent(0));
+
+	/* The last reference fragment */
+	bt_conn_tx_processor();
+	complete_packet();
+	zassert_equal(bt_send_fake.call_count, FRAG_POOL_COUNT + 1);
+	check_acl(sent(FRAG_POOL_COUNT), BT_ACL_CONT, FRAG_POOL_COUNT * ACL_MTU, ACL_MTU);
+
+	/* The ACL headers ran out again */
+	bt_conn_tx_processor();
+	zassert_equal(bt_send_fake.call_count, FRAG_POOL_COUNT + 1);
+
+	net_buf_unref(sent(1));
+
+	/* The last fragment, a view */
+	bt_conn_tx_processor();
+	complete_packet();
+	zassert_equal(bt_send_fake.call_count, FRAG_POOL_COUNT + 2);
+	check_acl(sent(FRAG_POOL_COUNT + 1), BT_ACL_CONT, (FRAG_POOL_COUNT + 1) * ACL_MTU, 2);
+	zassert_false(conn.next_is_frag);
+
+	for (size_t i = 2; i < FRAG_POOL_COUNT + 2; i++) {
+		net_buf_unref(sent(i));
+	}
+
+	zassert_true(pdu_destroyed);
+}
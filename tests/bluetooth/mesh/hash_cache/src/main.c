@@ -0,0 +1,119 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/random/random.h>
+
+#include "hash_cache.h"
+
+#define CACHE_SIZE 13
+#define KEY_RANGE  64
+
+BT_MESH_HASH_CACHE_DEFINE(cache, CACHE_SIZE);
+
+/* Linear cache behaving as the hashed one should */
+static uint64_t ref_keys[CACHE_SIZE];
+static uint16_t ref_next;
+
+static void ref_add(uint64_t key)
+{
+	ref_keys[ref_next] = key;
+	ref_next = (ref_next + 1) % CACHE_SIZE;
+}
+
+static void ref_remove_last(void)
+{
+	ref_next = (ref_next + CACHE_SIZE - 1) % CACHE_SIZE;
+	ref_keys[ref_next] = 0;
+}
+
+static bool ref_has(uint64_t key)
+{
+	for (int i = 0; i < CACHE_SIZE; i++) {
+		if (ref_keys[i] == key) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void check_all(void)
+{
+	for (uint64_t key = 1; key <= KEY_RANGE; key++) {
+		zassert_equal(bt_mesh_hash_cache_has(&cache, key), ref_has(key),
+			      "Key %llu mismatch", (unsigned long long)key);
+	}
+}
+
+static void hash_cache_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	bt_mesh_hash_cache_clear(&cache);
+	memset(ref_keys, 0, sizeof(ref_keys));
+	ref_next = 0;
+}
+
+ZTEST_SUITE(bt_mesh_hash_cache, NULL, NULL, hash_cache_before, NULL, NULL);
+
+/** Test that the oldest key is evicted when the cache is full. */
+ZTEST(bt_mesh_hash_cache, test_evict_oldest)
+{
+	for (uint64_t key = 1; key <= CACHE_SIZE; key++) {
+		bt_mesh_hash_cache_add(&cache, key);
+	}
+
+	for (uint64_t key = 1; key <= CACHE_SIZE; key++) {
+		zassert_true(bt_mesh_hash_cache_has(&cache, key));
+	}
+
+	bt_mesh_hash_cache_add(&cache, CACHE_SIZE + 1);
+
+	zassert_false(bt_mesh_hash_cache_has(&cache, 1));
+	zassert_true(bt_mesh_hash_cache_has(&cache, 2));
+	zassert_true(bt_mesh_hash_cache_has(&cache, CACHE_SIZE + 1));
+}
+
+/** Test that removing the last key rewinds the cache. */
+ZTEST(bt_mesh_hash_cache, test_remove_last)
+{
+	bt_mesh_hash_cache_add(&cache, 1);
+	bt_mesh_hash_cache_add(&cache, 2);
+	bt_mesh_hash_cache_remove_last(&cache);
+
+	zassert_true(bt_mesh_hash_cache_has(&cache, 1));
+	zassert_false(bt_mesh_hash_cache_has(&cache, 2));
+
+	/* The freed entry is the next one used */
+	for (uint64_t key = 3; key < CACHE_SIZE + 2; key++) {
+		bt_mesh_hash_cache_add(&cache, key);
+	}
+
+	zassert_true(bt_mesh_hash_cache_has(&cache, 1));
+
+	bt_mesh_hash_cache_add(&cache, CACHE_SIZE + 2);
+	zassert_false(bt_mesh_hash_cache_has(&cache, 1));
+}
+
+/** Test random operations against a linear cache, with colliding keys. */
+ZTEST(bt_mesh_hash_cache, test_random)
+{
+	for (int i = 0; i < 10000; i++) {
+		uint64_t key = sys_rand32_get() % KEY_RANGE + 1;
+
+		if (sys_rand32_get() % 8 == 0) {
+			bt_mesh_hash_cache_remove_last(&cache);
+			ref_remove_last();
+		} else {
+			bt_mesh_hash_cache_add(&cache, key);
+			ref_add(key);
+		}
+
+		check_all();
+	}
+}
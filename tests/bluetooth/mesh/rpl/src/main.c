@@ -469,3 +469,38 @@ ZTEST(bt_mesh_rpl_reset, test_rpl_check_on_save_new_entry)
 	zassert_true(bt_mesh_rpl_check(&msg, NULL, false));
 	check_empty_entries(EMPTY_ENTRIES_CNT - 1);
 }
+
+/** Test that a slot held for a segmented message gets the source it is updated for. */
+ZTEST(bt_mesh_rpl_reset, test_rpl_update_taken_slot)
+{
+	struct bt_mesh_net_rx msg_a = {
+		.local_match = true,
+		.ctx.addr = 0x10,
+		.seq = 100,
+	};
+	struct bt_mesh_net_rx msg_b = {
+		.local_match = true,
+		.ctx.addr = 0x20,
+		.seq = 200,
+	};
+	struct bt_mesh_rpl *rpl;
+
+	/* The slot is held, but not written, during the reassembly. */
+	zassert_false(bt_mesh_rpl_check(&msg_a, &rpl, false));
+
+	/* Another source takes the same free slot meanwhile. */
+	ztest_expect_value(bt_mesh_settings_store_schedule, flag, BT_MESH_SETTINGS_RPL_PENDING);
+	zassert_false(bt_mesh_rpl_check(&msg_b, NULL, false));
+
+	ztest_expect_value(bt_mesh_settings_store_schedule, flag, BT_MESH_SETTINGS_RPL_PENDING);
+	bt_mesh_rpl_update(rpl, &msg_a);
+
+	/* The slot now protects the first source, the other one is found no more. */
+	zassert_true(bt_mesh_rpl_check(&msg_a, NULL, false));
+
+	ztest_expect_value(bt_mesh_settings_store_schedule, flag, BT_MESH_SETTINGS_RPL_PENDING);
+	zassert_false(bt_mesh_rpl_check(&msg_b, NULL, false));
+	zassert_true(bt_mesh_rpl_check(&msg_b, NULL, false));
+
+	check_empty_entries(CONFIG_BT_MESH_CRPL - 2);
+}
@@ -14,6 +14,10 @@
 #include <zephyr/storage/disk_access.h>
 #include <zephyr/device.h>
 
+#ifdef CONFIG_DISK_ACCESS_RTIO
+#include <zephyr/storage/disk_access_rtio.h>
+#endif
+
 #ifdef CONFIG_DISK_DRIVER_LOOPBACK
 #include <ff.h>
 #include <zephyr/fs/fs.h>
@@ -275,6 +279,61 @@ ZTEST(disk_driver, test_write)
 	}
 }
 
+#ifdef CONFIG_DISK_ACCESS_RTIO
+DISK_ACCESS_IODEV_DEFINE(disk_iodev, DISK_NAME);
+RTIO_DEFINE(disk_rtio, 4, 4);
+
+static uint8_t rtio_buf[2][SECTOR_COUNT1 * SECTOR_SIZE] __aligned(4);
+
+ZTEST(disk_driver, test_rtio_write_read)
+{
+	struct rtio_sqe *wr, *rd;
+	struct rtio_cqe *cqe;
+	uint32_t len = SECTOR_COUNT1 * disk_sector_size;
+
+	for (int i = 0; i < len; i++) {
+		rtio_buf[0][i] = (uint8_t)(i * 7 + 3);
+	}
+	memset(rtio_buf[1], 0, len);
+
+	/* The read is only started once the write completed */
+	wr = rtio_sqe_acquire(&disk_rtio);
+	rd = rtio_sqe_acquire(&disk_rtio);
+	zassert_not_null(wr);
+	zassert_not_null(rd);
+	disk_access_sqe_prep_write(wr, &disk_iodev, 1, rtio_buf[0], len, (void *)1);
+	wr->flags |= RTIO_SQE_CHAINED;
+	disk_access_sqe_prep_read(rd, &disk_iodev, 1, rtio_buf[1], len, (void *)2);
+
+	zassert_ok(rtio_submit(&disk_rtio, 2));
+
+	for (uintptr_t i = 1; i <= 2; i++) {
+		cqe = rtio_cqe_consume_block(&disk_rtio);
+		zassert_equal((uintptr_t)cqe->userdata, i, "Completions out of order");
+		zassert_ok(cqe->result, "Submission %u failed", (unsigned int)i);
+		rtio_cqe_release(&disk_rtio, cqe);
+	}
+
+	zassert_mem_equal(rtio_buf[0], rtio_buf[1], len, "Read data differs from written one");
+}
+
+ZTEST(disk_driver, test_rtio_bad_length)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	sqe = rtio_sqe_acquire(&disk_rtio);
+	zassert_not_null(sqe);
+	disk_access_sqe_prep_read(sqe, &disk_iodev, 0, rtio_buf[0], disk_sector_size - 1, NULL);
+
+	zassert_ok(rtio_submit(&disk_rtio, 1));
+
+	cqe = rtio_cqe_consume_block(&disk_rtio);
+	zassert_equal(cqe->result, -EINVAL, "Partial sectors should be refused");
+	rtio_cqe_release(&disk_rtio, cqe);
+}
+#endif /* CONFIG_DISK_ACCESS_RTIO */
+
 static void *disk_driver_setup(void)
 {
 #ifdef CONFIG_DISK_DRIVER_LOOPBACK
@@ -300,6 +300,85 @@ ZTEST(disk_performance, test_random_write)
 	}
 }
 
+#define PARALLEL_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define PARALLEL_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(parallel_stacks, PARALLEL_THREADS,
+				   PARALLEL_STACK_SIZE);
+static struct k_thread parallel_threads[PARALLEL_THREADS];
+static uint64_t parallel_latency_ns[PARALLEL_THREADS];
+static int parallel_rc[PARALLEL_THREADS];
+
+static void parallel_read(void *p1, void *p2, void *p3)
+{
+	uintptr_t idx = (uintptr_t)p1;
+	uint8_t *buf = &test_buf[idx * SECTOR_SIZE];
+	timing_t start_time, end_time;
+	uint64_t total_ns = 0;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Each thread reads its own share of the chosen sectors */
+	for (int i = idx; i < RANDOM_ITERATIONS; i += PARALLEL_THREADS) {
+		start_time = timing_counter_get();
+		parallel_rc[idx] |= disk_access_read(disk_pdrv, buf,
+						     chosen_sectors[i], 1);
+		end_time = timing_counter_get();
+		total_ns += timing_cycles_to_ns(timing_cycles_get(&start_time,
+								  &end_time));
+	}
+
+	parallel_latency_ns[idx] = total_ns;
+}
+
+ZTEST(disk_performance, test_random_read_parallel)
+{
+	timing_t start_time, end_time;
+	uint64_t total_ns, latency_ns = 0;
+
+	if (!disk_init_done) {
+		zassert_unreachable("Disk is not initialized");
+	}
+
+	for (int i = 0; i < RANDOM_ITERATIONS; i++) {
+		chosen_sectors[i] = sys_rand32_get() /
+				    ((UINT32_MAX / disk_sector_count) + 1);
+	}
+
+	timing_init();
+	timing_start();
+
+	/*
+	 * One reader per CPU: with a disk driver that can keep several
+	 * requests in flight, this should beat test_random_read.
+	 */
+	start_time = timing_counter_get();
+	for (uintptr_t i = 0; i < PARALLEL_THREADS; i++) {
+		parallel_rc[i] = 0;
+		k_thread_create(&parallel_threads[i], parallel_stacks[i],
+				PARALLEL_STACK_SIZE, parallel_read,
+				(void *)i, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < PARALLEL_THREADS; i++) {
+		k_thread_join(&parallel_threads[i], K_FOREVER);
+		zassert_equal(parallel_rc[i], 0, "Random read failed");
+		latency_ns += parallel_latency_ns[i];
+	}
+	end_time = timing_counter_get();
+	total_ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+
+	timing_stop();
+
+	TC_PRINT("512 Byte IOPS over %d random reads from %d threads: %"PRIu64" IOPS\n",
+		RANDOM_ITERATIONS, PARALLEL_THREADS,
+		((uint64_t)RANDOM_ITERATIONS * NSEC_PER_SEC) / total_ns);
+	TC_PRINT("Average latency: %"PRIu64" ns\n",
+		latency_ns / RANDOM_ITERATIONS);
+}
+
 static void *disk_setup(void)
 {
 	test_setup();
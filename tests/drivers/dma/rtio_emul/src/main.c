@@ -0,0 +1,355 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/rtio.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/drivers/spi_emul.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define SPI_TARGET DT_NODELABEL(spi_target)
+#define I2C_TARGET DT_NODELABEL(i2c_target)
+
+/* What the targets received, and the next byte they send */
+static uint8_t rx_log[32];
+static size_t rx_log_len;
+static uint8_t tx_next;
+static struct i2c_msg i2c_msgs[4];
+static int i2c_num_msgs;
+
+static void target_receive(const uint8_t *buf, size_t len)
+{
+	zassert_true(len <= sizeof(rx_log) - rx_log_len);
+	memcpy(&rx_log[rx_log_len], buf, len);
+	rx_log_len += len;
+}
+
+static void target_send(uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = tx_next++;
+	}
+}
+
+static int spi_target_io(const struct emul *target, const struct spi_config *config,
+			 const struct spi_buf_set *tx_bufs, const struct spi_buf_set *rx_bufs)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(config);
+
+	for (size_t i = 0; tx_bufs != NULL && i < tx_bufs->count; i++) {
+		if (tx_bufs->buffers[i].buf != NULL) {
+			target_receive(tx_bufs->buffers[i].buf, tx_bufs->buffers[i].len);
+		}
+	}
+
+	for (size_t i = 0; rx_bufs != NULL && i < rx_bufs->count; i++) {
+		if (rx_bufs->buffers[i].buf != NULL) {
+			target_send(rx_bufs->buffers[i].buf, rx_bufs->buffers[i].len);
+		}
+	}
+
+	return 0;
+}
+
+static int i2c_target_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+			       int addr)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(addr);
+
+	zassert_true(num_msgs <= ARRAY_SIZE(i2c_msgs));
+	memcpy(i2c_msgs, msgs, num_msgs * sizeof(*msgs));
+	i2c_num_msgs = num_msgs;
+
+	for (int i = 0; i < num_msgs; i++) {
+		if (i2c_is_read_op(&msgs[i])) {
+			target_send(msgs[i].buf, msgs[i].len);
+		} else {
+			target_receive(msgs[i].buf, msgs[i].len);
+		}
+	}
+
+	return 0;
+}
+
+static const struct spi_emul_api spi_target_api = {
+	.io = spi_target_io,
+};
+
+static const struct i2c_emul_api i2c_target_api = {
+	.transfer = i2c_target_transfer,
+};
+
+static int target_init(const struct emul *target, const struct device *parent)
+{
+	ARG_UNUSED(target);
+	ARG_UNUSED(parent);
+
+	return 0;
+}
+
+DEVICE_DT_DEFINE(SPI_TARGET, NULL, NULL, NULL, NULL, POST_KERNEL,
+		 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+EMUL_DT_DEFINE(SPI_TARGET, target_init, NULL, NULL, &spi_target_api, NULL);
+
+DEVICE_DT_DEFINE(I2C_TARGET, NULL, NULL, NULL, NULL, POST_KERNEL,
+		 CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL);
+EMUL_DT_DEFINE(I2C_TARGET, target_init, NULL, NULL, &i2c_target_api, NULL);
+
+SPI_DT_IODEV_DEFINE(spi_iodev, SPI_TARGET, SPI_WORD_SET(8) | SPI_OP_MODE_MASTER);
+I2C_DT_IODEV_DEFINE(i2c_iodev, I2C_TARGET);
+
+RTIO_DEFINE(r, 8, 8);
+
+static void check_cqes(int count, int result)
+{
+	for (int i = 0; i < count; i++) {
+		struct rtio_cqe *cqe = rtio_cqe_consume_block(&r);
+
+		zassert_equal(result, cqe->result, "cqe %d result %d", i, cqe->result);
+		rtio_cqe_release(&r, cqe);
+	}
+}
+
+ZTEST(dma_rtio_emul, test_spi_transaction)
+{
+	const uint8_t cmd[] = {0x92, 0x34};
+	const uint8_t tx[] = {1, 2, 3};
+	uint8_t rx[4];
+	uint8_t txrx[3];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_tiny_write(sqe, &spi_iodev, RTIO_PRIO_NORM, cmd, sizeof(cmd), NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_read(sqe, &spi_iodev, RTIO_PRIO_NORM, rx, sizeof(rx), NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_transceive(sqe, &spi_iodev, RTIO_PRIO_NORM, tx, txrx, sizeof(tx), NULL);
+
+	zassert_ok(rtio_submit(&r, 3));
+	check_cqes(3, 0);
+
+	/* Nothing is sent for the read, the data of the others is contiguous */
+	zassert_equal(5, rx_log_len);
+	zassert_mem_equal(cmd, rx_log, sizeof(cmd));
+	zassert_mem_equal(tx, &rx_log[sizeof(cmd)], sizeof(tx));
+	zassert_mem_equal(((uint8_t[]){0, 1, 2, 3}), rx, sizeof(rx));
+	zassert_mem_equal(((uint8_t[]){4, 5, 6}), txrx, sizeof(txrx));
+}
+
+ZTEST(dma_rtio_emul, test_spi_queued)
+{
+	const uint8_t regs[] = {0x81, 0x82};
+	uint8_t rx[2][2];
+	struct rtio_sqe *sqe;
+
+	for (int i = 0; i < 2; i++) {
+		sqe = rtio_sqe_acquire(&r);
+		rtio_sqe_prep_tiny_write(sqe, &spi_iodev, RTIO_PRIO_NORM, &regs[i], 1, NULL);
+		sqe->flags |= RTIO_SQE_TRANSACTION;
+		sqe = rtio_sqe_acquire(&r);
+		rtio_sqe_prep_read(sqe, &spi_iodev, RTIO_PRIO_NORM, rx[i], sizeof(rx[i]), NULL);
+	}
+
+	zassert_ok(rtio_submit(&r, 4));
+	check_cqes(4, 0);
+
+	zassert_mem_equal(regs, rx_log, sizeof(regs));
+	zassert_mem_equal(((uint8_t[]){0, 1}), rx[0], sizeof(rx[0]));
+	zassert_mem_equal(((uint8_t[]){2, 3}), rx[1], sizeof(rx[1]));
+}
+
+ZTEST(dma_rtio_emul, test_spi_too_large)
+{
+	static uint8_t rx[CONFIG_SPI_EMUL_DMA_WINDOW_SIZE + 1];
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r);
+
+	rtio_sqe_prep_read(sqe, &spi_iodev, RTIO_PRIO_NORM, rx, sizeof(rx), NULL);
+	zassert_ok(rtio_submit(&r, 1));
+	check_cqes(1, -ENOMEM);
+	zassert_equal(0, rx_log_len);
+}
+
+ZTEST(dma_rtio_emul, test_i2c_write_read)
+{
+	const uint8_t reg = 0x10;
+	uint8_t rx[3];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_tiny_write(sqe, &i2c_iodev, RTIO_PRIO_NORM, &reg, 1, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_read(sqe, &i2c_iodev, RTIO_PRIO_NORM, rx, sizeof(rx), NULL);
+	sqe->iodev_flags |= RTIO_IODEV_I2C_RESTART | RTIO_IODEV_I2C_STOP;
+
+	zassert_ok(rtio_submit(&r, 2));
+	check_cqes(2, 0);
+
+	zassert_equal(2, i2c_num_msgs);
+	zassert_equal(I2C_MSG_WRITE, i2c_msgs[0].flags);
+	zassert_equal(I2C_MSG_READ | I2C_MSG_RESTART | I2C_MSG_STOP, i2c_msgs[1].flags);
+	zassert_equal(1, rx_log_len);
+	zassert_equal(reg, rx_log[0]);
+	zassert_mem_equal(((uint8_t[]){0, 1, 2}), rx, sizeof(rx));
+}
+
+ZTEST(dma_rtio_emul, test_i2c_bus_ops)
+{
+	const struct device *bus = DEVICE_DT_GET(DT_BUS(I2C_TARGET));
+	const uint32_t config = I2C_MODE_CONTROLLER | I2C_SPEED_SET(I2C_SPEED_FAST);
+	uint32_t actual;
+	struct rtio_sqe *sqe;
+
+	/* Bus operations are not DMA transfers, the fallback runs them */
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_nop(sqe, &i2c_iodev, NULL);
+	sqe->op = RTIO_OP_I2C_CONFIGURE;
+	sqe->i2c_config = config;
+
+	zassert_ok(rtio_submit(&r, 1));
+	check_cqes(1, 0);
+	zassert_ok(i2c_get_config(bus, &actual));
+	zassert_equal(config, actual);
+
+	/* The emulator cannot recover the bus */
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_nop(sqe, &i2c_iodev, NULL);
+	sqe->op = RTIO_OP_I2C_RECOVER;
+
+	zassert_ok(rtio_submit(&r, 1));
+	check_cqes(1, -ENOSYS);
+	zassert_equal(0, i2c_num_msgs);
+}
+
+ZTEST(dma_rtio_emul, test_i2c_bus_op_in_transaction)
+{
+	const struct device *bus = DEVICE_DT_GET(DT_BUS(I2C_TARGET));
+	const uint32_t config = I2C_MODE_CONTROLLER | I2C_SPEED_SET(I2C_SPEED_STANDARD);
+	const uint8_t reg = 0x20;
+	uint8_t rx[2];
+	uint32_t actual;
+	struct rtio_sqe *sqe;
+
+	/* The messages chained after the bus operation are still transferred */
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_nop(sqe, &i2c_iodev, NULL);
+	sqe->op = RTIO_OP_I2C_CONFIGURE;
+	sqe->i2c_config = config;
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_tiny_write(sqe, &i2c_iodev, RTIO_PRIO_NORM, &reg, 1, NULL);
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_read(sqe, &i2c_iodev, RTIO_PRIO_NORM, rx, sizeof(rx), NULL);
+	sqe->iodev_flags |= RTIO_IODEV_I2C_RESTART | RTIO_IODEV_I2C_STOP;
+
+	zassert_ok(rtio_submit(&r, 3));
+	check_cqes(3, 0);
+
+	zassert_ok(i2c_get_config(bus, &actual));
+	zassert_equal(config, actual);
+	zassert_equal(2, i2c_num_msgs);
+	zassert_equal(1, rx_log_len);
+	zassert_equal(reg, rx_log[0]);
+	zassert_mem_equal(((uint8_t[]){0, 1}), rx, sizeof(rx));
+
+	/* A failing bus operation ends the transaction */
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_nop(sqe, &i2c_iodev, NULL);
+	sqe->op = RTIO_OP_I2C_RECOVER;
+	sqe->flags |= RTIO_SQE_TRANSACTION;
+	sqe = rtio_sqe_acquire(&r);
+	rtio_sqe_prep_tiny_write(sqe, &i2c_iodev, RTIO_PRIO_NORM, &reg, 1, NULL);
+
+	zassert_ok(rtio_submit(&r, 2));
+	check_cqes(1, -ENOSYS);
+	check_cqes(1, -ECANCELED);
+	zassert_equal(1, rx_log_len);
+}
+
+static void link_txn(struct rtio_iodev_sqe *sqes, size_t count)
+{
+	for (size_t i = 0; i + 1 < count; i++) {
+		sqes[i].sqe.flags |= RTIO_SQE_TRANSACTION;
+		sqes[i].next = &sqes[i + 1];
+	}
+}
+
+ZTEST(dma_rtio_emul, test_chain_data_register)
+{
+	static uint8_t tx[6];
+	static uint8_t rx[3];
+	static uint8_t dummy;
+	const struct dma_rtio_port port = {
+		.addr = 0x1000,
+		.dummy = (uintptr_t)&dummy,
+	};
+	struct rtio_iodev_sqe sqes[3] = {0};
+	struct dma_block_config *block;
+
+	DMA_RTIO_CHAIN_DEFINE(chain, 2);
+	DMA_RTIO_CHAIN_DEFINE(short_chain, 1);
+
+	rtio_sqe_prep_write(&sqes[0].sqe, NULL, RTIO_PRIO_NORM, tx, 4, NULL);
+	rtio_sqe_prep_write(&sqes[1].sqe, NULL, RTIO_PRIO_NORM, &tx[4], 2, NULL);
+	rtio_sqe_prep_read(&sqes[2].sqe, NULL, RTIO_PRIO_NORM, rx, sizeof(rx), NULL);
+	link_txn(sqes, ARRAY_SIZE(sqes));
+
+	/* Contiguous writes share a block, the read sends the dummy byte */
+	zassert_ok(dma_rtio_chain_build(&chain, DMA_RTIO_TX, &port, &sqes[0], NULL));
+	zassert_equal(2, chain.count);
+	zassert_equal(9, chain.len);
+	block = &chain.blocks[0];
+	zassert_equal((uintptr_t)tx, block->source_address);
+	zassert_equal(DMA_ADDR_ADJ_INCREMENT, block->source_addr_adj);
+	zassert_equal(port.addr, block->dest_address);
+	zassert_equal(DMA_ADDR_ADJ_NO_CHANGE, block->dest_addr_adj);
+	zassert_equal(6, block->block_size);
+	block = &chain.blocks[1];
+	zassert_equal((uintptr_t)&dummy, block->source_address);
+	zassert_equal(DMA_ADDR_ADJ_NO_CHANGE, block->source_addr_adj);
+	zassert_equal(3, block->block_size);
+
+	/* Received data of the writes goes to the dummy byte */
+	zassert_ok(dma_rtio_chain_build(&chain, DMA_RTIO_RX, &port, &sqes[0], NULL));
+	zassert_equal(2, chain.count);
+	block = &chain.blocks[0];
+	zassert_equal((uintptr_t)&dummy, block->dest_address);
+	zassert_equal(DMA_ADDR_ADJ_NO_CHANGE, block->dest_addr_adj);
+	zassert_equal(6, block->block_size);
+	block = &chain.blocks[1];
+	zassert_equal(port.addr, block->source_address);
+	zassert_equal((uintptr_t)rx, block->dest_address);
+	zassert_equal(3, block->block_size);
+
+	/* Only the writes */
+	zassert_ok(dma_rtio_chain_build(&short_chain, DMA_RTIO_TX, &port, &sqes[0], &sqes[2]));
+	zassert_equal(1, short_chain.count);
+	zassert_equal(6, short_chain.len);
+
+	zassert_equal(-ENOMEM,
+		      dma_rtio_chain_build(&short_chain, DMA_RTIO_TX, &port, &sqes[0], NULL));
+}
+
+static void reset_targets(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	rx_log_len = 0;
+	tx_next = 0;
+	i2c_num_msgs = 0;
+}
+
+ZTEST_SUITE(dma_rtio_emul, NULL, NULL, reset_targets, NULL, NULL);
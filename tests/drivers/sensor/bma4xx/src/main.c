@@ -0,0 +1,276 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/emul_sensor.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#include "bma4xx_emul.h"
+#include "bma4xx_defs.h"
+
+#define NODE DT_NODELABEL(bma4xx)
+
+/* 100 ms at the default 100 Hz, 10 frames of 7 bytes */
+#define BATCH_FRAMES 10
+#define FRAME_SIZE   (BMA4XX_FIFO_HEADER_LENGTH + BMA4XX_FIFO_A_LENGTH)
+#define NUM_FRAMES   16
+
+/* Default range is +/-4g */
+#define ACCEL_SHIFT 6
+#define MS2_TO_Q31(v) ((q31_t)((v) * (double)BIT(31 - ACCEL_SHIFT)))
+/* Two LSBs of the 12 bit samples */
+#define ACCEL_TOLERANCE MS2_TO_Q31(2 * 4 * 9.80665 / 2048)
+
+SENSOR_DT_STREAM_IODEV(wm_iodev, NODE, {SENSOR_TRIG_FIFO_WATERMARK, SENSOR_STREAM_DATA_INCLUDE});
+SENSOR_DT_STREAM_IODEV(drop_iodev, NODE, {SENSOR_TRIG_FIFO_WATERMARK, SENSOR_STREAM_DATA_DROP});
+SENSOR_DT_STREAM_IODEV(full_iodev, NODE, {SENSOR_TRIG_FIFO_FULL, SENSOR_STREAM_DATA_NOP});
+
+RTIO_DEFINE_WITH_MEMPOOL(bma4xx_rtio_ctx, 4, 4, 8, 256, sizeof(void *));
+
+static const struct sensor_chan_spec accel_xyz = {SENSOR_CHAN_ACCEL_XYZ, 0};
+
+struct bma4xx_fixture {
+	const struct device *dev;
+	const struct emul *target;
+	const struct gpio_dt_spec int1;
+	struct rtio_sqe *handle;
+};
+
+static void *bma4xx_setup(void)
+{
+	static struct bma4xx_fixture fixture = {
+		.dev = DEVICE_DT_GET(NODE),
+		.target = EMUL_DT_GET(NODE),
+		.int1 = GPIO_DT_SPEC_GET(NODE, int1_gpios),
+	};
+
+	zassert_not_null(fixture.dev);
+	zassert_not_null(fixture.target);
+	return &fixture;
+}
+
+static void bma4xx_before(void *f)
+{
+	struct bma4xx_fixture *fixture = f;
+	struct sensor_value batch = {
+		.val1 = sys_clock_hw_cycles_per_sec() / (100 / BATCH_FRAMES),
+	};
+
+	zassert_ok(gpio_emul_input_set_dt(&fixture->int1, 0));
+
+	/* Also disables and flushes the FIFO */
+	zassert_ok(sensor_attr_set(fixture->dev, SENSOR_CHAN_ALL, SENSOR_ATTR_BATCH_DURATION,
+				   &batch));
+	zassert_equal(0, bma4xx_emul_get_fifo_len(fixture->target));
+}
+
+static void trigger_interrupt(const struct bma4xx_fixture *fixture)
+{
+	/* Let the driver resubmit the stream and enable the interrupt again */
+	k_msleep(1);
+	zassert_ok(gpio_emul_input_set_dt(&fixture->int1, 0));
+	zassert_ok(gpio_emul_input_set_dt(&fixture->int1, 1));
+}
+
+static void bma4xx_after(void *f)
+{
+	struct bma4xx_fixture *fixture = f;
+
+	if (fixture->handle == NULL) {
+		return;
+	}
+
+	/* The driver completes canceled streams on their next interrupt */
+	zassert_ok(rtio_sqe_cancel(fixture->handle));
+	trigger_interrupt(fixture);
+	k_msleep(1);
+	fixture->handle = NULL;
+	zassert_is_null(rtio_cqe_consume(&bma4xx_rtio_ctx));
+}
+
+ZTEST_SUITE(bma4xx, NULL, bma4xx_setup, bma4xx_before, bma4xx_after, NULL);
+
+ZTEST_F(bma4xx, test_accel_config)
+{
+	struct sensor_value odr = {.val1 = 200};
+	struct sensor_value bwp = {.val1 = BMA4XX_BWP_CIC_AVG8};
+	uint8_t accel_config;
+
+	/* The emulator rejects reserved ODR and bandwidth settings */
+	zassert_ok(sensor_attr_set(fixture->dev, SENSOR_CHAN_ACCEL_XYZ,
+				   SENSOR_ATTR_SAMPLING_FREQUENCY, &odr));
+	zassert_ok(sensor_attr_set(fixture->dev, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_CONFIGURATION,
+				   &bwp));
+	accel_config = bma4xx_emul_get_accel_config(fixture->target);
+	zassert_equal(BMA4XX_ODR_200, FIELD_GET(BMA4XX_MASK_ACC_CONF_ODR, accel_config));
+	zassert_equal(BMA4XX_BWP_CIC_AVG8, FIELD_GET(BMA4XX_MASK_ACC_CONF_BWP, accel_config));
+
+	/* Back to the defaults the other tests expect */
+	odr.val1 = 100;
+	bwp.val1 = BMA4XX_BWP_NORM_AVG4;
+	zassert_ok(sensor_attr_set(fixture->dev, SENSOR_CHAN_ACCEL_XYZ,
+				   SENSOR_ATTR_SAMPLING_FREQUENCY, &odr));
+	zassert_ok(sensor_attr_set(fixture->dev, SENSOR_CHAN_ACCEL_XYZ, SENSOR_ATTR_CONFIGURATION,
+				   &bwp));
+	accel_config = bma4xx_emul_get_accel_config(fixture->target);
+	zassert_equal(BMA4XX_ODR_100, FIELD_GET(BMA4XX_MASK_ACC_CONF_ODR, accel_config));
+}
+
+static void fill_fifo(const struct bma4xx_fixture *fixture, int count)
+{
+	q31_t values[NUM_FRAMES][3];
+
+	zassert_true(count <= NUM_FRAMES);
+	for (int i = 0; i < count; i++) {
+		values[i][0] = MS2_TO_Q31(0.5 * (i + 1));
+		values[i][1] = MS2_TO_Q31(1.0);
+		values[i][2] = MS2_TO_Q31(9.80665);
+	}
+
+	zassert_equal(count, emul_sensor_backend_fifo_fill(fixture->target, accel_xyz,
+							   &values[0][0], ACCEL_SHIFT, count));
+}
+
+static uint8_t *consume_event(uint32_t *buf_len)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&bma4xx_rtio_ctx);
+	uint8_t *buf;
+
+	zassert_ok(cqe->result);
+	zassert_ok(rtio_cqe_get_mempool_buffer(&bma4xx_rtio_ctx, cqe, &buf, buf_len));
+	rtio_cqe_release(&bma4xx_rtio_ctx, cqe);
+
+	return buf;
+}
+
+ZTEST_F(bma4xx, test_stream_watermark_include)
+{
+	const struct sensor_decoder_api *decoder;
+	struct {
+		struct sensor_three_axis_data data;
+		struct sensor_three_axis_sample_data readings[NUM_FRAMES - 1];
+	} decoded;
+	uint32_t fit = 0;
+	uint32_t buf_len;
+	uint16_t frame_count;
+	uint8_t *buf;
+
+	zassert_ok(sensor_stream(&wm_iodev, &bma4xx_rtio_ctx, NULL, &fixture->handle));
+
+	fill_fifo(fixture, NUM_FRAMES);
+	trigger_interrupt(fixture);
+	buf = consume_event(&buf_len);
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+	zassert_true(decoder->has_trigger(buf, SENSOR_TRIG_FIFO_WATERMARK));
+	zassert_false(decoder->has_trigger(buf, SENSOR_TRIG_FIFO_FULL));
+	zassert_ok(decoder->get_frame_count(buf, accel_xyz, &frame_count));
+	zassert_equal(NUM_FRAMES, frame_count);
+
+	zassert_equal(NUM_FRAMES, decoder->decode(buf, accel_xyz, &fit, NUM_FRAMES, &decoded));
+	zassert_equal(ACCEL_SHIFT, decoded.data.shift);
+	for (int i = 0; i < NUM_FRAMES; i++) {
+		const struct sensor_three_axis_sample_data *sample = &decoded.data.readings[i];
+
+		zassert_within(MS2_TO_Q31(0.5 * (i + 1)), sample->x, ACCEL_TOLERANCE);
+		zassert_within(MS2_TO_Q31(1.0), sample->y, ACCEL_TOLERANCE);
+		zassert_within(MS2_TO_Q31(9.80665), sample->z, ACCEL_TOLERANCE);
+		if (i > 0) {
+			zassert_true(sample->timestamp_delta > sample[-1].timestamp_delta);
+		}
+	}
+
+	rtio_release_buffer(&bma4xx_rtio_ctx, buf, buf_len);
+
+	/* All the frames were read */
+	zassert_equal(0, bma4xx_emul_get_fifo_len(fixture->target));
+}
+
+ZTEST_F(bma4xx, test_stream_watermark_drop)
+{
+	const struct sensor_decoder_api *decoder;
+	uint32_t buf_len;
+	uint16_t frame_count;
+	uint8_t *buf;
+
+	zassert_ok(sensor_stream(&drop_iodev, &bma4xx_rtio_ctx, NULL, &fixture->handle));
+
+	fill_fifo(fixture, NUM_FRAMES);
+	trigger_interrupt(fixture);
+	buf = consume_event(&buf_len);
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+	zassert_true(decoder->has_trigger(buf, SENSOR_TRIG_FIFO_WATERMARK));
+	zassert_ok(decoder->get_frame_count(buf, accel_xyz, &frame_count));
+	zassert_equal(0, frame_count);
+	rtio_release_buffer(&bma4xx_rtio_ctx, buf, buf_len);
+
+	/* The flush goes out right after the completion */
+	k_msleep(1);
+	zassert_equal(0, bma4xx_emul_get_fifo_len(fixture->target));
+}
+
+ZTEST_F(bma4xx, test_stream_full_nop)
+{
+	const struct sensor_decoder_api *decoder;
+	int queued = 0;
+	uint32_t buf_len;
+	uint16_t frame_count;
+	uint8_t *buf;
+	int rc;
+
+	zassert_ok(sensor_stream(&full_iodev, &bma4xx_rtio_ctx, NULL, &fixture->handle));
+
+	/* The emulated FIFO takes 1024 bytes, whole frames only */
+	do {
+		q31_t values[3] = {MS2_TO_Q31(1.0), MS2_TO_Q31(2.0), MS2_TO_Q31(3.0)};
+
+		rc = emul_sensor_backend_fifo_fill(fixture->target, accel_xyz, values, ACCEL_SHIFT,
+						   1);
+		zassert_true(rc >= 0);
+		queued += rc;
+	} while (rc == 1);
+	zassert_equal(1024 / FRAME_SIZE, queued);
+
+	trigger_interrupt(fixture);
+	buf = consume_event(&buf_len);
+
+	zassert_ok(sensor_get_decoder(fixture->dev, &decoder));
+	zassert_true(decoder->has_trigger(buf, SENSOR_TRIG_FIFO_FULL));
+	zassert_ok(decoder->get_frame_count(buf, accel_xyz, &frame_count));
+	zassert_equal(0, frame_count);
+	rtio_release_buffer(&bma4xx_rtio_ctx, buf, buf_len);
+
+	/* The frames are left in the FIFO */
+	zassert_equal(queued * FRAME_SIZE, bma4xx_emul_get_fifo_len(fixture->target));
+}
+
+ZTEST_F(bma4xx, test_stream_no_trigger)
+{
+	zassert_ok(sensor_stream(&wm_iodev, &bma4xx_rtio_ctx, NULL, &fixture->handle));
+
+	/* Below the watermark, the interrupt does not complete the stream */
+	fill_fifo(fixture, BATCH_FRAMES - 1);
+	trigger_interrupt(fixture);
+	k_msleep(1);
+	zassert_is_null(rtio_cqe_consume(&bma4xx_rtio_ctx));
+	zassert_equal((BATCH_FRAMES - 1) * FRAME_SIZE, bma4xx_emul_get_fifo_len(fixture->target));
+
+	/* Still armed for the next one */
+	fill_fifo(fixture, 1);
+	trigger_interrupt(fixture);
+
+	uint32_t buf_len;
+	uint8_t *buf = consume_event(&buf_len);
+
+	rtio_release_buffer(&bma4xx_rtio_ctx, buf, buf_len);
+	zassert_equal(0, bma4xx_emul_get_fifo_len(fixture->target));
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/drivers/sensor_convert.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+/* +/-16 g over 16 bits, in nano m/s^2 per LSB */
+#define ACCEL_16G_NANO_PER_LSB INT64_C(4788403)
+#define ACCEL_16G_SHIFT        8
+
+#define NUM_SAMPLES 37
+
+/* raw * nano_per_lsb * 2^(31 - shift) / 10^9, for 16 bit samples */
+static int64_t expected_q31(int32_t raw, int64_t nano_per_lsb, int8_t shift)
+{
+	return (int64_t)raw * nano_per_lsb * (int64_t)BIT64(31 - shift) / NSEC_PER_SEC;
+}
+
+ZTEST(sensor_convert, test_scale_init)
+{
+	struct sensor_convert_scale scale;
+	const int32_t raws[] = {INT16_MIN, -16385, -2, -1, 0, 1, 2, 16381, INT16_MAX};
+
+	zassert_ok(sensor_convert_scale_init(&scale, ACCEL_16G_NANO_PER_LSB, ACCEL_16G_SHIFT));
+	for (size_t i = 0; i < ARRAY_SIZE(raws); i++) {
+		zassert_within(expected_q31(raws[i], ACCEL_16G_NANO_PER_LSB, ACCEL_16G_SHIFT),
+			       sensor_convert_one(raws[i], &scale, 0), 1, "raw %d", raws[i]);
+	}
+
+	/* Flipped axis */
+	zassert_ok(sensor_convert_scale_init(&scale, -ACCEL_16G_NANO_PER_LSB, ACCEL_16G_SHIFT));
+	zassert_within(expected_q31(-1000, ACCEL_16G_NANO_PER_LSB, ACCEL_16G_SHIFT),
+		       sensor_convert_one(1000, &scale, 0), 1);
+
+	/* One unit per LSB does not fit a shift of 0 */
+	zassert_equal(-ERANGE, sensor_convert_scale_init(&scale, NSEC_PER_SEC, 0));
+
+	zassert_ok(sensor_convert_scale_init(&scale, 0, 4));
+	zassert_equal(0, sensor_convert_one(INT16_MAX, &scale, 0));
+}
+
+ZTEST(sensor_convert, test_saturation)
+{
+	struct sensor_convert_scale scale;
+
+	/* Full scale of 16 bits maps to 1.0, a bias of 0.5 pushes it out of range */
+	zassert_ok(sensor_convert_scale_init(&scale, NSEC_PER_SEC / 32768, 0));
+	zassert_equal(INT32_MAX, sensor_convert_one(INT16_MAX, &scale, INT32_MAX / 2 + 1));
+	zassert_equal(INT32_MIN, sensor_convert_one(INT16_MIN, &scale, INT32_MIN / 2 - 1));
+}
+
+ZTEST(sensor_convert, test_formats)
+{
+	struct sensor_convert_scale scale;
+	/* -2, 258 and -8388607, 65538 */
+	const uint8_t s16_le[] = {0xfe, 0xff, 0x02, 0x01};
+	const uint8_t s16_be[] = {0xff, 0xfe, 0x01, 0x02};
+	const uint8_t s24_le[] = {0x01, 0x00, 0x80, 0x02, 0x00, 0x01};
+	const uint8_t s24_be[] = {0x80, 0x00, 0x01, 0x01, 0x00, 0x02};
+	q31_t out[2];
+
+	/* Identity */
+	zassert_ok(sensor_convert_scale_init(&scale, NSEC_PER_SEC, 31));
+
+	sensor_convert_q31(s16_le, 2, 2, SENSOR_CONVERT_S16_LE, &scale, 0, out);
+	zassert_equal(-2, out[0]);
+	zassert_equal(258, out[1]);
+	sensor_convert_q31(s16_be, 2, 2, SENSOR_CONVERT_S16_BE, &scale, 0, out);
+	zassert_equal(-2, out[0]);
+	zassert_equal(258, out[1]);
+	sensor_convert_q31(s24_le, 3, 2, SENSOR_CONVERT_S24_LE, &scale, 0, out);
+	zassert_equal(-8388607, out[0]);
+	zassert_equal(65538, out[1]);
+	sensor_convert_q31(s24_be, 3, 2, SENSOR_CONVERT_S24_BE, &scale, 0, out);
+	zassert_equal(-8388607, out[0]);
+	zassert_equal(65538, out[1]);
+}
+
+static void check_block(enum sensor_convert_format format, size_t misalign, int8_t shift)
+{
+	static uint8_t raw[NUM_SAMPLES * sizeof(int16_t) + 1];
+	struct sensor_convert_scale scale;
+	const q31_t bias = -123456;
+	q31_t out[NUM_SAMPLES];
+
+	zassert_ok(sensor_convert_scale_init(&scale, ACCEL_16G_NANO_PER_LSB, shift));
+
+	for (int i = 0; i < NUM_SAMPLES; i++) {
+		int16_t value = (i - NUM_SAMPLES / 2) * 1771;
+
+		if (format == SENSOR_CONVERT_S16_LE) {
+			sys_put_le16(value, &raw[misalign + i * 2]);
+		} else {
+			sys_put_be16(value, &raw[misalign + i * 2]);
+		}
+	}
+
+	sensor_convert_q31(&raw[misalign], sizeof(int16_t), NUM_SAMPLES, format, &scale, bias,
+			   out);
+
+	for (int i = 0; i < NUM_SAMPLES; i++) {
+		int16_t value = (i - NUM_SAMPLES / 2) * 1771;
+
+		/* SIMD kernels may drop the last bit */
+		zassert_within(sensor_convert_one(value, &scale, bias), out[i], 1,
+			       "sample %d of format %d", i, format);
+	}
+}
+
+ZTEST(sensor_convert, test_block)
+{
+	check_block(SENSOR_CONVERT_S16_LE, 0, ACCEL_16G_SHIFT);
+	check_block(SENSOR_CONVERT_S16_BE, 0, ACCEL_16G_SHIFT);
+	check_block(SENSOR_CONVERT_S16_LE, 1, ACCEL_16G_SHIFT);
+	check_block(SENSOR_CONVERT_S16_BE, 1, ACCEL_16G_SHIFT);
+
+	/* Right shifts past 47 bits are left to the portable loop */
+	check_block(SENSOR_CONVERT_S16_LE, 0, 48);
+	check_block(SENSOR_CONVERT_S16_BE, 0, 48);
+}
+
+ZTEST(sensor_convert, test_three_axis)
+{
+	/* Two frames of a 1 byte header followed by x, y and z */
+	const uint8_t frames[] = {
+		0xaa, 0x01, 0x00, 0x02, 0x00, 0x03, 0x00,
+		0xaa, 0xff, 0xff, 0xfe, 0xff, 0xfd, 0xff,
+	};
+	struct sensor_convert_axes axes = {
+		/* Board X is sensor Y, board Y is sensor -X, board Z is sensor Z */
+		.offset = {3, 1, 5},
+		.bias = {0, 0, 100},
+	};
+	struct sensor_three_axis_sample_data out[2] = {
+		{.timestamp_delta = 1},
+		{.timestamp_delta = 2},
+	};
+
+	zassert_ok(sensor_convert_scale_init(&axes.scale[0], NSEC_PER_SEC, 31));
+	zassert_ok(sensor_convert_scale_init(&axes.scale[1], -(int64_t)NSEC_PER_SEC, 31));
+	zassert_ok(sensor_convert_scale_init(&axes.scale[2], NSEC_PER_SEC, 31));
+
+	sensor_convert_three_axis(frames, 7, 2, SENSOR_CONVERT_S16_LE, &axes, out);
+
+	zassert_equal(2, out[0].x);
+	zassert_equal(-1, out[0].y);
+	zassert_equal(103, out[0].z);
+	zassert_equal(-2, out[1].x);
+	zassert_equal(1, out[1].y);
+	zassert_equal(97, out[1].z);
+
+	zassert_equal(1, out[0].timestamp_delta);
+	zassert_equal(2, out[1].timestamp_delta);
+}
+
+ZTEST_SUITE(sensor_convert, NULL, NULL, NULL, NULL, NULL);
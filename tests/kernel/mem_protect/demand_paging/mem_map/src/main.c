@@ -105,6 +105,7 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 #ifndef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	printk("    - in ISR: %lu\n", stats->pagefaults.in_isr);
 #endif
+	printk("    - Prefetched pages: %lu\n", stats->pagefaults.prefetched);
 
 	printk("* Eviction (%s):\n", scope);
 	printk("    - Total pages evicted: %lu\n",
@@ -252,9 +253,16 @@ static void test_k_mem_page_out(void)
 	faults = k_mem_num_pagefaults_get() - faults;
 	irq_unlock(key);
 
-	zassert_equal(faults, HALF_PAGES,
-		      "unexpected num pagefaults expected %d got %lu",
-		      HALF_PAGES, faults);
+	if (CONFIG_DEMAND_PAGING_PREFETCH_PAGES > 0) {
+		/* Sequential writes get serviced by fewer, clustered page-ins */
+		zassert_true(faults > 0 && faults < HALF_PAGES,
+			     "unexpected num pagefaults expected less than %d got %lu",
+			     HALF_PAGES, faults);
+	} else {
+		zassert_equal(faults, HALF_PAGES,
+			      "unexpected num pagefaults expected %d got %lu",
+			      HALF_PAGES, faults);
+	}
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
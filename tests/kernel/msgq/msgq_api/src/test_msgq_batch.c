@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 5
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern k_tid_t tids[2];
+static struct k_msgq bmsgq;
+static ZTEST_BMEM char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_BMEM uint32_t tx[BATCH_LEN * 2];
+static ZTEST_BMEM uint32_t rx[BATCH_LEN * 2];
+
+static void fill_tx(uint32_t base)
+{
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = base + i;
+	}
+}
+
+static void put_get_many(struct k_msgq *q)
+{
+	int ret;
+
+	fill_tx(0);
+
+	/**TESTPOINT: only as many messages as fit get sent */
+	ret = k_msgq_put_many(q, tx, 3, K_NO_WAIT);
+	zassert_equal(ret, 3);
+	ret = k_msgq_put_many(q, &tx[3], 4, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 3);
+	ret = k_msgq_put_many(q, tx, 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN);
+
+	/**TESTPOINT: partial read, then wrap around the ring buffer */
+	ret = k_msgq_get_many(q, rx, 2, K_NO_WAIT);
+	zassert_equal(ret, 2);
+	zassert_equal(rx[0], 0);
+	zassert_equal(rx[1], 1);
+
+	ret = k_msgq_put_many(q, &tx[BATCH_LEN], 2, K_NO_WAIT);
+	zassert_equal(ret, 2);
+
+	ret = k_msgq_get_many(q, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN);
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(rx[i], i + 2, "got %u at %d", rx[i], i);
+	}
+
+	ret = k_msgq_get_many(q, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG);
+	ret = k_msgq_get_many(q, rx, ARRAY_SIZE(rx), TIMEOUT);
+	zassert_equal(ret, -EAGAIN);
+}
+
+static void tput_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg = MSG0;
+	int ret = k_msgq_put((struct k_msgq *)p1, &msg, K_FOREVER);
+
+	zassert_equal(ret, 0);
+}
+
+static void tget_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t msg;
+	int ret = k_msgq_get_many((struct k_msgq *)p1, &msg, 1, K_FOREVER);
+
+	zassert_equal(ret, 1);
+	zassert_equal(msg, MSG1);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving messages in batches
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api, test_msgq_put_get_many)
+{
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	put_get_many(&bmsgq);
+}
+
+/**
+ * @brief Test batches interacting with waiting threads
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_many_pending)
+{
+	uint32_t msgs[2] = { MSG1, MSG0 };
+	int ret;
+
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	/**TESTPOINT: waiting reader gets the first message of a batch */
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE, tget_entry,
+				  &bmsgq, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+				  K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	ret = k_msgq_put_many(&bmsgq, msgs, 2, K_NO_WAIT);
+	zassert_equal(ret, 2);
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+	zassert_equal(k_msgq_num_used_get(&bmsgq), 1);
+	k_msgq_purge(&bmsgq);
+
+	/**TESTPOINT: waiting writer gets in once a batch is received */
+	fill_tx(0);
+	ret = k_msgq_put_many(&bmsgq, tx, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN);
+	tids[0] = k_thread_create(&tdata, tstack, STACK_SIZE, tput_entry,
+				  &bmsgq, NULL, NULL, K_PRIO_PREEMPT(0), 0,
+				  K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	ret = k_msgq_get_many(&bmsgq, rx, 2, K_NO_WAIT);
+	zassert_equal(ret, 2);
+	k_thread_join(tids[0], K_FOREVER);
+	tids[0] = NULL;
+	zassert_equal(k_msgq_num_used_get(&bmsgq), BATCH_LEN - 1);
+
+	ret = k_msgq_get_many(&bmsgq, rx, ARRAY_SIZE(rx), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN - 1);
+	zassert_equal(rx[BATCH_LEN - 2], MSG0);
+}
+
+/**
+ * @brief Test building a message in place in the queue
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_cancel()
+ */
+ZTEST(msgq_api, test_msgq_reserve_commit)
+{
+	uint32_t msg = MSG0;
+	void *slot;
+	int ret;
+
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	ret = k_msgq_reserve(&bmsgq, &slot);
+	zassert_equal(ret, 0);
+	zassert_equal(k_msgq_reserve(&bmsgq, &slot), -EBUSY);
+
+	/**TESTPOINT: the reserved slot blocks other senders */
+	zassert_equal(k_msgq_put(&bmsgq, &msg, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_put_many(&bmsgq, &msg, 1, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_num_used_get(&bmsgq), 0);
+
+	/**TESTPOINT: a cancelled slot sends nothing */
+	k_msgq_cancel(&bmsgq);
+	zassert_equal(k_msgq_commit(&bmsgq), -EINVAL);
+	zassert_equal(k_msgq_num_used_get(&bmsgq), 0);
+
+	for (int i = 0; i < BATCH_LEN; i++) {
+		ret = k_msgq_reserve(&bmsgq, &slot);
+		zassert_equal(ret, 0);
+		*(uint32_t *)slot = MSG1 + i;
+		zassert_equal(k_msgq_commit(&bmsgq), 0);
+	}
+	zassert_equal(k_msgq_reserve(&bmsgq, &slot), -ENOMSG);
+
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(k_msgq_get(&bmsgq, &msg, K_NO_WAIT), 0);
+		zassert_equal(msg, MSG1 + i);
+	}
+
+	/**TESTPOINT: a purge discards the reserved slot */
+	ret = k_msgq_reserve(&bmsgq, &slot);
+	zassert_equal(ret, 0);
+	*(uint32_t *)slot = MSG0;
+	k_msgq_purge(&bmsgq);
+	zassert_equal(k_msgq_commit(&bmsgq), -EINVAL);
+	zassert_equal(k_msgq_num_used_get(&bmsgq), 0);
+	zassert_equal(k_msgq_put(&bmsgq, &msg, K_NO_WAIT), 0);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test sending and receiving messages in batches from user mode
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+ZTEST_USER(msgq_api, test_msgq_user_put_get_many)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN));
+
+	put_get_many(q);
+}
+#endif
+
+/**
+ * @}
+ */
@@ -447,8 +447,10 @@ ZTEST(mutex_complex, test_supervisor_access)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
-	/* coverage for get_k_mutex checks */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
+	/* coverage for get_k_mutex checks, the fast path would access
+	 * these addresses directly
+	 */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
@@ -457,7 +459,7 @@ ZTEST(mutex_complex, test_supervisor_access)
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FAST_PATH */
 
 	rv = sys_mutex_unlock(&not_my_mutex);
 	zassert_true(rv == -EPERM, "unlocked a mutex that wasn't owner");
@@ -467,7 +469,7 @@ ZTEST(mutex_complex, test_supervisor_access)
 
 ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 {
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
@@ -476,7 +478,72 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 #else
 	ztest_test_skip();
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
+#if defined(CONFIG_SMP) && defined(CONFIG_USERSPACE)
+#define HANDOFF_ITERATIONS 10000
+
+static ZTEST_BMEM SYS_MUTEX_DEFINE(handoff_mutex);
+static ZTEST_BMEM int handoff_count;
+static ZTEST_BMEM int handoff_errors;
+
+static K_THREAD_STACK_DEFINE(handoff_user_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static K_THREAD_STACK_DEFINE(handoff_kernel_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread handoff_user_thread;
+static struct k_thread handoff_kernel_thread;
+
+static void handoff_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < HANDOFF_ITERATIONS; i++) {
+		if (sys_mutex_lock(&handoff_mutex, K_FOREVER) != 0) {
+			handoff_errors++;
+			return;
+		}
+		handoff_count++;
+		if (sys_mutex_unlock(&handoff_mutex) != 0) {
+			handoff_errors++;
+			return;
+		}
+	}
+}
+#endif /* CONFIG_SMP && CONFIG_USERSPACE */
+
+/* A user mode thread and a supervisor thread running on different CPUs keep
+ * handing the mutex over to each other, switching between the user mode fast
+ * path and the kernel mutex whenever they contend
+ */
+ZTEST(mutex_complex, test_smp_user_kernel_handoff)
+{
+#if defined(CONFIG_SMP) && defined(CONFIG_USERSPACE)
+	int prio = k_thread_priority_get(k_current_get());
+
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	k_thread_create(&handoff_user_thread, handoff_user_stack,
+			K_THREAD_STACK_SIZEOF(handoff_user_stack), handoff_entry,
+			NULL, NULL, NULL, prio, K_USER | K_INHERIT_PERMS, K_FOREVER);
+	k_thread_create(&handoff_kernel_thread, handoff_kernel_stack,
+			K_THREAD_STACK_SIZEOF(handoff_kernel_stack), handoff_entry,
+			NULL, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_start(&handoff_user_thread);
+	k_thread_start(&handoff_kernel_thread);
+
+	zassert_equal(k_thread_join(&handoff_user_thread, K_SECONDS(60)), 0,
+		      "user mode thread deadlocked");
+	zassert_equal(k_thread_join(&handoff_kernel_thread, K_SECONDS(60)), 0,
+		      "supervisor thread deadlocked");
+	zassert_equal(handoff_errors, 0, "mutex lock or unlock failed");
+	zassert_equal(handoff_count, 2 * HANDOFF_ITERATIONS, "mutex did not serialize");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SMP && CONFIG_USERSPACE */
 }
 
 /*test case main entry*/
@@ -69,3 +69,39 @@ ZTEST(k_pipe_stress, test_read)
 	end_cycles = k_uptime_get_32();
 	LOG_INF("Elapsed cycles: %u\n", end_cycles - start_cycles);
 }
+
+#define HDR_LEN 8
+#define PAYLOAD_LEN 56
+
+ZTEST(k_pipe_stress, test_writev)
+{
+	uint8_t buffer[WRITE_LEN];
+	uint8_t hdr[HDR_LEN] = {};
+	uint8_t payload[PAYLOAD_LEN] = {};
+	uint8_t buf[HDR_LEN + PAYLOAD_LEN];
+	struct k_pipe_iovec iov[] = {
+		{ hdr, sizeof(hdr) },
+		{ payload, sizeof(payload) },
+	};
+	uint32_t start_cycles, split_cycles, vectored_cycles;
+
+	/* Small header and payload pieces, sent separately then gathered */
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	start_cycles = k_cycle_get_32();
+	for (int i = 0; i < 100; i++) {
+		zassert_equal(k_pipe_write(&pipe, hdr, sizeof(hdr), K_NO_WAIT), sizeof(hdr));
+		zassert_equal(k_pipe_write(&pipe, payload, sizeof(payload), K_NO_WAIT),
+			      sizeof(payload));
+		zassert_equal(k_pipe_read(&pipe, buf, sizeof(buf), K_NO_WAIT), sizeof(buf));
+	}
+	split_cycles = k_cycle_get_32() - start_cycles;
+
+	start_cycles = k_cycle_get_32();
+	for (int i = 0; i < 100; i++) {
+		zassert_equal(k_pipe_writev(&pipe, iov, ARRAY_SIZE(iov), K_NO_WAIT), sizeof(buf));
+		zassert_equal(k_pipe_readv(&pipe, iov, ARRAY_SIZE(iov), K_NO_WAIT), sizeof(buf));
+	}
+	vectored_cycles = k_cycle_get_32() - start_cycles;
+
+	LOG_INF("Elapsed cycles: %u split, %u vectored\n", split_cycles, vectored_cycles);
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+ZTEST_SUITE(k_pipe_vectored, NULL, NULL, NULL, NULL, NULL);
+
+#define DUMMY_DATA_SIZE 16
+static struct k_thread thread;
+static K_THREAD_STACK_DEFINE(stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_pipe pipe;
+
+static void fill(uint8_t *buffer, size_t size, uint8_t start)
+{
+	for (size_t i = 0; i < size; i++) {
+		buffer[i] = start + i;
+	}
+}
+
+ZTEST(k_pipe_vectored, test_writev_readv)
+{
+	uint8_t buffer[10];
+	uint8_t hdr[3], payload[5], empty[1];
+	uint8_t out_a[4], out_b[6];
+	struct k_pipe_iovec wr[] = {
+		{ hdr, sizeof(hdr) },
+		{ empty, 0 },
+		{ payload, sizeof(payload) },
+	};
+	struct k_pipe_iovec rd[] = {
+		{ out_a, sizeof(out_a) },
+		{ out_b, sizeof(out_b) },
+	};
+
+	fill(hdr, sizeof(hdr), 0);
+	fill(payload, sizeof(payload), sizeof(hdr));
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+
+	for (int i = 0; i < 3; i++) {
+		/* Every iteration wraps around the ring buffer at a different place */
+		zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), 8,
+			      "Failed to write vectors to pipe");
+		memset(out_a, 0, sizeof(out_a));
+		memset(out_b, 0, sizeof(out_b));
+		zassert_equal(k_pipe_readv(&pipe, rd, ARRAY_SIZE(rd), K_NO_WAIT), 8,
+			      "Failed to read vectors from pipe");
+		for (int j = 0; j < sizeof(out_a); j++) {
+			zassert_equal(out_a[j], j, "Unexpected data received from pipe");
+		}
+		for (int j = 0; j < 8 - sizeof(out_a); j++) {
+			zassert_equal(out_b[j], sizeof(out_a) + j,
+				      "Unexpected data received from pipe");
+		}
+	}
+
+	/* Only what fits is written without waiting */
+	zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), 8);
+	zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), 2);
+	zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), -EAGAIN);
+}
+
+ZTEST(k_pipe_vectored, test_writev_too_large)
+{
+	uint8_t buffer[10];
+	struct k_pipe_iovec wr[] = {
+		{ buffer, SIZE_MAX },
+		{ buffer, 2 },
+	};
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_readv(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), -EINVAL);
+}
+
+#ifdef CONFIG_USERSPACE
+ZTEST_USER(k_pipe_vectored, test_writev_readv_user)
+{
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t input[DUMMY_DATA_SIZE];
+	uint8_t output[DUMMY_DATA_SIZE];
+	struct k_pipe_iovec wr[DUMMY_DATA_SIZE];
+	struct k_pipe_iovec rd[] = {
+		{ output, 3 },
+		{ &output[3], DUMMY_DATA_SIZE - 3 },
+	};
+	struct k_pipe *p;
+
+	/* More vectors than the verifier copies to its stack */
+	for (int i = 0; i < ARRAY_SIZE(wr); i++) {
+		wr[i].iov_base = &input[i];
+		wr[i].iov_len = 1;
+	}
+
+	fill(input, sizeof(input), 0x40);
+	memset(output, 0, sizeof(output));
+
+	p = k_object_alloc(K_OBJ_PIPE);
+	zassert_not_null(p, "Failed to allocate pipe");
+	k_pipe_init(p, buffer, sizeof(buffer));
+
+	zassert_equal(k_pipe_writev(p, wr, ARRAY_SIZE(wr), K_NO_WAIT), DUMMY_DATA_SIZE,
+		      "Failed to write vectors to pipe");
+	zassert_equal(k_pipe_readv(p, rd, ARRAY_SIZE(rd), K_NO_WAIT), DUMMY_DATA_SIZE,
+		      "Failed to read vectors from pipe");
+	zassert_mem_equal(input, output, sizeof(input), "Unexpected data received from pipe");
+}
+#endif /* CONFIG_USERSPACE */
+
+static void thread_readv(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *out = arg2;
+	struct k_pipe_iovec rd[] = {
+		{ out, 1 },
+		{ &out[1], DUMMY_DATA_SIZE - 1 },
+	};
+
+	zassert_equal(k_pipe_readv((struct k_pipe *)arg1, rd, ARRAY_SIZE(rd), K_FOREVER),
+		      DUMMY_DATA_SIZE, "Failed to read vectors from pipe");
+}
+
+ZTEST(k_pipe_vectored, test_writev_to_pending_reader)
+{
+	k_tid_t tid;
+	uint8_t input[DUMMY_DATA_SIZE];
+	uint8_t output[DUMMY_DATA_SIZE];
+	struct k_pipe_iovec wr[] = {
+		{ input, 5 },
+		{ &input[5], DUMMY_DATA_SIZE - 5 },
+	};
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	/* Zero size pipes are not supported due to requiring cache
+	 * management on data buffers as the buffers can reside in
+	 * incoherent memory. So skip this test.
+	 */
+	ztest_test_skip();
+#endif
+
+	fill(input, sizeof(input), 0x20);
+	memset(output, 0, sizeof(output));
+	k_pipe_init(&pipe, NULL, 0);
+
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_readv, &pipe, output, NULL, K_PRIO_COOP(0), 0, K_NO_WAIT);
+	k_msleep(100);
+
+	/* Without a ring buffer, data can only go straight to the reader */
+	zassert_equal(k_pipe_writev(&pipe, wr, ARRAY_SIZE(wr), K_NO_WAIT), DUMMY_DATA_SIZE,
+		      "Failed to write vectors to pipe");
+	k_thread_join(tid, K_FOREVER);
+	zassert_mem_equal(input, output, sizeof(input), "Unexpected data received from pipe");
+}
+
+ZTEST(k_pipe_vectored, test_peek_consume)
+{
+	uint8_t buffer[10];
+	uint8_t data[8];
+	uint8_t read_data[8];
+	uint8_t *claimed;
+	int rc;
+
+	fill(data, sizeof(data), 0);
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	zassert_equal(k_pipe_peek(&pipe, &claimed, sizeof(buffer)), -EAGAIN,
+		      "Should not be able to peek into empty pipe");
+	zassert_equal(k_pipe_consume(&pipe, 0), -EINVAL,
+		      "Should not be able to consume without a claim");
+
+	/* Move the start of the data close to the end of the ring buffer */
+	zassert_equal(k_pipe_write(&pipe, data, 6, K_NO_WAIT), 6);
+	zassert_equal(k_pipe_read(&pipe, read_data, 6, K_NO_WAIT), 6);
+	zassert_equal(k_pipe_write(&pipe, data, sizeof(data), K_NO_WAIT), sizeof(data));
+
+	/* Data wrapping around has to be claimed in two pieces */
+	rc = k_pipe_peek(&pipe, &claimed, sizeof(data));
+	zassert_equal(rc, 4, "Unexpected claimed size %d", rc);
+	zassert_mem_equal(claimed, data, 4);
+	zassert_equal(k_pipe_read(&pipe, read_data, 1, K_NO_WAIT), -EBUSY,
+		      "Should not be able to read while data is claimed");
+	rc = k_pipe_peek(&pipe, &claimed, sizeof(data));
+	zassert_equal(rc, 4, "Unexpected claimed size %d", rc);
+	zassert_mem_equal(claimed, &data[4], 4);
+	zassert_equal(k_pipe_peek(&pipe, &claimed, sizeof(data)), -EAGAIN,
+		      "Should not be able to claim more than the pipe holds");
+
+	/* Unconsumed data is put back */
+	zassert_equal(k_pipe_consume(&pipe, 10), -EINVAL);
+	zassert_equal(k_pipe_consume(&pipe, 3), 0);
+	zassert_equal(k_pipe_consume(&pipe, 0), -EINVAL);
+	zassert_equal(k_pipe_read(&pipe, read_data, sizeof(read_data), K_NO_WAIT), 5);
+	zassert_mem_equal(read_data, &data[3], 5);
+
+	/* Claimed data survives closing the pipe */
+	zassert_equal(k_pipe_write(&pipe, data, 2, K_NO_WAIT), 2);
+	zassert_equal(k_pipe_peek(&pipe, &claimed, 1), 1);
+	k_pipe_close(&pipe);
+	zassert_equal(k_pipe_peek(&pipe, &claimed, 1), 1);
+	zassert_equal(k_pipe_consume(&pipe, 2), 0);
+	zassert_equal(k_pipe_peek(&pipe, &claimed, 1), -EPIPE,
+		      "Should not be able to peek into empty closed pipe");
+}
+
+static void thread_consume(void *arg1, void *arg2, void *arg3)
+{
+	uint8_t *claimed;
+
+	zassert_true(k_pipe_peek((struct k_pipe *)arg1, &claimed, DUMMY_DATA_SIZE) > 0,
+		     "Failed to peek into pipe");
+	zassert_equal(k_pipe_consume((struct k_pipe *)arg1, 1), 0,
+		      "Failed to consume from pipe");
+}
+
+ZTEST(k_pipe_vectored, test_consume_wakes_writer)
+{
+	k_tid_t tid;
+	uint8_t buffer[DUMMY_DATA_SIZE];
+	uint8_t data[DUMMY_DATA_SIZE + 1];
+
+	k_pipe_init(&pipe, buffer, sizeof(buffer));
+	tid = k_thread_create(&thread, stack, K_THREAD_STACK_SIZEOF(stack),
+		thread_consume, &pipe, NULL, NULL, K_PRIO_COOP(0), 0, K_MSEC(100));
+	zassert_equal(k_pipe_write(&pipe, data, sizeof(data), K_MSEC(1000)), sizeof(data),
+		      "Consuming should make room for the writer");
+	k_thread_join(tid, K_FOREVER);
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+#ifdef CONFIG_SYS_HASH_MAP_SWISS
+
+static uint32_t string_hash(uint64_t key)
+{
+	const char *str = (const char *)(uintptr_t)key;
+	uint32_t hash = 0;
+
+	/* independent of the configured default hash, which may only support scalars */
+	while (*str != '\0') {
+		hash = hash * 31 + *str++;
+	}
+
+	return hash;
+}
+
+static bool string_eq(uint64_t key1, uint64_t key2)
+{
+	return strcmp((const char *)(uintptr_t)key1, (const char *)(uintptr_t)key2) == 0;
+}
+
+SYS_HASHMAP_SWISS_BLOB_DEFINE(string_map, string_hash, string_eq);
+
+static char keys[MANY][16];
+
+ZTEST(hash_map, test_blob_keys)
+{
+	char lookup[16];
+	uint64_t value;
+
+	for (size_t i = 0; i < MANY; ++i) {
+		snprintf(keys[i], sizeof(keys[i]), "key-%zu", i);
+		zassert_equal(1, sys_hashmap_insert(&string_map, (uintptr_t)keys[i], i, NULL));
+	}
+
+	/* keys are compared by content, not by address */
+	for (size_t i = 0; i < MANY; ++i) {
+		snprintf(lookup, sizeof(lookup), "key-%zu", i);
+		zassert_true(sys_hashmap_get(&string_map, (uintptr_t)lookup, &value));
+		zassert_equal(i, value);
+	}
+
+	snprintf(lookup, sizeof(lookup), "key-%d", MANY);
+	zassert_false(sys_hashmap_contains_key(&string_map, (uintptr_t)lookup));
+
+	snprintf(lookup, sizeof(lookup), "key-%d", 0);
+	zassert_equal(0, sys_hashmap_insert(&string_map, (uintptr_t)lookup, 42, &value));
+	zassert_equal(0, value);
+	zassert_equal(MANY, sys_hashmap_size(&string_map));
+
+	zassert_true(sys_hashmap_remove(&string_map, (uintptr_t)lookup, &value));
+	zassert_equal(42, value);
+	zassert_equal(MANY - 1, sys_hashmap_size(&string_map));
+
+	sys_hashmap_clear(&string_map, NULL, NULL);
+}
+
+#endif /* CONFIG_SYS_HASH_MAP_SWISS */
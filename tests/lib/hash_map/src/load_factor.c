@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
+
 #include <zephyr/ztest.h>
 #include <zephyr/sys/hash_map.h>
 
@@ -55,3 +57,39 @@ ZTEST(hash_map, test_load_factor_custom)
 		zassert_true(load_factor <= CUSTOM_LOAD_FACTOR);
 	}
 }
+
+#ifdef CONFIG_SYS_HASH_MAP_SWISS
+
+#define FULL_N_BUCKETS 64
+
+/* with a load factor above 100, halving the table may leave no room for all the entries */
+SYS_HASHMAP_SWISS_DEFINE_ADVANCED(full_map, sys_hash32, realloc,
+				  {
+					  .max_size = SIZE_MAX,
+					  .load_factor = 200,
+					  .initial_n_buckets = FULL_N_BUCKETS,
+				  });
+
+ZTEST(hash_map, test_load_factor_above_100)
+{
+	uint64_t value;
+
+	for (size_t i = 0; i < FULL_N_BUCKETS; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&full_map, i, i, NULL));
+	}
+
+	zassert_equal(-ENOSPC, sys_hashmap_insert(&full_map, FULL_N_BUCKETS, 0, NULL));
+
+	/* the table cannot shrink, it is kept as is */
+	zassert_true(sys_hashmap_remove(&full_map, 0, NULL));
+	zassert_equal(FULL_N_BUCKETS - 1, sys_hashmap_size(&full_map));
+
+	for (size_t i = 1; i < FULL_N_BUCKETS; ++i) {
+		zassert_true(sys_hashmap_get(&full_map, i, &value));
+		zassert_equal(i, value);
+	}
+
+	sys_hashmap_clear(&full_map, NULL, NULL);
+}
+
+#endif /* CONFIG_SYS_HASH_MAP_SWISS */
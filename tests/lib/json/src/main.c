@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <zephyr/ztest.h>
 #include <zephyr/data/json.h>
+#include <zephyr/net_buf.h>
 
 struct test_nested {
 	int nested_int;
@@ -2927,4 +2928,220 @@ ZTEST(lib_json_test, test_debug_string_types)
 	zassert_str_equal(decoded.string_buf, "buffer\ttab", "string_buf not unescaped");
 }
 
+#ifdef CONFIG_JSON_LIBRARY_STREAM
+struct stream_inner {
+	int32_t value;
+	char label[8];
+};
+
+struct stream_item {
+	int id;
+	bool enabled;
+	char name[16];
+	int64_t big;
+	uint8_t small;
+	struct stream_inner inner;
+	int32_t samples[4];
+	size_t samples_len;
+};
+
+struct stream_doc {
+	struct stream_item items[3];
+	size_t items_len;
+	char title[24];
+	uint64_t serial;
+};
+
+static const struct json_obj_descr stream_inner_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct stream_inner, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct stream_inner, label, JSON_TOK_STRING_BUF),
+};
+
+static const struct json_obj_descr stream_item_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct stream_item, id, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct stream_item, enabled, JSON_TOK_TRUE),
+	JSON_OBJ_DESCR_PRIM(struct stream_item, name, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct stream_item, big, JSON_TOK_INT64),
+	JSON_OBJ_DESCR_PRIM(struct stream_item, small, JSON_TOK_UINT),
+	JSON_OBJ_DESCR_OBJECT(struct stream_item, inner, stream_inner_descr),
+	JSON_OBJ_DESCR_ARRAY(struct stream_item, samples, 4, samples_len, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr stream_doc_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct stream_doc, items, 3, items_len, stream_item_descr,
+				 ARRAY_SIZE(stream_item_descr)),
+	JSON_OBJ_DESCR_PRIM(struct stream_doc, title, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct stream_doc, serial, JSON_TOK_UINT64),
+};
+
+static const struct json_obj_descr elt_buf_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct elt, name_buf, JSON_TOK_STRING_BUF),
+	JSON_OBJ_DESCR_PRIM(struct elt, height, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr obj_array_buf_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct obj_array, elements, 10, num_elements,
+				 elt_buf_descr, ARRAY_SIZE(elt_buf_descr)),
+};
+
+static const char stream_doc_json[] =
+	"{\"items\":[{\"id\":1,\"enabled\":true,\"name\":\"a\\\"b\\n\\u0041\","
+	"\"big\":-9000000000,\"small\":200,\"inner\":{\"value\":-3,\"label\":\"x\\/y\"},"
+	"\"samples\":[1,-2,3],\"unknown\":{\"x\":[1,{\"y\":\"]}\"}],\"z\":[[[]]]}},"
+	" {\"id\" : 2 , \"enabled\":false , \"samples\" : [ ] } ],"
+	"\"skipped\":[[],\"}\",true,false,-1.2e-3,{}], \"title\":\"hello world\","
+	"\"serial\":18446744073709551615 }\n";
+
+/* Feed a value in chunks of chunk_size bytes */
+static int64_t stream_parse_chunked(struct json_stream_parser *parser, const char *json,
+				    size_t chunk_size)
+{
+	size_t len = strlen(json);
+
+	for (size_t off = 0; off < len; off += chunk_size) {
+		(void)json_stream_parse(parser, &json[off], MIN(chunk_size, len - off));
+	}
+
+	return json_stream_parse_finish(parser);
+}
+
+ZTEST(lib_json_test, test_json_stream_obj_parse)
+{
+	struct stream_doc expected = {0};
+	struct stream_doc decoded;
+	struct json_stream_parser parser;
+	char buffer[sizeof(stream_doc_json)];
+	int64_t ret;
+
+	memcpy(buffer, stream_doc_json, sizeof(buffer));
+	ret = json_obj_parse(buffer, sizeof(buffer) - 1, stream_doc_descr,
+			     ARRAY_SIZE(stream_doc_descr), &expected);
+	zassert_equal(ret, 0x7, "Reference parsing failed (%lld)", ret);
+	zassert_equal(expected.items_len, 2);
+	zassert_str_equal(expected.items[0].name, "a\"b\n\\u0041");
+
+	/* Every chunk size must give the same result as json_obj_parse() */
+	for (size_t chunk_size = 1; chunk_size < sizeof(stream_doc_json); chunk_size++) {
+		memset(&decoded, 0, sizeof(decoded));
+		json_stream_obj_parse_init(&parser, stream_doc_descr,
+					   ARRAY_SIZE(stream_doc_descr), &decoded);
+
+		ret = stream_parse_chunked(&parser, stream_doc_json, chunk_size);
+		zassert_equal(ret, 0x7, "Parsing in chunks of %zu failed (%lld)", chunk_size, ret);
+		zassert_mem_equal(&decoded, &expected, sizeof(decoded),
+				  "Chunks of %zu decoded differently", chunk_size);
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_arr_parse)
+{
+	struct obj_array expected = {0};
+	struct obj_array decoded = {0};
+	struct json_stream_parser parser;
+	char json[] = "[{\"name_buf\":\"Sim\",\"height\":174},{\"name_buf\":\"Joe\",\"height\":190}]";
+	int64_t ret;
+
+	json_stream_arr_parse_init(&parser, obj_array_buf_descr, &decoded);
+	ret = stream_parse_chunked(&parser, json, 5);
+	zassert_equal(ret, 0, "Parsing array failed (%lld)", ret);
+
+	zassert_equal(json_arr_parse(json, strlen(json), obj_array_buf_descr, &expected), 0);
+	zassert_mem_equal(&decoded, &expected, sizeof(decoded), "Array decoded differently");
+	zassert_equal(decoded.num_elements, 2);
+	zassert_str_equal(decoded.elements[1].name_buf, "Joe");
+}
+
+ZTEST(lib_json_test, test_json_stream_parse_errors)
+{
+	struct stream_doc decoded;
+	struct elt elt;
+	struct json_stream_parser parser;
+	static const struct {
+		const char *json;
+		int64_t ret;
+	} cases[] = {
+		{ "{\"title\":\"hello\"", -EINVAL },
+		{ "{\"serial\":1", -EINVAL },
+		{ "{\"serial\":1,}", -EINVAL },
+		{ "{\"serial\":tru}", -EINVAL },
+		{ "{\"serial\":\"1\"}", -EINVAL },
+		{ "{\"serial\":1} x", -EINVAL },
+		{ "[]", -EINVAL },
+		{ "{\"title\":\"bad \\q escape\"}", -EINVAL },
+		{ "{\"title\":\"longer than twenty four bytes\"}", -EINVAL },
+		/* Bounded by the escaped length, as by json_obj_parse() */
+		{ "{\"title\":\"\\n\\n\\n\\n\\n\\n\\n\\n\\n\\n\\n\\n\"}", -EINVAL },
+		{ "{\"title\":\"\\n\\n\\n\\n\\n\\n\\n\\n\\n\\n\\na\"}", 0x2 },
+		{ "{\"items\":[{},{},{},{}]}", -ENOSPC },
+		{ "{\"items\":[{\"small\":256}]}", -EINVAL },
+		{ "{\"unknown\":null,\"serial\":1}", 0x4 },
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		json_stream_obj_parse_init(&parser, stream_doc_descr,
+					   ARRAY_SIZE(stream_doc_descr), &decoded);
+		zassert_equal(stream_parse_chunked(&parser, cases[i].json, 3), cases[i].ret,
+			      "Unexpected result for %s", cases[i].json);
+	}
+
+	/* Errors are sticky */
+	json_stream_obj_parse_init(&parser, stream_doc_descr, ARRAY_SIZE(stream_doc_descr),
+				   &decoded);
+	zassert_equal(json_stream_parse(&parser, "{]", 2), -EINVAL);
+	zassert_equal(json_stream_parse(&parser, "}", 1), -EINVAL);
+
+	/* Pointers into the input cannot outlive the chunks */
+	json_stream_obj_parse_init(&parser, elt_descr, ARRAY_SIZE(elt_descr), &elt);
+	zassert_equal(json_stream_parse(&parser, "{\"name\":\"x\"}", 12), -ENOTSUP);
+}
+#endif /* CONFIG_JSON_LIBRARY_STREAM */
+
+#ifdef CONFIG_NET_BUF
+NET_BUF_POOL_FIXED_DEFINE(json_frag_pool, 16, 16, 0, NULL);
+
+ZTEST(lib_json_test, test_json_obj_encode_net_buf)
+{
+	struct obj_array obj_array = {
+		.elements = {
+			{ .name = "Simon \"Petrus\"", .name_buf = "Sim", .height = 179 },
+			{ .name = "Joe\tRoot", .name_buf = "Joe", .height = -1 },
+			{ .name = "Ben\\", .name_buf = "B\n", .height = 175 },
+		},
+		.num_elements = 3,
+	};
+	char expected[256];
+	char flat[256];
+	struct net_buf *buf;
+	size_t len;
+	int ret;
+
+	ret = json_obj_encode_buf(obj_array_descr, ARRAY_SIZE(obj_array_descr), &obj_array,
+				  expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding to a buffer failed");
+
+	buf = net_buf_alloc(&json_frag_pool, K_NO_WAIT);
+	zassert_not_null(buf);
+	net_buf_add_mem(buf, "x", 1);
+
+	ret = json_obj_encode_net_buf(obj_array_descr, ARRAY_SIZE(obj_array_descr), &obj_array,
+				      buf, &json_frag_pool);
+	zassert_equal(ret, 0, "Encoding to a net_buf chain failed (%d)", ret);
+	zassert_not_null(buf->frags, "Data should span fragments");
+
+	len = net_buf_linearize(flat, sizeof(flat) - 1, buf, 0, sizeof(flat) - 1);
+	flat[len] = '\0';
+	zassert_equal(flat[0], 'x', "Existing data overwritten");
+	zassert_str_equal(&flat[1], expected, "Encoded contents not consistent");
+	net_buf_unref(buf);
+
+	/* Without a pool, only the room left in the chain is used */
+	buf = net_buf_alloc(&json_frag_pool, K_NO_WAIT);
+	zassert_not_null(buf);
+	ret = json_obj_encode_net_buf(obj_array_descr, ARRAY_SIZE(obj_array_descr), &obj_array,
+				      buf, NULL);
+	zassert_equal(ret, -ENOMEM, "Encoding should not fit in a fragment");
+	net_buf_unref(buf);
+}
+#endif /* CONFIG_NET_BUF */
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
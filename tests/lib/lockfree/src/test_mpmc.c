@@ -0,0 +1,281 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/mpmc_lockfree.h>
+
+/*
+ * @brief Produce and Consume a single uint32_t in the same execution context
+ *
+ * @see mpmc_acquire(), mpmc_produce(), mpmc_consume(), mpmc_release()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_produce_consume_size2)
+{
+	MPMC_DEFINE(ezmpmc, uint32_t, 2);
+
+	const uint32_t magic = 43219876;
+
+	uint32_t *acq = mpmc_acquire(&ezmpmc);
+
+	zassert_not_null(acq, "Acquire should succeed");
+	*acq = magic;
+
+	uint32_t *acq2 = mpmc_acquire(&ezmpmc);
+
+	zassert_not_null(acq2, "Acquire should succeed");
+	zassert_is_null(mpmc_acquire(&ezmpmc), "Acquire should fail");
+
+	zassert_is_null(mpmc_consume(&ezmpmc), "Consume should fail");
+
+	mpmc_produce(&ezmpmc, acq);
+
+	uint32_t *cons = mpmc_consume(&ezmpmc);
+
+	zassert_not_null(cons, "Consume should not fail");
+	zassert_equal(*cons, magic, "Consume value should equal magic");
+
+	/* Second element is acquired but not produced yet */
+	zassert_is_null(mpmc_consume(&ezmpmc), "Consume should fail");
+	zassert_is_null(mpmc_acquire(&ezmpmc), "Acquire should fail");
+
+	mpmc_release(&ezmpmc, cons);
+
+	uint32_t *acq3 = mpmc_acquire(&ezmpmc);
+
+	zassert_not_null(acq3, "Acquire should succeed");
+	zassert_equal_ptr(acq3, cons, "Released element should be reused");
+	zassert_equal(mpmc_consumable(&ezmpmc), 2, "Consumables should be 2");
+
+	mpmc_produce(&ezmpmc, acq3);
+	mpmc_produce(&ezmpmc, acq2);
+
+	zassert_equal_ptr(mpmc_consume(&ezmpmc), acq2, "Consume should be in order");
+	zassert_equal_ptr(mpmc_consume(&ezmpmc), acq3, "Consume should be in order");
+	zassert_equal(mpmc_consumable(&ezmpmc), 0, "Consumables should be 0");
+}
+
+/**
+ * @brief Produce and Consume 3 items at a time in a mpmc of size 4 to validate
+ * masking and wrap around reads/writes.
+ *
+ * @see mpmc_acquire(), mpmc_produce(), mpmc_consume(), mpmc_release()
+ *
+ * @ingroup tests
+ */
+ZTEST(mpmc, test_produce_consume_wrap_around)
+{
+	MPMC_DEFINE(ezmpmc, uint32_t, 4);
+
+	for (int i = 0; i < 10; i++) {
+		zassert_equal(mpmc_consumable(&ezmpmc), 0, "Consumables should be 0");
+		for (int j = 0; j < 3; j++) {
+			uint32_t *entry = mpmc_acquire(&ezmpmc);
+
+			zassert_not_null(entry, "Acquire should succeed");
+			*entry = i * 3 + j;
+			mpmc_produce(&ezmpmc, entry);
+		}
+		zassert_equal(mpmc_consumable(&ezmpmc), 3, "Consumables should be 3");
+
+		for (int k = 0; k < 3; k++) {
+			uint32_t *entry = mpmc_consume(&ezmpmc);
+
+			zassert_not_null(entry, "Consume should succeed");
+			zassert_equal(*entry, i * 3 + k, "Consume value should equal i*3+k");
+			mpmc_release(&ezmpmc, entry);
+		}
+
+		zassert_equal(mpmc_consumable(&ezmpmc), 0, "Consumables should be 0");
+	}
+}
+
+/**
+ * @brief Ensure that integer wraps continue to work.
+ *
+ * Done by starting both positions and all sequence numbers right below
+ * UINTPTR_MAX, and writing and reading enough to ensure integer wraps occur.
+ */
+ZTEST(mpmc, test_int_wrap_around)
+{
+	MPMC_DEFINE(ezmpmc, uint32_t, 4);
+	const unsigned long start = UINTPTR_MAX - 2;
+
+	ezmpmc._mpmc.in = ATOMIC_INIT(start);
+	ezmpmc._mpmc.out = ATOMIC_INIT(start);
+	for (unsigned long i = 0; i < mpmc_size(&ezmpmc); i++) {
+		/* Element (start + i) is due for the lap starting at start */
+		unsigned long idx = (start + i) & ezmpmc._mpmc.mask;
+
+		ezmpmc._mpmc.seq[idx] = ATOMIC_INIT(start + i - idx);
+	}
+
+	for (int j = 0; j < 3; j++) {
+		uint32_t *entry = mpmc_acquire(&ezmpmc);
+
+		zassert_not_null(entry, "Acquire should succeed");
+		*entry = j;
+		mpmc_produce(&ezmpmc, entry);
+	}
+
+	zassert_equal(atomic_get(&ezmpmc._mpmc.in), UINTPTR_MAX + 1, "Mpmc in should wrap");
+
+	for (int k = 0; k < 3; k++) {
+		uint32_t *entry = mpmc_consume(&ezmpmc);
+
+		zassert_not_null(entry, "Consume should succeed");
+		zassert_equal(*entry, k, "Consume value should equal k");
+		mpmc_release(&ezmpmc, entry);
+	}
+
+	zassert_equal(atomic_get(&ezmpmc._mpmc.out), UINTPTR_MAX + 1, "Mpmc out should wrap");
+}
+
+#define SMP_ITERATIONS 1000
+#define PRODUCERS_NUM 2
+#define CONSUMERS_NUM 2
+#define THREADS_NUM (PRODUCERS_NUM + CONSUMERS_NUM)
+
+MPMC_DEFINE(mpmc, uint32_t, 4);
+
+static atomic_t consumed_count;
+static atomic_t consumed_sum;
+
+static void t_produce(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct mpmc_mpmc *ezmpmc = p1;
+	uint32_t *val;
+
+	for (int i = 1; i <= SMP_ITERATIONS; i++) {
+		while ((val = mpmc_acquire(ezmpmc)) == NULL) {
+			k_yield();
+		}
+		*val = i;
+		mpmc_produce(ezmpmc, val);
+	}
+}
+
+static void t_consume(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct mpmc_mpmc *ezmpmc = p1;
+	uint32_t *val;
+
+	while (atomic_get(&consumed_count) < (PRODUCERS_NUM * SMP_ITERATIONS)) {
+		val = mpmc_consume(ezmpmc);
+		if (val == NULL) {
+			k_yield();
+			continue;
+		}
+		atomic_add(&consumed_sum, *val);
+		mpmc_release(ezmpmc, val);
+		atomic_inc(&consumed_count);
+	}
+}
+
+#define STACK_SIZE (384 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_thread tthread[THREADS_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, THREADS_NUM, STACK_SIZE);
+
+/**
+ * @brief Test that concurrent producers and consumers neither lose nor
+ * duplicate elements
+ *
+ * This can and should be validated on SMP machines where incoherent
+ * memory could cause issues.
+ */
+ZTEST(mpmc, test_mpmc_threaded)
+{
+	k_tid_t tid[THREADS_NUM];
+
+	for (int i = 0; i < THREADS_NUM; i++) {
+		tid[i] = k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+					 i < PRODUCERS_NUM ? t_produce : t_consume,
+					 &mpmc, NULL, NULL,
+					 K_PRIO_PREEMPT(5),
+					 K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < THREADS_NUM; i++) {
+		k_thread_join(tid[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&consumed_count), PRODUCERS_NUM * SMP_ITERATIONS,
+		      "All produced elements should be consumed");
+	zassert_equal(atomic_get(&consumed_sum),
+		      PRODUCERS_NUM * (SMP_ITERATIONS * (SMP_ITERATIONS + 1) / 2),
+		      "Each element should be consumed exactly once");
+	zassert_equal(mpmc_consumable(&mpmc), 0, "Consumables should be 0");
+}
+
+#define THROUGHPUT_ITERS 100000
+
+K_MSGQ_DEFINE(ref_msgq, sizeof(uint32_t), 4, 4);
+
+/**
+ * @brief Compare the cost of an element hand-off with the one of a k_msgq
+ */
+ZTEST(mpmc, test_mpmc_throughput)
+{
+	timing_t start_time, end_time;
+	uint64_t mpmc_ns, msgq_ns;
+	uint32_t *x, *y;
+	uint32_t val;
+
+	timing_init();
+	timing_start();
+
+	int key = irq_lock();
+
+	start_time = timing_counter_get();
+	for (int i = 0; i < THROUGHPUT_ITERS; i++) {
+		x = mpmc_acquire(&mpmc);
+		*x = i;
+		mpmc_produce(&mpmc, x);
+
+		y = mpmc_consume(&mpmc);
+		mpmc_release(&mpmc, y);
+	}
+	end_time = timing_counter_get();
+	mpmc_ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+
+	start_time = timing_counter_get();
+	for (int i = 0; i < THROUGHPUT_ITERS; i++) {
+		val = i;
+		(void)k_msgq_put(&ref_msgq, &val, K_NO_WAIT);
+		(void)k_msgq_get(&ref_msgq, &val, K_NO_WAIT);
+	}
+	end_time = timing_counter_get();
+	msgq_ns = timing_cycles_to_ns(timing_cycles_get(&start_time, &end_time));
+
+	irq_unlock(key);
+
+	timing_stop();
+
+	TC_PRINT("mpmc: %llu ns for %d iterations, %llu ns per op\n", mpmc_ns,
+		 THROUGHPUT_ITERS, mpmc_ns / THROUGHPUT_ITERS);
+	TC_PRINT("msgq: %llu ns for %d iterations, %llu ns per op\n", msgq_ns,
+		 THROUGHPUT_ITERS, msgq_ns / THROUGHPUT_ITERS);
+}
+
+static void mpmc_before(void *data)
+{
+	ARG_UNUSED(data);
+
+	mpmc_reset(&mpmc);
+	atomic_clear(&consumed_count);
+	atomic_clear(&consumed_sum);
+}
+
+ZTEST_SUITE(mpmc, NULL, NULL, mpmc_before, NULL, NULL);
@@ -38,6 +38,9 @@ static void *fat_fs_basic_setup(void)
 #ifdef CONFIG_FS_FATFS_REENTRANT
 	test_fat_file_reentrant();
 #endif /* CONFIG_FS_FATFS_REENTRANT */
+#ifdef CONFIG_FILE_SYSTEM_RTIO
+	test_fat_file_async();
+#endif /* CONFIG_FILE_SYSTEM_RTIO */
 	test_fat_unmount();
 
 	return NULL;
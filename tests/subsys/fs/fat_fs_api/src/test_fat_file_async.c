@@ -0,0 +1,75 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio.h>
+
+#include "test_fat.h"
+
+#define ASYNC_TEST_FILE FATFS_MNTP"/async.txt"
+#define ASYNC_CHUNK 16
+
+RTIO_DEFINE(fs_rtio, 4, 4);
+
+static uint8_t wbuf[2][ASYNC_CHUNK];
+static uint8_t rbuf[2 * ASYNC_CHUNK + 1];
+
+static int32_t consume(void *userdata)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume_block(&fs_rtio);
+	int32_t result = cqe->result;
+
+	zassert_equal_ptr(cqe->userdata, userdata, "Unexpected completion");
+	rtio_cqe_release(&fs_rtio, cqe);
+
+	return result;
+}
+
+void test_fat_file_async(void)
+{
+	struct rtio_sqe *sqe;
+	int res;
+
+	TC_PRINT("\nAsynchronous file access test:\n");
+
+	for (int i = 0; i < ASYNC_CHUNK; i++) {
+		wbuf[0][i] = i;
+		wbuf[1][i] = ASYNC_CHUNK + i;
+	}
+
+	res = fs_open(&filep, ASYNC_TEST_FILE, FS_O_CREATE | FS_O_RDWR);
+	zassert_ok(res, "Err: File could not be opened [%d]\n", res);
+
+	/* Two writes chained so that they land in order */
+	sqe = rtio_sqe_acquire(&fs_rtio);
+	zassert_not_null(sqe);
+	fs_sqe_prep_write(sqe, &filep, wbuf[0], ASYNC_CHUNK, wbuf[0]);
+	sqe->flags |= RTIO_SQE_CHAINED;
+	sqe = rtio_sqe_acquire(&fs_rtio);
+	zassert_not_null(sqe);
+	fs_sqe_prep_write(sqe, &filep, wbuf[1], ASYNC_CHUNK, wbuf[1]);
+	zassert_ok(rtio_submit(&fs_rtio, 0));
+
+	zassert_equal(consume(wbuf[0]), ASYNC_CHUNK, "First write failed");
+	zassert_equal(consume(wbuf[1]), ASYNC_CHUNK, "Second write failed");
+
+	res = fs_seek(&filep, 0, FS_SEEK_SET);
+	zassert_ok(res, "Error seeking to start of file [%d]\n", res);
+
+	/* Reading past the end returns what the file holds */
+	zassert_ok(fs_read_async(&filep, rbuf, sizeof(rbuf), &fs_rtio, rbuf));
+	zassert_equal(consume(rbuf), 2 * ASYNC_CHUNK, "Read failed");
+	zassert_mem_equal(rbuf, wbuf[0], ASYNC_CHUNK);
+	zassert_mem_equal(&rbuf[ASYNC_CHUNK], wbuf[1], ASYNC_CHUNK);
+
+	res = fs_close(&filep);
+	zassert_ok(res, "Error closing file [%d]\n", res);
+
+	/* Closed files are refused right away */
+	zassert_equal(fs_write_async(&filep, wbuf[0], ASYNC_CHUNK, &fs_rtio, NULL), -EBADF);
+
+	res = fs_unlink(ASYNC_TEST_FILE);
+	zassert_ok(res, "Error deleting file [%d]\n", res);
+}
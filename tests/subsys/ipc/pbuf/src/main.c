@@ -106,6 +106,64 @@ ZTEST(test_pbuf, test_rw)
 	zassert_mem_equal(write_buf, read_buf, MPS);
 }
 
+/* Unread data as seen by the writer. */
+ZTEST(test_pbuf, test_unread)
+{
+	uint8_t read_buf[MEM_AREA_SZ] = {0};
+	uint8_t write_buf[MEM_AREA_SZ] = {0};
+	uint32_t rd_idx;
+	int ret;
+
+	/* TODO: Use PBUF_DEFINE().
+	 * The user should use PBUF_DEFINE() macro to define the buffer,
+	 * however for the purpose of this test PBUF_CFG_INIT() is used in
+	 * order to avoid clang complains about memory_area not being constant
+	 * expression.
+	 */
+	static PBUF_MAYBE_CONST struct pbuf_cfg cfg = PBUF_CFG_INIT(memory_area, MEM_AREA_SZ, 0, 0);
+
+	static struct pbuf pb = {
+		.cfg = &cfg,
+	};
+
+	zassert_equal(pbuf_tx_init(&pb), 0);
+	zassert_equal(pbuf_unread(&pb), 0);
+
+	/* Every packet written counts with its length field and padding. */
+	ret = pbuf_write(&pb, write_buf, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+	ret = pbuf_write(&pb, write_buf, MSGB_SZ);
+	zassert_equal(ret, MSGB_SZ);
+	ret = pbuf_unread(&pb);
+	zassert_equal(ret, PBUF_PACKET_SIZE(MSGA_SZ) + PBUF_PACKET_SIZE(MSGB_SZ));
+
+	/* The count drops as the reader consumes the packets. */
+	ret = pbuf_read(&pb, read_buf, MSGA_SZ);
+	zassert_equal(ret, MSGA_SZ);
+	ret = pbuf_unread(&pb);
+	zassert_equal(ret, PBUF_PACKET_SIZE(MSGB_SZ));
+	ret = pbuf_read(&pb, read_buf, MSGB_SZ);
+	zassert_equal(ret, MSGB_SZ);
+	zassert_equal(pbuf_unread(&pb), 0);
+
+	/* A packet wrapping around is counted whole. */
+	ret = pbuf_write(&pb, write_buf, MPS);
+	zassert_equal(ret, MPS);
+	ret = pbuf_unread(&pb);
+	zassert_equal(ret, PBUF_PACKET_SIZE(MPS));
+	ret = pbuf_read(&pb, read_buf, MPS);
+	zassert_equal(ret, MPS);
+	zassert_equal(pbuf_unread(&pb), 0);
+
+	/* The read index comes from the reader and is validated. */
+	rd_idx = *(cfg.rd_idx_loc);
+	*(cfg.rd_idx_loc) = cfg.len + 1;
+	zassert_equal(pbuf_unread(&pb), -EINVAL);
+	*(cfg.rd_idx_loc) = rd_idx;
+
+	zassert_equal(pbuf_unread(NULL), -EINVAL);
+}
+
 /* API ret codes tests. */
 ZTEST(test_pbuf, test_retcodes)
 {
@@ -511,6 +511,100 @@ ZTEST(modem_cmux, test_modem_cmux_resync)
 		     "Incorrect data received");
 }
 
+ZTEST(modem_cmux, test_modem_cmux_receive_dlci2_ppp_fragmented)
+{
+	int ret;
+	size_t split = sizeof(cmux_frame_dlci2_ppp_52) / 2;
+
+	/* Frame data is written to the DLCI receive buffer as it arrives */
+	modem_backend_mock_put(&bus_mock, cmux_frame_dlci2_ppp_52, split);
+	k_msleep(20);
+
+	ret = modem_pipe_receive(dlci2_pipe, buffer2, sizeof(buffer2));
+	zassert_equal(ret, 0, "Data of incomplete frame received");
+
+	/* But only made available once the whole frame is received */
+	modem_backend_mock_put(&bus_mock, &cmux_frame_dlci2_ppp_52[split],
+			       sizeof(cmux_frame_dlci2_ppp_52) - split - 1);
+	k_msleep(20);
+
+	ret = modem_pipe_receive(dlci2_pipe, buffer2, sizeof(buffer2));
+	zassert_equal(ret, 0, "Data of incomplete frame received");
+
+	modem_backend_mock_put(&bus_mock,
+			       &cmux_frame_dlci2_ppp_52[sizeof(cmux_frame_dlci2_ppp_52) - 1], 1);
+	k_msleep(20);
+
+	ret = modem_pipe_receive(dlci2_pipe, buffer2, sizeof(buffer2));
+	zassert_equal(ret, sizeof(cmux_frame_data_dlci2_ppp_52),
+		      "Incorrect number of bytes received");
+
+	zassert_true(memcmp(buffer2, cmux_frame_data_dlci2_ppp_52,
+			    sizeof(cmux_frame_data_dlci2_ppp_52)) == 0,
+		     "Incorrect data received");
+}
+
+ZTEST(modem_cmux, test_modem_cmux_receive_dlci1_invalid_fcs)
+{
+	static uint8_t invalid_fcs[] = {0xF9, 0x07, 0xEF, 0x05, 0x41, 0x54, 0x31, 0xF9};
+	int ret;
+
+	modem_backend_mock_put(&bus_mock, invalid_fcs, sizeof(invalid_fcs));
+	modem_backend_mock_put(&bus_mock, cmux_frame_dlci1_at_newline,
+			       sizeof(cmux_frame_dlci1_at_newline));
+
+	k_msleep(100);
+
+	/* Data of the dropped frame must be discarded from the DLCI receive buffer */
+	ret = modem_pipe_receive(dlci1_pipe, buffer1, sizeof(buffer1));
+	zassert_equal(ret, sizeof(cmux_frame_data_dlci1_at_newline),
+		      "Incorrect number of bytes received");
+
+	zassert_true(memcmp(buffer1, cmux_frame_data_dlci1_at_newline,
+			    sizeof(cmux_frame_data_dlci1_at_newline)) == 0,
+		     "Incorrect data received");
+}
+
+ZTEST(modem_cmux, test_modem_cmux_stalled_dlci1_does_not_block_dlci2)
+{
+	int ret;
+
+	/* Overrun the receive buffer of DLCI1, which is not read, while receiving on DLCI2 */
+	for (int i = 0; i < 70; i++) {
+		modem_backend_mock_put(&bus_mock, cmux_frame_dlci1_at_at,
+				       sizeof(cmux_frame_dlci1_at_at));
+
+		if ((i % 10) == 0) {
+			modem_backend_mock_put(&bus_mock, cmux_frame_dlci2_at_newline,
+					       sizeof(cmux_frame_dlci2_at_newline));
+		}
+	}
+
+	k_msleep(100);
+
+	ret = modem_pipe_receive(dlci2_pipe, buffer2, sizeof(buffer2));
+	zassert_equal(ret, 7 * sizeof(cmux_frame_data_dlci2_at_newline),
+		      "Incorrect number of bytes received on DLCI2");
+
+	for (int i = 0; i < ret; i += sizeof(cmux_frame_data_dlci2_at_newline)) {
+		zassert_true(memcmp(&buffer2[i], cmux_frame_data_dlci2_at_newline,
+				    sizeof(cmux_frame_data_dlci2_at_newline)) == 0,
+			     "Incorrect data received on DLCI2");
+	}
+
+	/* DLCI1 kept what fit in its receive buffer */
+	ret = modem_pipe_receive(dlci1_pipe, buffer1, sizeof(buffer1));
+	zassert_equal(ret, sizeof(dlci1_receive_buf), "Incorrect number of bytes received");
+
+	for (int i = 0; i < ret; i++) {
+		zassert_equal(buffer1[i], cmux_frame_data_dlci1_at_at[i % 2],
+			      "Incorrect data received on DLCI1");
+	}
+
+	/* Let the flow control of DLCI1 be released */
+	k_msleep(100);
+}
+
 ZTEST(modem_cmux, test_modem_cmux_flow_control_dlci2)
 {
 	int ret;
@@ -0,0 +1,209 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/ztest.h>
+
+#define MAX_SUBMITTED 16
+
+/* Iodev keeping what it is given until the test completes it */
+struct sched_test_iodev {
+	struct rtio_iodev_sqe *submitted[MAX_SUBMITTED];
+	uintptr_t id[MAX_SUBMITTED];
+	uint32_t len[MAX_SUBMITTED];
+	int count;
+	int completed;
+};
+
+static struct sched_test_iodev test_iodev;
+
+static void sched_test_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	zassert_true(test_iodev.count < MAX_SUBMITTED);
+
+	test_iodev.id[test_iodev.count] = (uintptr_t)iodev_sqe->sqe.userdata;
+	test_iodev.len[test_iodev.count] = iodev_sqe->sqe.tx.buf_len;
+	test_iodev.submitted[test_iodev.count++] = iodev_sqe;
+}
+
+static const struct rtio_iodev_api sched_test_api = {
+	.submit = sched_test_submit,
+};
+
+RTIO_IODEV_SCHED_DEFINE(sched_one, 1, 0);
+RTIO_IODEV_SCHED_DEFINE(sched_two, 2, 0);
+RTIO_IODEV_SCHED_DEFINE(sched_merge, 1, RTIO_IODEV_SCHED_MERGE);
+
+RTIO_IODEV_DEFINE_WITH_SCHED(iodev_one, &sched_test_api, NULL, &sched_one);
+/* Two devices on the same bus */
+RTIO_IODEV_DEFINE_WITH_SCHED(iodev_bus_a, &sched_test_api, NULL, &sched_two);
+RTIO_IODEV_DEFINE_WITH_SCHED(iodev_bus_b, &sched_test_api, NULL, &sched_two);
+RTIO_IODEV_DEFINE_WITH_SCHED(iodev_merge, &sched_test_api, NULL, &sched_merge);
+
+RTIO_DEFINE(r_sched, 16, 16);
+
+static uint8_t buf[32];
+
+static void submit_tx(const struct rtio_iodev *iodev, uint8_t prio, k_timeout_t deadline,
+		      const uint8_t *data, uint32_t len, uintptr_t id)
+{
+	struct rtio_sqe *sqe = rtio_sqe_acquire(&r_sched);
+
+	zassert_not_null(sqe);
+	rtio_sqe_prep_write(sqe, iodev, prio, data, len, (void *)id);
+	rtio_sqe_set_deadline(sqe, deadline);
+	zassert_ok(rtio_submit(&r_sched, 0));
+}
+
+/* Complete the submissions handed to the iodev, oldest first */
+static void complete_next(void)
+{
+	zassert_true(test_iodev.completed < test_iodev.count, "nothing in flight");
+	rtio_iodev_sqe_ok(test_iodev.submitted[test_iodev.completed++], 0);
+}
+
+static void check_submitted(const uintptr_t *ids, int count)
+{
+	zassert_equal(count, test_iodev.count);
+	for (int i = 0; i < count; i++) {
+		zassert_equal(ids[i], test_iodev.id[i], "submission %d", i);
+	}
+}
+
+static void check_completions(const uintptr_t *ids, int count)
+{
+	for (int i = 0; i < count; i++) {
+		struct rtio_cqe *cqe = rtio_cqe_consume(&r_sched);
+
+		zassert_not_null(cqe, "completion %d missing", i);
+		zassert_ok(cqe->result);
+		zassert_equal(ids[i], (uintptr_t)cqe->userdata, "completion %d", i);
+		rtio_cqe_release(&r_sched, cqe);
+	}
+	zassert_is_null(rtio_cqe_consume(&r_sched));
+}
+
+static void sched_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	memset(&test_iodev, 0, sizeof(test_iodev));
+}
+
+static void sched_after(void *f)
+{
+	ARG_UNUSED(f);
+
+	while (test_iodev.completed < test_iodev.count) {
+		complete_next();
+	}
+	while (rtio_cqe_consume(&r_sched) != NULL) {
+	}
+	zassert_equal(0, sched_one.in_flight);
+	zassert_equal(0, sched_two.in_flight);
+	zassert_equal(0, sched_merge.in_flight);
+}
+
+ZTEST_SUITE(rtio_iodev_sched, NULL, NULL, sched_before, sched_after, NULL);
+
+ZTEST(rtio_iodev_sched, test_priority)
+{
+	const uintptr_t order[] = {1, 3, 4, 2};
+
+	submit_tx(&iodev_one, RTIO_PRIO_LOW, K_FOREVER, buf, 1, 1);
+	submit_tx(&iodev_one, RTIO_PRIO_LOW, K_FOREVER, buf, 1, 2);
+	submit_tx(&iodev_one, RTIO_PRIO_HIGH, K_FOREVER, buf, 1, 3);
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_FOREVER, buf, 1, 4);
+
+	/* Only one at a time, the others wait in priority order */
+	zassert_equal(1, test_iodev.count);
+	for (int i = 0; i < ARRAY_SIZE(order); i++) {
+		complete_next();
+	}
+
+	check_submitted(order, ARRAY_SIZE(order));
+	check_completions(order, ARRAY_SIZE(order));
+}
+
+ZTEST(rtio_iodev_sched, test_deadline)
+{
+	const uintptr_t order[] = {1, 4, 3, 5, 2};
+
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_FOREVER, buf, 1, 1);
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_FOREVER, buf, 1, 2);
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_MSEC(100), buf, 1, 3);
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_MSEC(10), buf, 1, 4);
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_MSEC(100), buf, 1, 5);
+
+	for (int i = 0; i < ARRAY_SIZE(order); i++) {
+		complete_next();
+	}
+
+	check_submitted(order, ARRAY_SIZE(order));
+	check_completions(order, ARRAY_SIZE(order));
+}
+
+ZTEST(rtio_iodev_sched, test_shared_depth)
+{
+	submit_tx(&iodev_bus_a, RTIO_PRIO_LOW, K_FOREVER, buf, 1, 1);
+	submit_tx(&iodev_bus_a, RTIO_PRIO_LOW, K_FOREVER, buf, 1, 2);
+	submit_tx(&iodev_bus_a, RTIO_PRIO_LOW, K_FOREVER, buf, 1, 3);
+	submit_tx(&iodev_bus_b, RTIO_PRIO_HIGH, K_FOREVER, buf, 1, 4);
+
+	/* Both devices count against the depth of the bus */
+	zassert_equal(2, test_iodev.count);
+	zassert_equal(2, sched_two.in_flight);
+
+	complete_next();
+	zassert_equal(3, test_iodev.count);
+	zassert_equal_ptr(&iodev_bus_b, test_iodev.submitted[2]->sqe.iodev);
+}
+
+ZTEST(rtio_iodev_sched, test_merge)
+{
+	const uintptr_t order[] = {1, 2, 3, 4};
+	const uintptr_t submitted[] = {1, 2, 4};
+
+	submit_tx(&iodev_merge, RTIO_PRIO_NORM, K_FOREVER, &buf[0], 4, 1);
+	submit_tx(&iodev_merge, RTIO_PRIO_NORM, K_FOREVER, &buf[4], 4, 2);
+	submit_tx(&iodev_merge, RTIO_PRIO_NORM, K_FOREVER, &buf[8], 8, 3);
+	/* Not contiguous */
+	submit_tx(&iodev_merge, RTIO_PRIO_NORM, K_FOREVER, &buf[20], 4, 4);
+
+	complete_next();
+	zassert_equal(2, test_iodev.count);
+	zassert_equal(12, test_iodev.len[1], "contiguous writes not merged");
+
+	complete_next();
+	complete_next();
+
+	check_submitted(submitted, ARRAY_SIZE(submitted));
+	zassert_equal(4, test_iodev.len[2]);
+	check_completions(order, ARRAY_SIZE(order));
+}
+
+ZTEST(rtio_iodev_sched, test_cancel_queued)
+{
+	const uintptr_t order[] = {1, 3};
+	struct rtio_sqe *handle;
+	struct rtio_sqe sqe;
+
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_FOREVER, buf, 1, 1);
+
+	rtio_sqe_prep_write(&sqe, &iodev_one, RTIO_PRIO_NORM, buf, 1, (void *)2);
+	zassert_ok(rtio_sqe_copy_in_get_handles(&r_sched, &sqe, &handle, 1));
+	zassert_ok(rtio_submit(&r_sched, 0));
+
+	submit_tx(&iodev_one, RTIO_PRIO_NORM, K_FOREVER, buf, 1, 3);
+
+	/* Canceled while queued, it never reaches the iodev */
+	zassert_ok(rtio_sqe_cancel(handle));
+	complete_next();
+	complete_next();
+
+	check_submitted(order, ARRAY_SIZE(order));
+	check_completions(order, ARRAY_SIZE(order));
+}
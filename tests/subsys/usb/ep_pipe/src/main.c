@@ -0,0 +1,371 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/usb/usbd.h>
+#include <zephyr/usb/usbh.h>
+#include <zephyr/drivers/usb/udc.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(usb_test, LOG_LEVEL_INF);
+
+#define TEST_OUT_DEPTH		3
+#define TEST_IN_DEPTH		2
+#define TEST_BUF_SIZE		512
+#define TEST_TIMEOUT_US		(1000 * USEC_PER_MSEC)
+
+USBD_CONFIGURATION_DEFINE(test_fs_config, USB_SCD_SELF_POWERED, 200, NULL);
+USBD_CONFIGURATION_DEFINE(test_hs_config, USB_SCD_SELF_POWERED, 200, NULL);
+
+USBD_DESC_LANG_DEFINE(test_lang);
+
+USBD_DEVICE_DEFINE(test_usbd,
+		   DEVICE_DT_GET(DT_NODELABEL(zephyr_udc0)),
+		   0x2fe3, 0xffff);
+
+USBH_CONTROLLER_DEFINE(uhs_ctx, DEVICE_DT_GET(DT_NODELABEL(zephyr_uhc0)));
+
+/* One more buffer than the pipelines may hold, to tell leaks from refills */
+UDC_BUF_POOL_DEFINE(test_out_pool, TEST_OUT_DEPTH + 1, TEST_BUF_SIZE,
+		    sizeof(struct udc_buf_info), NULL);
+
+UDC_BUF_POOL_DEFINE(test_in_pool, TEST_IN_DEPTH + 1, TEST_BUF_SIZE,
+		    sizeof(struct udc_buf_info), NULL);
+
+struct test_pipe_desc {
+	struct usb_if_descriptor if0;
+	struct usb_ep_descriptor if0_out_ep;
+	struct usb_ep_descriptor if0_in_ep;
+	struct usb_ep_descriptor if0_hs_out_ep;
+	struct usb_ep_descriptor if0_hs_in_ep;
+	struct usb_desc_header nil_desc;
+};
+
+static struct test_pipe_desc test_desc = {
+	.if0 = {
+		.bLength = sizeof(struct usb_if_descriptor),
+		.bDescriptorType = USB_DESC_INTERFACE,
+		.bInterfaceNumber = 0,
+		.bAlternateSetting = 0,
+		.bNumEndpoints = 2,
+		.bInterfaceClass = USB_BCC_VENDOR,
+		.bInterfaceSubClass = 0,
+		.bInterfaceProtocol = 0,
+		.iInterface = 0,
+	},
+	.if0_out_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = 0x01,
+		.bmAttributes = USB_EP_TYPE_BULK,
+		.wMaxPacketSize = sys_cpu_to_le16(64U),
+		.bInterval = 0x00,
+	},
+	.if0_in_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = 0x81,
+		.bmAttributes = USB_EP_TYPE_BULK,
+		.wMaxPacketSize = sys_cpu_to_le16(64U),
+		.bInterval = 0x00,
+	},
+	.if0_hs_out_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = 0x01,
+		.bmAttributes = USB_EP_TYPE_BULK,
+		.wMaxPacketSize = sys_cpu_to_le16(512U),
+		.bInterval = 0x00,
+	},
+	.if0_hs_in_ep = {
+		.bLength = sizeof(struct usb_ep_descriptor),
+		.bDescriptorType = USB_DESC_ENDPOINT,
+		.bEndpointAddress = 0x81,
+		.bmAttributes = USB_EP_TYPE_BULK,
+		.wMaxPacketSize = sys_cpu_to_le16(512U),
+		.bInterval = 0x00,
+	},
+	.nil_desc = {
+		.bLength = 0,
+		.bDescriptorType = 0,
+	},
+};
+
+static const struct usb_desc_header *test_fs_desc[] = {
+	(struct usb_desc_header *)&test_desc.if0,
+	(struct usb_desc_header *)&test_desc.if0_out_ep,
+	(struct usb_desc_header *)&test_desc.if0_in_ep,
+	(struct usb_desc_header *)&test_desc.nil_desc,
+};
+
+static const struct usb_desc_header *test_hs_desc[] = {
+	(struct usb_desc_header *)&test_desc.if0,
+	(struct usb_desc_header *)&test_desc.if0_hs_out_ep,
+	(struct usb_desc_header *)&test_desc.if0_hs_in_ep,
+	(struct usb_desc_header *)&test_desc.nil_desc,
+};
+
+static struct usbd_ep_pipe out_pipe;
+static struct usbd_ep_pipe in_pipe;
+static atomic_t pipe_enabled;
+/* Number of transfers the pipelines got back cancelled */
+static atomic_t cancelled;
+
+static uint8_t test_get_bulk_out(struct usbd_class_data *const c_data)
+{
+	if (usbd_bus_speed(usbd_class_get_ctx(c_data)) == USBD_SPEED_HS) {
+		return test_desc.if0_hs_out_ep.bEndpointAddress;
+	}
+
+	return test_desc.if0_out_ep.bEndpointAddress;
+}
+
+static uint8_t test_get_bulk_in(struct usbd_class_data *const c_data)
+{
+	if (usbd_bus_speed(usbd_class_get_ctx(c_data)) == USBD_SPEED_HS) {
+		return test_desc.if0_hs_in_ep.bEndpointAddress;
+	}
+
+	return test_desc.if0_in_ep.bEndpointAddress;
+}
+
+static int test_pipe_request(struct usbd_class_data *const c_data,
+			     struct net_buf *buf, int err)
+{
+	struct udc_buf_info *bi = udc_get_buf_info(buf);
+	struct usbd_ep_pipe *pipe = USB_EP_DIR_IS_IN(bi->ep) ? &in_pipe : &out_pipe;
+	atomic_val_t count = 0;
+	int ret;
+
+	if (err == -ECONNABORTED) {
+		for (struct net_buf *n = buf; n != NULL; n = n->frags) {
+			count++;
+		}
+	}
+
+	ret = usbd_ep_pipe_done(pipe, buf);
+
+	/* Only account after the pipeline is done with the transfers */
+	atomic_add(&cancelled, count);
+
+	return ret;
+}
+
+static void *test_pipe_get_desc(struct usbd_class_data *const c_data,
+				const enum usbd_speed speed)
+{
+	if (USBD_SUPPORTS_HIGH_SPEED && speed == USBD_SPEED_HS) {
+		return test_hs_desc;
+	}
+
+	return test_fs_desc;
+}
+
+static void test_pipe_enable(struct usbd_class_data *const c_data)
+{
+	int err;
+
+	err = usbd_ep_pipe_start(&in_pipe, test_get_bulk_in(c_data));
+	if (err == 0) {
+		err = usbd_ep_pipe_start(&out_pipe, test_get_bulk_out(c_data));
+	}
+
+	if (err) {
+		LOG_ERR("Failed to start endpoint pipelines (%d)", err);
+		return;
+	}
+
+	atomic_set(&pipe_enabled, 1);
+}
+
+static void test_pipe_disable(struct usbd_class_data *const c_data)
+{
+	atomic_set(&pipe_enabled, 0);
+	usbd_ep_pipe_stop(&in_pipe);
+	usbd_ep_pipe_stop(&out_pipe);
+}
+
+static int test_pipe_init(struct usbd_class_data *const c_data)
+{
+	usbd_ep_pipe_init(&in_pipe, c_data, NULL, TEST_IN_DEPTH);
+	usbd_ep_pipe_init(&out_pipe, c_data, &test_out_pool, TEST_OUT_DEPTH);
+
+	return 0;
+}
+
+static struct usbd_class_api test_pipe_api = {
+	.request = test_pipe_request,
+	.get_desc = test_pipe_get_desc,
+	.enable = test_pipe_enable,
+	.disable = test_pipe_disable,
+	.init = test_pipe_init,
+};
+
+USBD_DEFINE_CLASS(test_pipe, &test_pipe_api, NULL, NULL);
+
+/* Cancel whatever is queued on the endpoint and wait for it to come back */
+static void test_cancel(const uint8_t ep, const atomic_val_t expected)
+{
+	int err;
+
+	err = usbd_ep_dequeue(&test_usbd, ep);
+	zassert_equal(err, 0, "Failed to dequeue endpoint 0x%02x (%d)", ep, err);
+
+	zassert_true(WAIT_FOR(atomic_get(&cancelled) == expected, TEST_TIMEOUT_US,
+			      k_msleep(1)),
+		     "%ld transfers cancelled, expected %ld",
+		     atomic_get(&cancelled), expected);
+}
+
+ZTEST(ep_pipe, test_out_refill)
+{
+	zassert_equal(atomic_get(&out_pipe.queued), TEST_OUT_DEPTH,
+		      "OUT pipeline not filled");
+	zassert_equal(net_buf_get_available(&test_out_pool), 1,
+		      "OUT pipeline holds more buffers than its depth");
+
+	/* The cancelled transfers are replaced, no buffer is lost */
+	test_cancel(test_get_bulk_out(&test_pipe), TEST_OUT_DEPTH);
+
+	zassert_equal(atomic_get(&out_pipe.queued), TEST_OUT_DEPTH,
+		      "OUT pipeline not refilled");
+	zassert_equal(net_buf_get_available(&test_out_pool), 1,
+		      "OUT pipeline leaked buffers");
+}
+
+ZTEST(ep_pipe, test_in_throttle)
+{
+	struct net_buf *bufs[TEST_IN_DEPTH + 1];
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(bufs); i++) {
+		bufs[i] = net_buf_alloc(&test_in_pool, K_NO_WAIT);
+		zassert_not_null(bufs[i], "Failed to allocate IN buffer");
+		memset(udc_get_buf_info(bufs[i]), 0, sizeof(struct udc_buf_info));
+		net_buf_add(bufs[i], TEST_BUF_SIZE);
+	}
+
+	for (size_t i = 0; i < TEST_IN_DEPTH; i++) {
+		err = usbd_ep_pipe_enqueue(&in_pipe, bufs[i], K_NO_WAIT);
+		zassert_equal(err, 0, "Failed to enqueue IN transfer (%d)", err);
+	}
+
+	zassert_equal(atomic_get(&in_pipe.queued), TEST_IN_DEPTH,
+		      "IN transfers not accounted");
+
+	/* Nothing completes, the pipeline is full */
+	err = usbd_ep_pipe_enqueue(&in_pipe, bufs[TEST_IN_DEPTH], K_MSEC(10));
+	zassert_equal(err, -EAGAIN, "IN transfer above the pipeline depth (%d)", err);
+	net_buf_unref(bufs[TEST_IN_DEPTH]);
+
+	test_cancel(test_get_bulk_in(&test_pipe), TEST_IN_DEPTH);
+
+	zassert_equal(atomic_get(&in_pipe.queued), 0, "IN transfers still accounted");
+	zassert_equal(k_sem_count_get(&in_pipe.slots), TEST_IN_DEPTH,
+		      "IN pipeline slots not released");
+	zassert_equal(net_buf_get_available(&test_in_pool), TEST_IN_DEPTH + 1,
+		      "IN pipeline leaked buffers");
+}
+
+ZTEST(ep_pipe, test_stop)
+{
+	const uint8_t ep = test_get_bulk_out(&test_pipe);
+	int err;
+
+	usbd_ep_pipe_stop(&out_pipe);
+
+	/* The cancelled transfers are all released and not replaced */
+	test_cancel(ep, TEST_OUT_DEPTH);
+
+	zassert_equal(atomic_get(&out_pipe.queued), 0, "OUT transfers still accounted");
+	zassert_equal(net_buf_get_available(&test_out_pool), TEST_OUT_DEPTH + 1,
+		      "Cancelled OUT buffers not released");
+
+	err = usbd_ep_pipe_start(&out_pipe, ep);
+	zassert_equal(err, 0, "Failed to restart OUT pipeline (%d)", err);
+	zassert_equal(atomic_get(&out_pipe.queued), TEST_OUT_DEPTH,
+		      "OUT pipeline not filled on restart");
+}
+
+static void *usb_test_enable(void)
+{
+	int err;
+
+	err = usbh_init(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to initialize USB host");
+
+	err = usbh_enable(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to enable USB host");
+
+	err = uhc_bus_reset(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to signal bus reset");
+
+	err = uhc_bus_resume(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to signal bus resume");
+
+	err = uhc_sof_enable(uhs_ctx.dev);
+	zassert_equal(err, 0, "Failed to enable SoF generator");
+
+	LOG_INF("Host controller enabled");
+
+	err = usbd_add_descriptor(&test_usbd, &test_lang);
+	zassert_equal(err, 0, "Failed to initialize descriptor (%d)", err);
+
+	if (USBD_SUPPORTS_HIGH_SPEED &&
+	    usbd_caps_speed(&test_usbd) == USBD_SPEED_HS) {
+		err = usbd_add_configuration(&test_usbd, USBD_SPEED_HS, &test_hs_config);
+		zassert_equal(err, 0, "Failed to add configuration (%d)", err);
+
+		err = usbd_register_class(&test_usbd, "test_pipe", USBD_SPEED_HS, 1);
+		zassert_equal(err, 0, "Failed to register test_pipe class (%d)", err);
+	}
+
+	err = usbd_add_configuration(&test_usbd, USBD_SPEED_FS, &test_fs_config);
+	zassert_equal(err, 0, "Failed to add configuration (%d)", err);
+
+	err = usbd_register_class(&test_usbd, "test_pipe", USBD_SPEED_FS, 1);
+	zassert_equal(err, 0, "Failed to register test_pipe class (%d)", err);
+
+	err = usbd_init(&test_usbd);
+	zassert_equal(err, 0, "Failed to initialize device support");
+
+	err = usbd_enable(&test_usbd);
+	zassert_equal(err, 0, "Failed to enable device support");
+
+	LOG_INF("Device support enabled");
+
+	/* The host configures the device, which starts the pipelines */
+	zassert_true(WAIT_FOR(atomic_get(&pipe_enabled), TEST_TIMEOUT_US, k_msleep(10)),
+		     "Endpoint pipelines not started");
+
+	return NULL;
+}
+
+static void usb_test_before(void *f)
+{
+	atomic_set(&cancelled, 0);
+}
+
+static void usb_test_shutdown(void *f)
+{
+	int err;
+
+	err = usbd_disable(&test_usbd);
+	zassert_equal(err, 0, "Failed to disable device support");
+
+	err = usbd_shutdown(&test_usbd);
+	zassert_equal(err, 0, "Failed to shutdown device support");
+
+	LOG_INF("Device support disabled");
+
+	err = usbh_disable(&uhs_ctx);
+	zassert_equal(err, 0, "Failed to disable USB host");
+
+	LOG_INF("Host controller disabled");
+}
+
+ZTEST_SUITE(ep_pipe, NULL, usb_test_enable, usb_test_before, NULL, usb_test_shutdown);
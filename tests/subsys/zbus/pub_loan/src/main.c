@@ -0,0 +1,179 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/net_buf.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+
+struct msg {
+	uint8_t bytes[64];
+};
+
+static bool msg_validator(const void *msg, size_t msg_size)
+{
+	return true;
+}
+
+static int listener_calls;
+
+static void listener_cb(const struct zbus_channel *chan)
+{
+	const struct msg *msg = zbus_chan_const_msg(chan);
+
+	zassert_equal(0xa5, msg->bytes[0]);
+	listener_calls++;
+}
+
+ZBUS_LISTENER_DEFINE(lis, listener_cb);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub1);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub2);
+
+ZBUS_CHAN_DEFINE(chan, struct msg, NULL, NULL, ZBUS_OBSERVERS(lis, msub1, msub2),
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(validated_chan, struct msg, msg_validator, NULL, ZBUS_OBSERVERS_EMPTY,
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_CHAN_DEFINE(lonely_chan, struct msg, NULL, NULL, ZBUS_OBSERVERS_EMPTY, ZBUS_MSG_INIT(0));
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msub3);
+
+ZBUS_CHAN_DEFINE(queued_chan, struct msg, NULL, NULL, ZBUS_OBSERVERS(msub3), ZBUS_MSG_INIT(0));
+
+ZTEST(pub_loan, test_loan_commit)
+{
+	const struct zbus_channel *chan1, *chan2;
+	struct net_buf *buf1, *buf2;
+	struct msg *loaned, read;
+
+	listener_calls = 0;
+
+	zassert_ok(zbus_chan_pub_loan(&chan, (void **)&loaned, K_NO_WAIT));
+	zassert_equal_ptr(zbus_chan_msg(&chan), loaned);
+
+	/* The channel stays blocked until the commit */
+	zassert_equal(-EBUSY, zbus_chan_claim(&chan, K_NO_WAIT));
+	zassert_equal(-EBUSY, zbus_chan_read(&chan, &read, K_NO_WAIT));
+
+	memset(loaned->bytes, 0xa5, sizeof(loaned->bytes));
+	zassert_ok(zbus_chan_pub_commit(&chan, K_NO_WAIT));
+
+	zassert_equal(1, listener_calls);
+	zassert_equal(1, zbus_chan_pub_stats_count(&chan));
+
+	zassert_ok(zbus_chan_read(&chan, &read, K_NO_WAIT));
+	zassert_mem_equal(loaned->bytes, read.bytes, sizeof(read.bytes));
+
+	/* Both message subscribers get the same copy of the message */
+	zassert_ok(zbus_sub_wait_msg_buf(&msub1, &chan1, &buf1, K_NO_WAIT));
+	zassert_ok(zbus_sub_wait_msg_buf(&msub2, &chan2, &buf2, K_NO_WAIT));
+	zassert_equal_ptr(&chan, chan1);
+	zassert_equal_ptr(&chan, chan2);
+	zassert_equal(sizeof(struct msg), buf1->len);
+	zassert_equal_ptr(buf1->data, buf2->data);
+	zassert_mem_equal(read.bytes, buf1->data, sizeof(read.bytes));
+
+	net_buf_unref(buf1);
+	zassert_mem_equal(read.bytes, buf2->data, sizeof(read.bytes));
+	net_buf_unref(buf2);
+}
+
+ZTEST(pub_loan, test_pub_shared_buf)
+{
+	const struct zbus_channel *sub_chan;
+	struct msg msg = {0}, received;
+	struct net_buf *buf;
+
+	msg.bytes[0] = 0xa5;
+	msg.bytes[63] = 0x5a;
+	zassert_ok(zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+
+	zassert_ok(zbus_sub_wait_msg(&msub1, &sub_chan, &received, K_NO_WAIT));
+	zassert_mem_equal(msg.bytes, received.bytes, sizeof(msg.bytes));
+
+	zassert_ok(zbus_sub_wait_msg_buf(&msub2, &sub_chan, &buf, K_NO_WAIT));
+	zassert_mem_equal(msg.bytes, buf->data, sizeof(msg.bytes));
+	net_buf_unref(buf);
+
+	zassert_equal(-ENOMSG, zbus_sub_wait_msg_buf(&msub2, &sub_chan, &buf, K_NO_WAIT));
+}
+
+ZTEST(pub_loan, test_pub_queued_bufs)
+{
+	const struct zbus_channel *sub_chan;
+	struct msg msg = {0}, received;
+
+	if (!IS_ENABLED(CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_STATIC)) {
+		ztest_test_skip();
+	}
+
+	/* Every buffer of the pool but the one being cloned holds a message of the maximum size */
+	for (int i = 0; i < CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE - 1; i++) {
+		msg.bytes[0] = i;
+		zassert_ok(zbus_chan_pub(&queued_chan, &msg, K_NO_WAIT), "publication %d", i);
+	}
+
+	for (int i = 0; i < CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE - 1; i++) {
+		zassert_ok(zbus_sub_wait_msg(&msub3, &sub_chan, &received, K_NO_WAIT));
+		zassert_equal(i, received.bytes[0]);
+	}
+}
+
+ZTEST(pub_loan, test_loan_validator)
+{
+	void *loaned;
+
+	zassert_equal(-ENOTSUP, zbus_chan_pub_loan(&validated_chan, &loaned, K_NO_WAIT));
+
+	/* The channel is left unclaimed */
+	zassert_ok(zbus_chan_claim(&validated_chan, K_NO_WAIT));
+	zassert_ok(zbus_chan_finish(&validated_chan));
+}
+
+ZTEST(pub_loan, test_commit_without_loan)
+{
+	/* The mocked assertion reports the misuse itself */
+	const int err = IS_ENABLED(CONFIG_ZBUS_ASSERT_MOCK) ? -EFAULT : -EPERM;
+	struct msg *loaned;
+
+	if (IS_ENABLED(CONFIG_ASSERT) && !IS_ENABLED(CONFIG_ZBUS_ASSERT_MOCK)) {
+		ztest_test_skip();
+	}
+
+	zassert_equal(err, zbus_chan_pub_commit(&lonely_chan, K_NO_WAIT));
+
+	/* A claim is not a loan, the channel stays claimed */
+	zassert_ok(zbus_chan_claim(&lonely_chan, K_NO_WAIT));
+	zassert_equal(err, zbus_chan_pub_commit(&lonely_chan, K_NO_WAIT));
+	zassert_equal(-EBUSY, zbus_chan_claim(&lonely_chan, K_NO_WAIT));
+	zassert_ok(zbus_chan_finish(&lonely_chan));
+
+	/* A loan is committed once */
+	zassert_ok(zbus_chan_pub_loan(&lonely_chan, (void **)&loaned, K_NO_WAIT));
+	zassert_ok(zbus_chan_pub_commit(&lonely_chan, K_NO_WAIT));
+	zassert_equal(err, zbus_chan_pub_commit(&lonely_chan, K_NO_WAIT));
+}
+
+ZTEST(pub_loan, test_read_after_claim)
+{
+	struct msg msg = {0}, read;
+
+	/* No message subscriber, no buffer needed */
+	for (int i = 0; i < 2 * CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_SIZE; i++) {
+		msg.bytes[0] = i;
+		zassert_ok(zbus_chan_pub(&lonely_chan, &msg, K_NO_WAIT));
+	}
+
+	zassert_ok(zbus_chan_claim(&lonely_chan, K_NO_WAIT));
+	zassert_equal(-EBUSY, zbus_chan_read(&lonely_chan, &read, K_NO_WAIT));
+	((struct msg *)zbus_chan_msg(&lonely_chan))->bytes[1] = 42;
+	zassert_ok(zbus_chan_finish(&lonely_chan));
+
+	zassert_ok(zbus_chan_read(&lonely_chan, &read, K_NO_WAIT));
+	zassert_equal(msg.bytes[0], read.bytes[0]);
+	zassert_equal(42, read.bytes[1]);
+}
+
+ZTEST_SUITE(pub_loan, NULL, NULL, NULL, NULL, NULL);